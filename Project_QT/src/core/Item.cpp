@@ -54,7 +54,9 @@ void Item::copyBaseMembersTo(Item& targetItem) const {
     // targetItem.id = this->id; // Already set by constructor
     // targetItem.subtype = this->subtype; // Already set by constructor
     // targetItem.itemTypeProvider = this.itemTypeProvider; // Already set by constructor
-    targetItem.attributes = this->attributes; // Deep copy of QMap
+    targetItem.actionId = this->actionId;
+    targetItem.uniqueId = this->uniqueId;
+    targetItem.attributes = this->attributes ? std::make_unique<ItemAttributeStore>(*this->attributes) : nullptr;
 }
 
 bool Item::hasSubtype() const {
@@ -74,40 +76,141 @@ bool Item::hasSubtype() const {
 }
 
 // Attribute Management
+// "aid"/"uid" values that are ints in 1..65535 (what setActionID/setUniqueID produce) live in
+// the typed slots and read back as the same int QVariant. Anything else, including an explicit
+// 0, goes to the interned store, so getAttribute/hasAttribute behave exactly like a plain map.
+uint16_t* Item::typedSlot(ItemAttributeStore::Key key) {
+    return const_cast<uint16_t*>(static_cast<const Item*>(this)->typedSlot(key));
+}
+
+const uint16_t* Item::typedSlot(ItemAttributeStore::Key key) const {
+    if (key == ItemAttributeStore::ActionIdKey) return &actionId;
+    if (key == ItemAttributeStore::UniqueIdKey) return &uniqueId;
+    return nullptr;
+}
+
+void Item::setTypedAttribute(ItemAttributeStore::Key key, uint16_t value) {
+    if (value == 0) {
+        setAttributeByKey(key, QVariant(0));
+        return;
+    }
+    *typedSlot(key) = value;
+    if (attributes && attributes->remove(key) && attributes->isEmpty()) {
+        attributes.reset();
+    }
+}
+
+void Item::setAttributeByKey(ItemAttributeStore::Key key, const QVariant& value) {
+    if (uint16_t* slot = typedSlot(key)) {
+        if (value.typeId() == QMetaType::Int) {
+            const int intValue = value.toInt();
+            if (intValue > 0 && intValue <= 0xFFFF) {
+                setTypedAttribute(key, static_cast<uint16_t>(intValue));
+                return;
+            }
+        }
+        *slot = 0;
+    }
+    if (!attributes) {
+        attributes = std::make_unique<ItemAttributeStore>();
+    }
+    attributes->set(key, value);
+}
+
 void Item::setAttribute(const QString& key, const QVariant& value) {
-    attributes.insert(key, value);
+    setAttributeByKey(ItemAttributeStore::intern(key), value);
 }
 
 QVariant Item::getAttribute(const QString& key) const {
-    return attributes.value(key); // Returns default-constructed QVariant if key not found
+    ItemAttributeStore::Key internedKey;
+    if (!ItemAttributeStore::lookup(key, internedKey)) {
+        return QVariant(); // Never set on any item
+    }
+    const uint16_t* slot = typedSlot(internedKey);
+    if (slot && *slot != 0) {
+        return QVariant(static_cast<int>(*slot));
+    }
+    const QVariant* value = attributes ? attributes->find(internedKey) : nullptr;
+    return value ? *value : QVariant(); // Default-constructed QVariant if key not found
 }
 
 bool Item::hasAttribute(const QString& key) const {
-    return attributes.contains(key);
+    ItemAttributeStore::Key internedKey;
+    if (!ItemAttributeStore::lookup(key, internedKey)) {
+        return false;
+    }
+    const uint16_t* slot = typedSlot(internedKey);
+    if (slot && *slot != 0) {
+        return true;
+    }
+    return attributes && attributes->find(internedKey) != nullptr;
 }
 
 void Item::clearAttribute(const QString& key) {
-    attributes.remove(key);
+    ItemAttributeStore::Key internedKey;
+    if (!ItemAttributeStore::lookup(key, internedKey)) {
+        return;
+    }
+    if (uint16_t* slot = typedSlot(internedKey)) {
+        *slot = 0;
+    }
+    if (attributes && attributes->remove(internedKey) && attributes->isEmpty()) {
+        attributes.reset();
+    }
+}
+
+Item::AttributeMap Item::getAllAttributes() const {
+    AttributeMap result;
+    if (actionId != 0) result.insert(QStringLiteral("aid"), QVariant(static_cast<int>(actionId)));
+    if (uniqueId != 0) result.insert(QStringLiteral("uid"), QVariant(static_cast<int>(uniqueId)));
+    if (attributes) {
+        attributes->forEach([&result](ItemAttributeStore::Key key, const QVariant& value) {
+            result.insert(ItemAttributeStore::name(key), value);
+        });
+    }
+    return result;
+}
+
+void Item::setAllAttributes(const AttributeMap& newAttributes) {
+    clearAllAttributes();
+    for (auto it = newAttributes.constBegin(); it != newAttributes.constEnd(); ++it) {
+        setAttribute(it.key(), it.value());
+    }
+}
+
+void Item::clearAllAttributes() {
+    actionId = 0;
+    uniqueId = 0;
+    attributes.reset();
 }
 
 // Convenience Attribute Accessors
 void Item::setUniqueID(uint16_t uid) {
-    setAttribute("uid", uid);
+    setTypedAttribute(ItemAttributeStore::UniqueIdKey, uid);
 }
 uint16_t Item::getUniqueID() const {
-    return getAttribute("uid").toUInt(); // QVariant handles conversion
+    if (uniqueId != 0) {
+        return uniqueId;
+    }
+    const QVariant* value = attributes ? attributes->find(ItemAttributeStore::UniqueIdKey) : nullptr;
+    return value ? value->toUInt() : 0; // QVariant handles conversion
 }
 void Item::setActionID(uint16_t aid) {
-    setAttribute("aid", aid);
+    setTypedAttribute(ItemAttributeStore::ActionIdKey, aid);
 }
 uint16_t Item::getActionID() const {
-    return getAttribute("aid").toUInt();
+    if (actionId != 0) {
+        return actionId;
+    }
+    const QVariant* value = attributes ? attributes->find(ItemAttributeStore::ActionIdKey) : nullptr;
+    return value ? value->toUInt() : 0;
 }
 void Item::setText(const QString& text) {
-    setAttribute("text", text);
+    setAttributeByKey(ItemAttributeStore::TextKey, text);
 }
 QString Item::getText() const {
-    return getAttribute("text").toString();
+    const QVariant* value = attributes ? attributes->find(ItemAttributeStore::TextKey) : nullptr;
+    return value ? value->toString() : QString();
 }
 
 // Item Properties (delegated to itemTypeProvider)
@@ -194,21 +297,17 @@ uint8_t Item::getLightColor() const {
 /**
  * @brief Estimates the memory usage of this Item object.
  *
- * This method provides a basic estimation. A more accurate version
- * would iterate through the `attributes` QMap and sum the memory
- * used by keys and QVariant values.
+ * Action and unique IDs are stored inline; other attributes are only
+ * counted when the item actually owns an attribute store.
  *
  * @return size_t Estimated memory usage in bytes.
  */
 size_t Item::estimateMemoryUsage() const {
     size_t memory = sizeof(Item);
-    // Add cost of attributes. This is a rough estimate.
-    // A more accurate calculation would iterate attributes:
-    // for (auto it = attributes.begin(); it != attributes.end(); ++it) {
-    //     memory += it.key().capacity() + sizeof(QVariant); // QVariant size is tricky
-    // }
-    memory += attributes.size() * (sizeof(QString) + sizeof(QVariant) + 30); // Rough estimate per attribute
-    return memory + 50; // Placeholder for basic item + general overhead
+    if (attributes) {
+        memory += sizeof(ItemAttributeStore) + attributes->estimateExtraMemoryUsage();
+    }
+    return memory;
 }
 
 // OTBM Attribute Handling
@@ -2,6 +2,7 @@
 #define RME_ITEM_H
 
 #include "IItemTypeProvider.h" // Interface for item properties
+#include "ItemAttributes.h"    // Interned attribute storage
 #include <cstdint>
 #include <memory>      // For std::unique_ptr
 #include <QMap>
@@ -25,13 +26,17 @@ namespace core {
 
 class Item {
 public:
-    // Attributes map type
+    // Attributes map type (used when exchanging the whole attribute set)
     using AttributeMap = QMap<QString, QVariant>;
 
 protected:
     uint16_t id;
     uint16_t subtype; // Used for count, charges, fluid type, etc.
-    AttributeMap attributes;
+    // Typed slots for "aid"/"uid" integer values 1..65535; 0 means the attribute is not held here.
+    // They fill what would otherwise be padding, so they add nothing to sizeof(Item).
+    uint16_t actionId = 0;
+    uint16_t uniqueId = 0;
+    std::unique_ptr<ItemAttributeStore> attributes; // All other attributes; null while there are none
     IItemTypeProvider* itemTypeProvider; // Non-owning pointer, set externally
 
 public:
@@ -59,8 +64,10 @@ public:
     QVariant getAttribute(const QString& key) const;
     bool hasAttribute(const QString& key) const;
     void clearAttribute(const QString& key);
-    const AttributeMap& getAllAttributes() const { return attributes; }
-    void setAllAttributes(const AttributeMap& newAttributes) { attributes = newAttributes; }
+    bool hasAnyAttributes() const { return actionId != 0 || uniqueId != 0 || (attributes && !attributes->isEmpty()); }
+    AttributeMap getAllAttributes() const; // Built on demand, ordered by attribute name
+    void setAllAttributes(const AttributeMap& newAttributes);
+    void clearAllAttributes();
 
 
     // Common attribute accessors (convenience)
@@ -127,6 +134,13 @@ public:
 protected:
     // Helper for deep copy of base members
     void copyBaseMembersTo(Item& targetItem) const;
+
+private:
+    // Returns the typed slot for 'key' ("aid"/"uid"), or nullptr for other keys.
+    uint16_t* typedSlot(ItemAttributeStore::Key key);
+    const uint16_t* typedSlot(ItemAttributeStore::Key key) const;
+    void setAttributeByKey(ItemAttributeStore::Key key, const QVariant& value);
+    void setTypedAttribute(ItemAttributeStore::Key key, uint16_t value);
 };
 
 // Placeholder derived classes (can be expanded in future tasks)
@@ -0,0 +1,123 @@
+#include "ItemAttributes.h"
+#include <QHash>
+#include <QList>
+#include <QReadWriteLock>
+#include <QDebug>
+#include <limits>
+
+namespace RME {
+
+namespace {
+
+// Process-wide name <-> key table. Keys are never removed, so a name returned by
+// ItemAttributeStore::name() stays valid for the lifetime of the process.
+struct AttributeKeyRegistry {
+    QReadWriteLock lock;
+    QHash<QString, ItemAttributeStore::Key> keys;
+    QList<QString> names;
+
+    AttributeKeyRegistry() {
+        add(QStringLiteral("uid")); // ItemAttributeStore::UniqueIdKey
+        add(QStringLiteral("aid")); // ItemAttributeStore::ActionIdKey
+        add(QStringLiteral("text")); // ItemAttributeStore::TextKey
+    }
+
+    ItemAttributeStore::Key add(const QString& name) {
+        const auto key = static_cast<ItemAttributeStore::Key>(names.size());
+        keys.insert(name, key);
+        names.append(name);
+        return key;
+    }
+};
+
+AttributeKeyRegistry& registry() {
+    static AttributeKeyRegistry instance;
+    return instance;
+}
+
+} // namespace
+
+ItemAttributeStore::Key ItemAttributeStore::intern(const QString& name) {
+    Key key;
+    if (lookup(name, key)) {
+        return key;
+    }
+
+    AttributeKeyRegistry& reg = registry();
+    QWriteLocker locker(&reg.lock);
+    auto it = reg.keys.constFind(name); // Another thread may have added it meanwhile
+    if (it != reg.keys.constEnd()) {
+        return it.value();
+    }
+    if (reg.names.size() > std::numeric_limits<Key>::max()) {
+        qCritical() << "ItemAttributeStore::intern: attribute key space exhausted, reusing key for" << name;
+        return std::numeric_limits<Key>::max();
+    }
+    return reg.add(name);
+}
+
+bool ItemAttributeStore::lookup(const QString& name, Key& key) {
+    // The well-known keys are by far the most common; answer them without locking.
+    if (name == QLatin1String("aid")) { key = ActionIdKey; return true; }
+    if (name == QLatin1String("uid")) { key = UniqueIdKey; return true; }
+    if (name == QLatin1String("text")) { key = TextKey; return true; }
+
+    AttributeKeyRegistry& reg = registry();
+    QReadLocker locker(&reg.lock);
+    auto it = reg.keys.constFind(name);
+    if (it == reg.keys.constEnd()) {
+        return false;
+    }
+    key = it.value();
+    return true;
+}
+
+QString ItemAttributeStore::name(Key key) {
+    AttributeKeyRegistry& reg = registry();
+    QReadLocker locker(&reg.lock);
+    return key < reg.names.size() ? reg.names.at(key) : QString();
+}
+
+const QVariant* ItemAttributeStore::find(Key key) const {
+    for (const Entry& entry : m_entries) {
+        if (entry.key == key) {
+            return &entry.value;
+        }
+    }
+    return nullptr;
+}
+
+void ItemAttributeStore::set(Key key, const QVariant& value) {
+    for (Entry& entry : m_entries) {
+        if (entry.key == key) {
+            entry.value = value;
+            return;
+        }
+    }
+    m_entries.append(Entry{key, value});
+}
+
+bool ItemAttributeStore::remove(Key key) {
+    for (qsizetype i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].key == key) {
+            m_entries.remove(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ItemAttributeStore::estimateExtraMemoryUsage() const {
+    size_t memory = 0;
+    if (m_entries.size() > 2) {
+        memory += static_cast<size_t>(m_entries.capacity()) * sizeof(Entry); // Spilled to the heap
+    }
+    for (const Entry& entry : m_entries) {
+        if (entry.value.typeId() == QMetaType::QString) {
+            memory += static_cast<size_t>(entry.value.toString().capacity()) * sizeof(QChar);
+        }
+    }
+    return memory;
+}
+
+} // namespace RME
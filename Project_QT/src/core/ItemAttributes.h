@@ -0,0 +1,66 @@
+#ifndef RME_ITEM_ATTRIBUTES_H
+#define RME_ITEM_ATTRIBUTES_H
+
+#include <QString>
+#include <QVariant>
+#include <QVarLengthArray>
+#include <cstdint>
+
+namespace RME {
+
+/**
+ * @brief Compact storage for the free-form attributes of an Item.
+ *
+ * Attribute names are interned process-wide into 16-bit keys, so items never
+ * hold their own copies of names like "aid" or "text". Values live in a small
+ * inline array that only grows onto the heap beyond two attributes.
+ *
+ * Item only allocates a store once it has an attribute outside its typed
+ * action ID / unique ID slots, so attribute-less items pay nothing for it.
+ */
+class ItemAttributeStore {
+public:
+    using Key = uint16_t;
+
+    // Keys registered before any other; stable across runs.
+    static constexpr Key UniqueIdKey = 0; ///< "uid"
+    static constexpr Key ActionIdKey = 1; ///< "aid"
+    static constexpr Key TextKey = 2;     ///< "text"
+
+    /** @brief Returns the key for an attribute name, registering it on first use. Thread-safe. */
+    static Key intern(const QString& name);
+    /** @brief Looks up an existing key without registering; returns false if the name was never interned. */
+    static bool lookup(const QString& name, Key& key);
+    /** @brief Returns the attribute name for a key obtained from intern(). */
+    static QString name(Key key);
+
+    bool isEmpty() const { return m_entries.isEmpty(); }
+    int size() const { return static_cast<int>(m_entries.size()); }
+
+    /** @brief Returns the value stored under 'key', or nullptr if there is none. */
+    const QVariant* find(Key key) const;
+    void set(Key key, const QVariant& value);
+    bool remove(Key key);
+
+    /** @brief Calls visitor(key, value) for each attribute in insertion order. */
+    template <typename Visitor>
+    void forEach(Visitor&& visitor) const {
+        for (const Entry& entry : m_entries) {
+            visitor(entry.key, entry.value);
+        }
+    }
+
+    /** @brief Approximate heap bytes owned by this store beyond sizeof(ItemAttributeStore). */
+    size_t estimateExtraMemoryUsage() const;
+
+private:
+    struct Entry {
+        Key key;
+        QVariant value;
+    };
+    QVarLengthArray<Entry, 2> m_entries;
+};
+
+} // namespace RME
+
+#endif // RME_ITEM_ATTRIBUTES_H
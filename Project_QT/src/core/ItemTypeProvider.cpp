@@ -15,52 +15,23 @@ ItemTypeProvider::ItemTypeProvider(const assets::ItemDatabase* itemDatabase)
 }
 
 bool ItemTypeProvider::isWalkable(uint16_t itemId) const {
-    auto it = m_walkableCache.find(itemId);
-    if (it != m_walkableCache.end()) {
-        return it.value();
-    }
-    
-    const assets::ItemData* itemData = getItemData(itemId);
-    bool walkable = itemData ? !itemData->isBlocking : true; // Default to walkable if no data
-    
-    cacheBoolProperty(m_walkableCache, itemId, walkable);
-    return walkable;
+    return !isBlocking(itemId); // Items without data are walkable
 }
 
 bool ItemTypeProvider::isBlocking(uint16_t itemId) const {
-    auto it = m_blockingCache.find(itemId);
-    if (it != m_blockingCache.end()) {
-        return it.value();
-    }
-    
-    const assets::ItemData* itemData = getItemData(itemId);
-    bool blocking = itemData ? itemData->isBlocking : false;
-    
-    cacheBoolProperty(m_blockingCache, itemId, blocking);
-    return blocking;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_BLOCK_SOLID);
 }
 
 bool ItemTypeProvider::isContainer(uint16_t itemId) const {
-    auto it = m_containerCache.find(itemId);
-    if (it != m_containerCache.end()) {
-        return it.value();
-    }
-    
-    const assets::ItemData* itemData = getItemData(itemId);
-    bool container = itemData ? itemData->isContainer : false;
-    
-    cacheBoolProperty(m_containerCache, itemId, container);
-    return container;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_CONTAINER);
 }
 
 bool ItemTypeProvider::isDoor(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? itemData->isDoor : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_DOOR);
 }
 
 bool ItemTypeProvider::isTeleport(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? itemData->isTeleport : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_TELEPORT);
 }
 
 bool ItemTypeProvider::isBed(uint16_t itemId) const {
@@ -69,68 +40,55 @@ bool ItemTypeProvider::isBed(uint16_t itemId) const {
 }
 
 bool ItemTypeProvider::isDepot(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? itemData->isDepot : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_DEPOT);
 }
 
 bool ItemTypeProvider::isSplash(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? itemData->isSplash : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_SPLASH);
 }
 
 bool ItemTypeProvider::isFluidContainer(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? itemData->isFluidContainer : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_FLUID_CONTAINER);
 }
 
 bool ItemTypeProvider::hasLight(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? (itemData->lightLevel > 0) : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_HAS_LIGHT);
 }
 
 bool ItemTypeProvider::isStackable(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? itemData->isStackable : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_STACKABLE);
 }
 
 bool ItemTypeProvider::isMoveable(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? itemData->isMoveable : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_MOVEABLE);
 }
 
 bool ItemTypeProvider::isPickupable(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? itemData->isPickupable : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_PICKUPABLE);
 }
 
 bool ItemTypeProvider::isRotatable(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? itemData->isRotatable : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_ROTATABLE);
 }
 
 bool ItemTypeProvider::isHangable(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? itemData->isHangable : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_HANGABLE);
 }
 
 bool ItemTypeProvider::isVertical(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? itemData->isVertical : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_VERTICAL);
 }
 
 bool ItemTypeProvider::isHorizontal(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? itemData->isHorizontal : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_HORIZONTAL);
 }
 
 bool ItemTypeProvider::isReadable(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? itemData->isReadable : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_READABLE);
 }
 
 bool ItemTypeProvider::isWriteable(uint16_t itemId) const {
-    const assets::ItemData* itemData = getItemData(itemId);
-    return itemData ? itemData->isWriteable : false;
+    return m_itemDatabase && m_itemDatabase->hasProperty(itemId, ITEM_PROP_WRITEABLE);
 }
 
 bool ItemTypeProvider::isDecoration(uint16_t itemId) const {
@@ -139,16 +97,8 @@ bool ItemTypeProvider::isDecoration(uint16_t itemId) const {
 }
 
 uint8_t ItemTypeProvider::getSpeed(uint16_t itemId) const {
-    auto it = m_speedCache.find(itemId);
-    if (it != m_speedCache.end()) {
-        return it.value();
-    }
-    
     const assets::ItemData* itemData = getItemData(itemId);
-    uint8_t speed = itemData ? itemData->speed : 0;
-    
-    cacheNumericProperty(m_speedCache, itemId, speed);
-    return speed;
+    return itemData ? itemData->speed : 0;
 }
 
 uint8_t ItemTypeProvider::getLightLevel(uint16_t itemId) const {
@@ -187,12 +137,7 @@ QString ItemTypeProvider::getDescription(uint16_t itemId) const {
 }
 
 void ItemTypeProvider::clearCache() {
-    m_walkableCache.clear();
-    m_blockingCache.clear();
-    m_containerCache.clear();
-    m_speedCache.clear();
-    
-    qDebug() << "ItemTypeProvider: Cache cleared";
+    // Nothing is cached here any more; ItemDatabase rebuilds its lookup tables on every load.
 }
 
 bool ItemTypeProvider::isValid() const {
@@ -207,13 +152,5 @@ const assets::ItemData* ItemTypeProvider::getItemData(uint16_t itemId) const {
     return m_itemDatabase->getItemData(itemId);
 }
 
-void ItemTypeProvider::cacheBoolProperty(QHash<uint16_t, bool>& cache, uint16_t itemId, bool value) const {
-    cache[itemId] = value;
-}
-
-void ItemTypeProvider::cacheNumericProperty(QHash<uint16_t, uint8_t>& cache, uint16_t itemId, uint8_t value) const {
-    cache[itemId] = value;
-}
-
 } // namespace core
 } // namespace RME
\ No newline at end of file
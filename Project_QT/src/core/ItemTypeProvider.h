@@ -2,7 +2,6 @@
 #define RME_ITEM_TYPE_PROVIDER_H
 
 #include "IItemTypeProvider.h"
-#include <QHash>
 #include <memory>
 
 namespace RME {
@@ -14,8 +13,9 @@ namespace assets {
 /**
  * @brief Concrete implementation of IItemTypeProvider using ItemDatabase
  * 
- * This class provides item type information by querying the ItemDatabase
- * and caching results for performance. It implements all the interface
+ * This class provides item type information by querying the ItemDatabase.
+ * Boolean properties come straight from the database's packed per-ID flag
+ * table, so no per-property caches are kept. It implements all the interface
  * methods required by the Tile class and other components.
  */
 class ItemTypeProvider : public IItemTypeProvider {
@@ -64,10 +64,10 @@ public:
     QString getDescription(uint16_t itemId) const override;
     
     /**
-     * @brief Clear the internal cache
+     * @brief Kept for callers that used to flush per-property caches
      * 
-     * Call this when the ItemDatabase is reloaded to ensure
-     * cached data is refreshed.
+     * ItemDatabase rebuilds its lookup tables itself when it is reloaded,
+     * so there is nothing to refresh.
      */
     void clearCache();
     
@@ -80,34 +80,12 @@ public:
 private:
     const assets::ItemDatabase* m_itemDatabase;
     
-    // Cache for frequently accessed properties
-    mutable QHash<uint16_t, bool> m_walkableCache;
-    mutable QHash<uint16_t, bool> m_blockingCache;
-    mutable QHash<uint16_t, bool> m_containerCache;
-    mutable QHash<uint16_t, uint8_t> m_speedCache;
-    
     /**
      * @brief Get item data from database with null checking
      * @param itemId The item ID to look up
      * @return Pointer to item data or nullptr if not found
      */
     const assets::ItemData* getItemData(uint16_t itemId) const;
-    
-    /**
-     * @brief Cache a boolean property
-     * @param cache The cache to store in
-     * @param itemId The item ID
-     * @param value The value to cache
-     */
-    void cacheBoolProperty(QHash<uint16_t, bool>& cache, uint16_t itemId, bool value) const;
-    
-    /**
-     * @brief Cache a numeric property
-     * @param cache The cache to store in
-     * @param itemId The item ID
-     * @param value The value to cache
-     */
-    void cacheNumericProperty(QHash<uint16_t, uint8_t>& cache, uint16_t itemId, uint8_t value) const;
 };
 
 } // namespace core
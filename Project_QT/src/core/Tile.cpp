@@ -770,12 +770,20 @@ void Tile::borderize(const Tile* neighbors[8]) {
         return; // No ground to borderize
     }
     
+    applyBorders(borderNeighborConfig(neighbors));
+}
+
+uint8_t Tile::borderNeighborConfig(const Tile* neighbors[8]) const {
     // For now, we'll use a simplified approach
     // In a full implementation, we'd get the MaterialManager from a global context
     // and determine the material type from the ground item
     
     QString materialType = "grass"; // Simplified - would be determined from ground item
-    uint8_t config = analyzeNeighbors(neighbors, materialType);
+    return analyzeNeighbors(neighbors, materialType);
+}
+
+void Tile::applyBorders(uint8_t neighborConfig) {
+    Q_UNUSED(neighborConfig);
     
     // Apply borders based on neighbor configuration
     // This is a simplified implementation - the full version would:
@@ -786,9 +794,6 @@ void Tile::borderize(const Tile* neighbors[8]) {
     
     // For now, just mark the tile as modified
     addStateFlag(TileStateFlag::MODIFIED);
-    
-    qDebug() << "Tile::borderize applied at position" << position.x << "," << position.y 
-             << "with neighbor config" << QString::number(config, 16);
 }
 
 void Tile::wallize() {
@@ -158,6 +158,9 @@ public:
     void update();
 
     void borderize(const Tile* neighbors[8]);
+    // borderize() in two steps; the neighbour analysis only reads tiles
+    uint8_t borderNeighborConfig(const Tile* neighbors[8]) const;
+    void applyBorders(uint8_t neighborConfig);
     void wallize();
     void tableize();
     void carpetize();
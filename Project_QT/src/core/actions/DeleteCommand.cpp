@@ -66,9 +66,9 @@ void DeleteCommand::undo() {
             //    tile->setSpawn(spawn);
             // }
         }
-        m_map->markTileDirty(tile->getPosition());
+        m_map->notifyTileChanged(tile->getPosition());
     }
-    // Map change notifications are handled per-tile via markTileDirty above
+    // Map change notifications are handled per-tile via notifyTileChanged above
 }
 
 void DeleteCommand::redo() {
@@ -108,10 +108,10 @@ void DeleteCommand::redo() {
         if (tile->isEmptyAndClean()) { // Assuming Tile::isEmptyAndClean() checks if it has no content and no special state
              // m_map->removeTile(tile->getPosition()); // If map supports removing empty tiles
         } else {
-            m_map->markTileDirty(tile->getPosition());
+            m_map->notifyTileChanged(tile->getPosition());
         }
     }
-    // Map change notifications are handled per-tile via markTileDirty above
+    // Map change notifications are handled per-tile via notifyTileChanged above
     // Border updates are automatically handled by the brush system during normal editing operations
     // For delete operations, affected neighboring tiles may need border recalculation,
     // which is typically handled by the EditorController or brush system.
@@ -2,133 +2,150 @@
 #include "core/map/Map.h"
 #include "core/Tile.h"
 #include "core/Item.h"
-#include "core/Creature.h"
-#include "core/spawns/Spawn.h"
+#include "core/creatures/Creature.h"
+#include "core/clipboard/ClipboardStream.h"
 // #include "core/settings/EditorSettings.h" // For Config::MERGE_PASTE
 #include <QDebug>
 
 namespace RME {
 
+namespace {
+// Undo snapshots favour speed over size, they never leave the process
+constexpr int ORIGINAL_STATE_COMPRESSION_LEVEL = 1;
+}
+
 PasteCommand::PasteCommand(
     Map* map,
     const Position& targetTopLeftPosition,
-    const ClipboardContent& clipboardContent,
+    const QByteArray& clipboardPayload,
+    AssetManager* assetManager,
+    AppSettings* settings,
     const QString& text,
     QUndoCommand* parent)
     : QUndoCommand(parent),
       m_map(map),
       m_targetTopLeft(targetTopLeftPosition),
-      m_pastedContent(clipboardContent)
+      m_payload(clipboardPayload),
+      m_assetManager(assetManager),
+      m_settings(settings)
 {
     setText(text);
     Q_ASSERT(m_map);
+    Q_ASSERT(m_assetManager);
+    Q_ASSERT(m_settings);
 }
 
-PasteCommand::~PasteCommand() {
-    // qDeleteAll(m_affectedTilesOriginalState); // If storing deep copies
-}
+PasteCommand::~PasteCommand() = default;
 
-void PasteCommand::undo() {
-    // Remove the elements that were pasted by redo().
-    // This needs to be the inverse of redo().
-    // If redo() replaced tiles, undo() restores the originals.
-    // If redo() merged, undo() needs to unmerge.
-    // For a simple first pass: remove all items/creatures/spawns that were part of m_pastedContent
-    // from the tiles at m_pastedTilePositions. Clear ground if it was pasted.
-    qDebug() << "PasteCommand: Undoing paste of" << m_pastedContent.tiles.count() << "tiles' data.";
-
-    for (const Position& pos : m_pastedTilePositions) {
-        Tile* tile = m_map->getTile(pos);
-        if (!tile) continue;
-
-        // This is a simplified undo. A robust undo would restore the exact previous state
-        // of each tile (which should have been saved by redo() before modifying).
-        // For now, let's assume we're just clearing what was pasted.
-
-        // Find the corresponding ClipboardTileData for this position
-        bool found = false;
-        for(const auto& pastedTileData : m_pastedContent.tiles) {
-            if (m_targetTopLeft + pastedTileData.relativePosition == pos) {
-                // tile->removeMatchingPastedElements(pastedTileData); // Tile needs complex logic here
-                found = true;
-                break;
-            }
-        }
-        // Fallback: just clear the tile if it was newly created, or try to revert based on m_affectedTilesOriginalState
-        // This part is highly dependent on how redo() stores pre-paste state.
-        // If m_affectedTilesOriginalState stored deep copies of tiles *before* paste, restore them.
-        // For now, let's assume redo clears the area, so undo just clears it again (or removes if it was new)
-
-        // Clear tile contents for precise undo restoration
-        if (tile) {
-            tile->clear();
-        }
-        if (tile->isEmptyAndClean()) { // if it became empty after removing pasted stuff
-            // m_map->removeTile(pos);
-        } else {
-            m_map->markTileDirty(pos);
-        }
+void PasteCommand::mergeTile(Tile& destination, Tile& source) {
+    // Ground carries the tile properties with it
+    if (Item* ground = source.getGround()) {
+        destination.setGround(ground->deepCopy());
+        destination.setHouseId(source.getHouseId());
+        destination.setMapFlags(source.getMapFlags());
+    }
+    while (!source.getItems().isEmpty()) {
+        destination.addItem(source.popItem(source.getItems().first().get()));
+    }
+    if (source.hasCreature()) {
+        destination.setCreature(source.popCreature());
+    }
+    if (source.isSpawnTile()) {
+        destination.setSpawnRadius(source.getSpawnRadius());
+        destination.setSpawnIntervalSeconds(source.getSpawnIntervalSeconds());
+        destination.setSpawnCreatureList(source.getSpawnCreatureList());
     }
-    m_pastedTilePositions.clear(); // Clear for next redo, if any
-    // Map change notifications are handled per-tile in the loop above
 }
 
-void PasteCommand::redo() {
-    // Perform the paste operation
-    qDebug() << "PasteCommand: Redoing paste of" << m_pastedContent.tiles.count() << "tiles' data to target" << m_targetTopLeft;
-    m_pastedTilePositions.clear(); // Prepare for this redo pass
-
-    // bool mergePaste = EditorSettings::getInstance().getBool(Config::MERGE_PASTE); // Example
-    bool mergePaste = true; // Defaulting to merge for now, as in wxWidgets.
+void PasteCommand::undo() {
+    ClipboardReader pasted(m_payload, *m_assetManager, *m_settings);
+    if (!pasted.open()) {
+        qWarning() << "PasteCommand::undo:" << pasted.getLastError();
+        return;
+    }
+    const Position offset = m_targetTopLeft - pasted.header().origin;
 
-    for (const ClipboardTileData& data : m_pastedContent.tiles) {
-        Position targetPos = m_targetTopLeft + data.relativePosition;
-        if (!m_map->isValidPosition(targetPos)) { // Assuming Map::isValidPosition
-            continue;
+    // Drop every tile the paste touched, then put back the ones that existed before
+    while (pasted.readNextChunk([this, &offset](std::unique_ptr<Tile> tile) {
+        const Position target = tile->getPosition() + offset;
+        if (m_map->isPositionValid(target) && m_map->removeTile(target)) {
+            m_map->notifyTileChanged(target);
         }
-        m_pastedTilePositions.append(targetPos);
+    })) {}
+    if (pasted.hasError()) {
+        qWarning() << "PasteCommand::undo:" << pasted.getLastError();
+    }
 
-        Tile* destTile = m_map->getOrCreateTile(targetPos);
-        if (!destTile) continue;
+    ClipboardReader original(m_originalState, *m_assetManager, *m_settings);
+    if (!original.open()) {
+        qWarning() << "PasteCommand::undo: Original tile state is unreadable:" << original.getLastError();
+        return;
+    }
+    while (original.readNextChunk([this](std::unique_ptr<Tile> tile) {
+        const Position pos = tile->getPosition();
+        m_map->setTile(pos, std::move(tile));
+        m_map->notifyTileChanged(pos);
+    })) {}
+    if (original.hasError()) {
+        qWarning() << "PasteCommand::undo:" << original.getLastError();
+    }
+
+    qDebug() << "PasteCommand: Undid paste of" << m_pastedTileCount << "tiles.";
+    m_originalState.clear();
+}
 
-        // TODO: Before modifying destTile, if robust undo is needed, store its current state.
-        // DeletedTileData originalState = captureTileState(destTile);
-        // m_affectedTilesOriginalState.append(originalState);
+void PasteCommand::redo() {
+    m_pastedTileCount = 0;
+    m_originalState.clear();
 
+    ClipboardReader reader(m_payload, *m_assetManager, *m_settings);
+    if (!reader.open()) {
+        qWarning() << "PasteCommand::redo:" << reader.getLastError();
+        return;
+    }
+    const Position offset = m_targetTopLeft - reader.header().origin;
 
-        // Logic based on original wxWidgets copybuffer.cpp paste:
-        if (mergePaste || !data.hasGround) {
-            // Merge with existing tile
-            if (data.hasGround) { // Only merge ground if data has ground
-                // destTile->setGround(data.groundItemID); // Example
-                destTile->setHouseId(data.houseId);
-                destTile->setFlags(data.tileFlags);
-                // merge zone IDs etc.
+    // bool mergePaste = EditorSettings::getInstance().getBool(Config::MERGE_PASTE); // Example
+    const bool mergePaste = true; // Defaulting to merge for now, as in wxWidgets.
+
+    ClipboardWriter originalState(*m_assetManager, *m_settings, ORIGINAL_STATE_COMPRESSION_LEVEL);
+    bool chunkRead = true;
+    while (chunkRead) {
+        chunkRead = reader.readNextChunk([&](std::unique_ptr<Tile> source) {
+            const Position target = source->getPosition() + offset;
+            if (!m_map->isPositionValid(target)) {
+                return;
             }
-            for (const ClipboardItemData& itemData : data.items) {
-                // Item* item = RME::Item::create(itemData.id);
-                // if (item) { /* set properties */ destTile->addItem(item); }
+
+            if (const Tile* existing = m_map->getTile(target)) {
+                originalState.addTile(existing->deepCopy());
             }
-            if (data.hasCreature) {
-                // Creature* creature = RME::Creature::create(data.creature.name);
-                // if (creature) { /* set properties */ destTile->addCreature(creature); }
+            if (!mergePaste && source->getGround()) {
+                // Replace the existing tile instead of merging into it
+                m_map->setTile(target, std::make_unique<Tile>(target, m_assetManager));
             }
-            if (data.hasSpawn) {
-                // Spawn* spawn = RME::Spawn::create();
-                // if (spawn) { /* set properties */ destTile->setSpawn(spawn); }
+
+            bool created = false;
+            Tile* destination = m_map->getOrCreateTile(target, created);
+            if (!destination) {
+                return;
             }
-        } else { // Replace existing tile (if data.hasGround and not merging)
-            // destTile->clear(); // Clear existing content
-            // destTile->setGround(data.groundItemID); // Example
-            // destTile->setHouseId(data.houseId);
-            // destTile->setFlags(data.tileFlags);
-            // Add items, creature, and spawn using the same logic as above
+            mergeTile(*destination, *source);
+            m_map->notifyTileChanged(target);
+            ++m_pastedTileCount;
+        });
+        // Encode this area's snapshots before the next one is decoded
+        if (!originalState.flush()) {
+            qWarning() << "PasteCommand::redo: Could not record tile state for undo:" << originalState.getLastError();
+            break;
         }
-        m_map->markTileDirty(targetPos);
     }
-    // Map change notifications are handled per-tile via markTileDirty above
-    // Border updates are automatically handled by the brush system during normal editing operations
-    // For paste operations, borders are typically preserved as part of the copied data.
+    if (reader.hasError()) {
+        qWarning() << "PasteCommand::redo:" << reader.getLastError();
+    }
+
+    m_originalState = originalState.finish(Position(0, 0, 0));
+    qDebug() << "PasteCommand: Pasted" << m_pastedTileCount << "tiles at" << m_targetTopLeft.x << m_targetTopLeft.y << m_targetTopLeft.z;
 }
 
 } // namespace RME
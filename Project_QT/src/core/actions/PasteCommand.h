@@ -2,42 +2,53 @@
 #define PASTECOMMAND_H
 
 #include <QUndoCommand>
-#include "core/clipboard/ClipboardData.h" // For ClipboardContent
+#include <QByteArray>
 #include "core/Position.h"
 
 namespace RME {
 class Map;
-
+class Tile;
+class AssetManager;
+class AppSettings;
+
+// Pastes a binary clipboard payload (see ClipboardStream.h) as one undo step.
+//
+// redo() streams the payload one tile area at a time and merges each decoded
+// tile into the map, so only a single area is ever decoded at once. Before a
+// map tile is modified its previous state is encoded into a second payload of
+// the same format; undo() removes the pasted tiles and streams that payload
+// back into the map. Both payloads stay compressed between undo and redo.
 class PasteCommand : public QUndoCommand {
 public:
     PasteCommand(
         Map* map,
         const Position& targetTopLeftPosition, // Top-left where paste begins
-        const ClipboardContent& clipboardContent,
+        const QByteArray& clipboardPayload,
+        AssetManager* assetManager,
+        AppSettings* settings,
         const QString& text = "Paste",
         QUndoCommand* parent = nullptr
     );
 
     ~PasteCommand() override;
 
-    void undo() override; // Removes the pasted elements
+    void undo() override; // Restores the tiles replaced or merged into by redo()
     void redo() override; // Performs the paste operation
 
+    int getPastedTileCount() const { return m_pastedTileCount; }
+
 private:
+    // Merges a decoded clipboard tile into a map tile, like the wxWidgets merge paste
+    static void mergeTile(Tile& destination, Tile& source);
+
     Map* m_map; // Non-owning
     Position m_targetTopLeft;
-    ClipboardContent m_pastedContent; // Data that was pasted
-
-    // To support undo, we need to store what was on the tiles *before* pasting,
-    // if we are merging. If we are replacing, we need to store the replaced content.
-    // This can be complex. A common approach is for redo() to capture the "before" state
-    // of the affected area, which undo() then restores.
-    // For simplicity in this first pass, undo might just delete what was pasted,
-    // assuming no complex merge that needs perfect original state restoration yet.
-    // A more robust undo would store the state of all affected tiles before the paste.
-    QList<Tile*> m_affectedTilesOriginalState; // Simplified: list of pointers to tiles that were modified.
-                                              // A better way is to store QList<DeletedTileData> of what was there before paste.
-    QList<Position> m_pastedTilePositions; // Store actual absolute positions where tiles were pasted/affected.
+    QByteArray m_payload;     // Data that was pasted
+    AssetManager* m_assetManager; // Non-owning
+    AppSettings* m_settings;      // Non-owning
+
+    QByteArray m_originalState; // Encoded map tiles as they were before redo(), consumed by undo()
+    int m_pastedTileCount = 0;
 };
 
 } // namespace RME
@@ -232,6 +232,7 @@ const RME::core::assets::MaterialData* AssetManager::getMaterialData(const QStri
 
 
 // --- IItemTypeProvider Implementation ---
+// Boolean properties are answered from ItemDatabase's packed per-ID flag table.
 QString AssetManager::getName(quint16 id) const {
     if (id == 0) {
         return "Empty"; // Standard name for empty/null items
@@ -258,76 +259,61 @@ double AssetManager::getWeight(quint16 id, quint16 subtype) const {
     return 0.0;
 }
 bool AssetManager::isBlocking(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->hasFlag(ItemFlag::BLOCK_SOLID) : true;
+    const quint32 flags = d->itemDatabase.getPropertyFlags(id);
+    return !(flags & ITEM_PROP_KNOWN) || (flags & ITEM_PROP_BLOCK_SOLID); // Unknown items block
 }
 bool AssetManager::isProjectileBlocking(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->hasFlag(ItemFlag::BLOCK_PROJECTILE) : true;
+    const quint32 flags = d->itemDatabase.getPropertyFlags(id);
+    return !(flags & ITEM_PROP_KNOWN) || (flags & ITEM_PROP_BLOCK_PROJECTILE); // Unknown items block
 }
 bool AssetManager::isPathBlocking(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->hasFlag(ItemFlag::BLOCK_PATHFIND) : true;
+    const quint32 flags = d->itemDatabase.getPropertyFlags(id);
+    return !(flags & ITEM_PROP_KNOWN) || (flags & ITEM_PROP_BLOCK_PATHFIND); // Unknown items block
 }
 bool AssetManager::isWalkable(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? !data->hasFlag(ItemFlag::BLOCK_PATHFIND) && !data->hasFlag(ItemFlag::WALL) : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_WALKABLE;
 }
 bool AssetManager::isStackable(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->hasFlag(ItemFlag::STACKABLE) : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_STACKABLE;
 }
 bool AssetManager::isGround(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->group == ItemGroup::GROUND : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_GROUND;
 }
 bool AssetManager::isAlwaysOnTop(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->hasFlag(ItemFlag::ALWAYSONTOP) : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_ALWAYS_ON_TOP;
 }
 bool AssetManager::isReadable(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->hasFlag(ItemFlag::READABLE) : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_READABLE;
 }
 bool AssetManager::isWriteable(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? (data->hasFlag(ItemFlag::READABLE) && data->maxReadWriteChars > 0) : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_WRITEABLE;
 }
 bool AssetManager::isFluidContainer(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->group == ItemGroup::FLUID : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_FLUID_CONTAINER;
 }
 bool AssetManager::isSplash(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->group == ItemGroup::SPLASH : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_SPLASH;
 }
 bool AssetManager::isMoveable(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->hasFlag(ItemFlag::MOVEABLE) : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_MOVEABLE;
 }
 bool AssetManager::hasHeight(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->hasFlag(ItemFlag::HAS_HEIGHT) : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_HAS_HEIGHT;
 }
 bool AssetManager::isContainer(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->group == ItemGroup::CONTAINER : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_CONTAINER;
 }
 bool AssetManager::isTeleport(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->group == ItemGroup::TELEPORT : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_TELEPORT;
 }
 bool AssetManager::isDoor(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->group == ItemGroup::DOOR : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_DOOR;
 }
 bool AssetManager::isPodium(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->group == ItemGroup::PODIUM : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_PODIUM;
 }
 bool AssetManager::isDepot(quint16 id) const {
-    const ItemData* data = getItemData(id);
-    return (data && data->serverID != 0) ? data->type == ItemType::TYPE_DEPOT : false;
+    return d->itemDatabase.getPropertyFlags(id) & ITEM_PROP_DEPOT;
 }
 
 } // namespace RME
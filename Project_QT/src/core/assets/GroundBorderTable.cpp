@@ -0,0 +1,218 @@
+#include "core/assets/GroundBorderTable.h"
+#include "core/assets/MaterialData.h"
+#include "core/assets/MaterialManager.h"
+#include "core/assets/ItemDatabase.h"
+#include "core/assets/ItemData.h"
+#include <QDebug>
+#include <algorithm>
+
+namespace RME {
+namespace core {
+namespace assets {
+
+namespace {
+
+QString borderTypeToEdgeKey(RME::BorderType pieceType) {
+    switch (pieceType) {
+        case RME::BorderType::WX_NORTH_HORIZONTAL: return QStringLiteral("n");
+        case RME::BorderType::WX_EAST_HORIZONTAL:  return QStringLiteral("e");
+        case RME::BorderType::WX_SOUTH_HORIZONTAL: return QStringLiteral("s");
+        case RME::BorderType::WX_WEST_HORIZONTAL:  return QStringLiteral("w");
+        case RME::BorderType::WX_NORTHWEST_CORNER: return QStringLiteral("cnw");
+        case RME::BorderType::WX_NORTHEAST_CORNER: return QStringLiteral("cne");
+        case RME::BorderType::WX_SOUTHWEST_CORNER: return QStringLiteral("csw");
+        case RME::BorderType::WX_SOUTHEAST_CORNER: return QStringLiteral("cse");
+        case RME::BorderType::WX_NORTHWEST_DIAGONAL: return QStringLiteral("dnw");
+        case RME::BorderType::WX_NORTHEAST_DIAGONAL: return QStringLiteral("dne");
+        case RME::BorderType::WX_SOUTHWEST_DIAGONAL: return QStringLiteral("dsw");
+        case RME::BorderType::WX_SOUTHEAST_DIAGONAL: return QStringLiteral("dse");
+        default: return QString(); // Invalid or NONE
+    }
+}
+
+uint16_t resolveBaseItem(const MaterialBorderRule& rule, RME::BorderType pieceType,
+                         const MaterialManager& materialManager) {
+    bool conversionOk = false;
+    const uint16_t directItemId = rule.ruleTargetId.toUShort(&conversionOk);
+    if (conversionOk && directItemId != 0) {
+        return directItemId;
+    }
+
+    const BorderSetData* borderSet = materialManager.getBorderSet(rule.ruleTargetId);
+    return borderSet ? borderSet->edgeItems.value(borderTypeToEdgeKey(pieceType), 0) : 0;
+}
+
+void appendUnique(GroundBorderTable::ItemList& items, uint16_t itemId) {
+    if (itemId != 0 && !items.contains(itemId)) {
+        items.append(itemId);
+    }
+}
+
+// GroundBrush::doAutoBorders only produces outer pieces
+bool isOuterRule(const MaterialBorderRule& rule) {
+    return rule.align.compare(QLatin1String("outer"), Qt::CaseInsensitive) == 0 ||
+           rule.align.compare(QLatin1String("any"), Qt::CaseInsensitive) == 0;
+}
+
+bool isWildcardRule(const MaterialBorderRule& rule) {
+    return rule.toBrushName.compare(QLatin1String("all"), Qt::CaseInsensitive) == 0;
+}
+
+} // namespace
+
+void GroundBorderTable::clear() {
+    m_materialByItem.clear();
+    m_materials.clear();
+    m_grounds.clear();
+    m_targetBorders.clear();
+}
+
+void GroundBorderTable::build(const MaterialManager& materialManager, const RME::ItemDatabase& itemDatabase) {
+    clear();
+
+    const QMap<QString, MaterialData>& allMaterials = materialManager.getAllMaterials();
+    QHash<QString, quint16> indexById;
+    QHash<QString, quint16> indexByFoldedId; // Border rules name their target brush case-insensitively
+    m_materials.reserve(allMaterials.size());
+    for (auto it = allMaterials.constBegin(); it != allMaterials.constEnd(); ++it) {
+        const quint16 index = static_cast<quint16>(m_materials.size());
+        m_materials.append(&it.value());
+        indexById.insert(it.key(), index);
+        indexByFoldedId.insert(it.key().toCaseFolded(), index);
+    }
+
+    // Item ID -> material. Ground brush <item> entries claim their items; an explicit
+    // ItemData::materialId takes precedence.
+    const QMap<quint16, ItemData>& allItems = itemDatabase.getAllItems();
+    int tableSize = allItems.isEmpty() ? 0 : static_cast<int>(allItems.lastKey()) + 1;
+    for (const MaterialData* material : std::as_const(m_materials)) {
+        if (const auto* specifics = std::get_if<MaterialGroundSpecifics>(&material->specificData)) {
+            for (const MaterialItemEntry& entry : specifics->items) {
+                tableSize = std::max(tableSize, static_cast<int>(entry.itemId) + 1);
+            }
+        }
+    }
+    m_materialByItem.fill(NO_MATERIAL, tableSize);
+    for (int index = 0; index < m_materials.size(); ++index) {
+        if (const auto* specifics = std::get_if<MaterialGroundSpecifics>(&m_materials[index]->specificData)) {
+            for (const MaterialItemEntry& entry : specifics->items) {
+                m_materialByItem[entry.itemId] = static_cast<quint16>(index);
+            }
+        }
+    }
+    for (auto it = allItems.constBegin(); it != allItems.constEnd(); ++it) {
+        if (!it.value().materialId.isEmpty()) {
+            m_materialByItem[it.key()] = indexById.value(it.value().materialId, NO_MATERIAL);
+        }
+    }
+
+    // Friends and border rules of ground materials
+    m_grounds.resize(m_materials.size());
+    for (int index = 0; index < m_materials.size(); ++index) {
+        const MaterialData* material = m_materials[index];
+        const auto* specifics = std::get_if<MaterialGroundSpecifics>(&material->specificData);
+        if (!material->isGround() || !specifics) {
+            continue;
+        }
+
+        GroundEntry& ground = m_grounds[index];
+        ground.isGround = true;
+        ground.friends.resize(m_materials.size());
+        for (const QString& friendId : specifics->friends) {
+            const quint16 friendIndex = indexById.value(friendId, NO_MATERIAL);
+            if (friendIndex != NO_MATERIAL) {
+                ground.friends.setBit(friendIndex);
+            }
+        }
+
+        // Group the outer rules by the neighbour they border against
+        QHash<quint16, QVector<const MaterialBorderRule*>> rulesByTarget;
+        QVector<const MaterialBorderRule*> wildcardRules;
+        for (const MaterialBorderRule& rule : specifics->borders) {
+            if (!isOuterRule(rule)) {
+                continue;
+            }
+            bool isItemId = false;
+            if ((rule.ruleTargetId.toUShort(&isItemId) == 0 || !isItemId) && !materialManager.getBorderSet(rule.ruleTargetId)) {
+                qWarning("GroundBorderTable: ruleTargetId '%s' for align '%s' to '%s' in brush '%s' is not a valid direct item ID and not a found BorderSet.",
+                         qUtf8Printable(rule.ruleTargetId), qUtf8Printable(rule.align), qUtf8Printable(rule.toBrushName),
+                         qUtf8Printable(material->id));
+            }
+            if (isWildcardRule(rule)) {
+                wildcardRules.append(&rule);
+                continue;
+            }
+            const QString target = rule.toBrushName.toCaseFolded();
+            if (target == QLatin1String("none")) {
+                rulesByTarget[NO_MATERIAL].append(&rule);
+            } else if (const auto found = indexByFoldedId.constFind(target); found != indexByFoldedId.constEnd()) {
+                rulesByTarget[found.value()].append(&rule);
+            }
+            // Rules naming an unknown brush can never match a neighbour
+        }
+
+        for (auto it = rulesByTarget.begin(); it != rulesByTarget.end(); ++it) {
+            it.value().append(wildcardRules);
+            ground.targets.insert(it.key(), static_cast<int>(m_targetBorders.size()));
+            m_targetBorders.push_back(compileTarget(it.value(), materialManager));
+        }
+        if (!wildcardRules.isEmpty()) {
+            ground.wildcardTarget = static_cast<int>(m_targetBorders.size());
+            m_targetBorders.push_back(compileTarget(wildcardRules, materialManager));
+        }
+    }
+
+    qDebug() << "GroundBorderTable: Compiled" << m_targetBorders.size() << "border targets for"
+             << m_materials.size() << "materials and" << tableSize << "item IDs.";
+}
+
+GroundBorderTable::TargetBorders GroundBorderTable::compileTarget(const QVector<const MaterialBorderRule*>& rules,
+                                                                  const MaterialManager& materialManager) {
+    TargetBorders target;
+    for (int pieceIndex = 1; pieceIndex < PIECE_COUNT; ++pieceIndex) {
+        const auto piece = static_cast<RME::BorderType>(pieceIndex);
+        PieceBorders& borders = target[pieceIndex];
+
+        for (const MaterialBorderRule* rule : rules) {
+            const RuleRef ref{rule, resolveBaseItem(*rule, piece, materialManager)};
+            (rule->isSuper ? borders.superRules : borders.normalRules).append(ref);
+            if (!rule->specificRuleCases.isEmpty()) {
+                borders.dynamic = true;
+            }
+        }
+        if (borders.dynamic) {
+            continue;
+        }
+
+        // Without specific cases, super rules replace the normal ones whenever they place anything
+        for (const RuleRef& ref : std::as_const(borders.superRules)) {
+            appendUnique(borders.items, ref.baseItemId);
+        }
+        if (borders.items.isEmpty()) {
+            for (const RuleRef& ref : std::as_const(borders.normalRules)) {
+                appendUnique(borders.items, ref.baseItemId);
+            }
+        }
+        borders.superRules.clear();
+        borders.normalRules.clear();
+    }
+    return target;
+}
+
+const GroundBorderTable::PieceBorders* GroundBorderTable::borders(quint16 material, quint16 target,
+                                                                  RME::BorderType piece) const {
+    const int pieceIndex = static_cast<int>(piece);
+    if (!isGround(material) || pieceIndex <= 0 || pieceIndex >= PIECE_COUNT) {
+        return nullptr;
+    }
+    const GroundEntry& ground = m_grounds[material];
+    const int targetIndex = ground.targets.value(target, ground.wildcardTarget);
+    if (targetIndex < 0) {
+        return nullptr;
+    }
+    return &m_targetBorders[targetIndex][pieceIndex];
+}
+
+} // namespace assets
+} // namespace core
+} // namespace RME
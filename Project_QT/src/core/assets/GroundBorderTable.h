@@ -0,0 +1,100 @@
+#ifndef RME_GROUNDBORDERTABLE_H
+#define RME_GROUNDBORDERTABLE_H
+
+#include "core/brush/BrushEnums.h"
+#include <QBitArray>
+#include <QHash>
+#include <QVarLengthArray>
+#include <QVector>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace RME {
+class ItemDatabase;
+
+namespace core {
+namespace assets {
+
+struct MaterialData;
+struct MaterialBorderRule;
+class MaterialManager;
+
+// Ground borderization rules compiled to integer lookups when materials are loaded.
+//
+// Every material gets a dense index. Item IDs map directly to the index of the
+// material they belong to, and each ground material's friends become a bitset
+// over those indices, so classifying a tile's neighbours is one array read and
+// one bit test per neighbour.
+//
+// The outer <border> rules of each ground material are resolved per neighbour
+// material ("to" brush, or void) and per border piece into the item IDs they
+// place, BorderSet edge lookups included. Rules with specific cases depend on
+// the tile contents and cannot be baked; their pieces are marked dynamic and
+// keep the matched rules with base items resolved for the caller to evaluate.
+class GroundBorderTable {
+public:
+    static constexpr quint16 NO_MATERIAL = 0xFFFF; // Also the neighbour "material" of void / unknown ground
+    static constexpr int PIECE_COUNT = static_cast<int>(RME::BorderType::WX_SOUTHEAST_DIAGONAL) + 1;
+
+    using ItemList = QVarLengthArray<uint16_t, 4>;
+
+    struct RuleRef {
+        const MaterialBorderRule* rule = nullptr;
+        uint16_t baseItemId = 0; // Item for the piece from ruleTargetId or its BorderSet, 0 if none
+    };
+
+    struct PieceBorders {
+        ItemList items;     // Unique items to place; complete unless dynamic
+        bool dynamic = false;
+        QVarLengthArray<RuleRef, 2> superRules;  // Matched rules, only kept when dynamic
+        QVarLengthArray<RuleRef, 2> normalRules;
+    };
+
+    void build(const MaterialManager& materialManager, const RME::ItemDatabase& itemDatabase);
+    void clear();
+
+    quint16 materialIndexForItem(uint16_t itemId) const {
+        return itemId < m_materialByItem.size() ? m_materialByItem[itemId] : NO_MATERIAL;
+    }
+    const MaterialData* material(quint16 index) const {
+        return index < m_materials.size() ? m_materials[index] : nullptr;
+    }
+    int materialCount() const { return m_materials.size(); }
+
+    // True if 'index' is a ground material with compiled border rules
+    bool isGround(quint16 index) const {
+        return index < m_grounds.size() && m_grounds[index].isGround;
+    }
+    bool areFriends(quint16 material, quint16 other) const {
+        return other != NO_MATERIAL && m_grounds[material].friends.testBit(other);
+    }
+
+    // Border items for 'piece' on a tile of ground 'material' bordering 'target'.
+    // Returns nullptr when no rule applies.
+    const PieceBorders* borders(quint16 material, quint16 target, RME::BorderType piece) const;
+
+private:
+    using TargetBorders = std::array<PieceBorders, PIECE_COUNT>;
+
+    struct GroundEntry {
+        bool isGround = false;
+        QBitArray friends;
+        QHash<quint16, int> targets; // Neighbour material -> m_targetBorders index
+        int wildcardTarget = -1;     // Rules for "all", used for neighbours not listed in targets
+    };
+
+    static TargetBorders compileTarget(const QVector<const MaterialBorderRule*>& rules,
+                                       const MaterialManager& materialManager);
+
+    QVector<quint16> m_materialByItem;    // Item ID -> material index, NO_MATERIAL for gaps
+    QVector<const MaterialData*> m_materials;
+    QVector<GroundEntry> m_grounds;       // Parallel to m_materials
+    std::vector<TargetBorders> m_targetBorders;
+};
+
+} // namespace assets
+} // namespace core
+} // namespace RME
+
+#endif // RME_GROUNDBORDERTABLE_H
@@ -2,6 +2,7 @@
 #include <QFile>
 #include <QDataStream>
 #include <QXmlStreamReader>
+#include <QScopeGuard>
 #include <QDebug>
 
 namespace RME {
@@ -53,9 +54,55 @@ ItemDatabase::ItemDatabase() : d(new ItemDatabaseData()) {
 
 ItemDatabase::~ItemDatabase() = default;
 
-const ItemData* ItemDatabase::getItemData(quint16 serverID) const {
-    auto it = d->items.constFind(serverID);
-    return (it != d->items.constEnd()) ? &it.value() : &invalidItemData;
+// Same property definitions AssetManager's IItemTypeProvider answers with
+static quint32 computePropertyFlags(const ItemData& data) {
+    quint32 flags = ITEM_PROP_KNOWN;
+    if (data.hasFlag(ItemFlag::BLOCK_SOLID)) flags |= ITEM_PROP_BLOCK_SOLID;
+    if (data.hasFlag(ItemFlag::BLOCK_PROJECTILE)) flags |= ITEM_PROP_BLOCK_PROJECTILE;
+    if (data.hasFlag(ItemFlag::BLOCK_PATHFIND)) flags |= ITEM_PROP_BLOCK_PATHFIND;
+    if (data.hasFlag(ItemFlag::WALL)) flags |= ITEM_PROP_WALL;
+    if (!data.hasFlag(ItemFlag::BLOCK_PATHFIND) && !data.hasFlag(ItemFlag::WALL)) flags |= ITEM_PROP_WALKABLE;
+    if (data.hasFlag(ItemFlag::ALWAYSONTOP)) flags |= ITEM_PROP_ALWAYS_ON_TOP;
+    if (data.hasFlag(ItemFlag::STACKABLE)) flags |= ITEM_PROP_STACKABLE;
+    if (data.hasFlag(ItemFlag::MOVEABLE)) flags |= ITEM_PROP_MOVEABLE;
+    if (data.hasFlag(ItemFlag::PICKUPABLE)) flags |= ITEM_PROP_PICKUPABLE;
+    if (data.hasFlag(ItemFlag::HAS_HEIGHT)) flags |= ITEM_PROP_HAS_HEIGHT;
+    if (data.hasFlag(ItemFlag::READABLE)) flags |= ITEM_PROP_READABLE;
+    if (data.hasFlag(ItemFlag::READABLE) && data.maxReadWriteChars > 0) flags |= ITEM_PROP_WRITEABLE;
+    if (data.hasFlag(ItemFlag::ROTATABLE)) flags |= ITEM_PROP_ROTATABLE;
+    if (data.hasFlag(ItemFlag::HANGABLE)) flags |= ITEM_PROP_HANGABLE;
+    if (data.hasFlag(ItemFlag::VERTICAL)) flags |= ITEM_PROP_VERTICAL;
+    if (data.hasFlag(ItemFlag::HORIZONTAL)) flags |= ITEM_PROP_HORIZONTAL;
+    if (data.lightLevel > 0) flags |= ITEM_PROP_HAS_LIGHT;
+    if (data.group == ItemGroup::GROUND) flags |= ITEM_PROP_GROUND;
+    if (data.group == ItemGroup::CONTAINER) flags |= ITEM_PROP_CONTAINER;
+    if (data.group == ItemGroup::FLUID) flags |= ITEM_PROP_FLUID_CONTAINER;
+    if (data.group == ItemGroup::SPLASH) flags |= ITEM_PROP_SPLASH;
+    if (data.group == ItemGroup::TELEPORT) flags |= ITEM_PROP_TELEPORT;
+    if (data.group == ItemGroup::DOOR) flags |= ITEM_PROP_DOOR;
+    if (data.group == ItemGroup::PODIUM) flags |= ITEM_PROP_PODIUM;
+    if (data.type == ItemType::TYPE_DEPOT) flags |= ITEM_PROP_DEPOT;
+    return flags;
+}
+
+void ItemDatabase::rebuildLookupTables() {
+    m_itemTable.clear();
+    m_propertyFlags.clear();
+    if (d->items.isEmpty()) {
+        return;
+    }
+
+    // Server IDs are dense in practice, so the tables span 0..max ID directly
+    const int tableSize = static_cast<int>(d->items.lastKey()) + 1;
+    m_itemTable.fill(nullptr, tableSize);
+    m_propertyFlags.fill(0u, tableSize);
+
+    for (auto it = d->items.constBegin(); it != d->items.constEnd(); ++it) {
+        m_itemTable[it.key()] = &it.value();
+        if (it.value().serverID != 0) { // Entries without a server ID are treated as unknown items
+            m_propertyFlags[it.key()] = computePropertyFlags(it.value());
+        }
+    }
 }
 
 const ItemData& ItemDatabase::getDefaultItemData() const {
@@ -76,6 +123,9 @@ bool ItemDatabase::loadFromOTB(const QString& filePath) {
         return false;
     }
     
+    // Whatever happens below, lookups must not keep pointing into a modified item map
+    auto tableGuard = qScopeGuard([this] { rebuildLookupTables(); });
+
     QFile file(filePath);
     if (!file.exists()) {
         qWarning() << "ItemDatabase::loadFromOTB: File does not exist:" << filePath;
@@ -290,6 +340,9 @@ bool ItemDatabase::loadFromXML(const QString& filePath) {
         return false;
     }
     
+    // Whatever happens below, lookups must not keep pointing into a modified item map
+    auto tableGuard = qScopeGuard([this] { rebuildLookupTables(); });
+
     QFile file(filePath);
     if (!file.exists()) {
         qWarning() << "ItemDatabase::loadFromXML: File does not exist:" << filePath;
@@ -3,6 +3,7 @@
 
 #include "ItemData.h"
 #include <QMap>
+#include <QVector>
 #include <QString>
 #include <QReadWriteLock> // For thread-safe access if needed later
 #include <QScopedPointer> // For PIMPL
@@ -12,6 +13,41 @@ class QDataStream;      // Forward declaration
 
 namespace RME {
 
+/**
+ * @brief Per-item property bits, packed into one word per server ID at load time.
+ *
+ * Hot loops (rendering, borderizing, validation) test these with a single array
+ * index through ItemDatabase::getPropertyFlags() instead of looking up ItemData.
+ */
+enum ItemPropertyFlag : quint32 {
+    ITEM_PROP_KNOWN            = 1u << 0,  // The server ID exists in the database
+    ITEM_PROP_BLOCK_SOLID      = 1u << 1,
+    ITEM_PROP_BLOCK_PROJECTILE = 1u << 2,
+    ITEM_PROP_BLOCK_PATHFIND   = 1u << 3,
+    ITEM_PROP_WALKABLE         = 1u << 4,  // Known, not path blocking and not a wall
+    ITEM_PROP_GROUND           = 1u << 5,
+    ITEM_PROP_ALWAYS_ON_TOP    = 1u << 6,
+    ITEM_PROP_STACKABLE        = 1u << 7,
+    ITEM_PROP_MOVEABLE         = 1u << 8,
+    ITEM_PROP_PICKUPABLE       = 1u << 9,
+    ITEM_PROP_HAS_HEIGHT       = 1u << 10,
+    ITEM_PROP_READABLE         = 1u << 11,
+    ITEM_PROP_WRITEABLE        = 1u << 12,
+    ITEM_PROP_CONTAINER        = 1u << 13,
+    ITEM_PROP_FLUID_CONTAINER  = 1u << 14,
+    ITEM_PROP_SPLASH           = 1u << 15,
+    ITEM_PROP_TELEPORT         = 1u << 16,
+    ITEM_PROP_DOOR             = 1u << 17,
+    ITEM_PROP_PODIUM           = 1u << 18,
+    ITEM_PROP_DEPOT            = 1u << 19,
+    ITEM_PROP_ROTATABLE        = 1u << 20,
+    ITEM_PROP_HANGABLE         = 1u << 21,
+    ITEM_PROP_VERTICAL         = 1u << 22,
+    ITEM_PROP_HORIZONTAL       = 1u << 23,
+    ITEM_PROP_HAS_LIGHT        = 1u << 24,
+    ITEM_PROP_WALL             = 1u << 25
+};
+
 class ItemDatabase {
 public:
     ItemDatabase();
@@ -25,7 +61,21 @@ public:
     bool loadItemsOtb(const QString& filePath);  // Alias for loadFromOTB
     bool loadItemsXml(const QString& filePath);  // Alias for loadFromXML
 
-    const ItemData* getItemData(quint16 serverID) const;
+    // Direct-indexed lookups; the tables are rebuilt after every load
+    const ItemData* getItemData(quint16 serverID) const {
+        const ItemData* data = serverID < m_itemTable.size() ? m_itemTable[serverID] : nullptr;
+        return data ? data : &invalidItemData;
+    }
+    quint32 getPropertyFlags(quint16 serverID) const {
+        return serverID < m_propertyFlags.size() ? m_propertyFlags[serverID] : 0u;
+    }
+    bool hasProperty(quint16 serverID, quint32 flags) const {
+        return (getPropertyFlags(serverID) & flags) == flags;
+    }
+    // Raw flag table for loops that hoist the bounds check; index by server ID
+    const quint32* getPropertyFlagTable() const { return m_propertyFlags.constData(); }
+    int getPropertyFlagTableSize() const { return m_propertyFlags.size(); }
+
     const ItemData& getDefaultItemData() const; // Returns a default/invalid ItemData
 
     int getItemCount() const;
@@ -41,10 +91,16 @@ private:
     void parseXmlItem(QXmlStreamReader& xml, ItemData& itemData);
     void parseXmlAttribute(QXmlStreamReader& xml, ItemData& itemData);
 
+    // Rebuilds m_itemTable and m_propertyFlags from d->items
+    void rebuildLookupTables();
+
     struct ItemDatabaseData; // PIMPL
     QScopedPointer<ItemDatabaseData> d;
 
     ItemData invalidItemData; // Returned for invalid IDs
+
+    QVector<const ItemData*> m_itemTable; // Server ID -> entry in d->items, nullptr for gaps
+    QVector<quint32> m_propertyFlags;     // Server ID -> ItemPropertyFlag bits, 0 for gaps
 };
 
 } // namespace RME
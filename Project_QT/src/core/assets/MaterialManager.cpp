@@ -1,5 +1,6 @@
 #include "core/assets/MaterialManager.h"
 #include "core/assets/AssetManager.h" // For context, e.g. item validation (though not deeply used in this impl yet)
+#include "core/assets/ItemDatabase.h"
 #include <QFile>
 #include <QFileInfo>
 #include <QDir>
@@ -40,6 +41,7 @@ const BorderSetData* MaterialManager::getBorderSet(const QString& setId) const {
 }
 
 bool MaterialManager::loadMaterialsFromDirectory(const QString& baseDir, const QString& mainXmlFile, AssetManager& assetManager) {
+    m_groundBorderTable.clear();
     m_materialsById.clear();
     m_parsedFiles.clear();
     m_lastError.clear();
@@ -54,6 +56,7 @@ bool MaterialManager::loadMaterialsFromDirectory(const QString& baseDir, const Q
         }
         return false;
     }
+    m_groundBorderTable.build(*this, assetManager.getItemDatabase());
     // Even if some non-critical errors occurred (warnings), consider loading successful if it didn't return false.
     return true;
 }
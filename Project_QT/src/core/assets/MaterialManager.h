@@ -2,6 +2,7 @@
 #define RME_MATERIALMANAGER_H
 
 #include "core/assets/MaterialData.h"
+#include "core/assets/GroundBorderTable.h"
 #include <QMap>
 #include <QString>
 #include <QXmlStreamReader> // For private method declaration
@@ -55,6 +56,13 @@ public:
      */
     const BorderSetData* getBorderSet(const QString& setId) const;
 
+    /**
+     * @brief Gets the ground border rules compiled for auto-bordering.
+     * Rebuilt after every successful loadMaterialsFromDirectory().
+     * @return Const reference to the compiled table.
+     */
+    const GroundBorderTable& getGroundBorderTable() const { return m_groundBorderTable; }
+
     /**
      * @brief Gets the last error message from loading.
      * @return QString containing the error message, or empty if no error.
@@ -64,6 +72,7 @@ public:
 private:
     QMap<QString, MaterialData> m_materialsById;
     QMap<QString, BorderSetData> m_borderSetsById; // Stores parsed border sets from borders.xml
+    GroundBorderTable m_groundBorderTable; // Points into m_materialsById
     QString m_lastError;
     QSet<QString> m_parsedFiles; // To prevent circular includes and redundant parsing
 
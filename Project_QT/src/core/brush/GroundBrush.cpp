@@ -12,177 +12,64 @@
 
 #include <QRandomGenerator>
 #include <QDebug>
+#include <QVarLengthArray>
 #include <array> // For std::array
 #include <algorithm> // For std::sort
+#include <initializer_list>
 
 
 namespace { // Anonymous namespace for helpers
 
-const RME::core::assets::MaterialData* getMaterialFromTile(
-    const RME::core::Tile* tile,
-    const RME::core::assets::AssetManager* assetManager) {
-
-    if (!tile || !tile->getGround() || !assetManager) {
-        return nullptr;
-    }
+// Small sorted item ID lists; a tile rarely carries more than a handful of border items
+using BorderItemIds = QVarLengthArray<uint16_t, 8>;
 
-    const RME::core::Item* groundItem = tile->getGround();
-    uint16_t groundItemId = groundItem->getID();
-
-    const RME::core::assets::ItemDatabase* itemDb = assetManager->getItemDatabase();
-    const RME::core::assets::MaterialManager* materialMgr = assetManager->getMaterialManager();
+quint16 getMaterialIndexFromTile(
+    const RME::core::Tile* tile,
+    const RME::core::assets::GroundBorderTable& borderTable) {
 
-    if (!itemDb || !materialMgr) { // Also check materialMgr
-        qWarning("getMaterialFromTile: ItemDatabase or MaterialManager not available via AssetManager.");
-        return nullptr;
+    if (!tile || !tile->getGround()) {
+        return RME::core::assets::GroundBorderTable::NO_MATERIAL;
     }
+    return borderTable.materialIndexForItem(tile->getGround()->getID());
+}
 
-    const RME::core::assets::ItemData* itemData = itemDb->getItemData(groundItemId);
-    if (!itemData) {
-        // qWarning("getMaterialFromTile: ItemData not found for ground item ID %u.", groundItemId); // Less verbose
-        return nullptr;
-    }
+const RME::core::assets::MaterialData* getMaterialFromTile(
+    const RME::core::Tile* tile,
+    const RME::core::assets::AssetManager* assetManager) {
 
-    if (!itemData->materialId.isEmpty()) {
-        const RME::core::assets::MaterialData* foundMaterial = materialMgr->getMaterial(itemData->materialId);
-        // if (!foundMaterial) { // Less verbose
-        //     qDebug("getMaterialFromTile: Material ID '%s' from ItemData (item %u) not found in MaterialManager.",
-        //            qUtf8Printable(itemData->materialId), groundItemId);
-        // }
-        return foundMaterial;
-    } else {
-        // qDebug("getMaterialFromTile: Item ID %u (name: '%s') has no associated materialId in its ItemData.",
-        //        groundItemId, qUtf8Printable(itemData->name)); // Less verbose
+    if (!tile || !assetManager) {
         return nullptr;
     }
+    const RME::core::assets::GroundBorderTable& borderTable = assetManager->getMaterialManager().getGroundBorderTable();
+    return borderTable.material(getMaterialIndexFromTile(tile, borderTable));
 }
 
-QString determineAlignString(
-    RME::BorderType pieceType,
-    uint8_t /*tiledata*/, // tiledata might be used for more complex inner/outer distinctions later
-    const std::array<const RME::core::assets::MaterialData*, 8>& /*neighborMaterials*/,
-    const RME::core::assets::MaterialData* /*currentTileMaterial*/
-) {
-    switch (pieceType) {
-        case RME::BorderType::WX_NORTH_HORIZONTAL:
-        case RME::BorderType::WX_EAST_HORIZONTAL:
-        case RME::BorderType::WX_SOUTH_HORIZONTAL:
-        case RME::BorderType::WX_WEST_HORIZONTAL:
-        case RME::BorderType::WX_NORTHWEST_CORNER:
-        case RME::BorderType::WX_NORTHEAST_CORNER:
-        case RME::BorderType::WX_SOUTHWEST_CORNER:
-        case RME::BorderType::WX_SOUTHEAST_CORNER:
-        case RME::BorderType::WX_NORTHWEST_DIAGONAL:
-        case RME::BorderType::WX_NORTHEAST_DIAGONAL:
-        case RME::BorderType::WX_SOUTHWEST_DIAGONAL:
-        case RME::BorderType::WX_SOUTHEAST_DIAGONAL:
-            return QStringLiteral("outer"); // Most ground borders are outer borders
-
-        case RME::BorderType::NONE:
-        default:
-            if (pieceType == RME::BorderType::NONE) return QStringLiteral("none");
-            qWarning("determineAlignString: Unhandled BorderType %d, defaulting align to 'outer'.", static_cast<int>(pieceType));
-            return QStringLiteral("outer");
-    }
-}
-
-QString determineToBrushName(
-    RME::BorderType pieceType,
-    uint8_t tiledata, // Used to know *which* neighbors are different
-    const std::array<const RME::core::assets::MaterialData*, 8>& neighborMaterials,
-    const RME::core::assets::MaterialData* currentTileMaterial // The material of the tile we are placing borders on
-) {
-    // Helper to check if a neighbor at index 'idx' is different and not a friend
-    auto isNeighborDifferentNonFriend = [&](int idx) {
-        if (idx < 0 || idx >= 8) return false;
-
-        bool tileIsDifferentBit = (tiledata & (1 << idx));
-        if (!tileIsDifferentBit) return false; // This neighbor was not marked as 'different' by tiledata calculation
-
-        if (neighborMaterials[idx]) {
-            return true; // It's different and was included in tiledata (implies not friend or different ID)
-        } else {
-            return true; // It's void, thus different
+// Neighbour slot (NW(0), N(1), NE(2), W(3), E(4), SW(5), S(6), SE(7)) that a border piece
+// is drawn against, or -1. Corners and diagonals prefer the straight sides.
+int borderNeighborSlot(RME::BorderType pieceType, uint8_t tiledata) {
+    auto firstDifferent = [tiledata](std::initializer_list<int> slots) {
+        for (int slot : slots) {
+            if (tiledata & (1 << slot)) {
+                return slot;
+            }
         }
+        return -1;
     };
 
-    // Indices for neighbors: NW(0), N(1), NE(2), W(3), E(4), SW(5), S(6), SE(7)
     switch (pieceType) {
-        case RME::BorderType::WX_NORTH_HORIZONTAL: // Border against North
-            if (isNeighborDifferentNonFriend(1)) return neighborMaterials[1] ? neighborMaterials[1]->id : QStringLiteral("none");
-            break;
-        case RME::BorderType::WX_EAST_HORIZONTAL:  // Border against East
-            if (isNeighborDifferentNonFriend(4)) return neighborMaterials[4] ? neighborMaterials[4]->id : QStringLiteral("none");
-            break;
-        case RME::BorderType::WX_SOUTH_HORIZONTAL: // Border against South
-            if (isNeighborDifferentNonFriend(6)) return neighborMaterials[6] ? neighborMaterials[6]->id : QStringLiteral("none");
-            break;
-        case RME::BorderType::WX_WEST_HORIZONTAL:  // Border against West
-            if (isNeighborDifferentNonFriend(3)) return neighborMaterials[3] ? neighborMaterials[3]->id : QStringLiteral("none");
-            break;
-
-        case RME::BorderType::WX_NORTHWEST_CORNER: // Against N or W or NW
-            if (isNeighborDifferentNonFriend(1)) return neighborMaterials[1] ? neighborMaterials[1]->id : QStringLiteral("none"); // Prioritize N
-            if (isNeighborDifferentNonFriend(3)) return neighborMaterials[3] ? neighborMaterials[3]->id : QStringLiteral("none"); // Then W
-            if (isNeighborDifferentNonFriend(0)) return neighborMaterials[0] ? neighborMaterials[0]->id : QStringLiteral("none"); // Then NW
-            break;
-        case RME::BorderType::WX_NORTHEAST_CORNER: // Against N or E or NE
-            if (isNeighborDifferentNonFriend(1)) return neighborMaterials[1] ? neighborMaterials[1]->id : QStringLiteral("none"); // N
-            if (isNeighborDifferentNonFriend(4)) return neighborMaterials[4] ? neighborMaterials[4]->id : QStringLiteral("none"); // E
-            if (isNeighborDifferentNonFriend(2)) return neighborMaterials[2] ? neighborMaterials[2]->id : QStringLiteral("none"); // NE
-            break;
-        case RME::BorderType::WX_SOUTHWEST_CORNER: // Against S or W or SW
-            if (isNeighborDifferentNonFriend(6)) return neighborMaterials[6] ? neighborMaterials[6]->id : QStringLiteral("none"); // S
-            if (isNeighborDifferentNonFriend(3)) return neighborMaterials[3] ? neighborMaterials[3]->id : QStringLiteral("none"); // W
-            if (isNeighborDifferentNonFriend(5)) return neighborMaterials[5] ? neighborMaterials[5]->id : QStringLiteral("none"); // SW
-            break;
-        case RME::BorderType::WX_SOUTHEAST_CORNER: // Against S or E or SE
-            if (isNeighborDifferentNonFriend(6)) return neighborMaterials[6] ? neighborMaterials[6]->id : QStringLiteral("none"); // S
-            if (isNeighborDifferentNonFriend(4)) return neighborMaterials[4] ? neighborMaterials[4]->id : QStringLiteral("none"); // E
-            if (isNeighborDifferentNonFriend(7)) return neighborMaterials[7] ? neighborMaterials[7]->id : QStringLiteral("none"); // SE
-            break;
-        case RME::BorderType::WX_NORTHWEST_DIAGONAL: // N and W are different
-            if (isNeighborDifferentNonFriend(1)) return neighborMaterials[1] ? neighborMaterials[1]->id : QStringLiteral("none"); // Check N
-            if (isNeighborDifferentNonFriend(3)) return neighborMaterials[3] ? neighborMaterials[3]->id : QStringLiteral("none"); // Check W
-            break;
-        case RME::BorderType::WX_NORTHEAST_DIAGONAL: // N and E are different
-            if (isNeighborDifferentNonFriend(1)) return neighborMaterials[1] ? neighborMaterials[1]->id : QStringLiteral("none");
-            if (isNeighborDifferentNonFriend(4)) return neighborMaterials[4] ? neighborMaterials[4]->id : QStringLiteral("none");
-            break;
-        case RME::BorderType::WX_SOUTHWEST_DIAGONAL: // S and W are different
-            if (isNeighborDifferentNonFriend(6)) return neighborMaterials[6] ? neighborMaterials[6]->id : QStringLiteral("none");
-            if (isNeighborDifferentNonFriend(3)) return neighborMaterials[3] ? neighborMaterials[3]->id : QStringLiteral("none");
-            break;
-        case RME::BorderType::WX_SOUTHEAST_DIAGONAL: // S and E are different
-            if (isNeighborDifferentNonFriend(6)) return neighborMaterials[6] ? neighborMaterials[6]->id : QStringLiteral("none");
-            if (isNeighborDifferentNonFriend(4)) return neighborMaterials[4] ? neighborMaterials[4]->id : QStringLiteral("none");
-            break;
-
-        case RME::BorderType::NONE:
-            return QStringLiteral("none");
-        default:
-            break;
-    }
-    qWarning("determineToBrushName: Could not determine a single target brush for BorderType %d with tiledata %u. Defaulting to 'none'. Rule matching might need 'all'.",
-             static_cast<int>(pieceType), tiledata);
-    return QStringLiteral("none");
-}
-
-static QString borderTypeToEdgeKey(RME::BorderType pieceType) {
-    switch (pieceType) {
-        case RME::BorderType::WX_NORTH_HORIZONTAL: return QStringLiteral("n");
-        case RME::BorderType::WX_EAST_HORIZONTAL:  return QStringLiteral("e");
-        case RME::BorderType::WX_SOUTH_HORIZONTAL: return QStringLiteral("s");
-        case RME::BorderType::WX_WEST_HORIZONTAL:  return QStringLiteral("w");
-        case RME::BorderType::WX_NORTHWEST_CORNER: return QStringLiteral("cnw");
-        case RME::BorderType::WX_NORTHEAST_CORNER: return QStringLiteral("cne");
-        case RME::BorderType::WX_SOUTHWEST_CORNER: return QStringLiteral("csw");
-        case RME::BorderType::WX_SOUTHEAST_CORNER: return QStringLiteral("cse");
-        case RME::BorderType::WX_NORTHWEST_DIAGONAL: return QStringLiteral("dnw");
-        case RME::BorderType::WX_NORTHEAST_DIAGONAL: return QStringLiteral("dne");
-        case RME::BorderType::WX_SOUTHWEST_DIAGONAL: return QStringLiteral("dsw");
-        case RME::BorderType::WX_SOUTHEAST_DIAGONAL: return QStringLiteral("dse");
-        default: return QString(); // Invalid or NONE
+        case RME::BorderType::WX_NORTH_HORIZONTAL: return firstDifferent({1});
+        case RME::BorderType::WX_EAST_HORIZONTAL:  return firstDifferent({4});
+        case RME::BorderType::WX_SOUTH_HORIZONTAL: return firstDifferent({6});
+        case RME::BorderType::WX_WEST_HORIZONTAL:  return firstDifferent({3});
+        case RME::BorderType::WX_NORTHWEST_CORNER: return firstDifferent({1, 3, 0});
+        case RME::BorderType::WX_NORTHEAST_CORNER: return firstDifferent({1, 4, 2});
+        case RME::BorderType::WX_SOUTHWEST_CORNER: return firstDifferent({6, 3, 5});
+        case RME::BorderType::WX_SOUTHEAST_CORNER: return firstDifferent({6, 4, 7});
+        case RME::BorderType::WX_NORTHWEST_DIAGONAL: return firstDifferent({1, 3});
+        case RME::BorderType::WX_NORTHEAST_DIAGONAL: return firstDifferent({1, 4});
+        case RME::BorderType::WX_SOUTHWEST_DIAGONAL: return firstDifferent({6, 3});
+        case RME::BorderType::WX_SOUTHEAST_DIAGONAL: return firstDifferent({6, 4});
+        default: return -1;
     }
 }
 
@@ -192,8 +79,7 @@ static bool evaluateSpecificConditions(
     const QList<RME::core::assets::SpecificCondition>& conditions,
     const RME::core::Tile* targetTile,
     const RME::core::assets::AssetManager* assetManager,
-    const std::array<const RME::core::assets::MaterialData*, 8>& /*neighborMaterials*/, // For future use
-    const QList<uint16_t>& oldBorderItemIds) {
+    const BorderItemIds& oldBorderItemIds) {
 
     if (!targetTile || !assetManager) return false;
 
@@ -810,15 +696,46 @@ void GroundBrush::undraw(RME::core::map::Map* map, RME::core::Tile* tile, const
 } // namespace core
 } // namespace RME
 
+namespace {
+
+// Items placed by one matched rule, after its specific cases (if any) have been evaluated
+void appendDynamicRuleItems(
+    QList<uint16_t>& itemsForPiece,
+    const RME::core::assets::GroundBorderTable::RuleRef& ref,
+    const RME::core::Tile* targetTile,
+    const RME::core::assets::AssetManager* assetManager,
+    const BorderItemIds& oldBorderItemIds) {
+
+    const uint16_t baseItemId = ref.baseItemId;
+    QList<uint16_t> resolvedItemsForRule;
+    bool specificCaseApplied = false;
+    for (const auto& specificCase : ref.rule->specificRuleCases) {
+        if (::evaluateSpecificConditions(specificCase.conditions, targetTile, assetManager, oldBorderItemIds)) {
+            if (specificCase.keepBaseBorder && baseItemId != 0) {
+                resolvedItemsForRule.append(baseItemId);
+            }
+            ::applySpecificActions(resolvedItemsForRule, specificCase.actions, baseItemId, specificCase.keepBaseBorder);
+            specificCaseApplied = true;
+            break;
+        }
+    }
+    if (!specificCaseApplied && baseItemId != 0) { // No specific case met, use base
+        resolvedItemsForRule.append(baseItemId);
+    }
+    for (uint16_t item : resolvedItemsForRule) {
+        if (item != 0 && !itemsForPiece.contains(item)) itemsForPiece.append(item);
+    }
+}
+
+} // namespace
+
 void RME::core::GroundBrush::doAutoBorders(RME::core::editor::EditorControllerInterface* controller,
                                            const RME::core::Position& targetPos) {
+    using RME::core::assets::GroundBorderTable;
+
     if (!s_staticDataInitialized) {
         qCritical("GroundBrush::doAutoBorders: s_border_types not initialized!");
-        // initializeStaticData(); // Constructor should have handled this.
-        if (!s_staticDataInitialized) {
-            qCritical("GroundBrush::doAutoBorders: Initialization failed even after explicit call. Aborting.");
-            return;
-        }
+        return;
     }
 
     RME::core::map::Map* map = controller->getMap();
@@ -829,17 +746,8 @@ void RME::core::GroundBrush::doAutoBorders(RME::core::editor::EditorControllerIn
         return;
     }
 
-    const RME::core::assets::MaterialManager* materialManager = assetManager->getMaterialManager();
-    if (!materialManager) {
-        qWarning("GroundBrush::doAutoBorders: MaterialManager not available from AssetManager for pos %s.", qUtf8Printable(targetPos.toString()));
-        return;
-    }
-
-    const RME::core::assets::ItemDatabase* itemDb = assetManager->getItemDatabase();
-    if (!itemDb) {
-        qWarning("GroundBrush::doAutoBorders: ItemDatabase not available for pos %s.", qUtf8Printable(targetPos.toString()));
-        return;
-    }
+    // Built with the materials; every lookup below is by item ID or material index
+    const GroundBorderTable& borderTable = assetManager->getMaterialManager().getGroundBorderTable();
 
     const RME::core::Tile* targetTile = map->getTile(targetPos);
     if (!targetTile) {
@@ -848,30 +756,28 @@ void RME::core::GroundBrush::doAutoBorders(RME::core::editor::EditorControllerIn
     }
 
     // 1. Collect old border item IDs
-    QList<uint16_t> oldBorderItemIds;
+    BorderItemIds oldBorderItemIds;
     for (const auto& itemPtr : targetTile->getItems()) {
         if (itemPtr) {
-            const RME::core::assets::ItemData* itemData = itemDb->getItemData(itemPtr->getID());
-            if (itemData) {
-                 oldBorderItemIds.append(itemPtr->getID());
-            }
+            oldBorderItemIds.append(itemPtr->getID());
         }
     }
     std::sort(oldBorderItemIds.begin(), oldBorderItemIds.end());
 
     // 2. Get current tile's material
-    const RME::core::assets::MaterialData* currentTileMaterial = ::getMaterialFromTile(targetTile, assetManager);
-    const RME::core::assets::MaterialGroundSpecifics* currentTileSpecifics = nullptr;
-    if (currentTileMaterial && currentTileMaterial->isGround()) {
-        currentTileSpecifics = std::get_if<RME::core::assets::MaterialGroundSpecifics>(&currentTileMaterial->specificData);
-    }
+    const quint16 currentMaterial = getMaterialIndexFromTile(targetTile, borderTable);
 
-    QList<uint16_t> newBorderItemIds;
+    BorderItemIds newBorderItemIds;
+    auto addNewBorderItem = [&newBorderItemIds](uint16_t item) {
+        if (item != 0 && !newBorderItemIds.contains(item)) {
+            newBorderItemIds.append(item);
+        }
+    };
 
-    if (currentTileMaterial && currentTileSpecifics) {
-        // 4. Calculate tiledata
+    if (borderTable.isGround(currentMaterial)) {
+        // 3. Calculate tiledata: neighbours of another, non-friend material (or none at all)
         uint8_t tiledata = 0;
-        std::array<const RME::core::assets::MaterialData*, 8> neighborMaterials;
+        std::array<quint16, 8> neighborMaterials;
         static const std::array<std::pair<int, int>, 8> neighborOffsets = {{
             {-1,-1}, {0,-1}, {1,-1}, {-1,0}, {1,0}, {-1,1}, {0,1}, {1,1}
         }};
@@ -880,163 +786,59 @@ void RME::core::GroundBrush::doAutoBorders(RME::core::editor::EditorControllerIn
             RME::core::Position neighborPos(targetPos.x + neighborOffsets[i].first,
                                             targetPos.y + neighborOffsets[i].second,
                                             targetPos.z);
-            const RME::core::Tile* neighborTile = map->getTile(neighborPos);
-            neighborMaterials[i] = ::getMaterialFromTile(neighborTile, assetManager);
-
-            bool isDifferent = false;
-            if (!neighborMaterials[i]) {
-                isDifferent = true;
-            } else if (neighborMaterials[i]->id != currentTileMaterial->id) {
-                bool areFriends = currentTileSpecifics->friends.contains(neighborMaterials[i]->id);
-                if (!areFriends) {
-                    isDifferent = true;
-                }
-            }
+            const quint16 neighbor = getMaterialIndexFromTile(map->getTile(neighborPos), borderTable);
+            neighborMaterials[i] = neighbor;
 
-            if (isDifferent) {
+            if (neighbor == GroundBorderTable::NO_MATERIAL ||
+                (neighbor != currentMaterial && !borderTable.areFriends(currentMaterial, neighbor))) {
                 tiledata |= (1 << i);
             }
         }
 
-        // 5. Lookup and Unpack Border Types
-        uint32_t packedComputedBorderTypes = s_border_types[tiledata];
-
-        // Helper lambda to resolve a rule and piece to an item ID (defined earlier, now just for context)
-        auto resolveItemForRuleAndPiece =
-            [&materialManager](const RME::core::assets::MaterialBorderRule* rule, RME::BorderType pieceType) -> uint16_t {
-            if (!rule) return 0;
-
-            bool conversionOk = false;
-            uint16_t directItemId = rule->ruleTargetId.toUShort(&conversionOk);
-
-            if (conversionOk && directItemId != 0) {
-                return directItemId;
-            } else {
-                const RME::core::assets::BorderSetData* borderSet = materialManager->getBorderSet(rule->ruleTargetId);
-                if (borderSet) {
-                    QString edgeKey = ::borderTypeToEdgeKey(pieceType);
-                    if (!edgeKey.isEmpty()) {
-                        return borderSet->edgeItems.value(edgeKey, 0);
-                    } else {
-                        qWarning("GroundBrush::doAutoBorders: Could not map BorderType %d to an edge key for set '%s'.",
-                                 static_cast<int>(pieceType), qUtf8Printable(rule->ruleTargetId));
-                    }
-                } else {
-                    if (!conversionOk || directItemId == 0) {
-                         qWarning("GroundBrush::doAutoBorders: ruleTargetId '%s' for align '%s' to '%s' is not a valid direct item ID and not a found BorderSet.",
-                                 qUtf8Printable(rule->ruleTargetId), qUtf8Printable(rule->align), qUtf8Printable(rule->toBrushName));
-                    }
-                }
-            }
-            return 0;
-        };
+        // 4. Lookup and Unpack Border Types
+        const uint32_t packedComputedBorderTypes = s_border_types[tiledata];
 
         for (int pieceNum = 0; pieceNum < 4; ++pieceNum) {
             RME::BorderType piece = RME::unpackBorderType(packedComputedBorderTypes, pieceNum);
             if (piece == RME::BorderType::NONE) continue;
 
-            QList<uint16_t> itemsForThisPiece; // Holds items specifically for this geometric piece
-
-            QString alignStr = ::determineAlignString(piece, tiledata, neighborMaterials, currentTileMaterial);
-            QString toBrushIdStr = ::determineToBrushName(piece, tiledata, neighborMaterials, currentTileMaterial);
-
-            if (alignStr == QLatin1String("none") && piece != RME::BorderType::NONE) {
-                 qDebug("GroundBrush::doAutoBorders: alignStr is 'none' for a valid pieceType %d for tile %s. Skipping.", static_cast<int>(piece), qUtf8Printable(targetPos.toString()));
-                 continue;
+            // 5. Resolve the piece against the neighbour it borders
+            const int neighborSlot = ::borderNeighborSlot(piece, tiledata);
+            const quint16 toMaterial = neighborSlot >= 0 ? neighborMaterials[neighborSlot] : GroundBorderTable::NO_MATERIAL;
+            const GroundBorderTable::PieceBorders* pieceBorders = borderTable.borders(currentMaterial, toMaterial, piece);
+            if (!pieceBorders) {
+                continue;
             }
 
-            QList<const RME::core::assets::MaterialBorderRule*> pieceMatchedSuperRules;
-            QList<const RME::core::assets::MaterialBorderRule*> pieceMatchedNormalRules;
-
-            for (const auto& rule : currentTileSpecifics->borders) {
-                bool alignMatch = (rule.align.compare(alignStr, Qt::CaseInsensitive) == 0 ||
-                                   rule.align.compare(QStringLiteral("any"), Qt::CaseInsensitive) == 0);
-                bool toBrushMatch = (rule.toBrushName.compare(toBrushIdStr, Qt::CaseInsensitive) == 0 ||
-                                     rule.toBrushName.compare(QStringLiteral("all"), Qt::CaseInsensitive) == 0 ||
-                                     (toBrushIdStr == QLatin1String("none") && rule.toBrushName.compare(QStringLiteral("none"), Qt::CaseInsensitive) == 0));
-                if (alignMatch && toBrushMatch) {
-                    if (rule.isSuper) pieceMatchedSuperRules.append(&rule);
-                    else pieceMatchedNormalRules.append(&rule);
+            if (!pieceBorders->dynamic) {
+                for (uint16_t item : pieceBorders->items) {
+                    addNewBorderItem(item);
                 }
+                continue;
             }
 
-            bool superRuleGeneratedItemsForThisPiece = false;
-            for (const auto* rule : pieceMatchedSuperRules) {
-                uint16_t baseItemId = resolveItemForRuleAndPiece(rule, piece);
-                QList<uint16_t> resolvedItemsForRule; // Items from this rule after specific cases
-
-                if (rule->specificRuleCases.isEmpty()) {
-                    if (baseItemId != 0) resolvedItemsForRule.append(baseItemId);
-                } else {
-                    bool specificCaseApplied = false;
-                    for (const auto& specificCase : rule->specificRuleCases) {
-                        if (::evaluateSpecificConditions(specificCase.conditions, targetTile, assetManager, neighborMaterials, oldBorderItemIds)) {
-                            QList<uint16_t> tempItemsForAction = resolvedItemsForRule; // Or start fresh?
-                            if (specificCase.keepBaseBorder && baseItemId != 0 && !tempItemsForAction.contains(baseItemId)) {
-                                tempItemsForAction.append(baseItemId);
-                            }
-                            ::applySpecificActions(tempItemsForAction, specificCase.actions, baseItemId, specificCase.keepBaseBorder);
-                            resolvedItemsForRule = tempItemsForAction; // Update with items after actions
-                            specificCaseApplied = true;
-                            break;
-                        }
-                    }
-                    if (!specificCaseApplied && baseItemId != 0) { // No specific case met, use base
-                        resolvedItemsForRule.append(baseItemId);
-                    }
-                }
-                for (uint16_t item : resolvedItemsForRule) {
-                    if (item != 0 && !itemsForThisPiece.contains(item)) itemsForThisPiece.append(item);
-                }
-            }
-            if (!itemsForThisPiece.isEmpty()) {
-                superRuleGeneratedItemsForThisPiece = true;
+            // Specific cases depend on the tile contents; super rules win if they place anything
+            QList<uint16_t> itemsForThisPiece;
+            for (const auto& ref : pieceBorders->superRules) {
+                appendDynamicRuleItems(itemsForThisPiece, ref, targetTile, assetManager, oldBorderItemIds);
             }
-
-            if (!superRuleGeneratedItemsForThisPiece) {
-                for (const auto* rule : pieceMatchedNormalRules) {
-                    uint16_t baseItemId = resolveItemForRuleAndPiece(rule, piece);
-                    QList<uint16_t> resolvedItemsForRule;
-                    if (rule->specificRuleCases.isEmpty()) {
-                        if (baseItemId != 0) resolvedItemsForRule.append(baseItemId);
-                    } else {
-                        bool specificCaseApplied = false;
-                        for (const auto& specificCase : rule->specificRuleCases) {
-                            if (::evaluateSpecificConditions(specificCase.conditions, targetTile, assetManager, neighborMaterials, oldBorderItemIds)) {
-                                QList<uint16_t> tempItemsForAction = resolvedItemsForRule;
-                                if (specificCase.keepBaseBorder && baseItemId != 0 && !tempItemsForAction.contains(baseItemId)) {
-                                     tempItemsForAction.append(baseItemId);
-                                }
-                                ::applySpecificActions(tempItemsForAction, specificCase.actions, baseItemId, specificCase.keepBaseBorder);
-                                resolvedItemsForRule = tempItemsForAction;
-                                specificCaseApplied = true;
-                                break;
-                            }
-                        }
-                        if (!specificCaseApplied && baseItemId != 0) {
-                             resolvedItemsForRule.append(baseItemId);
-                        }
-                    }
-                    for (uint16_t item : resolvedItemsForRule) {
-                        if (item != 0 && !itemsForThisPiece.contains(item)) itemsForThisPiece.append(item);
-                    }
+            if (itemsForThisPiece.isEmpty()) {
+                for (const auto& ref : pieceBorders->normalRules) {
+                    appendDynamicRuleItems(itemsForThisPiece, ref, targetTile, assetManager, oldBorderItemIds);
                 }
             }
-            // Add all unique items for this piece to the main list
             for (uint16_t item : itemsForThisPiece) {
-                if (item != 0 && !newBorderItemIds.contains(item)) {
-                    newBorderItemIds.append(item);
-                }
+                addNewBorderItem(item);
             }
         }
     }
 
-    // 7. Apply Changes
+    // 6. Apply Changes
     std::sort(newBorderItemIds.begin(), newBorderItemIds.end());
     if (oldBorderItemIds != newBorderItemIds) {
-        qDebug() << "GroundBrush::doAutoBorders: Tile" << targetPos.toString() << "borders changing. Old:" << oldBorderItemIds << "New:" << newBorderItemIds;
-        controller->recordSetBorderItems(targetPos, newBorderItemIds, oldBorderItemIds);
-    } else {
-        // qDebug() << "GroundBrush::doAutoBorders: Tile" << targetPos.toString() << "borders did not change.";
+        const QList<uint16_t> newItems(newBorderItemIds.cbegin(), newBorderItemIds.cend());
+        const QList<uint16_t> oldItems(oldBorderItemIds.cbegin(), oldBorderItemIds.cend());
+        qDebug() << "GroundBrush::doAutoBorders: Tile" << targetPos.toString() << "borders changing. Old:" << oldItems << "New:" << newItems;
+        controller->recordSetBorderItems(targetPos, newItems, oldItems);
     }
 }
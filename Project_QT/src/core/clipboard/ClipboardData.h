@@ -117,7 +117,8 @@ QDataStream& operator<<(QDataStream& out, const ClipboardContent& content);
 QDataStream& operator>>(QDataStream& in, ClipboardContent& content);
 
 
-// Define your custom MIME type
+// Define your custom MIME type. The system clipboard holds the binary payload
+// described in ClipboardStream.h; the structs above describe tiles for DeleteCommand.
 const QString RME_CLIPBOARD_MIME_TYPE = "application/x-rme-map-fragment";
 
 } // namespace RME
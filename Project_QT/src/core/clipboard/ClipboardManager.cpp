@@ -9,6 +9,9 @@
 #include "core/actions/DeleteCommand.h"
 #include "core/actions/PasteCommand.h"
 #include "core/selection/SelectionManager.h" // For getting detailed selection for delete
+#include "core/clipboard/ClipboardStream.h"
+#include "core/assets/AssetManager.h"
+#include "core/settings/AppSettings.h"
 
 #include <QApplication>
 #include <QClipboard>
@@ -19,18 +22,24 @@
 #include <limits>   // For std::numeric_limits
 #include <QDebug>   // For logging
 #include <QSize>    // For bounding box calculations
-#include <climits>  // For INT_MAX, INT_MIN
+#include <QSet>
+#include <QElapsedTimer>
 
 ClipboardManager::ClipboardManager(QObject *parent) : QObject(parent) {}
 
+ClipboardManager::~ClipboardManager() = default;
+
 void ClipboardManager::copySelection(const RME::SelectionManager& selectionManager, const RME::Map& map) {
     const QSet<RME::Tile*>& selectedTiles = selectionManager.getSelectedTiles();
     if (selectedTiles.isEmpty()) {
         qDebug() << "ClipboardManager: No tiles selected to copy.";
         return;
     }
+    if (!m_settings) {
+        qWarning() << "ClipboardManager::copySelection: No AppSettings set, cannot encode tiles.";
+        return;
+    }
 
-    RME::ClipboardContent clipboardContent;
     RME::Position copyRefPos(std::numeric_limits<int16_t>::max(),
                              std::numeric_limits<int16_t>::max(),
                              std::numeric_limits<int8_t>::max());
@@ -59,110 +68,91 @@ void ClipboardManager::copySelection(const RME::SelectionManager& selectionManag
     }
 
 
-    for (RME::Tile* tile : selectedTiles) {
-        if (!tile) continue;
+    RME::AssetManager* assetManager = map.getAssetManager();
+    if (!assetManager) {
+        qWarning() << "ClipboardManager::copySelection: Map has no AssetManager, cannot encode tiles.";
+        return;
+    }
+    m_assetManager = assetManager;
 
-        // We only copy data from a tile if the tile itself is selected or it contains selected items/creatures/spawn
-        // The wxwidgets version iterates editor.selection and then checks tile->ground->isSelected() or item->isSelected() etc.
-        // Our SelectionManager::isSelected(tile) or SelectionManager::isSelected(tile, item) should be the source of truth.
+    // Tiles are encoded straight from the map in the OTBM tile format; only partially
+    // selected tiles are assembled into temporary copies first.
+    QElapsedTimer timer;
+    timer.start();
+    RME::ClipboardWriter writer(*assetManager, *m_settings, m_compressionLevel);
+    for (RME::Tile* tile : selectedTiles) {
+        if (tile) {
+            addSelectedTileContent(writer, selectionManager, tile, assetManager);
+        }
+    }
 
-        RME::ClipboardTileData tileData;
-        tileData.relativePosition = tile->getPosition() - copyRefPos;
+    if (writer.getTileCount() == 0) {
+        qDebug() << "ClipboardManager: No selected elements found to copy.";
+        return;
+    }
 
-        // Ground data (assuming tile selection implies ground selection, or specific ground selection check)
-        if (selectionManager.isSelected(tile)) { // Check if the tile itself (ground) is selected
-            tileData.hasGround = true;
-            if (tile->getGround()) {
-                tileData.groundItemID = tile->getGround()->getID();
-            }
-            tileData.houseId = tile->getHouseId();
-            tileData.tileFlags = static_cast<uint32_t>(tile->getMapFlags()); // Convert TileMapFlags to uint32_t
-        }
+    const int tileCount = writer.getTileCount();
+    const QByteArray byteArray = writer.finish(copyRefPos);
+    if (byteArray.isEmpty()) {
+        qWarning() << "ClipboardManager::copySelection:" << writer.getLastError();
+        return;
+    }
 
-        // Items - Implement per-item selection when Item selection state is available
-        // Check if the tile itself is selected (which implies all items are selected)
-        // or check individual item selection states
-        bool tileSelected = selectionManager.isSelected(tile);
-        
-        // Copy ground item if it exists and is selected
-        if (tile->getGround()) {
-            bool groundSelected = tileSelected || selectionManager.isItemSelected(tile, tile->getGround());
-            if (groundSelected) {
-                RME::ClipboardItemData groundData = createItemClipboardData(tile->getGround());
-                tileData.items.append(groundData);
-                
-                // If ground is selected, mark tile as having ground data
-                if (!tileData.hasGround) {
-                    tileData.hasGround = true;
-                    tileData.groundItemID = tile->getGround()->getID();
-                    tileData.houseId = tile->getHouseId();
-                    tileData.tileFlags = static_cast<uint32_t>(tile->getMapFlags());
-                }
-            }
-        }
-        
-        // Copy stacked items (check individual selection for each item)
-        QList<RME::Item*> allItems = tile->getAllItems();
-        for (RME::Item* item : allItems) {
-            if (item && item != tile->getGround()) { // Skip ground item as it's handled above
-                bool itemSelected = tileSelected || selectionManager.isItemSelected(tile, item);
-                if (itemSelected) {
-                    RME::ClipboardItemData itemData = createItemClipboardData(item);
-                    tileData.items.append(itemData);
-                }
-            }
-        }
+    QMimeData* mimeData = new QMimeData();
+    mimeData->setData(RME::RME_CLIPBOARD_MIME_TYPE, byteArray);
+    QApplication::clipboard()->setMimeData(mimeData);
 
-        // Creature - Implement per-creature selection when Creature selection state is available
-        if (tile->hasCreature()) {
-            RME::core::creatures::Creature* creature = tile->getCreature();
-            if (creature) {
-                bool creatureSelected = tileSelected || selectionManager.isCreatureSelected(tile, creature);
-                if (creatureSelected) {
-                    tileData.hasCreature = true;
-                    tileData.creature = createCreatureClipboardData(creature);
-                }
-            }
-        }
+    qDebug() << "ClipboardManager: Copied" << tileCount << "tiles (" << byteArray.size() << "bytes) to clipboard in"
+             << timer.elapsed() << "ms.";
+}
 
-        // Spawn - Implement per-spawn selection when Spawn selection state is available
-        if (tile->isSpawnTile()) {
-            // For now, assume tile-level selection includes spawn data
-            // In a full implementation, we'd check individual spawn selection
-            bool spawnSelected = tileSelected;
-            
-            // If tile has spawn integration, check its selection state
-            if (tile->hasSpawn()) {
-                RME::core::spawns::Spawn spawn = tile->getSpawn();
-                spawnSelected = tileSelected || spawn.isSelected();
-            }
-            
-            if (spawnSelected) {
-                tileData.hasSpawn = true;
-                tileData.spawn = createSpawnClipboardData(tile);
-            }
+bool ClipboardManager::addSelectedTileContent(RME::ClipboardWriter& writer, const RME::SelectionManager& selectionManager,
+                                              const RME::Tile* tile, RME::AssetManager* assetManager) const {
+    // We only copy data from a tile if the tile itself is selected or it contains selected items/creatures/spawn
+    // The wxwidgets version iterates editor.selection and then checks tile->ground->isSelected() or item->isSelected() etc.
+    if (selectionManager.isSelected(tile)) {
+        // Whole tile (ground, items, creature, spawn, flags and house) - encode it in place
+        writer.addTile(tile);
+        return true;
+    }
+
+    auto partial = std::make_unique<RME::Tile>(tile->getPosition(), assetManager);
+    bool hasContent = false;
+
+    if (RME::Item* ground = tile->getGround()) {
+        if (selectionManager.isItemSelected(tile, ground)) {
+            // Selected ground carries the tile properties with it
+            partial->setGround(ground->deepCopy());
+            partial->setHouseId(tile->getHouseId());
+            partial->setMapFlags(tile->getMapFlags());
+            hasContent = true;
         }
+    }
 
-        // Only add tileData if it has some selected content
-        if (tileData.hasGround || !tileData.items.isEmpty() || tileData.hasCreature || tileData.hasSpawn) {
-            clipboardContent.tiles.append(tileData);
+    for (const auto& item : tile->getItems()) {
+        if (item && selectionManager.isItemSelected(tile, item.get())) {
+            partial->addItem(item->deepCopy());
+            hasContent = true;
         }
     }
 
-    if (clipboardContent.tiles.isEmpty()) {
-        qDebug() << "ClipboardManager: No selected elements found to copy.";
-        return;
+    const RME::core::creatures::Creature* creature = tile->getCreature();
+    if (creature && selectionManager.isCreatureSelected(tile, creature)) {
+        partial->setCreature(creature->deepCopy());
+        hasContent = true;
     }
 
-    QByteArray byteArray;
-    QDataStream stream(&byteArray, QIODevice::WriteOnly);
-    stream << clipboardContent;
-
-    QMimeData* mimeData = new QMimeData();
-    mimeData->setData(RME::RME_CLIPBOARD_MIME_TYPE, byteArray);
-    QApplication::clipboard()->setMimeData(mimeData);
+    if (tile->hasSpawn() && tile->getSpawn().isSelected()) {
+        partial->setSpawnRadius(tile->getSpawnRadius());
+        partial->setSpawnIntervalSeconds(tile->getSpawnIntervalSeconds());
+        partial->setSpawnCreatureList(tile->getSpawnCreatureList());
+        hasContent = true;
+    }
 
-    qDebug() << "ClipboardManager: Copied" << clipboardContent.tiles.count() << "tiles' data to clipboard.";
+    if (hasContent) {
+        writer.addTile(std::move(partial));
+    }
+    return hasContent;
 }
 
 bool ClipboardManager::canPaste() const {
@@ -173,20 +163,39 @@ bool ClipboardManager::canPaste() const {
     return false;
 }
 
-RME::ClipboardContent ClipboardManager::getPasteData() const {
+QByteArray ClipboardManager::getPasteData() const {
     const QMimeData* mimeData = QApplication::clipboard()->mimeData();
     if (mimeData && mimeData->hasFormat(RME::RME_CLIPBOARD_MIME_TYPE)) {
-        QByteArray byteArray = mimeData->data(RME::RME_CLIPBOARD_MIME_TYPE);
-        QDataStream stream(&byteArray, QIODevice::ReadOnly);
-        RME::ClipboardContent content;
-        stream >> content;
-        if (stream.status() == QDataStream::Ok) {
-            return content;
-        } else {
-            qWarning() << "ClipboardManager: Error deserializing clipboard data.";
-        }
+        return mimeData->data(RME::RME_CLIPBOARD_MIME_TYPE);
+    }
+    return QByteArray();
+}
+
+bool ClipboardManager::forEachClipboardTile(const std::function<void(const RME::Tile&)>& visitor, QSize* boundingBox) const {
+    const QByteArray payload = getPasteData();
+    if (payload.isEmpty()) {
+        return false;
+    }
+
+    if (!m_assetManager || !m_settings) {
+        qWarning() << "ClipboardManager: No AssetManager or AppSettings available to decode clipboard tiles.";
+        return false;
+    }
+
+    RME::ClipboardReader reader(payload, *m_assetManager, *m_settings);
+    if (!reader.open()) {
+        qWarning() << "ClipboardManager:" << reader.getLastError();
+        return false;
     }
-    return RME::ClipboardContent(); // Return empty content
+    if (boundingBox) {
+        *boundingBox = reader.header().size;
+    }
+    while (reader.readNextChunk([&visitor](std::unique_ptr<RME::Tile> tile) { visitor(*tile); })) {}
+    if (reader.hasError()) {
+        qWarning() << "ClipboardManager: Error deserializing clipboard data:" << reader.getLastError();
+        return false;
+    }
+    return true;
 }
 
 // --- Stubs for cut/paste which will use DeleteCommand and PasteCommand (Step 4) ---
@@ -292,175 +301,25 @@ void ClipboardManager::paste(RME::Map& map, const RME::Position& targetPosition,
         qDebug() << "ClipboardManager: No data to paste or invalid format.";
         return;
     }
-    RME::ClipboardContent pasteData = getPasteData();
-    if (pasteData.tiles.isEmpty()) {
+    const QByteArray pasteData = getPasteData();
+    if (pasteData.isEmpty()) {
         qDebug() << "ClipboardManager: Clipboard data is empty.";
         return;
     }
-
-    RME::PasteCommand* cmd = new RME::PasteCommand(&map, targetPosition, pasteData, "Paste");
-    undoStack->push(cmd);
-    qDebug() << "ClipboardManager: Paste operation - PasteCommand pushed.";
-}
-
-// Helper methods for creating clipboard data
-RME::ClipboardItemData ClipboardManager::createItemClipboardData(const RME::Item* item) const {
-    RME::ClipboardItemData itemData;
-    itemData.id = item->getID();
-    itemData.subType = item->getSubtype();
-    itemData.attributes = QVariantMap();
-    
-    // Copy common attributes
-    if (item->hasAttribute("uid")) {
-        itemData.attributes["uid"] = item->getAttribute("uid");
-    }
-    if (item->hasAttribute("aid")) {
-        itemData.attributes["aid"] = item->getAttribute("aid");
-    }
-    if (item->hasAttribute("text")) {
-        itemData.attributes["text"] = item->getAttribute("text");
-    }
-    if (item->hasAttribute("description")) {
-        itemData.attributes["description"] = item->getAttribute("description");
-    }
-    if (item->hasAttribute("charges")) {
-        itemData.attributes["charges"] = item->getAttribute("charges");
-    }
-    if (item->hasAttribute("count")) {
-        itemData.attributes["count"] = item->getAttribute("count");
-    }
-    
-    // Copy container contents if this is a container
-    if (item->isContainer()) {
-        const RME::ContainerItem* container = dynamic_cast<const RME::ContainerItem*>(item);
-        if (container) {
-            QVariantList containerItems;
-            const auto& contents = container->getContents();
-            for (const RME::Item* contentItem : contents) {
-                if (contentItem) {
-                    // Recursively create clipboard data for container contents
-                    RME::ClipboardItemData contentData = createItemClipboardData(contentItem);
-                    QVariantMap contentMap;
-                    contentMap["id"] = contentData.id;
-                    contentMap["subType"] = contentData.subType;
-                    contentMap["attributes"] = contentData.attributes;
-                    containerItems.append(contentMap);
-                }
-            }
-            if (!containerItems.isEmpty()) {
-                itemData.attributes["containerContents"] = containerItems;
-            }
-        }
-    }
-    
-    // Copy special item properties
-    if (item->isDoor()) {
-        const RME::DoorItem* door = dynamic_cast<const RME::DoorItem*>(item);
-        if (door) {
-            itemData.attributes["doorId"] = door->getDoorID();
-            itemData.attributes["isOpen"] = door->isOpen();
-        }
-    }
-    
-    if (item->isTeleport()) {
-        const RME::TeleportItem* teleport = dynamic_cast<const RME::TeleportItem*>(item);
-        if (teleport) {
-            const RME::core::Position& dest = teleport->getDestination();
-            QVariantMap destMap;
-            destMap["x"] = dest.x;
-            destMap["y"] = dest.y;
-            destMap["z"] = dest.z;
-            itemData.attributes["teleportDestination"] = destMap;
-        }
-    }
-    
-    return itemData;
-}
-
-RME::ClipboardCreatureData ClipboardManager::createCreatureClipboardData(const RME::core::creatures::Creature* creature) const {
-    RME::ClipboardCreatureData creatureData;
-    creatureData.name = creature->getName();
-    
-    // Copy outfit data
-    const RME::core::creatures::Outfit& outfit = creature->getOutfit();
-    creatureData.lookType = outfit.lookType;
-    creatureData.head = outfit.head;
-    creatureData.body = outfit.body;
-    creatureData.legs = outfit.legs;
-    creatureData.feet = outfit.feet;
-    creatureData.addons = outfit.addons;
-    creatureData.mount = outfit.mount;
-    
-    // Copy direction and other properties
-    creatureData.direction = static_cast<uint8_t>(creature->getDirection());
-    creatureData.isNpc = creature->isNpc();
-    
-    // Copy additional attributes
-    if (creature->hasAttribute("spawnTime")) {
-        creatureData.attributes["spawnTime"] = creature->getAttribute("spawnTime");
-    }
-    if (creature->hasAttribute("script")) {
-        creatureData.attributes["script"] = creature->getAttribute("script");
-    }
-    if (creature->hasAttribute("health")) {
-        creatureData.attributes["health"] = creature->getAttribute("health");
+    if (!map.getAssetManager()) {
+        qWarning() << "ClipboardManager::paste: Map has no AssetManager, cannot decode tiles.";
+        return;
     }
-    if (creature->hasAttribute("maxHealth")) {
-        creatureData.attributes["maxHealth"] = creature->getAttribute("maxHealth");
+    if (!m_settings) {
+        qWarning() << "ClipboardManager::paste: No AppSettings set, cannot decode tiles.";
+        return;
     }
-    
-    return creatureData;
-}
+    m_assetManager = map.getAssetManager();
 
-RME::ClipboardSpawnData ClipboardManager::createSpawnClipboardData(const RME::Tile* tile) const {
-    RME::ClipboardSpawnData spawnData;
-    
-    if (!tile->isSpawnTile()) {
-        return spawnData; // Return empty spawn data if tile is not a spawn tile
-    }
-    
-    // Copy basic spawn data from tile
-    spawnData.radius = tile->getSpawnRadius();
-    spawnData.spawnTime = tile->getSpawnIntervalSeconds();
-    spawnData.creatureNames = tile->getSpawnCreatureList();
-    
-    // Set default values for advanced spawn properties
-    spawnData.despawnRange = 2; // Default value
-    spawnData.despawnRadius = 1; // Default value
-    
-    // Convert creature names to detailed creature spawn entries
-    for (const QString& creatureName : spawnData.creatureNames) {
-        RME::ClipboardSpawnData::CreatureSpawnEntry entry;
-        entry.name = creatureName;
-        entry.chance = 100; // Default chance
-        entry.max = 1; // Default max
-        spawnData.creatures.append(entry);
-    }
-    
-    // If the tile has spawn integration, use that for more detailed information
-    if (tile->hasSpawn()) {
-        RME::core::spawns::Spawn tileSpawn = tile->getSpawn();
-        spawnData.radius = tileSpawn.getRadius();
-        spawnData.spawnTime = tileSpawn.getIntervalSeconds();
-        spawnData.creatureNames = tileSpawn.getCreatureTypes();
-        
-        // Update creature entries with spawn information
-        spawnData.creatures.clear();
-        for (const QString& creatureName : tileSpawn.getCreatureTypes()) {
-            RME::ClipboardSpawnData::CreatureSpawnEntry entry;
-            entry.name = creatureName;
-            entry.chance = 100; // Default chance - Spawn doesn't have individual chances
-            entry.max = 1; // Default max
-            spawnData.creatures.append(entry);
-        }
-        
-        // Add spawn selection state if available
-        if (tileSpawn.isSelected()) {
-            spawnData.attributes["selected"] = true;
-        }
-    }
-    
-    return spawnData;
+    // The command decodes the payload itself, one tile area at a time
+    RME::PasteCommand* cmd = new RME::PasteCommand(&map, targetPosition, pasteData, m_assetManager, m_settings, "Paste");
+    undoStack->push(cmd);
+    qDebug() << "ClipboardManager: Paste operation - PasteCommand pushed," << cmd->getPastedTileCount() << "tiles pasted.";
 }
 
 // Advanced clipboard operations
@@ -483,67 +342,67 @@ bool ClipboardManager::validateClipboardData() const {
     if (!canPaste()) {
         return false;
     }
-    
-    RME::ClipboardContent content = getPasteData();
-    if (content.tiles.isEmpty()) {
-        return false;
-    }
-    
-    // Validate each tile's data
-    for (const auto& tileData : content.tiles) {
-        // Check for valid position ranges
-        if (tileData.relativePosition.x < -1000 || tileData.relativePosition.x > 1000 ||
-            tileData.relativePosition.y < -1000 || tileData.relativePosition.y > 1000 ||
-            tileData.relativePosition.z < 0 || tileData.relativePosition.z > 15) {
-            qWarning() << "ClipboardManager: Invalid position in clipboard data:" << tileData.relativePosition.x << tileData.relativePosition.y << tileData.relativePosition.z;
-            return false;
-        }
-        
-        // Validate item IDs
-        for (const auto& itemData : tileData.items) {
-            if (itemData.id == 0 || itemData.id > 65535) {
-                qWarning() << "ClipboardManager: Invalid item ID in clipboard data:" << itemData.id;
-                return false;
-            }
+
+    // Decoding already rejects malformed nodes and unknown attributes; check the values on top
+    int tileCount = 0;
+    bool valid = true;
+    const bool decoded = forEachClipboardTile([&](const RME::Tile& tile) {
+        ++tileCount;
+        if (!valid) {
+            return;
         }
-        
-        // Validate creature data
-        if (tileData.hasCreature) {
-            if (tileData.creature.name.isEmpty()) {
-                qWarning() << "ClipboardManager: Empty creature name in clipboard data";
-                return false;
-            }
-            if (tileData.creature.direction > 3) {
-                qWarning() << "ClipboardManager: Invalid creature direction:" << tileData.creature.direction;
-                return false;
+        for (const RME::Item* item : tile.getAllItems()) {
+            if (item && item->getID() == 0) {
+                qWarning() << "ClipboardManager: Invalid item ID in clipboard data at" << tile.getPosition().toString();
+                valid = false;
+                return;
             }
         }
-        
-        // Validate spawn data
-        if (tileData.hasSpawn) {
-            if (tileData.spawn.radius == 0 || tileData.spawn.radius > 50) {
-                qWarning() << "ClipboardManager: Invalid spawn radius:" << tileData.spawn.radius;
-                return false;
-            }
-            if (tileData.spawn.creatures.isEmpty() && tileData.spawn.creatureNames.isEmpty()) {
-                qWarning() << "ClipboardManager: Spawn with no creatures in clipboard data";
-                return false;
-            }
+        if (tile.isSpawnTile() && (tile.getSpawnRadius() <= 0 || tile.getSpawnRadius() > 50)) {
+            qWarning() << "ClipboardManager: Invalid spawn radius:" << tile.getSpawnRadius();
+            valid = false;
         }
-    }
-    
-    return true;
+    });
+
+    return decoded && valid && tileCount > 0;
 }
 
 void ClipboardManager::compressClipboardData() {
-    // This is a placeholder for future compression implementation
-    // Could implement:
-    // 1. Remove duplicate tile data
-    // 2. Compress item stacks
-    // 3. Optimize position encoding
-    // 4. Use binary compression algorithms
-    
-    qDebug() << "ClipboardManager::compressClipboardData - Not yet implemented";
+    const QByteArray payload = getPasteData();
+    if (payload.isEmpty() || !m_assetManager || !m_settings) {
+        qDebug() << "ClipboardManager::compressClipboardData - No clipboard data to compress";
+        return;
+    }
+
+    RME::ClipboardReader reader(payload, *m_assetManager, *m_settings);
+    if (!reader.open()) {
+        qWarning() << "ClipboardManager::compressClipboardData:" << reader.getLastError();
+        return;
+    }
+
+    // Re-encode area by area, so only one decoded area is held at a time
+    RME::ClipboardWriter writer(*m_assetManager, *m_settings, 9);
+    while (reader.readNextChunk([&writer](std::unique_ptr<RME::Tile> tile) { writer.addTile(std::move(tile)); })) {
+        if (!writer.flush()) {
+            qWarning() << "ClipboardManager::compressClipboardData:" << writer.getLastError();
+            return;
+        }
+    }
+    if (reader.hasError()) {
+        qWarning() << "ClipboardManager::compressClipboardData:" << reader.getLastError();
+        return;
+    }
+
+    const QByteArray compressed = writer.finish(reader.header().origin);
+    if (compressed.isEmpty() || compressed.size() >= payload.size()) {
+        return; // Already as small as it gets
+    }
+
+    QMimeData* mimeData = new QMimeData();
+    mimeData->setData(RME::RME_CLIPBOARD_MIME_TYPE, compressed);
+    QApplication::clipboard()->setMimeData(mimeData);
+    qDebug() << "ClipboardManager::compressClipboardData - Reduced clipboard data from" << payload.size()
+             << "to" << compressed.size() << "bytes";
 }
 
 ClipboardManager::ClipboardStats ClipboardManager::analyzeClipboardData() const {
@@ -555,63 +414,43 @@ ClipboardManager::ClipboardStats ClipboardManager::analyzeClipboardData() const
     stats.uniqueItemTypes = 0;
     stats.uniqueCreatureTypes = 0;
     stats.boundingBox = QSize(0, 0);
-    stats.formatVersion = "1.0";
+    stats.formatVersion = QString::number(RME::ClipboardHeader::VERSION);
     
     if (!canPaste()) {
         return stats;
     }
     
-    RME::ClipboardContent content = getPasteData();
-    if (content.tiles.isEmpty()) {
-        return stats;
-    }
-    
     QSet<uint16_t> uniqueItems;
     QSet<QString> uniqueCreatures;
-    int minX = INT_MAX, maxX = INT_MIN;
-    int minY = INT_MAX, maxY = INT_MIN;
     
-    for (const auto& tileData : content.tiles) {
+    forEachClipboardTile([&](const RME::Tile& tile) {
         stats.totalTiles++;
         
         // Count items and track unique types
-        for (const auto& itemData : tileData.items) {
-            stats.totalItems++;
-            uniqueItems.insert(itemData.id);
+        for (const RME::Item* item : tile.getAllItems()) {
+            if (item) {
+                stats.totalItems++;
+                uniqueItems.insert(item->getID());
+            }
         }
         
         // Count creatures and track unique types
-        if (tileData.hasCreature) {
+        if (const RME::core::creatures::Creature* creature = tile.getCreature()) {
             stats.totalCreatures++;
-            uniqueCreatures.insert(tileData.creature.name);
+            uniqueCreatures.insert(creature->getName());
         }
         
-        // Count spawns
-        if (tileData.hasSpawn) {
+        // Count spawns and add spawn creatures to unique creature list
+        if (tile.isSpawnTile()) {
             stats.totalSpawns++;
-            // Add spawn creatures to unique creature list
-            for (const auto& creatureName : tileData.spawn.creatureNames) {
+            for (const QString& creatureName : tile.getSpawnCreatureList()) {
                 uniqueCreatures.insert(creatureName);
             }
-            for (const auto& creature : tileData.spawn.creatures) {
-                uniqueCreatures.insert(creature.name);
-            }
         }
-        
-        // Calculate bounding box
-        const auto& pos = tileData.relativePosition;
-        minX = qMin(minX, static_cast<int>(pos.x));
-        maxX = qMax(maxX, static_cast<int>(pos.x));
-        minY = qMin(minY, static_cast<int>(pos.y));
-        maxY = qMax(maxY, static_cast<int>(pos.y));
-    }
+    }, &stats.boundingBox);
     
     stats.uniqueItemTypes = uniqueItems.size();
     stats.uniqueCreatureTypes = uniqueCreatures.size();
     
-    if (stats.totalTiles > 0) {
-        stats.boundingBox = QSize(maxX - minX + 1, maxY - minY + 1);
-    }
-    
     return stats;
 }
@@ -3,6 +3,10 @@
 
 #include <QObject> // For Q_OBJECT if signals/slots are needed later
 #include "ClipboardData.h" // For ClipboardContent etc.
+#include <QByteArray>
+#include <QSize>
+#include <functional>
+#include <memory>
 
 // Forward declarations
 class QUndoStack;
@@ -11,6 +15,9 @@ class SelectionManager;
 class Map;
 class Tile; // For iterating selection
 class Item;
+class AssetManager;
+class AppSettings;
+class ClipboardWriter;
 namespace core {
     namespace creatures {
         class Creature;
@@ -25,6 +32,16 @@ class ClipboardManager : public QObject {
     Q_OBJECT
 public:
     explicit ClipboardManager(QObject *parent = nullptr);
+    ~ClipboardManager() override;
+
+    // Settings used when encoding/decoding clipboard tiles; copy and paste do nothing until set
+    void setAppSettings(RME::AppSettings* settings) { m_settings = settings; }
+    // Item data for decoding clipboard tiles outside of a paste; copy and paste use the map's
+    void setAssetManager(RME::AssetManager* assetManager) { m_assetManager = assetManager; }
+
+    // zlib level for copied data: -1 stores it uncompressed, 1 (default, fast) to 9 (smallest)
+    void setCompressionLevel(int level) { m_compressionLevel = level; }
+    int getCompressionLevel() const { return m_compressionLevel; }
 
     // Copies the current selection from SelectionManager to the system clipboard
     void copySelection(const RME::SelectionManager& selectionManager, const RME::Map& map);
@@ -40,6 +57,7 @@ public:
     // Advanced clipboard operations
     QString getClipboardStatistics() const;
     bool validateClipboardData() const;
+    // Re-encodes the current clipboard data at the highest compression level
     void compressClipboardData();
     
     // Clipboard analysis
@@ -56,14 +74,19 @@ public:
     ClipboardStats analyzeClipboardData() const;
 
 private:
-    // Helper to retrieve and deserialize data for pasting
-    // Returns empty ClipboardContent if paste is not possible or data is invalid.
-    RME::ClipboardContent getPasteData() const;
-    
-    // Helper methods for creating clipboard data
-    RME::ClipboardItemData createItemClipboardData(const RME::Item* item) const;
-    RME::ClipboardCreatureData createCreatureClipboardData(const RME::core::creatures::Creature* creature) const;
-    RME::ClipboardSpawnData createSpawnClipboardData(const RME::Tile* tile) const;
+    // Raw clipboard payload (see ClipboardStream.h), empty if there is none
+    QByteArray getPasteData() const;
+
+    // Streams every tile of the clipboard payload to 'visitor'; returns false if the payload is invalid
+    bool forEachClipboardTile(const std::function<void(const RME::Tile&)>& visitor, QSize* boundingBox = nullptr) const;
+
+    // Adds the selected parts of 'tile' to 'writer'; returns false if nothing on it is selected
+    bool addSelectedTileContent(RME::ClipboardWriter& writer, const RME::SelectionManager& selectionManager,
+                                const RME::Tile* tile, RME::AssetManager* assetManager) const;
+
+    RME::AppSettings* m_settings = nullptr;
+    RME::AssetManager* m_assetManager = nullptr; // Last one set or used by copy/paste
+    int m_compressionLevel = 1;
 };
 
 #endif // CLIPBOARDMANAGER_H
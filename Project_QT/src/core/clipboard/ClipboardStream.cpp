@@ -0,0 +1,210 @@
+#include "ClipboardStream.h"
+#include "core/Tile.h"
+#include "core/assets/AssetManager.h"
+#include "core/settings/AppSettings.h"
+#include "core/io/OtbmMapIO.h"
+#include "core/io/MemoryNodeFileWriteHandle.h"
+
+#include <QHash>
+#include <QtConcurrent>
+#include <QDebug>
+#include <algorithm>
+
+namespace RME {
+
+namespace {
+constexpr int AREA_SIZE = core::io::OtbmMapIO::TILE_AREA_SIZE;
+
+struct EncodedChunk {
+    QByteArray bytes;
+    QString error;
+};
+} // namespace
+
+// --- ClipboardWriter ---
+
+ClipboardWriter::ClipboardWriter(AssetManager& assetManager, AppSettings& settings, int compressionLevel)
+    : m_assetManager(assetManager),
+      m_codec(core::io::OtbmMapIO::TileCodecSettings::fromSettings(settings)),
+      m_compressionLevel(compressionLevel)
+{
+}
+
+ClipboardWriter::~ClipboardWriter() = default;
+
+quint64 ClipboardWriter::areaKey(const Position& pos) {
+    return (static_cast<quint64>(pos.z) << 48) |
+           (static_cast<quint64>(pos.y / AREA_SIZE) << 24) |
+           static_cast<quint64>(pos.x / AREA_SIZE);
+}
+
+void ClipboardWriter::addTile(const Tile* tile) {
+    if (!tile) {
+        return;
+    }
+    const Position& pos = tile->getPosition();
+    m_pendingAreas[areaKey(pos)].append(tile);
+
+    if (m_tileCount == 0) {
+        m_minX = m_maxX = pos.x;
+        m_minY = m_maxY = pos.y;
+    } else {
+        m_minX = std::min(m_minX, static_cast<int>(pos.x));
+        m_maxX = std::max(m_maxX, static_cast<int>(pos.x));
+        m_minY = std::min(m_minY, static_cast<int>(pos.y));
+        m_maxY = std::max(m_maxY, static_cast<int>(pos.y));
+    }
+    ++m_tileCount;
+}
+
+void ClipboardWriter::addTile(std::unique_ptr<Tile> tile) {
+    if (!tile) {
+        return;
+    }
+    addTile(tile.get());
+    m_ownedTiles.push_back(std::move(tile));
+}
+
+bool ClipboardWriter::flush() {
+    if (m_pendingAreas.isEmpty()) {
+        return m_lastError.isEmpty();
+    }
+
+    // Every area is encoded by its own worker; tile and item serialization only reads the
+    // tiles and item types, and the workers share the settings snapshot, not AppSettings
+    const QList<QList<const Tile*>> areas = m_pendingAreas.values();
+    AssetManager& assetManager = m_assetManager;
+    const core::io::OtbmMapIO::TileCodecSettings codec = m_codec;
+    const int compressionLevel = m_compressionLevel;
+    const QList<EncodedChunk> encoded = QtConcurrent::blockingMapped<QList<EncodedChunk>>(areas,
+        std::function<EncodedChunk(const QList<const Tile*>&)>([&](const QList<const Tile*>& tiles) {
+            const Position& first = tiles.first()->getPosition();
+            const Position areaBase((first.x / AREA_SIZE) * AREA_SIZE, (first.y / AREA_SIZE) * AREA_SIZE, first.z);
+
+            // A private OtbmMapIO per chunk keeps error reporting thread-local
+            core::io::OtbmMapIO chunkIO;
+            core::io::MemoryNodeFileWriteHandle buffer(16 * 1024);
+            EncodedChunk chunk;
+            if (!chunkIO.serializeTileFragment(buffer, areaBase, tiles, assetManager, codec) || !buffer.isOk()) {
+                chunk.error = chunkIO.getLastError();
+                return chunk;
+            }
+            const QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char*>(buffer.getData()),
+                                                           static_cast<qsizetype>(buffer.getSize()));
+            chunk.bytes = compressionLevel >= 0 ? qCompress(raw, compressionLevel) : QByteArray(raw.constData(), raw.size());
+            return chunk;
+        }));
+
+    m_pendingAreas.clear();
+    m_ownedTiles.clear();
+
+    for (const EncodedChunk& chunk : encoded) {
+        if (!chunk.error.isEmpty()) {
+            m_lastError = "Failed to encode clipboard tiles: " + chunk.error;
+            qWarning() << "ClipboardWriter::flush:" << m_lastError;
+            m_chunks.clear();
+            return false;
+        }
+        m_chunks.append(chunk.bytes);
+    }
+    return true;
+}
+
+QByteArray ClipboardWriter::finish(const Position& origin) {
+    if (!flush()) {
+        return QByteArray();
+    }
+
+    ClipboardHeader header;
+    header.flags = m_compressionLevel >= 0 ? ClipboardHeader::FLAG_COMPRESSED : 0;
+    header.origin = origin;
+    header.tileCount = static_cast<quint32>(m_tileCount);
+    header.size = m_tileCount > 0 ? QSize(m_maxX - m_minX + 1, m_maxY - m_minY + 1) : QSize(0, 0);
+
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out << ClipboardHeader::MAGIC << header.version << header.flags
+        << static_cast<qint32>(header.origin.x) << static_cast<qint32>(header.origin.y) << static_cast<qint32>(header.origin.z)
+        << header.tileCount << static_cast<qint32>(header.size.width()) << static_cast<qint32>(header.size.height());
+    for (const QByteArray& chunk : m_chunks) {
+        out << chunk;
+    }
+    m_chunks.clear();
+    return payload;
+}
+
+// --- ClipboardReader ---
+
+ClipboardReader::ClipboardReader(const QByteArray& payload, AssetManager& assetManager, AppSettings& settings)
+    : m_payload(payload),
+      m_stream(m_payload),
+      m_assetManager(assetManager),
+      m_codec(core::io::OtbmMapIO::TileCodecSettings::fromSettings(settings))
+{
+    m_stream.setByteOrder(QDataStream::LittleEndian);
+}
+
+bool ClipboardReader::open() {
+    quint32 magic = 0;
+    qint32 originX = 0, originY = 0, originZ = 0, width = 0, height = 0;
+    m_stream >> magic >> m_header.version >> m_header.flags >> originX >> originY >> originZ
+             >> m_header.tileCount >> width >> height;
+    if (m_stream.status() != QDataStream::Ok || magic != ClipboardHeader::MAGIC) {
+        m_lastError = "Clipboard data is not an RME map fragment.";
+        return false;
+    }
+    if (m_header.version != ClipboardHeader::VERSION) {
+        m_lastError = QString("Unsupported clipboard format version %1.").arg(m_header.version);
+        return false;
+    }
+    m_header.origin = Position(originX, originY, originZ);
+    m_header.size = QSize(width, height);
+    return true;
+}
+
+bool ClipboardReader::readNextChunk(const TileVisitor& visitor) {
+    if (hasError() || m_stream.atEnd()) {
+        return false;
+    }
+
+    QByteArray chunk;
+    m_stream >> chunk;
+    if (m_stream.status() != QDataStream::Ok) {
+        m_lastError = "Clipboard data is truncated.";
+        return false;
+    }
+    if (m_header.isCompressed()) {
+        chunk = qUncompress(chunk);
+        if (chunk.isEmpty()) {
+            m_lastError = "Clipboard data is corrupt (decompression failed).";
+            return false;
+        }
+    }
+
+    // Tiles are decoded detached from any map; one area is the most ever held at once
+    std::vector<std::unique_ptr<Tile>> tiles;
+    QHash<Position, Tile*> tilesByPosition;
+    const core::io::OtbmMapIO::TileResolver detachedTiles = [&](const Position& pos) -> Tile* {
+        Tile*& slot = tilesByPosition[pos];
+        if (!slot) {
+            tiles.push_back(std::make_unique<Tile>(pos, &m_assetManager));
+            slot = tiles.back().get();
+        }
+        return slot;
+    };
+
+    core::io::OtbmMapIO chunkIO;
+    if (!chunkIO.parseTileFragment(reinterpret_cast<const uint8_t*>(chunk.constData()), static_cast<size_t>(chunk.size()),
+                                   detachedTiles, m_assetManager, m_codec)) {
+        m_lastError = "Failed to decode clipboard tiles: " + chunkIO.getLastError();
+        return false;
+    }
+
+    for (std::unique_ptr<Tile>& tile : tiles) {
+        visitor(std::move(tile));
+    }
+    return true;
+}
+
+} // namespace RME
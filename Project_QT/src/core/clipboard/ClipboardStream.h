@@ -0,0 +1,114 @@
+#ifndef CLIPBOARDSTREAM_H
+#define CLIPBOARDSTREAM_H
+
+#include "core/Position.h"
+#include "core/io/OtbmMapIO.h"
+#include <QByteArray>
+#include <QDataStream>
+#include <QList>
+#include <QMap>
+#include <QSize>
+#include <QString>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace RME {
+class Tile;
+class AssetManager;
+class AppSettings;
+
+// Binary clipboard payload stored under RME_CLIPBOARD_MIME_TYPE.
+//
+// A fixed header (magic, version, flags, copy origin, tile count, bounding size)
+// is followed by one chunk per OTBM tile area (256x256 tiles on one floor) that
+// holds selected tiles. Each chunk is a TILE_AREA node stream written with the
+// same tile and item encoding as an OTBM save, optionally zlib-compressed, so
+// item attributes, containers, creatures and spawns need no separate format.
+// Tiles keep their absolute source positions; a paste offsets them by
+// (target - origin). Chunks are independent, so a reader only ever holds one
+// decoded tile area in memory.
+struct ClipboardHeader {
+    static constexpr quint32 MAGIC = 0x524D4350; // "RMCP"
+    static constexpr quint16 VERSION = 2;
+    static constexpr quint16 FLAG_COMPRESSED = 0x0001;
+
+    quint16 version = VERSION;
+    quint16 flags = 0;
+    Position origin;      // Top-left (and lowest floor) of the copied selection
+    quint32 tileCount = 0;
+    QSize size;           // Bounding box width/height in tiles
+
+    bool isCompressed() const { return (flags & FLAG_COMPRESSED) != 0; }
+};
+
+// Builds a clipboard payload. Tiles are grouped by tile area as they are added
+// and encoded by finish(), one worker task per area.
+class ClipboardWriter {
+public:
+    // compressionLevel: -1 stores chunks uncompressed, 1 (fast) to 9 (smallest) deflates them.
+    // The tile codec settings are read from 'settings' here, on the calling thread.
+    ClipboardWriter(AssetManager& assetManager, AppSettings& settings, int compressionLevel = 1);
+    ~ClipboardWriter();
+
+    // 'tile' must stay alive and unchanged until finish() returns
+    void addTile(const Tile* tile);
+    // Takes ownership, for tiles assembled from a partial selection
+    void addTile(std::unique_ptr<Tile> tile);
+
+    int getTileCount() const { return m_tileCount; }
+
+    // Encodes every added tile and returns the complete payload, or an empty array on error
+    QByteArray finish(const Position& origin);
+
+    // Encodes the added tiles into chunks now and drops them, so they may change afterwards.
+    // The chunks are kept for finish().
+    bool flush();
+
+    QString getLastError() const { return m_lastError; }
+
+private:
+    static quint64 areaKey(const Position& pos);
+
+    AssetManager& m_assetManager;
+    core::io::OtbmMapIO::TileCodecSettings m_codec;
+    int m_compressionLevel;
+
+    QMap<quint64, QList<const Tile*>> m_pendingAreas; // Sorted by (z, y, x), matching a save
+    std::vector<std::unique_ptr<Tile>> m_ownedTiles;
+    QList<QByteArray> m_chunks;
+    int m_tileCount = 0;
+    int m_minX = 0, m_minY = 0, m_maxX = -1, m_maxY = -1;
+    QString m_lastError;
+};
+
+// Reads a clipboard payload one tile area at a time.
+class ClipboardReader {
+public:
+    using TileVisitor = std::function<void(std::unique_ptr<Tile> tile)>;
+
+    ClipboardReader(const QByteArray& payload, AssetManager& assetManager, AppSettings& settings);
+
+    // Reads and checks the header; must succeed before readNextChunk()
+    bool open();
+    const ClipboardHeader& header() const { return m_header; }
+
+    // Decodes the next tile area and passes its tiles (at their source positions) to 'visitor'.
+    // Returns false at the end of the payload or on error; see hasError().
+    bool readNextChunk(const TileVisitor& visitor);
+
+    bool hasError() const { return !m_lastError.isEmpty(); }
+    QString getLastError() const { return m_lastError; }
+
+private:
+    QByteArray m_payload;
+    QDataStream m_stream;
+    AssetManager& m_assetManager;
+    core::io::OtbmMapIO::TileCodecSettings m_codec;
+    ClipboardHeader m_header;
+    QString m_lastError;
+};
+
+} // namespace RME
+
+#endif // CLIPBOARDSTREAM_H
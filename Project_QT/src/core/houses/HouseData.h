@@ -30,7 +30,8 @@ public:
     HouseData(uint32_t houseId, const QString& houseName, const Position& entry) :
         id(houseId), name(houseName), entryPoint(entry) {}
 
-    // Methods to manage exits, if needed
+    // Methods to manage exits, if needed. For a house owned by a Map use
+    // Map::addHouseExit()/removeHouseExit() instead, which keep its exit index current.
     void addExit(const Position& exitPos) {
         if (!exits.contains(exitPos)) {
             exits.append(exitPos);
@@ -8,6 +8,7 @@
 #include <QtGlobal>  // For quint32
 #include <algorithm> // For std::max for getNextAvailableHouseID
 #include <QSet>      // For QSet<quint8> in door ID management
+#include <functional>
 
 namespace RME {
 namespace core {
@@ -16,6 +17,67 @@ namespace houses {
 Houses::Houses(RME::core::Map* map)
     : m_map(map) {
     Q_ASSERT(m_map); // Houses manager needs a valid map context
+    rebuildTileIndex();
+    if (m_map) {
+        m_tileChangeListenerId = m_map->addTileChangeListener([this](const Position& pos) {
+            syncTileIndex(pos);
+        });
+    }
+}
+
+Houses::~Houses() {
+    if (m_map && m_tileChangeListenerId != 0) {
+        m_map->removeTileChangeListener(m_tileChangeListenerId);
+    }
+}
+
+void Houses::rebuildTileIndex() {
+    m_tilesByHouse.clear();
+    m_houseIdByTile.clear();
+    if (!m_map) {
+        return;
+    }
+
+    const RME::core::Map* map = m_map;
+    map->forEachTile(std::function<bool(const Tile&)>([this](const Tile& tile) {
+        if (tile.getHouseId() != 0) {
+            indexTile(tile.getHouseId(), tile.getPosition());
+        }
+        return true;
+    }));
+}
+
+void Houses::indexTile(quint32 houseId, const Position& tilePos) {
+    unindexTile(tilePos);
+    m_tilesByHouse[houseId].insert(tilePos);
+    m_houseIdByTile.insert(tilePos, houseId);
+}
+
+void Houses::syncTileIndex(const Position& tilePos) {
+    // The tile is the source of truth; this picks up house IDs set outside link/unlink
+    const RME::core::Map* map = m_map;
+    const Tile* tile = map->getTile(tilePos);
+    const quint32 houseId = tile ? tile->getHouseId() : 0;
+    if (houseId == 0) {
+        unindexTile(tilePos);
+    } else if (m_houseIdByTile.value(tilePos) != houseId) {
+        indexTile(houseId, tilePos);
+    }
+}
+
+void Houses::unindexTile(const Position& tilePos) {
+    auto it = m_houseIdByTile.find(tilePos);
+    if (it == m_houseIdByTile.end()) {
+        return;
+    }
+    auto houseIt = m_tilesByHouse.find(it.value());
+    if (houseIt != m_tilesByHouse.end()) {
+        houseIt.value().remove(tilePos);
+        if (houseIt.value().isEmpty()) {
+            m_tilesByHouse.erase(houseIt);
+        }
+    }
+    m_houseIdByTile.erase(it);
 }
 
 HouseData* Houses::createNewHouse(quint32 desiredId) {
@@ -63,24 +125,15 @@ bool Houses::removeHouse(quint32 houseId) {
     }
 
     // Clean all tile links for this house
-    if (m_map) {
-        const HouseData& house = it.value();
-        // Clear house ID from all tiles that belong to this house
-        // Note: This is a simplified approach - in a full implementation,
-        // we'd need to track which tiles belong to each house
-        for (int x = 0; x < m_map->getWidth(); ++x) {
-            for (int y = 0; y < m_map->getHeight(); ++y) {
-                for (int z = 0; z < m_map->getFloors(); ++z) {
-                    Position pos(x, y, z);
-                    Tile* tile = m_map->getTile(pos);
-                    if (tile && tile->getHouseId() == houseId) {
-                        tile->setHouseId(0);
-                        tile->setIsProtectionZone(false);
-                        if (tile->isHouseExit()) {
-                            tile->setIsHouseExit(false);
-                        }
-                    }
-                }
+    const QSet<Position> tilePositions = m_tilesByHouse.take(houseId);
+    for (const Position& pos : tilePositions) {
+        m_houseIdByTile.remove(pos);
+        Tile* tile = m_map ? m_map->getTile(pos) : nullptr;
+        if (tile && tile->getHouseId() == houseId) {
+            tile->setHouseId(0);
+            tile->setIsProtectionZone(false);
+            if (tile->isHouseExit()) {
+                tile->setIsHouseExit(false);
             }
         }
     }
@@ -183,42 +236,37 @@ bool Houses::changeHouseID(quint32 oldId, quint32 newId) {
     m_housesById.insert(newId, houseData);
 
     // Update tiles on the map to use the new house ID
-    if (m_map) {
-        for (int x = 0; x < m_map->getWidth(); ++x) {
-            for (int y = 0; y < m_map->getHeight(); ++y) {
-                for (int z = 0; z < m_map->getFloors(); ++z) {
-                    Position pos(x, y, z);
-                    Tile* tile = m_map->getTile(pos);
-                    if (tile && tile->getHouseId() == oldId) {
-                        tile->setHouseId(newId);
-                        m_map->notifyTileChanged(pos);
-                    }
-                }
-            }
+    const QSet<Position> tilePositions = m_tilesByHouse.take(oldId);
+    for (const Position& pos : tilePositions) {
+        m_houseIdByTile.insert(pos, newId);
+        Tile* tile = m_map ? m_map->getTile(pos) : nullptr;
+        if (tile && tile->getHouseId() == oldId) {
+            tile->setHouseId(newId);
+            m_map->notifyTileChanged(pos);
         }
     }
+    if (!tilePositions.isEmpty()) {
+        m_tilesByHouse.insert(newId, tilePositions);
+    }
     return true;
 }
 
 void Houses::clearAllHouses() {
     if (m_map) {
         // Clear all house-related tile data
-        for (int x = 0; x < m_map->getWidth(); ++x) {
-            for (int y = 0; y < m_map->getHeight(); ++y) {
-                for (int z = 0; z < m_map->getFloors(); ++z) {
-                    Position pos(x, y, z);
-                    Tile* tile = m_map->getTile(pos);
-                    if (tile && tile->getHouseId() > 0) {
-                        tile->setHouseId(0);
-                        tile->setIsProtectionZone(false);
-                        if (tile->isHouseExit()) {
-                            tile->setIsHouseExit(false);
-                        }
-                    }
+        for (auto it = m_houseIdByTile.constBegin(); it != m_houseIdByTile.constEnd(); ++it) {
+            Tile* tile = m_map->getTile(it.key());
+            if (tile && tile->getHouseId() > 0) {
+                tile->setHouseId(0);
+                tile->setIsProtectionZone(false);
+                if (tile->isHouseExit()) {
+                    tile->setIsHouseExit(false);
                 }
             }
         }
     }
+    m_tilesByHouse.clear();
+    m_houseIdByTile.clear();
     m_housesById.clear();
 }
 
@@ -242,6 +290,7 @@ void Houses::linkTileToHouse(quint32 houseId, const Position& tilePos) {
     }
     
     tile->setHouseId(houseId);
+    indexTile(houseId, tilePos);
     // Note: Protection zone setting should be handled by brush logic, not automatically here
     m_map->notifyTileChanged(tilePos);
 }
@@ -252,6 +301,10 @@ void Houses::unlinkTileFromHouse(quint32 houseId, const Position& tilePos) {
         return;
     }
     
+    if (m_houseIdByTile.value(tilePos) == houseId) {
+        unindexTile(tilePos);
+    }
+
     Tile* tile = m_map->getTile(tilePos);
     if (!tile) {
         return; // Tile doesn't exist, nothing to unlink
@@ -301,6 +354,16 @@ void Houses::setHouseExit(quint32 houseId, const Position& exitPos) {
             m_map->notifyTileChanged(exitPos);
         }
     }
+
+    // Mirror the move into the map's copy of the house so its exit index stays current
+    if (m_map->getHouse(houseId)) {
+        if (oldExit.isValid()) {
+            m_map->removeHouseExit(houseId, oldExit);
+        }
+        if (exitPos.isValid()) {
+            m_map->addHouseExit(houseId, exitPos);
+        }
+    }
 }
 
 // Door management methods (from original wxWidgets)
@@ -317,23 +380,18 @@ quint8 Houses::getEmptyDoorID(quint32 houseId) const {
     // Collect all door IDs used by this house
     QSet<quint8> usedIds;
     
-    // Iterate through all tiles on the map to find doors belonging to this house
-    for (int x = 0; x < m_map->getWidth(); ++x) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int z = 0; z < m_map->getFloors(); ++z) {
-                Position pos(x, y, z);
-                const Tile* tile = m_map->getTile(pos);
-                if (tile && tile->getHouseId() == houseId) {
-                    // Check all items on this tile for doors
-                    const auto& items = tile->getItems();
-                    for (const auto& item : items) {
-                        if (item) {
-                            // Check if this item is a door and get its door ID
-                            const DoorItem* door = dynamic_cast<const DoorItem*>(item.get());
-                            if (door && door->getDoorId() > 0) {
-                                usedIds.insert(door->getDoorId());
-                            }
-                        }
+    // Look for doors on the tiles of this house
+    for (const Position& pos : m_tilesByHouse.value(houseId)) {
+        const Tile* tile = m_map->getTile(pos);
+        if (tile && tile->getHouseId() == houseId) {
+            // Check all items on this tile for doors
+            const auto& items = tile->getItems();
+            for (const auto& item : items) {
+                if (item) {
+                    // Check if this item is a door and get its door ID
+                    const DoorItem* door = dynamic_cast<const DoorItem*>(item.get());
+                    if (door && door->getDoorId() > 0) {
+                        usedIds.insert(door->getDoorId());
                     }
                 }
             }
@@ -360,23 +418,18 @@ Position Houses::getDoorPositionByID(quint32 houseId, quint8 doorId) const {
         return Position(); // Invalid position if house doesn't exist
     }
     
-    // Iterate through all tiles on the map to find the door with the specified ID
-    for (int x = 0; x < m_map->getWidth(); ++x) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int z = 0; z < m_map->getFloors(); ++z) {
-                Position pos(x, y, z);
-                const Tile* tile = m_map->getTile(pos);
-                if (tile && tile->getHouseId() == houseId) {
-                    // Check all items on this tile for doors
-                    const auto& items = tile->getItems();
-                    for (const auto& item : items) {
-                        if (item) {
-                            // Check if this item is a door with the specified ID
-                            const DoorItem* door = dynamic_cast<const DoorItem*>(item.get());
-                            if (door && door->getDoorId() == doorId) {
-                                return pos; // Found the door at this position
-                            }
-                        }
+    // Look for the door among the tiles of this house
+    for (const Position& pos : m_tilesByHouse.value(houseId)) {
+        const Tile* tile = m_map->getTile(pos);
+        if (tile && tile->getHouseId() == houseId) {
+            // Check all items on this tile for doors
+            const auto& items = tile->getItems();
+            for (const auto& item : items) {
+                if (item) {
+                    // Check if this item is a door with the specified ID
+                    const DoorItem* door = dynamic_cast<const DoorItem*>(item.get());
+                    if (door && door->getDoorId() == doorId) {
+                        return pos; // Found the door at this position
                     }
                 }
             }
@@ -400,17 +453,12 @@ int Houses::calculateHouseSizeInSqms(quint32 houseId) const {
     int walkableCount = 0;
     
     // Count walkable tiles belonging to this house
-    for (int x = 0; x < m_map->getWidth(); ++x) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int z = 0; z < m_map->getFloors(); ++z) {
-                Position pos(x, y, z);
-                const Tile* tile = m_map->getTile(pos);
-                if (tile && tile->getHouseId() == houseId) {
-                    // Check if tile is walkable (not blocking)
-                    if (!tile->isBlocking()) {
-                        walkableCount++;
-                    }
-                }
+    for (const Position& pos : m_tilesByHouse.value(houseId)) {
+        const Tile* tile = m_map->getTile(pos);
+        if (tile && tile->getHouseId() == houseId) {
+            // Check if tile is walkable (not blocking)
+            if (!tile->isBlocking()) {
+                walkableCount++;
             }
         }
     }
@@ -431,21 +479,35 @@ QList<Position> Houses::getHouseTilePositions(quint32 houseId) const {
     }
     
     // Collect all tile positions belonging to this house
-    for (int x = 0; x < m_map->getWidth(); ++x) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int z = 0; z < m_map->getFloors(); ++z) {
-                Position pos(x, y, z);
-                const Tile* tile = m_map->getTile(pos);
-                if (tile && tile->getHouseId() == houseId) {
-                    positions.append(pos);
-                }
-            }
+    const QSet<Position> tilePositions = m_tilesByHouse.value(houseId);
+    positions.reserve(tilePositions.size());
+    for (const Position& pos : tilePositions) {
+        const Tile* tile = m_map->getTile(pos);
+        if (tile && tile->getHouseId() == houseId) {
+            positions.append(pos);
         }
     }
     
     return positions;
 }
 
+int Houses::getHouseTileCount(quint32 houseId) const {
+    if (!m_map) {
+        return 0;
+    }
+
+    // Tiles can be reassigned with Tile::setHouseId() without going through
+    // link/unlink, so only count indexed tiles that still carry the house id
+    int count = 0;
+    for (const Position& pos : m_tilesByHouse.value(houseId)) {
+        const Tile* tile = m_map->getTile(pos);
+        if (tile && tile->getHouseId() == houseId) {
+            ++count;
+        }
+    }
+    return count;
+}
+
 } // namespace houses
 } // namespace core
 } // namespace RME
@@ -3,6 +3,7 @@
 
 #include <QHash>       // For QHash
 #include <QList>       // For QList
+#include <QSet>        // For QSet
 #include <QString>     // For QString
 #include <QtGlobal>    // For quint32
 #include "HouseData.h" // Use HouseData as primary house class
@@ -21,19 +22,25 @@ namespace RME {
 namespace core {
 namespace houses {
 
+// Keeps an index of which tiles belong to which house, so per-house queries
+// (size, tile list, doors) only visit that house's tiles. The index is built
+// from the map when the manager is created; afterwards every tile reported
+// through Map::notifyTileChanged() (brushes, paste, undo) is re-read, so house
+// IDs written by any command are picked up. Call rebuildTileIndex() after
+// replacing the map's tiles wholesale (loading or creating a map).
 class Houses {
     friend class ::TestHouses;
     friend class RME::core::Map; // Allow Map to potentially access/modify houses during load/save or complex ops
 
 public:
     explicit Houses(RME::core::Map* map);
-    ~Houses() = default;
+    ~Houses();
 
-    // Prevent copying, allow moving if needed
+    // Not copyable or movable: the map holds a tile change listener bound to this instance
     Houses(const Houses&) = delete;
     Houses& operator=(const Houses&) = delete;
-    Houses(Houses&&) = default;
-    Houses& operator=(Houses&&) = default;
+    Houses(Houses&&) = delete;
+    Houses& operator=(Houses&&) = delete;
 
     // Creates a new HouseData with a unique ID (either desiredId if available, or next available).
     // Adds it to the manager and returns a pointer to the new HouseData.
@@ -71,6 +78,9 @@ public:
     int getHouseCount() const { return m_housesById.size(); }
     
     // Tile management methods (moved from House class)
+    // Linking moves the tile out of whichever house it was indexed under.
+    // Unlinking always drops the index entry; the tile itself is only cleared
+    // if it still carries houseId, so callers may reset the tile first.
     void linkTileToHouse(quint32 houseId, const Position& tilePos);
     void unlinkTileFromHouse(quint32 houseId, const Position& tilePos);
     void setHouseExit(quint32 houseId, const Position& exitPos);
@@ -82,11 +92,23 @@ public:
     // Additional utility methods
     int calculateHouseSizeInSqms(quint32 houseId) const;
     QList<Position> getHouseTilePositions(quint32 houseId) const;
+    int getHouseTileCount(quint32 houseId) const;
+
+    // Re-scans the map's populated sectors and rebuilds the house tile index.
+    void rebuildTileIndex();
 
 private:
+    void indexTile(quint32 houseId, const Position& tilePos);
+    void unindexTile(const Position& tilePos);
+    void syncTileIndex(const Position& tilePos);
+
     RME::core::Map* m_map; // Non-owning pointer to the map context
     // Stores HouseData objects, keyed by their ID.
     QHash<quint32, HouseData> m_housesById;
+    // House tile index, both directions
+    QHash<quint32, QSet<Position>> m_tilesByHouse;
+    QHash<Position, quint32> m_houseIdByTile;
+    int m_tileChangeListenerId = 0;
 };
 
 } // namespace houses
@@ -40,8 +40,8 @@ BinaryNode::~BinaryNode() {
     m_child = nullptr; // Avoid dangling pointer just in case.
 }
 
-void BinaryNode::setProperties(const QByteArray& propsData) {
-    m_properties = propsData;
+void BinaryNode::setProperties(QByteArray propsData) {
+    m_properties = std::move(propsData);
     resetReadOffset();
 }
 
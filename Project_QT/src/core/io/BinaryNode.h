@@ -4,7 +4,9 @@
 #include <vector>
 #include <string> // For getString, getLongString return types, and potentially internal use if not fully vector<uint8_t>
 #include <cstdint>
+#include <utility> // For std::move
 #include <memory> // Required if BinaryNode manages children with unique_ptr, though original uses raw with custom pool
+#include <QByteArray>
 
 // Forward declaration
 namespace RME {
@@ -50,8 +52,13 @@ public:
     BinaryNode* getNextChild(); // Advances to the next sibling of the current child (or gets first if no current child)
     BinaryNode* advance();    // Advances this node to its next sibling
 
-    /** @brief Sets the properties data for this node and resets the read offset. */
-    void setProperties(const QByteArray& propsData);
+    /**
+     * @brief Sets the properties data for this node and resets the read offset.
+     *
+     * The data is taken over without copying. It may be a QByteArray::fromRawData() view into
+     * the owning handle's buffer, valid for as long as that handle is alive.
+     */
+    void setProperties(QByteArray propsData);
     /** @brief Gets the raw properties data. Useful if external parsing or decompression is needed first. */
     const QByteArray& getPropertiesData() const { return m_properties; }
     /** @brief Resets the internal read offset for properties to the beginning. */
@@ -67,8 +74,10 @@ public:
     void setType(uint8_t type) { m_type = type; }
     /** @brief Gets the node data (distinct from properties, e.g. tile coords, item id). */
     const QByteArray& getNodeData() const { return m_nodeData; }
-    /** @brief Sets the node data (used by NodeFileReadHandle). */
-    void setNodeData(const QByteArray& data) { m_nodeData = data; }
+    /** @brief Offset of this node's NODE_START in the handle's stream (see NodeFileReadHandle::tell()). */
+    size_t getStreamOffset() const { return m_streamOffset; }
+    /** @brief Sets the node data (used by NodeFileReadHandle). Same ownership rules as setProperties(). */
+    void setNodeData(QByteArray data) { m_nodeData = std::move(data); }
 
 
 private:
@@ -79,6 +88,7 @@ private:
     QByteArray m_nodeData;   // Raw data for this node (e.g., tile coordinates, item ID)
     QByteArray m_properties; // Stores the properties (attributes) of this node.
     qsizetype m_readOffset;  // Current read offset within m_properties
+    size_t m_streamOffset = 0; // Position of this node's NODE_START in the source stream
 
     NodeFileReadHandle* m_fileHandle; // Non-owning pointer to the file handle that created it
     BinaryNode* m_parent;             // Non-owning pointer to the parent node
@@ -89,6 +99,7 @@ private:
     friend class NodeFileReadHandle; // To allow NodeFileReadHandle to call loadProperties and manage child nodes
     friend class MemoryNodeFileReadHandle;
     friend class DiskNodeFileReadHandle; // If Disk version is also ported
+    friend class MappedNodeFileReadHandle;
 };
 
 } // namespace io
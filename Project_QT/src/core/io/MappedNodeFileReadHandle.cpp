@@ -0,0 +1,88 @@
+#include "core/io/MappedNodeFileReadHandle.h"
+#include "core/io/otbm_constants.h" // For NODE_START, NODE_END, ESCAPE_CHAR and error codes
+#include <QDebug>                   // For qWarning
+
+namespace RME {
+namespace core {
+namespace io {
+
+MappedNodeFileReadHandle::MappedNodeFileReadHandle(const QString& filePath)
+    : NodeFileReadHandle()
+    , m_file(filePath)
+{
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = RME_OTBM_IO_ERROR_FILE_OPEN;
+        qWarning() << "MappedNodeFileReadHandle: Failed to open file:" << filePath << "Error:" << m_file.errorString();
+        return;
+    }
+
+    const qint64 fileSize = m_file.size();
+    if (fileSize < 4) {
+        m_error = RME_OTBM_IO_ERROR_SYNTAX;
+        qWarning() << "MappedNodeFileReadHandle: File too short for OTBM identifier:" << filePath;
+        m_file.close();
+        return;
+    }
+
+    m_mapped = m_file.map(0, fileSize);
+    if (m_mapped) {
+        m_begin = m_mapped;
+    } else {
+        // Not every device supports mapping; read it once and parse from memory instead.
+        m_fallbackData = m_file.readAll();
+        if (m_fallbackData.size() != fileSize) {
+            m_error = RME_OTBM_IO_ERROR_READ_FAILED;
+            qWarning() << "MappedNodeFileReadHandle: Failed to read file:" << filePath << "Error:" << m_file.errorString();
+            m_file.close();
+            return;
+        }
+        m_begin = reinterpret_cast<const uint8_t*>(m_fallbackData.constData());
+    }
+    m_end = m_begin + fileSize;
+
+    // Skip the 4-byte file identifier; the node stream starts with the first NODE_START after it.
+    m_cursor = m_begin + 4;
+}
+
+MappedNodeFileReadHandle::~MappedNodeFileReadHandle() {
+    if (m_mapped) {
+        m_file.unmap(m_mapped);
+        m_mapped = nullptr;
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+}
+
+size_t MappedNodeFileReadHandle::tell() const {
+    return static_cast<size_t>(m_cursor - m_begin);
+}
+
+bool MappedNodeFileReadHandle::isEof() const {
+    if (m_error != RME_OTBM_IO_NO_ERROR) {
+        return true;
+    }
+    return m_cursor >= m_end;
+}
+
+bool MappedNodeFileReadHandle::ensureBytesAvailable(size_t bytes) {
+    if (m_error != RME_OTBM_IO_NO_ERROR) return false;
+    return static_cast<size_t>(m_end - m_cursor) >= bytes;
+}
+
+uint8_t MappedNodeFileReadHandle::readByteUnsafe() {
+    // Assumes ensureBytesAvailable(1) returned true.
+    return *m_cursor++;
+}
+
+bool MappedNodeFileReadHandle::readEscapedStream(QByteArray& buffer) {
+    return readEscapedStreamFromSpan(m_cursor, m_end, buffer);
+}
+
+bool MappedNodeFileReadHandle::readRawBytes(QByteArray& buffer, size_t length) {
+    return readRawBytesFromSpan(m_cursor, m_end, buffer, length);
+}
+
+} // namespace io
+} // namespace core
+} // namespace RME
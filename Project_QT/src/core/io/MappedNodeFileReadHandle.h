@@ -0,0 +1,87 @@
+#ifndef RME_MAPPED_NODE_FILE_READ_HANDLE_H
+#define RME_MAPPED_NODE_FILE_READ_HANDLE_H
+
+#include "core/io/NodeFileReadHandle.h"
+#include <QFile>
+#include <QByteArray>
+#include <QString>
+
+namespace RME {
+namespace core {
+namespace io {
+
+/**
+ * @brief Implements NodeFileReadHandle over a memory-mapped OTBM file.
+ *
+ * The whole file is mapped with QFile::map() and node boundaries and escape bytes
+ * are scanned directly in the mapped region. Properties without escaped bytes are
+ * handed to BinaryNode as QByteArray::fromRawData() views, so they are never copied;
+ * only properties containing ESCAPE_CHAR are unescaped into an owned buffer.
+ *
+ * If the file cannot be mapped (e.g. it lives in a Qt resource), its contents are
+ * read into memory once and parsed the same way.
+ *
+ * Node data handed out by this handle is only valid while the handle is alive.
+ */
+class MappedNodeFileReadHandle : public NodeFileReadHandle {
+public:
+    /**
+     * @brief Opens and maps the specified file and consumes the 4-byte OTBM identifier.
+     * @param filePath The path to the OTBM file to be read.
+     */
+    explicit MappedNodeFileReadHandle(const QString& filePath);
+
+    /**
+     * @brief Unmaps and closes the file.
+     */
+    ~MappedNodeFileReadHandle() override;
+
+    MappedNodeFileReadHandle(const MappedNodeFileReadHandle&) = delete;
+    MappedNodeFileReadHandle& operator=(const MappedNodeFileReadHandle&) = delete;
+
+    /**
+     * @brief Gets the current read position.
+     * @return The offset in bytes from the beginning of the file, including the identifier.
+     */
+    size_t tell() const override;
+
+    /**
+     * @brief Checks if the end of the mapped data has been reached.
+     * @return True on EOF or if an error has occurred.
+     */
+    bool isEof() const override;
+
+    /** @brief The whole file, including the 4-byte identifier; valid while the handle is alive. */
+    const uint8_t* data() const override { return m_begin; }
+
+    /** @brief True if the file is accessed through a memory mapping rather than a read fallback. */
+    bool isMapped() const { return m_mapped != nullptr; }
+
+protected:
+    bool ensureBytesAvailable(size_t bytes = 1) override;
+    uint8_t readByteUnsafe() override;
+
+    /**
+     * @brief Scans the mapped region for the property terminator.
+     *
+     * Returns a zero-copy view when the run contains no ESCAPE_CHAR, otherwise an unescaped copy.
+     */
+    bool readEscapedStream(QByteArray& buffer) override;
+
+    /** @brief Returns a zero-copy view of the next 'length' bytes. */
+    bool readRawBytes(QByteArray& buffer, size_t length) override;
+
+private:
+    QFile m_file;
+    uchar* m_mapped = nullptr;   ///< Start of the mapping, or nullptr when using m_fallbackData.
+    QByteArray m_fallbackData;   ///< File contents when the file could not be mapped.
+    const uint8_t* m_begin = nullptr;  ///< Start of the file data.
+    const uint8_t* m_cursor = nullptr; ///< Current read position.
+    const uint8_t* m_end = nullptr;    ///< One past the last byte of the file data.
+};
+
+} // namespace io
+} // namespace core
+} // namespace RME
+
+#endif // RME_MAPPED_NODE_FILE_READ_HANDLE_H
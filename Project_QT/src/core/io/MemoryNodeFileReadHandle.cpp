@@ -78,6 +78,20 @@ uint8_t MemoryNodeFileReadHandle::readByteUnsafe() {
     return m_data[m_currentPosition++];
 }
 
+bool MemoryNodeFileReadHandle::readEscapedStream(QByteArray& buffer) {
+    const uint8_t* cursor = m_data + m_currentPosition;
+    const bool ok = readEscapedStreamFromSpan(cursor, m_data + m_size, buffer);
+    m_currentPosition = static_cast<size_t>(cursor - m_data);
+    return ok;
+}
+
+bool MemoryNodeFileReadHandle::readRawBytes(QByteArray& buffer, size_t length) {
+    const uint8_t* cursor = m_data + m_currentPosition;
+    const bool ok = readRawBytesFromSpan(cursor, m_data + m_size, buffer, length);
+    m_currentPosition = static_cast<size_t>(cursor - m_data);
+    return ok;
+}
+
 } // namespace io
 } // namespace core
 } // namespace RME
@@ -7,6 +7,7 @@ namespace RME {
 namespace core {
 namespace io {
 
+// Node properties may point into the caller's buffer, which must outlive the parsed nodes.
 class MemoryNodeFileReadHandle : public NodeFileReadHandle {
 public:
     MemoryNodeFileReadHandle(const uint8_t* data, size_t size, size_t initialPoolSize = 16);
@@ -16,11 +17,16 @@ public:
 
     size_t tell() const override;
     bool isEof() const override;
+    const uint8_t* data() const override { return m_data; }
 
 protected:
     bool ensureBytesAvailable(size_t bytes = 1) override;
     uint8_t readByteUnsafe() override;
 
+    // Scan the buffer directly; unescaped properties are views into it, not copies
+    bool readEscapedStream(QByteArray& buffer) override;
+    bool readRawBytes(QByteArray& buffer, size_t length) override;
+
 private:
     const uint8_t* m_data;    // Non-owning pointer to the memory buffer
     size_t m_size;            // Total size of the buffer
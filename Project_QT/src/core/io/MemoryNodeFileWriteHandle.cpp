@@ -23,7 +23,11 @@ MemoryNodeFileWriteHandle::MemoryNodeFileWriteHandle(size_t initialBufferSize)
 void MemoryNodeFileWriteHandle::clear() {
     m_buffer.clear();
     m_error = RME_OTBM_IO_NO_ERROR; // Reset error state in the base class
-    // Base class's m_attributeBuffer is handled by its addNode/endNode logic.
+    // Also drop any half-written node chain so the handle can be reused from level 0.
+    m_attributeBuffer.clear();
+    m_openNodes.clear();
+    m_nodeLevel = 0;
+    m_currentNodeCompressProps = false;
 }
 
 // Protected method from NodeFileWriteHandle to be implemented
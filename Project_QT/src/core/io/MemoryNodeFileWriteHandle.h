@@ -2,6 +2,7 @@
 #define RME_MEMORY_NODE_FILE_WRITE_HANDLE_H
 
 #include "core/io/NodeFileWriteHandle.h"
+#include <vector>
 
 namespace RME {
 namespace core {
@@ -16,11 +17,14 @@ public:
     const std::vector<uint8_t>&getBuffer() const { return m_buffer; }
     const uint8_t* getData() const { return m_buffer.data(); }
     size_t getSize() const { return m_buffer.size(); }
+    // Moves the written data out, leaving the handle empty
+    std::vector<uint8_t> takeBuffer() { std::vector<uint8_t> out; out.swap(m_buffer); return out; }
 
     void clear() override;
 
 protected:
-    void writeEscapedBytes(const uint8_t* data, size_t length) override;
+    void writeEscapedBytesInternal(const char* data, qsizetype length) override;
+    void writeRawBytesInternal(const char* data, qsizetype length) override;
 
 private:
     std::vector<uint8_t> m_buffer;
@@ -0,0 +1,391 @@
+#include "core/io/MinimapExporter.h"
+#include "core/map/Map.h"
+#include "core/map/Floor.h"
+#include "core/map/MinimapCache.h"
+#include "core/Tile.h"
+
+#include <zlib.h> // Streaming deflate for the PNG writer
+#include <QColor>
+#include <QDir>
+#include <QFile>
+#include <QFuture>
+#include <QPainter>
+#include <QSet>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <QDebug>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+
+namespace RME {
+namespace core {
+namespace io {
+
+namespace {
+
+// Minimal PNG encoder (8-bit RGBA, non-interlaced) that takes the image a few rows at
+// a time, so the caller never has to hold the whole picture in memory.
+class PngStreamWriter {
+public:
+    ~PngStreamWriter() {
+        if (m_streamInitialized) {
+            deflateEnd(&m_stream);
+        }
+    }
+
+    bool open(const QString& filename, int width, int height) {
+        m_file.setFileName(filename);
+        if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            m_error = QStringLiteral("Cannot open %1 for writing: %2").arg(filename, m_file.errorString());
+            return false;
+        }
+        m_width = width;
+        m_rowBuffer.resize(1 + static_cast<qsizetype>(width) * 4);
+
+        static const char signature[8] = {'\x89', 'P', 'N', 'G', '\r', '\n', '\x1a', '\n'};
+        m_file.write(signature, sizeof(signature));
+
+        QByteArray header;
+        appendU32(header, static_cast<quint32>(width));
+        appendU32(header, static_cast<quint32>(height));
+        header.append(char(8)); // Bit depth
+        header.append(char(6)); // Color type RGBA
+        header.append(char(0)); // Compression
+        header.append(char(0)); // Filter method
+        header.append(char(0)); // No interlace
+        writeChunk("IHDR", header);
+
+        if (deflateInit(&m_stream, Z_DEFAULT_COMPRESSION) != Z_OK) {
+            m_error = QStringLiteral("Failed to initialize deflate stream");
+            return false;
+        }
+        m_streamInitialized = true;
+        return m_file.error() == QFileDevice::NoError;
+    }
+
+    // Rows are tightly packed RGBA, 'width' pixels each
+    bool writeRows(const QImage& band) {
+        for (int y = 0; y < band.height(); ++y) {
+            // Sub filter: flat minimap areas turn into runs of zeros
+            const uchar* row = band.constScanLine(y);
+            uchar* out = reinterpret_cast<uchar*>(m_rowBuffer.data());
+            out[0] = 1;
+            const int rowBytes = m_width * 4;
+            for (int i = 0; i < rowBytes; ++i) {
+                out[1 + i] = static_cast<uchar>(row[i] - (i >= 4 ? row[i - 4] : 0));
+            }
+            if (!deflateData(out, static_cast<uInt>(m_rowBuffer.size()), Z_NO_FLUSH)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool finish() {
+        if (!deflateData(nullptr, 0, Z_FINISH)) {
+            return false;
+        }
+        flushIdat();
+        writeChunk("IEND", QByteArray());
+        m_file.close();
+        if (m_file.error() != QFileDevice::NoError) {
+            m_error = QStringLiteral("Write error: %1").arg(m_file.errorString());
+            return false;
+        }
+        return true;
+    }
+
+    const QString& error() const { return m_error; }
+
+private:
+    static constexpr int IDAT_CHUNK_BYTES = 256 * 1024;
+
+    static void appendU32(QByteArray& out, quint32 value) {
+        out.append(char(value >> 24));
+        out.append(char(value >> 16));
+        out.append(char(value >> 8));
+        out.append(char(value));
+    }
+
+    void writeChunk(const char* type, const QByteArray& data) {
+        QByteArray chunk;
+        chunk.reserve(data.size() + 12);
+        appendU32(chunk, static_cast<quint32>(data.size()));
+        chunk.append(type, 4);
+        chunk.append(data);
+        const uLong crc = crc32(0L, reinterpret_cast<const Bytef*>(chunk.constData() + 4),
+                                static_cast<uInt>(data.size() + 4));
+        appendU32(chunk, static_cast<quint32>(crc));
+        m_file.write(chunk);
+    }
+
+    bool deflateData(const uchar* data, uInt size, int flush) {
+        m_stream.next_in = const_cast<Bytef*>(data);
+        m_stream.avail_in = size;
+        uchar out[64 * 1024];
+        int result = Z_OK;
+        do {
+            m_stream.next_out = out;
+            m_stream.avail_out = sizeof(out);
+            result = deflate(&m_stream, flush);
+            if (result == Z_STREAM_ERROR) {
+                m_error = QStringLiteral("Deflate failed");
+                return false;
+            }
+            m_pending.append(reinterpret_cast<const char*>(out), static_cast<qsizetype>(sizeof(out) - m_stream.avail_out));
+            if (m_pending.size() >= IDAT_CHUNK_BYTES) {
+                flushIdat();
+            }
+        } while (m_stream.avail_out == 0 || (flush == Z_FINISH && result != Z_STREAM_END));
+        return m_file.error() == QFileDevice::NoError;
+    }
+
+    void flushIdat() {
+        if (!m_pending.isEmpty()) {
+            writeChunk("IDAT", m_pending);
+            m_pending.clear();
+        }
+    }
+
+    QFile m_file;
+    z_stream m_stream = {};
+    bool m_streamInitialized = false;
+    int m_width = 0;
+    QByteArray m_rowBuffer;
+    QByteArray m_pending; // Compressed bytes not yet written as an IDAT chunk
+    QString m_error;
+};
+
+} // namespace
+
+MinimapExporter::MinimapExporter(RME::core::Map* map)
+    : m_map(map) {
+}
+
+QColor MinimapExporter::getTileColor(const RME::core::Tile* tile) {
+    if (!tile) {
+        return getVoidColor();
+    }
+    if (tile->getGround()) {
+        return QColor(150, 100, 50); // Brown
+    }
+    if (tile->isBlocking()) {
+        return QColor(100, 100, 100); // Gray
+    }
+    if (!tile->getItems().isEmpty()) {
+        return QColor(50, 100, 150); // Blue
+    }
+    return getVoidColor();
+}
+
+QColor MinimapExporter::getVoidColor() {
+    return QColor(Qt::transparent);
+}
+
+QImage MinimapExporter::renderFloorArea(const QRect& area, int floor) const {
+    QImage image(area.size(), QImage::Format_RGBA8888);
+    if (image.isNull()) {
+        return image;
+    }
+    image.fill(Qt::transparent);
+
+    if (m_minimapCache) {
+        // Copy the cached sector tiles overlapping the area
+        const int span = MinimapCache::tileSpan(0);
+        QPainter painter(&image);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        for (int tileY = area.top() / span; tileY <= area.bottom() / span; ++tileY) {
+            for (int tileX = area.left() / span; tileX <= area.right() / span; ++tileX) {
+                const QImage tile = m_minimapCache->getTile(0, floor, tileX, tileY);
+                if (!tile.isNull()) {
+                    painter.drawImage(QPoint(tileX * span - area.left(), tileY * span - area.top()), tile);
+                }
+            }
+        }
+        return image;
+    }
+
+    // Only populated sectors overlapping the area are visited
+    const RME::core::Map* map = m_map;
+    map->forEachTile(std::function<bool(const Tile&)>([&image, &area](const Tile& tile) {
+        const QColor color = getTileColor(&tile);
+        if (color.alpha() != 0) {
+            const Position& pos = tile.getPosition();
+            image.setPixelColor(pos.x - area.left(), pos.y - area.top(), color);
+        }
+        return true;
+    }), SectorFilter::forArea(area, 1u << floor));
+    return image;
+}
+
+bool MinimapExporter::exportFloorStreaming(const QString& filename, int floor, const QRect& region) {
+    m_lastError.clear();
+    if (!m_map) {
+        m_lastError = QStringLiteral("No map to export");
+        return false;
+    }
+    if (floor < 0 || floor > 15) {
+        m_lastError = QStringLiteral("Invalid floor %1").arg(floor);
+        return false;
+    }
+
+    const QRect area = region.isNull() ? QRect(0, 0, m_map->getWidth(), m_map->getHeight()) : region;
+    if (area.width() <= 0 || area.height() <= 0) {
+        m_lastError = QStringLiteral("Invalid export area %1 x %2").arg(area.width()).arg(area.height());
+        return false;
+    }
+
+    PngStreamWriter writer;
+    if (!writer.open(filename, area.width(), area.height())) {
+        m_lastError = writer.error();
+        return false;
+    }
+
+    // Bands are rendered on the pool and written strictly in order; the FIFO window
+    // bounds how many finished bands can wait for the writer.
+    const int bandRows = static_cast<int>(qBound<qint64>(1, MAX_BAND_BYTES / (static_cast<qint64>(area.width()) * 4),
+                                                         area.height()));
+    const int bandCount = (area.height() + bandRows - 1) / bandRows;
+    const int maxInFlight = qMax(1, QThreadPool::globalInstance()->maxThreadCount() * 2);
+    QList<QFuture<QImage>> inFlight; // FIFO; the head is always the next band to write
+    int nextToSubmit = 0;
+
+    auto drainInFlight = [&inFlight]() {
+        for (QFuture<QImage>& future : inFlight) {
+            future.waitForFinished();
+        }
+    };
+
+    while (nextToSubmit < bandCount || !inFlight.isEmpty()) {
+        while (nextToSubmit < bandCount && inFlight.size() < maxInFlight) {
+            const int top = area.top() + nextToSubmit * bandRows;
+            const QRect band(area.left(), top, area.width(), qMin(bandRows, area.bottom() + 1 - top));
+            ++nextToSubmit;
+            inFlight.append(QtConcurrent::run([this, band, floor]() {
+                return renderFloorArea(band, floor);
+            }));
+        }
+
+        // Waiting on the head runs it on this thread if no worker has picked it up yet
+        const QImage band = inFlight.takeFirst().takeResult();
+        if (band.isNull()) {
+            m_lastError = QStringLiteral("Failed to allocate minimap band");
+            drainInFlight();
+            return false;
+        }
+        if (!writer.writeRows(band)) {
+            m_lastError = writer.error();
+            drainInFlight();
+            return false;
+        }
+    }
+
+    if (!writer.finish()) {
+        m_lastError = writer.error();
+        return false;
+    }
+    return true;
+}
+
+bool MinimapExporter::exportFloorTiles(const QString& directory, int floor, int tileSize, const QRect& region) {
+    m_lastError.clear();
+    if (!m_map) {
+        m_lastError = QStringLiteral("No map to export");
+        return false;
+    }
+    if (floor < 0 || floor > 15 || tileSize <= 0) {
+        m_lastError = QStringLiteral("Invalid floor %1 or tile size %2").arg(floor).arg(tileSize);
+        return false;
+    }
+
+    const QRect area = region.isNull() ? QRect(0, 0, m_map->getWidth(), m_map->getHeight()) : region;
+    if (area.width() <= 0 || area.height() <= 0) {
+        m_lastError = QStringLiteral("Invalid export area %1 x %2").arg(area.width()).arg(area.height());
+        return false;
+    }
+
+    // Level 0: only tiles overlapping a populated sector are rendered
+    QSet<QPoint> tiles;
+    const RME::core::Map* map = m_map;
+    map->forEachFloor(ConstFloorVisitor([&](const Floor&, int sectorX, int sectorY) {
+        const QRect sector = QRect(sectorX, sectorY, SECTOR_WIDTH_TILES, SECTOR_HEIGHT_TILES).intersected(area);
+        for (int ty = (sector.top() - area.top()) / tileSize; ty <= (sector.bottom() - area.top()) / tileSize; ++ty) {
+            for (int tx = (sector.left() - area.left()) / tileSize; tx <= (sector.right() - area.left()) / tileSize; ++tx) {
+                tiles.insert(QPoint(tx, ty));
+            }
+        }
+        return true;
+    }), SectorFilter::forArea(area, 1u << floor));
+
+    std::atomic<bool> failed{false};
+    auto tilePath = [&directory](int level, const QPoint& tile) {
+        return QStringLiteral("%1/%2/%3_%4.png").arg(directory).arg(level).arg(tile.x()).arg(tile.y());
+    };
+
+    int level = 0;
+    int levelWidth = (area.width() + tileSize - 1) / tileSize;
+    int levelHeight = (area.height() + tileSize - 1) / tileSize;
+    while (true) {
+        if (!QDir().mkpath(QStringLiteral("%1/%2").arg(directory).arg(level))) {
+            m_lastError = QStringLiteral("Cannot create directory %1/%2").arg(directory).arg(level);
+            return false;
+        }
+
+        const QList<QPoint> levelTiles = tiles.values();
+        QtConcurrent::blockingMap(levelTiles, [&, level](const QPoint& tile) {
+            if (failed.load()) {
+                return;
+            }
+            QImage image;
+            if (level == 0) {
+                const QRect tileArea = QRect(area.left() + tile.x() * tileSize, area.top() + tile.y() * tileSize,
+                                             tileSize, tileSize).intersected(area);
+                image = renderFloorArea(tileArea, floor);
+            } else {
+                // Each tile halves the 2x2 block of tiles below it
+                QImage block(tileSize * 2, tileSize * 2, QImage::Format_RGBA8888);
+                block.fill(Qt::transparent);
+                for (int dy = 0; dy < 2; ++dy) {
+                    for (int dx = 0; dx < 2; ++dx) {
+                        const QImage child(tilePath(level - 1, QPoint(tile.x() * 2 + dx, tile.y() * 2 + dy)));
+                        if (child.isNull()) {
+                            continue; // Empty child, never written
+                        }
+                        const QImage converted = child.convertToFormat(QImage::Format_RGBA8888);
+                        for (int y = 0; y < converted.height(); ++y) {
+                            std::copy_n(converted.constScanLine(y), converted.width() * 4,
+                                        block.scanLine(dy * tileSize + y) + dx * tileSize * 4);
+                        }
+                    }
+                }
+                image = block.scaled(tileSize, tileSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+            }
+            if (image.isNull() || !image.save(tilePath(level, tile), "PNG")) {
+                failed.store(true);
+            }
+        });
+        if (failed.load()) {
+            m_lastError = QStringLiteral("Failed to write minimap tiles for level %1").arg(level);
+            return false;
+        }
+
+        if (levelWidth <= 1 && levelHeight <= 1) {
+            break;
+        }
+
+        QSet<QPoint> parents;
+        for (const QPoint& tile : tiles) {
+            parents.insert(QPoint(tile.x() / 2, tile.y() / 2));
+        }
+        tiles = parents;
+        levelWidth = (levelWidth + 1) / 2;
+        levelHeight = (levelHeight + 1) / 2;
+        ++level;
+    }
+    return true;
+}
+
+} // namespace io
+} // namespace core
+} // namespace RME
@@ -8,6 +8,7 @@
 
 // Forward declarations
 namespace RME {
+    class MinimapCache;
 namespace core {
     class Map;
     class Tile;
@@ -25,6 +26,11 @@ namespace io {
  * This class handles the export of map data to minimap format images.
  * It supports exporting entire maps, specific floors, or selected regions
  * as minimap images that can be used by Tibia clients or other tools.
+ *
+ * The streaming exports never hold the whole image: exportFloorStreaming()
+ * renders horizontal bands in parallel from the populated sectors and
+ * deflates them into the PNG in order, and exportFloorTiles() writes a pyramid
+ * of fixed-size tiles. Memory stays bounded for maps of any size.
  */
 class MinimapExporter {
 public:
@@ -48,6 +54,16 @@ public:
     bool exportRegion(const QString& filename, const QRect& region, const ExportOptions& options = ExportOptions());
     bool exportSelection(const QString& filename, RME::core::selection::SelectionManager* selectionManager, const ExportOptions& options = ExportOptions());
 
+    // Streaming export, one pixel per tile. A null region exports the whole map.
+    bool exportFloorStreaming(const QString& filename, int floor, const QRect& region = QRect());
+    // Writes <directory>/<level>/<x>_<y>.png; level 0 is one pixel per tile, each further
+    // level halves the resolution until a single tile covers the region. Empty tiles are skipped.
+    bool exportFloorTiles(const QString& directory, int floor, int tileSize = 256, const QRect& region = QRect());
+    const QString& getLastError() const { return m_lastError; }
+
+    // Render from (and fill) a shared minimap cache of the same map instead of the tiles
+    void setMinimapCache(RME::MinimapCache* cache) { m_minimapCache = cache; }
+
     // Image generation
     QImage generateMapImage(const ExportOptions& options = ExportOptions());
     QImage generateFloorImage(int floor, const ExportOptions& options = ExportOptions());
@@ -66,6 +82,10 @@ public:
 
 private:
     RME::core::Map* m_map;
+    RME::MinimapCache* m_minimapCache = nullptr;
+    QString m_lastError;
+
+    static constexpr qint64 MAX_BAND_BYTES = 4 * 1024 * 1024; // Pixel budget of one streamed band
 
     // Helper methods
     QImage createBaseImage(const QRect& region, int scale) const;
@@ -75,6 +95,8 @@ private:
     void renderHouses(QImage& image, const QRect& region, int scale) const;
     void renderWaypoints(QImage& image, const QRect& region, int scale) const;
     
+    QImage renderFloorArea(const QRect& area, int floor) const;
+
     QRect calculateRegion(const ExportOptions& options) const;
     QString generateFilename(const QString& baseFilename, int floor) const;
 };
@@ -4,6 +4,7 @@
 #include <QtZlib/qtzlib.h> // For qUncompress
 #include <QtEndian>    // For qFromLittleEndian
 #include <QDebug>      // For warnings
+#include <utility>     // For std::move
 
 namespace RME {
 namespace core {
@@ -11,8 +12,8 @@ namespace io {
 
 NodeFileReadHandle::NodeFileReadHandle(size_t initialPoolSize) :
     m_error(RME_OTBM_IO_NO_ERROR),
-    m_rootNode(nullptr),
-    m_lastByteWasStart(false) // Initial state: not expecting a node type immediately
+    m_lastByteWasStart(false), // Initial state: not expecting a node type immediately
+    m_rootNode(nullptr)
 {
     m_nodePool.reserve(initialPoolSize);
 }
@@ -129,6 +130,20 @@ bool NodeFileReadHandle::readEscapedStream(QByteArray& buffer) {
     return false;
 }
 
+bool NodeFileReadHandle::readRawBytes(QByteArray& buffer, size_t length) {
+    if (m_error != RME_OTBM_IO_NO_ERROR) return false;
+    if (!ensureBytesAvailable(length)) {
+        m_error = RME_OTBM_IO_ERROR_UNEXPECTED_EOF;
+        return false;
+    }
+    buffer.resize(static_cast<qsizetype>(length));
+    for (size_t i = 0; i < length; ++i) {
+        buffer[static_cast<qsizetype>(i)] = static_cast<char>(readByteUnsafe());
+        if (m_error != RME_OTBM_IO_NO_ERROR) return false;
+    }
+    return true;
+}
+
 BinaryNode* NodeFileReadHandle::readNextNodeInternal(BinaryNode* parentNode) {
     if (m_error != RME_OTBM_IO_NO_ERROR) return nullptr;
 
@@ -163,89 +178,135 @@ BinaryNode* NodeFileReadHandle::readNextNodeInternal(BinaryNode* parentNode) {
 
     // 1. Read Node Type (U8)
     if (!ensureBytesAvailable(1)) { m_error = RME_OTBM_IO_ERROR_UNEXPECTED_EOF; return nullptr; }
+    const size_t nodeStart = tell() - 1; // The NODE_START just before the type byte
     uint8_t nodeType = readByteUnsafe();
     if (m_error != RME_OTBM_IO_NO_ERROR) return nullptr;
 
     BinaryNode* newNode = createNode(parentNode);
     newNode->setType(nodeType);
+    newNode->m_streamOffset = nodeStart;
+
+    // 2./3. Flags and properties, followed by the next marker.
+    QByteArray propsData;
+    if (!readNodeProperties(propsData, true)) {
+        return nullptr; // m_error is set by readNodeProperties
+    }
+    newNode->setProperties(std::move(propsData));
 
+    // Node is fully read (type, flags, properties). The m_lastByteWasStart is now set based on
+    // the terminator of the properties (if uncompressed) or the explicit marker after compressed data.
+    // This state will be used by the next call to readNextNodeInternal or by parent's getChild loop.
+    return newNode;
+}
+
+bool NodeFileReadHandle::readNodeProperties(QByteArray& propsData, bool decompress) {
     // 2. Read Node Flags (U8) - This is specific to OTBM v2+ like formats.
     // The original wxOTBM code might have this integrated differently or for specific node types.
     // For a generic NodeFileReadHandle, this might be optional or part of properties.
     // Assuming OTBM v2+ structure for now based on rework proposal.
-    if (!ensureBytesAvailable(1)) { m_error = RME_OTBM_IO_ERROR_UNEXPECTED_EOF; return nullptr; }
+    if (!ensureBytesAvailable(1)) { m_error = RME_OTBM_IO_ERROR_UNEXPECTED_EOF; return false; }
     uint8_t nodeFlags = readByteUnsafe(); // Assuming flags always present after type
-    if (m_error != RME_OTBM_IO_NO_ERROR) return nullptr;
+    if (m_error != RME_OTBM_IO_NO_ERROR) return false;
 
     // 3. Read Properties
-    QByteArray propsData;
+    propsData.clear();
     if (nodeFlags & OTBM_FLAG_COMPRESSION) {
         if (!ensureBytesAvailable(8)) { // CompressedLen (U32) + DecompressedLen (U32)
             m_error = RME_OTBM_IO_ERROR_UNEXPECTED_EOF;
-            return nullptr;
+            return false;
         }
         uint32_t compressedLength = readU32Unsafe();
-        if (m_error != RME_OTBM_IO_NO_ERROR) return nullptr;
+        if (m_error != RME_OTBM_IO_NO_ERROR) return false;
         uint32_t decompressedLength = readU32Unsafe();
-        if (m_error != RME_OTBM_IO_NO_ERROR) return nullptr;
+        if (m_error != RME_OTBM_IO_NO_ERROR) return false;
 
         if (compressedLength == 0 && decompressedLength == 0) {
             // Valid case: empty compressed properties
             propsData.clear();
         } else if (compressedLength > 0 && decompressedLength > 0) {
-            if (!ensureBytesAvailable(compressedLength)) {
-                m_error = RME_OTBM_IO_ERROR_UNEXPECTED_EOF;
-                return nullptr;
-            }
-            QByteArray compressedBuffer(compressedLength, Qt::Uninitialized);
-            for (uint32_t i = 0; i < compressedLength; ++i) {
-                compressedBuffer[i] = static_cast<char>(readByteUnsafe());
-                if (m_error != RME_OTBM_IO_NO_ERROR) return nullptr;
+            QByteArray compressedBuffer;
+            if (!readRawBytes(compressedBuffer, compressedLength)) {
+                return false; // m_error is set by readRawBytes
             }
-            propsData = qUncompress(compressedBuffer);
-            if (propsData.isEmpty() && compressedLength > 0) { // qUncompress returns empty on error
-                m_error = RME_OTBM_IO_ERROR_DECOMPRESSION;
-                qWarning("NodeFileReadHandle: qUncompress failed.");
-                return nullptr;
-            }
-            if (static_cast<uint32_t>(propsData.size()) != decompressedLength) {
-                m_error = RME_OTBM_IO_ERROR_DECOMPRESSION; // Decompressed size mismatch
-                qWarning() << "NodeFileReadHandle: Decompressed size mismatch. Expected:" << decompressedLength << "Got:" << propsData.size();
-                return nullptr;
+            if (decompress) {
+                propsData = qUncompress(compressedBuffer);
+                if (propsData.isEmpty() && compressedLength > 0) { // qUncompress returns empty on error
+                    m_error = RME_OTBM_IO_ERROR_DECOMPRESSION;
+                    qWarning("NodeFileReadHandle: qUncompress failed.");
+                    return false;
+                }
+                if (static_cast<uint32_t>(propsData.size()) != decompressedLength) {
+                    m_error = RME_OTBM_IO_ERROR_DECOMPRESSION; // Decompressed size mismatch
+                    qWarning() << "NodeFileReadHandle: Decompressed size mismatch. Expected:" << decompressedLength << "Got:" << propsData.size();
+                    return false;
+                }
             }
         } else {
              m_error = RME_OTBM_IO_ERROR_SYNTAX; // Invalid combination of lengths
              qWarning() << "NodeFileReadHandle: Invalid compressed/decompressed length combination.";
-             return nullptr;
+             return false;
         }
         // After compressed properties, the next byte is a marker (NODE_START or NODE_END)
         // This marker needs to be read to set m_lastByteWasStart correctly for the next iteration.
         if (!ensureBytesAvailable(1)) {
             m_error = RME_OTBM_IO_ERROR_UNEXPECTED_EOF;
-            return nullptr;
+            return false;
         }
         uint8_t postCompressionMarker = readByteUnsafe();
-        if (m_error != RME_OTBM_IO_NO_ERROR) return nullptr;
+        if (m_error != RME_OTBM_IO_NO_ERROR) return false;
         if (postCompressionMarker == NODE_START) m_lastByteWasStart = true;
         else if (postCompressionMarker == NODE_END) m_lastByteWasStart = false;
-        else { m_error = RME_OTBM_IO_ERROR_SYNTAX; return nullptr; }
+        else { m_error = RME_OTBM_IO_ERROR_SYNTAX; return false; }
 
     } else {
         // Not compressed: properties are an escaped stream terminated by NODE_START or NODE_END.
         // readEscapedStream will consume the terminator and set m_lastByteWasStart.
         if (!readEscapedStream(propsData)) {
             // m_error is set by readEscapedStream on failure
-            return nullptr;
+            return false;
         }
     }
-    newNode->setProperties(propsData);
-
-    // Node is fully read (type, flags, properties). The m_lastByteWasStart is now set based on
-    // the terminator of the properties (if uncompressed) or the explicit marker after compressed data.
-    // This state will be used by the next call to readNextNodeInternal or by parent's getChild loop.
-    return newNode;
+    return true;
 }
 
+bool NodeFileReadHandle::skipNode(BinaryNode* node) {
+    if (m_error != RME_OTBM_IO_NO_ERROR || !node) return false;
+
+    // Properties ending in NODE_END mean the node had no children and is already closed.
+    if (!m_lastByteWasStart) return true;
+
+    // 'openNodes' counts nodes whose NODE_END has not been seen yet, starting with 'node' itself.
+    // 'headerPending' is set while a consumed NODE_START still awaits its node's type byte.
+    int openNodes = 1;
+    bool headerPending = true;
+    QByteArray ignoredProps;
+    while (openNodes > 0) {
+        if (!ensureBytesAvailable(1)) {
+            m_error = RME_OTBM_IO_ERROR_UNEXPECTED_EOF;
+            return false;
+        }
+        uint8_t byte = readByteUnsafe();
+        if (m_error != RME_OTBM_IO_NO_ERROR) return false;
+
+        if (headerPending) {
+            // 'byte' is a child's type; its properties end with the next marker.
+            ++openNodes;
+            if (!readNodeProperties(ignoredProps, false)) return false;
+            headerPending = m_lastByteWasStart;
+            if (!headerPending) --openNodes; // Child closed immediately (no grandchildren)
+        } else if (byte == NODE_START) {
+            headerPending = true;
+        } else if (byte == NODE_END) {
+            --openNodes;
+        } else {
+            m_error = RME_OTBM_IO_ERROR_SYNTAX;
+            qWarning() << "NodeFileReadHandle::skipNode: Expected NODE_START or NODE_END, got" << Qt::hex << byte;
+            return false;
+        }
+    }
+    m_lastByteWasStart = false;
+    return true;
+}
 
 BinaryNode* NodeFileReadHandle::readNextNode(BinaryNode* parentNode, BinaryNode* previousSiblingNode) {
     if (m_error != RME_OTBM_IO_NO_ERROR) return nullptr;
@@ -279,6 +340,63 @@ BinaryNode* NodeFileReadHandle::readNextNode(BinaryNode* parentNode, BinaryNode*
     return readNextNodeInternal(parentNode);
 }
 
+bool NodeFileReadHandle::readEscapedStreamFromSpan(const uint8_t*& cursor, const uint8_t* end, QByteArray& buffer) {
+    buffer.clear();
+    if (m_error != RME_OTBM_IO_NO_ERROR) return false;
+
+    const uint8_t* runStart = cursor;
+    const uint8_t* p = cursor;
+    while (p < end && *p != NODE_START && *p != NODE_END && *p != ESCAPE_CHAR) {
+        ++p;
+    }
+    if (p == end) {
+        cursor = end;
+        m_error = RME_OTBM_IO_ERROR_UNEXPECTED_EOF;
+        return false;
+    }
+
+    if (*p != ESCAPE_CHAR) {
+        // Common case: nothing to unescape, hand out a view of the span.
+        buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(runStart), p - runStart);
+        m_lastByteWasStart = (*p == NODE_START);
+        cursor = p + 1;
+        return true;
+    }
+
+    // Escaped bytes present: copy the clean prefix, then unescape the rest of the run.
+    buffer.append(reinterpret_cast<const char*>(runStart), p - runStart);
+    while (p < end) {
+        uint8_t byte = *p++;
+        if (byte == NODE_START || byte == NODE_END) {
+            m_lastByteWasStart = (byte == NODE_START);
+            cursor = p;
+            return true;
+        }
+        if (byte == ESCAPE_CHAR) {
+            if (p == end) {
+                break;
+            }
+            byte = *p++;
+        }
+        buffer.append(static_cast<char>(byte));
+    }
+
+    cursor = end;
+    m_error = RME_OTBM_IO_ERROR_UNEXPECTED_EOF;
+    return false;
+}
+
+bool NodeFileReadHandle::readRawBytesFromSpan(const uint8_t*& cursor, const uint8_t* end, QByteArray& buffer, size_t length) {
+    if (m_error != RME_OTBM_IO_NO_ERROR) return false;
+    if (static_cast<size_t>(end - cursor) < length) {
+        m_error = RME_OTBM_IO_ERROR_UNEXPECTED_EOF;
+        return false;
+    }
+    buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(cursor), static_cast<qsizetype>(length));
+    cursor += length;
+    return true;
+}
+
 } // namespace io
 } // namespace core
 } // namespace RME
@@ -30,6 +30,11 @@ public:
     // The handle is responsible for managing the lifecycle of the returned BinaryNode.
     BinaryNode* readNextNode(BinaryNode* parentNode, BinaryNode* previousSibling = nullptr);
 
+    // Skips the remaining (unread) children of 'node', which must be the node most recently
+    // returned by readNextNode. Afterwards the stream is positioned just past the node's NODE_END,
+    // so the node's complete encoding is [node->getStreamOffset(), tell()).
+    bool skipNode(BinaryNode* node);
+
     // Called by BinaryNode's destructor or when a node is no longer needed
     void recycleNode(BinaryNode* node);
 
@@ -41,6 +46,10 @@ public:
     virtual size_t tell() const = 0; // Current read position in the underlying stream/buffer
     virtual bool isEof() const = 0;  // True if no more data can be read from source
 
+    // Direct access to the underlying bytes, indexed like tell(); nullptr if the handle
+    // only supports streaming access.
+    virtual const uint8_t* data() const { return nullptr; }
+
 protected:
     BinaryNode* createNode(BinaryNode* parentNode); // Gets a node from the pool or creates one
 
@@ -48,18 +57,39 @@ protected:
     virtual bool ensureBytesAvailable(size_t bytes = 1) = 0; // Ensure at least 'bytes' are in cache or readable
     virtual uint8_t readByteUnsafe() = 0; // Reads a byte, assumes ensureBytesAvailable was called
 
+    // Bulk reads used while parsing node properties. The defaults go through readByteUnsafe();
+    // handles with direct access to the underlying bytes override them to avoid per-byte calls.
+    // Reads an escaped stream up to the next NODE_START/NODE_END, consuming the marker.
+    virtual bool readEscapedStream(QByteArray& buffer);
+    // Reads 'length' unescaped bytes verbatim.
+    virtual bool readRawBytes(QByteArray& buffer, size_t length);
+
+    // Implementations of the bulk reads for handles that hold the whole stream in memory.
+    // 'cursor' is advanced past the consumed bytes; runs without escapes are returned as
+    // zero-copy views into [cursor, end), so they stay valid only as long as that memory.
+    bool readEscapedStreamFromSpan(const uint8_t*& cursor, const uint8_t* end, QByteArray& buffer);
+    bool readRawBytesFromSpan(const uint8_t*& cursor, const uint8_t* end, QByteArray& buffer, size_t length);
+
+    uint16_t readU16Unsafe();
+    uint32_t readU32Unsafe();
+
     // Error codes (simple for now, can be an enum)
     // 0: No error
     // 1: EOF unexpected
     // 2: Syntax error (e.g. bad node sequence)
     int m_error;
+    bool m_lastByteWasStart; // State for parsing node structure
 
 private:
+    BinaryNode* readNextNodeInternal(BinaryNode* parentNode);
+    // Reads a node's flags and properties (the part after its type byte) and the marker that
+    // follows them. Compressed properties are only inflated if 'decompress' is set.
+    bool readNodeProperties(QByteArray& propsData, bool decompress);
+
     std::vector<std::unique_ptr<BinaryNode>> m_nodePool; // Owns all nodes
     std::stack<BinaryNode*> m_recycledNodes;             // Pool of recycled nodes
 
     BinaryNode* m_rootNode;
-    bool m_lastByteWasStart; // State for parsing node structure
 };
 
 } // namespace io
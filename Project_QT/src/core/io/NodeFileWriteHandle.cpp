@@ -19,6 +19,9 @@ NodeFileWriteHandle::NodeFileWriteHandle() :
 bool NodeFileWriteHandle::addNode(uint8_t nodeType, bool compressProperties) {
     if (m_error != RME_OTBM_IO_NO_ERROR) return false;
 
+    // The parent's attributes must be in the stream before its first child.
+    if (m_nodeLevel > 0 && !writePendingAttributes()) return false;
+
     char node_start_char = static_cast<char>(NODE_START);
     // NODE_START itself is a special marker. The original wxWidgets FileHandle::writeBytes
     // would escape it if it matched NODE_START, NODE_END, or ESCAPE_CHAR.
@@ -38,10 +41,25 @@ bool NodeFileWriteHandle::addNode(uint8_t nodeType, bool compressProperties) {
 
     m_attributeBuffer.clear();
     m_currentNodeCompressProps = compressProperties;
+    m_openNodes.push_back(OpenNodeState{compressProperties, false});
     m_nodeLevel++;
     return true;
 }
 
+bool NodeFileWriteHandle::addEncodedNodes(const char* data, qsizetype length) {
+    if (m_error != RME_OTBM_IO_NO_ERROR) return false;
+    if (m_nodeLevel == 0) { // Encoded children need an enclosing node
+        m_error = RME_OTBM_IO_ERROR_SYNTAX;
+        qWarning("NodeFileWriteHandle::addEncodedNodes: Attempted to add nodes outside a node.");
+        return false;
+    }
+    if (!writePendingAttributes()) return false;
+
+    // Already escaped and delimited by the producing handle; copy verbatim.
+    writeRawBytesInternal(data, length);
+    return m_error == RME_OTBM_IO_NO_ERROR;
+}
+
 bool NodeFileWriteHandle::addNodeData(const QByteArray& data) {
     if (m_error != RME_OTBM_IO_NO_ERROR) return false;
     if (m_nodeLevel == 0) { // Cannot add node data outside a node
@@ -62,7 +80,29 @@ bool NodeFileWriteHandle::endNode() {
         return false;
     }
 
-    if (m_currentNodeCompressProps) {
+    if (!writePendingAttributes()) return false;
+
+    char node_end_char = static_cast<char>(NODE_END);
+    // NODE_END itself is a special marker and should be escaped if it were part of general data.
+    // However, as a structural token, it's written raw by some OTBM parsers/writers.
+    // Given addNode writes NODE_START escaped, for symmetry and caution:
+    writeEscapedBytesInternal(&node_end_char, 1);
+    // If strict OTBM requires raw NODE_END, this would be writeRawByteUnsafe(NODE_END);
+
+    m_openNodes.pop_back();
+    m_nodeLevel--;
+    m_currentNodeCompressProps = !m_openNodes.empty() && m_openNodes.back().compressProps;
+    return m_error == RME_OTBM_IO_NO_ERROR;
+}
+
+bool NodeFileWriteHandle::writePendingAttributes() {
+    if (m_error != RME_OTBM_IO_NO_ERROR) return false;
+    if (m_openNodes.empty() || m_openNodes.back().attributesWritten) {
+        return true;
+    }
+    m_openNodes.back().attributesWritten = true;
+
+    if (m_openNodes.back().compressProps) {
         if (m_attributeBuffer.isEmpty()) {
             writeU32RawUnsafe(0); // Compressed length
             if (m_error != RME_OTBM_IO_NO_ERROR) return false;
@@ -72,7 +112,7 @@ bool NodeFileWriteHandle::endNode() {
             QByteArray compressedAttributes = qCompress(m_attributeBuffer, -1); // Default Qt Zlib compression level
             if (compressedAttributes.isEmpty() && !m_attributeBuffer.isEmpty()) {
                 m_error = RME_OTBM_IO_ERROR_DECOMPRESSION; // Using this for compression error too
-                qWarning("NodeFileWriteHandle::endNode: qCompress failed.");
+                qWarning("NodeFileWriteHandle::writePendingAttributes: qCompress failed.");
                 return false;
             }
             writeU32RawUnsafe(static_cast<quint32>(compressedAttributes.size()));
@@ -86,35 +126,17 @@ bool NodeFileWriteHandle::endNode() {
         }
     } else {
         // For uncompressed properties, the OTBM format expects the raw properties data
-        // to be written directly, followed by a NODE_END marker.
-        // The properties themselves are escaped.
-        // The length of the properties is NOT written before the data in this case for uncompressed.
+        // to be written directly (escaped), before any child node and the NODE_END marker.
+        // The length of the properties is NOT written before the data in this case.
         // The original wxWidgets RME code for uncompressed properties:
-        //   writeByte(NODE_START); writeByte(type); write_properties(); writeByte(NODE_END);
-        // And `write_properties` would call `write_attributes_otbm` which does:
-        //   for each attribute: writeByte(key); write_attribute_value(value);
-        //   (attribute values like strings have their own length prefixes)
-        // Then, crucially, the uncompressed properties stream is terminated by NODE_END.
-        // The `writeEscapedBytesInternal` function handles escaping.
-
-        // The current structure with m_attributeBuffer accumulates all properties.
-        // This buffer needs to be written escaped.
+        //   writeByte(NODE_START); writeByte(type); write_properties(); [children...] writeByte(NODE_END);
         if (!m_attributeBuffer.isEmpty()) {
             writeEscapedBytesInternal(m_attributeBuffer.constData(), m_attributeBuffer.size());
             if (m_error != RME_OTBM_IO_NO_ERROR) return false;
         }
     }
     m_attributeBuffer.clear();
-
-    char node_end_char = static_cast<char>(NODE_END);
-    // NODE_END itself is a special marker and should be escaped if it were part of general data.
-    // However, as a structural token, it's written raw by some OTBM parsers/writers.
-    // Given addNode writes NODE_START escaped, for symmetry and caution:
-    writeEscapedBytesInternal(&node_end_char, 1);
-    // If strict OTBM requires raw NODE_END, this would be writeRawByteUnsafe(NODE_END);
-
-    m_nodeLevel--;
-    return m_error == RME_OTBM_IO_NO_ERROR;
+    return true;
 }
 
 // --- Attribute Writing Methods (appends to internal m_attributeBuffer) ---
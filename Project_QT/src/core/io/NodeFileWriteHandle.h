@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <QByteArray> // For m_attributeBuffer
 #include <QtGlobal>   // For quint16, quint32
+#include <vector>
 
 // Forward include otbm_constants.h for NODE_START etc.
 #include "core/io/otbm_constants.h"
@@ -57,6 +58,17 @@ public:
      */
     bool endNode();
 
+    /**
+     * @brief Appends one or more complete, already-encoded nodes as children of the current node.
+     * The data must be a node stream produced by another NodeFileWriteHandle (e.g. a
+     * MemoryNodeFileWriteHandle that started at nesting level 0), so it is written verbatim.
+     * Pending attributes of the current node are written first, exactly as addNode() would.
+     * @param data Pointer to the encoded node bytes.
+     * @param length Number of bytes.
+     * @return True on success, false on error.
+     */
+    bool addEncodedNodes(const char* data, qsizetype length);
+
     // --- Attribute Writing Methods (appends to internal m_attributeBuffer) ---
     bool addU8(uint8_t value);
     bool addByte(uint8_t value) { return addU8(value); } // Alias
@@ -100,10 +112,24 @@ protected:
     template <typename T>
     void appendToAttributeBuffer(const T& value); // For numeric types, ensures little-endian.
 
+    /**
+     * @brief Writes the current node's buffered attributes, if not written yet.
+     * Called before the node's first child and at endNode(), so attributes always
+     * precede children in the stream.
+     */
+    bool writePendingAttributes();
+
+    /// Per-node state for the open node chain (innermost node last).
+    struct OpenNodeState {
+        bool compressProps = false;   ///< Attributes of this node are ZLib compressed.
+        bool attributesWritten = false; ///< Attributes already emitted (node has children).
+    };
+
     int m_error;                      ///< Current error state. RME_OTBM_IO_NO_ERROR if OK.
     QByteArray m_attributeBuffer;     ///< Buffer for accumulating attributes of the current node.
     bool m_currentNodeCompressProps;  ///< Flag if current node's attributes should be compressed.
     int m_nodeLevel;                  ///< Current nesting level of nodes.
+    std::vector<OpenNodeState> m_openNodes; ///< One entry per open node; size() == m_nodeLevel.
 };
 
 } // namespace io
@@ -1,10 +1,13 @@
 #include "core/io/OtbmMapIO.h"
-#include "core/io/DiskNodeFileReadHandle.h"
+#include "core/io/MappedNodeFileReadHandle.h"
 #include "core/io/DiskNodeFileWriteHandle.h"
+#include "core/io/MemoryNodeFileReadHandle.h"
+#include "core/io/MemoryNodeFileWriteHandle.h"
 #include "core/io/BinaryNode.h"
 #include "core/io/otbm_constants.h"
 
 #include "core/Map.h" // Full definition
+#include "core/map/Floor.h"
 #include "core/Tile.h"
 #include "core/Item.h" // Full definition
 #include "core/Position.h"
@@ -23,6 +26,11 @@
 #include <QFile>         // For checking file existence etc.
 #include <QDataStream>   // For writing node data for area/tile coordinates
 #include <QDebug>        // For logging errors and warnings
+#include <QMap>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <algorithm>     // For std::all_of, std::any_of
+#include <atomic>
 
 // QtZlib for qUncompress/qCompress is handled by NodeFileRead/WriteHandle now
 
@@ -47,11 +55,18 @@ QString OtbmMapIO::getFormatName() const {
 }
 
 // --- Loading Implementation ---
+OtbmMapIO::TileCodecSettings OtbmMapIO::TileCodecSettings::fromSettings(AppSettings& settings) {
+    TileCodecSettings codec;
+    codec.skipUnknownItems = settings.getValue(RME::core::settings::Config::Key::SKIP_UNKNOWN_ITEMS, QVariant(true)).toBool();
+    return codec;
+}
+
 bool OtbmMapIO::loadMap(const QString& filePath, Map& map, AssetManager& assetManager, AppSettings& settings) {
     m_lastError.clear();
     map.setChanged(false); // Reset changed status on new load attempt
 
-    DiskNodeFileReadHandle readHandle(filePath);
+    // Node properties read from this handle may reference its mapping; it outlives all parsing below.
+    MappedNodeFileReadHandle readHandle(filePath);
 
     if (!readHandle.isOk()) {
         m_lastError = QString("Failed to open or read initial part of map file: %1. Error code: %2 (%3)")
@@ -85,7 +100,7 @@ bool OtbmMapIO::loadMap(const QString& filePath, Map& map, AssetManager& assetMa
         return false;
     }
 
-    if (!parseMapDataNode(mapDataNode, map, assetManager, settings)) { // Pass assetManager
+    if (!parseMapDataNode(readHandle, mapDataNode, map, assetManager, settings)) { // Pass assetManager
         // m_lastError would be set by parseMapDataNode
         return false;
     }
@@ -102,7 +117,7 @@ bool OtbmMapIO::loadMap(const QString& filePath, Map& map, AssetManager& assetMa
 }
 
 // --- Creature Specific Parsing/Serialization ---
-bool OtbmMapIO::parseCreatureNode(BinaryNode* creatureNode, Tile* tile, AssetManager& assetManager, AppSettings& settings) {
+bool OtbmMapIO::parseCreatureNode(BinaryNode* creatureNode, Tile* tile, AssetManager& assetManager, const TileCodecSettings& codec) {
     if (!tile) {
         m_lastError = "parseCreatureNode: Called with null tile.";
         qWarning() << "OtbmMapIO::parseCreatureNode:" << m_lastError;
@@ -130,7 +145,7 @@ bool OtbmMapIO::parseCreatureNode(BinaryNode* creatureNode, Tile* tile, AssetMan
 
     if (!creatureData) {
         QString msg = QString("Creature type '%1' not found in AssetManager. Tile: %2").arg(creatureName).arg(tile->getPosition().toString());
-        bool skipUnknown = settings.getValue(RME::core::settings::Config::Key::SKIP_UNKNOWN_ITEMS, QVariant(true)).toBool();
+        bool skipUnknown = codec.skipUnknownItems;
         if (skipUnknown) {
             qWarning() << "OtbmMapIO::parseCreatureNode:" << msg << "Skipping creature.";
             while(creatureNode->hasMoreProperties()){
@@ -191,7 +206,7 @@ bool OtbmMapIO::parseCreatureNode(BinaryNode* creatureNode, Tile* tile, AssetMan
     return true;
 }
 
-bool OtbmMapIO::serializeCreatureNode(NodeFileWriteHandle& writer, const RME::core::creatures::Creature* creature, AssetManager& assetManager, AppSettings& settings) {
+bool OtbmMapIO::serializeCreatureNode(NodeFileWriteHandle& writer, const RME::core::creatures::Creature* creature, AssetManager& assetManager, const TileCodecSettings& codec) {
     if (!creature || !creature->getType()) {
         m_lastError = "serializeCreatureNode: Null creature or creature type.";
         qWarning() << m_lastError;
@@ -252,7 +267,7 @@ bool OtbmMapIO::serializeCreatureNode(NodeFileWriteHandle& writer, const RME::co
 }
 
 // Corrected signature to include AssetManager
-bool OtbmMapIO::parseMapDataNode(BinaryNode* mapDataNode, Map& map, AssetManager& assetManager, AppSettings& settings) {
+bool OtbmMapIO::parseMapDataNode(NodeFileReadHandle& readHandle, BinaryNode* mapDataNode, Map& map, AssetManager& assetManager, AppSettings& settings) {
     mapDataNode->resetReadOffset();
 
     RME::core::ClientVersionInfo clientVersionInfo; // Initialize struct to hold version info
@@ -333,33 +348,178 @@ bool OtbmMapIO::parseMapDataNode(BinaryNode* mapDataNode, Map& map, AssetManager
     map.setClientVersionInfo(clientVersionInfo); // Set the parsed version info on the map object
 
     // Parse child nodes of MAP_DATA (Tile Areas, Towns, Waypoints)
+    return parseMapDataChildren(readHandle, mapDataNode, map, assetManager, settings);
+}
+
+bool OtbmMapIO::parseMapDataChildren(NodeFileReadHandle& readHandle, BinaryNode* mapDataNode, Map& map,
+                                     AssetManager& assetManager, AppSettings& settings) {
+    const uint8_t* streamData = readHandle.data();
+    const TileCodecSettings codec = TileCodecSettings::fromSettings(settings);
+    const TileResolver mapTiles = [&map](const Position& pos) {
+        bool created = false;
+        return map.getOrCreateTile(pos, created);
+    };
+
+    struct PendingTileArea {
+        QFuture<LoadedTileArea> future;
+        const uint8_t* data;
+        size_t length;
+    };
+    const int maxInFlight = qMax(1, QThreadPool::globalInstance()->maxThreadCount() * 2);
+    QList<PendingTileArea> inFlight; // FIFO in stream order; the head is always the next area to graft
+
+    auto drainInFlight = [&inFlight]() {
+        // Workers reference the mapped file and the map; they must finish before we return.
+        for (PendingTileArea& pending : inFlight) {
+            pending.future.waitForFinished();
+        }
+    };
+    auto graftHead = [&]() {
+        PendingTileArea head = inFlight.takeFirst();
+        // Waiting on the head runs it on this thread if no worker has picked it up yet
+        LoadedTileArea area = head.future.takeResult();
+        return graftTileArea(area, head.data, head.length, map, assetManager, codec);
+    };
+    auto graftAll = [&]() {
+        while (!inFlight.isEmpty()) {
+            if (!graftHead()) {
+                drainInFlight();
+                return false;
+            }
+        }
+        return true;
+    };
+
     BinaryNode* childNode = mapDataNode->getChild();
     while(childNode) {
-        switch (childNode->getType()) {
-            case OTBM_NODE_TILE_AREA:
-                if (!parseTileAreaNode(childNode, map, assetManager, settings)) return false;
-                break;
-            case OTBM_NODE_TOWNS:
-                if (!parseTownsContainerNode(childNode, map, assetManager, settings)) return false;
-                break;
-            case OTBM_NODE_HOUSES: // Added case for houses
-                if (!parseHousesContainerNode(childNode, map, assetManager, settings)) return false;
-                break;
-            case OTBM_NODE_WAYPOINTS:
-                if (!parseWaypointsContainerNode(childNode, map, assetManager, settings)) return false;
-                break;
-            default:
-                qWarning() << "OtbmMapIO: Unknown child node type" << childNode->getType() << "in MAP_DATA.";
-                // Potentially skip unknown child nodes if parser is to be lenient.
-                break;
+        if (childNode->getType() == OTBM_NODE_TILE_AREA && streamData) {
+            const size_t areaStart = childNode->getStreamOffset();
+            const bool skipped = readHandle.skipNode(childNode);
+            const uint8_t* areaData = streamData + areaStart;
+            const size_t areaLength = readHandle.tell() - areaStart;
+            if (!skipped) {
+                // Malformed subtree: decode what is there serially, after every earlier area,
+                // so errors surface in the same order as in a serial load.
+                if (!graftAll()) return false;
+                if (!parseTileAreaSpan(areaData, areaLength, mapTiles, assetManager, codec)) return false;
+                break; // loadMap reports the stream error
+            }
+
+            const Map* mapPtr = &map;
+            inFlight.append({QtConcurrent::run(QThreadPool::globalInstance(),
+                                 [areaData, areaLength, mapPtr, &assetManager, codec]() {
+                                     return decodeTileArea(areaData, areaLength, *mapPtr, assetManager, codec);
+                                 }),
+                             areaData, areaLength});
+            if (inFlight.size() >= maxInFlight && !graftHead()) {
+                drainInFlight();
+                return false;
+            }
+        } else {
+            // Everything else is parsed in place, on top of all tile areas that precede it.
+            if (!graftAll()) return false;
+            switch (childNode->getType()) {
+                case OTBM_NODE_TILE_AREA: // Only reached for handles without direct byte access
+                    if (!parseTileAreaNode(childNode, mapTiles, assetManager, codec)) return false;
+                    break;
+                case OTBM_NODE_TOWNS:
+                    if (!parseTownsContainerNode(childNode, map, assetManager, settings)) return false;
+                    break;
+                case OTBM_NODE_HOUSES: // Added case for houses
+                    if (!parseHousesContainerNode(childNode, map, assetManager, settings)) return false;
+                    break;
+                case OTBM_NODE_WAYPOINTS:
+                    if (!parseWaypointsContainerNode(childNode, map, assetManager, settings)) return false;
+                    break;
+                default:
+                    qWarning() << "OtbmMapIO: Unknown child node type" << childNode->getType() << "in MAP_DATA.";
+                    // Potentially skip unknown child nodes if parser is to be lenient.
+                    break;
+            }
         }
         childNode = mapDataNode->getNextChild(); // Get next child of mapDataNode
     }
+    return graftAll();
+}
+
+OtbmMapIO::LoadedTileArea OtbmMapIO::decodeTileArea(const uint8_t* data, size_t length, const Map& map,
+                                                     AssetManager& assetManager, const TileCodecSettings& codec) {
+    LoadedTileArea area;
+    const TileResolver detachedTiles = [&area, &map](const Position& pos) -> Tile* {
+        // Same rule BaseMap::getOrCreateTile applies, so rejected positions fail identically
+        if (!map.isPositionValid(pos)) {
+            return nullptr;
+        }
+        const int sectorX = (pos.x / SECTOR_WIDTH_TILES) * SECTOR_WIDTH_TILES;
+        const int sectorY = (pos.y / SECTOR_HEIGHT_TILES) * SECTOR_HEIGHT_TILES;
+        const quint64 key = (static_cast<quint64>(pos.z) << 48) |
+                            (static_cast<quint64>(sectorY) << 24) | static_cast<quint64>(sectorX);
+        LoadedTileArea::Sector& sector = area.sectors[key];
+        if (!sector.floor) {
+            sector.origin = Position(sectorX, sectorY, pos.z);
+            sector.floor = std::make_unique<RME::Floor>(pos.z, map.getAssetManager());
+        }
+        bool created = false;
+        return sector.floor->getOrCreateTile(pos.x - sectorX, pos.y - sectorY, created, pos);
+    };
+
+    // A private OtbmMapIO keeps error reporting off the shared m_lastError
+    OtbmMapIO areaIO;
+    area.ok = areaIO.parseTileAreaSpan(data, length, detachedTiles, assetManager, codec);
+    if (!area.ok) {
+        area.error = areaIO.m_lastError;
+    }
+    return area;
+}
+
+bool OtbmMapIO::graftTileArea(LoadedTileArea& area, const uint8_t* data, size_t length, Map& map,
+                              AssetManager& assetManager, const TileCodecSettings& codec) {
+    if (!area.ok) {
+        m_lastError = area.error;
+        return false;
+    }
+
+    const bool overlapsMap = std::any_of(area.sectors.begin(), area.sectors.end(), [&map](const auto& entry) {
+        return map.getFloor(entry.second.origin) != nullptr;
+    });
+    if (overlapsMap) {
+        const TileResolver mapTiles = [&map](const Position& pos) {
+            bool created = false;
+            return map.getOrCreateTile(pos, created);
+        };
+        return parseTileAreaSpan(data, length, mapTiles, assetManager, codec);
+    }
+
+    for (auto& entry : area.sectors) {
+        LoadedTileArea::Sector& sector = entry.second;
+        if (sector.floor->isEmpty()) {
+            continue;
+        }
+        if (!map.adoptFloor(sector.origin, sector.floor)) {
+            m_lastError = "Failed to attach loaded sector at " + sector.origin.toString() + ".";
+            qWarning() << "OtbmMapIO::graftTileArea:" << m_lastError;
+            return false;
+        }
+    }
     return true;
 }
 
+bool OtbmMapIO::parseTileAreaSpan(const uint8_t* data, size_t length, const TileResolver& resolveTile,
+                                  AssetManager& assetManager, const TileCodecSettings& codec) {
+    // The span starts with the area's NODE_START, which the handle treats as its root marker,
+    // so the root's first child is the TILE_AREA node itself.
+    MemoryNodeFileReadHandle areaHandle(data, length);
+    BinaryNode* rootNode = areaHandle.getRootNode();
+    BinaryNode* tileAreaNode = rootNode ? rootNode->getChild() : nullptr;
+    if (!tileAreaNode) {
+        // Only a truncated stream gets here; loadMap reports the read handle's error.
+        return true;
+    }
+    return parseTileAreaNode(tileAreaNode, resolveTile, assetManager, codec);
+}
+
 // Added settings to signature
-bool OtbmMapIO::parseTileAreaNode(BinaryNode* tileAreaNode, Map& map, AssetManager& assetManager, AppSettings& settings) {
+bool OtbmMapIO::parseTileAreaNode(BinaryNode* tileAreaNode, const TileResolver& resolveTile, AssetManager& assetManager, const TileCodecSettings& codec) {
     // Tile Area node data contains: BaseX (U16), BaseY (U16), BaseZ (U8)
     const QByteArray& nodeData = tileAreaNode->getNodeData();
     if (nodeData.size() < 5) {
@@ -386,7 +546,7 @@ bool OtbmMapIO::parseTileAreaNode(BinaryNode* tileAreaNode, Map& map, AssetManag
     BinaryNode* tileNode = tileAreaNode->getChild();
     while(tileNode) {
         if (tileNode->getType() == OTBM_NODE_TILE || tileNode->getType() == OTBM_NODE_HOUSETILE) {
-            if (!parseTileNode(tileNode, map, assetManager, areaBasePos, settings)) return false; // Pass settings
+            if (!parseTileNode(tileNode, resolveTile, assetManager, areaBasePos, codec)) return false; // Pass codec
         } else {
             qWarning() << "OtbmMapIO: Unknown child node type" << tileNode->getType() << "in TILE_AREA at base" << areaBasePos.toString();
         }
@@ -396,7 +556,7 @@ bool OtbmMapIO::parseTileAreaNode(BinaryNode* tileAreaNode, Map& map, AssetManag
 }
 
 // Added settings to signature
-bool OtbmMapIO::parseTileNode(BinaryNode* tileNode, Map& map, AssetManager& assetManager, const Position& areaBasePos, AppSettings& settings) {
+bool OtbmMapIO::parseTileNode(BinaryNode* tileNode, const TileResolver& resolveTile, AssetManager& assetManager, const Position& areaBasePos, const TileCodecSettings& codec) {
     // Tile node data contains: RelX (U8), RelY (U8)
     const QByteArray& nodeData = tileNode->getNodeData();
     if (nodeData.size() < 2) {
@@ -412,7 +572,7 @@ bool OtbmMapIO::parseTileNode(BinaryNode* tileNode, Map& map, AssetManager& asse
     tilePos.setY(areaBasePos.y() + static_cast<uint8_t>(nodeData[1]));
     // map.toAbsolute(tilePos); // Convert relative to absolute if needed by Map - already absolute now
 
-    Tile* currentTile = map.getOrCreateTile(tilePos);
+    Tile* currentTile = resolveTile(tilePos);
     if (!currentTile) {
         m_lastError = "Failed to get or create tile at " + tilePos.toString();
         qWarning() << "OtbmMapIO::parseTileNode:" << m_lastError;
@@ -502,10 +662,10 @@ bool OtbmMapIO::parseTileNode(BinaryNode* tileNode, Map& map, AssetManager& asse
     while(itemOrCreatureNode) {
         switch(itemOrCreatureNode->getType()) {
             case OTBM_NODE_ITEM:
-                if (!parseItemNode(itemOrCreatureNode, currentTile, assetManager, settings)) return false;
+                if (!parseItemNode(itemOrCreatureNode, currentTile, assetManager, codec)) return false;
                 break;
             case OTBM_NODE_CREATURE:
-                if (!parseCreatureNode(itemOrCreatureNode, currentTile, assetManager, settings)) return false;
+                if (!parseCreatureNode(itemOrCreatureNode, currentTile, assetManager, codec)) return false;
                 break;
             default:
                 qWarning() << "OtbmMapIO: Unknown child node type" << itemOrCreatureNode->getType() << "in TILE data for" << tilePos.toString();
@@ -518,7 +678,7 @@ bool OtbmMapIO::parseTileNode(BinaryNode* tileNode, Map& map, AssetManager& asse
 }
 
 // Added settings to parseItemNode signature
-bool OtbmMapIO::parseItemNode(BinaryNode* itemNode, Tile* tile, AssetManager& assetManager, AppSettings& settings) {
+bool OtbmMapIO::parseItemNode(BinaryNode* itemNode, Tile* tile, AssetManager& assetManager, const TileCodecSettings& codec) {
     // Item node data contains: ItemID (U16)
     const QByteArray& nodeData = itemNode->getNodeData();
     if (nodeData.size() < 2) {
@@ -531,7 +691,7 @@ bool OtbmMapIO::parseItemNode(BinaryNode* itemNode, Tile* tile, AssetManager& as
     const RME::core::assets::ItemType* itemType = assetManager.getItemData(itemId);
     if (!itemType) {
         QString msg = QString("Item ID %1 not found in ItemDatabase. Position: %2").arg(itemId).arg(tile->getPosition().toString());
-        bool skipUnknown = settings.getValue(Config::Key::SKIP_UNKNOWN_ITEMS, true).toBool(); // Example setting
+        bool skipUnknown = codec.skipUnknownItems;
         if (skipUnknown) {
             qWarning() << "OtbmMapIO::parseItemNode:" << msg << "Skipping item.";
             return true; // Skip this item successfully
@@ -763,34 +923,11 @@ bool OtbmMapIO::serializeMapDataNode(NodeFileWriteHandle& writer, const Map& map
         }
     }
 
-    // Iterate map by 256x256x1 areas (per floor)
-    // Ensure map dimensions are positive before iterating
-    if (map.getWidth() > 0 && map.getHeight() > 0 && map.getFloors() > 0) {
-        for (int z = 0; z < map.getFloors(); ++z) {
-            for (int y_base = 0; y_base < map.getHeight(); y_base += 256) {
-                for (int x_base = 0; x_base < map.getWidth(); x_base += 256) {
-                    // Check if this specific x_base, y_base, z area has any tiles to save
-                    bool areaHasTiles = false;
-                    for (int y_off = 0; y_off < 256 && (y_base + y_off) < map.getHeight(); ++y_off) {
-                        for (int x_off = 0; x_off < 256 && (x_base + x_off) < map.getWidth(); ++x_off) {
-                            if (map.getTile(Position(x_base + x_off, y_base + y_off, z))) {
-                                areaHasTiles = true; break;
-                            }
-                        }
-                        if (areaHasTiles) break;
-                    }
-
-                    if (areaHasTiles) {
-                        if (!serializeTileAreaNode(writer, map, Position(x_base, y_base, z), assetManager, settings)) {
-                            return false; // m_lastError set by callee
-                        }
-                    }
-                }
-            }
-        }
+    // Write one TILE_AREA per populated 256x256x1 area, in canonical (Z, Y, X) order
+    if (!serializeTileAreasParallel(writer, collectPopulatedTileAreas(map), assetManager, TileCodecSettings::fromSettings(settings))) {
+        return false; // m_lastError set by callee
     }
 
-
     // Serialize Waypoints if any
     if (!map.getWaypoints().isEmpty()) {
         if (!serializeWaypointsContainerNode(writer, map, assetManager, settings)) {
@@ -814,10 +951,92 @@ bool OtbmMapIO::serializeMapDataNode(NodeFileWriteHandle& writer, const Map& map
     return true;
 }
 
-// Pass AssetManager and AppSettings
-bool OtbmMapIO::serializeTileAreaNode(NodeFileWriteHandle& writer, const Map& map,
-                                   const Position& areaBasePos, // This now includes Z
-                                   AssetManager& assetManager, AppSettings& settings) {
+QList<OtbmMapIO::TileAreaSectors> OtbmMapIO::collectPopulatedTileAreas(const Map& map) const {
+    // Keyed by (z, areaY, areaX) packed so that QMap ordering matches the canonical area order
+    QMap<quint64, TileAreaSectors> areas;
+    map.forEachFloor(RME::ConstFloorVisitor([&areas](const RME::Floor& floor, int sectorX, int sectorY) {
+        const int areaX = sectorX / TILE_AREA_SIZE;
+        const int areaY = sectorY / TILE_AREA_SIZE;
+        const quint64 key = (static_cast<quint64>(floor.getZLevel()) << 32)
+                          | (static_cast<quint64>(areaY) << 16)
+                          | static_cast<quint64>(areaX);
+
+        auto it = areas.find(key);
+        if (it == areas.end()) {
+            TileAreaSectors area;
+            area.basePos = Position(areaX * TILE_AREA_SIZE, areaY * TILE_AREA_SIZE, floor.getZLevel());
+            it = areas.insert(key, area);
+        }
+        const int col = (sectorX % TILE_AREA_SIZE) / SECTOR_WIDTH_TILES;
+        const int row = (sectorY % TILE_AREA_SIZE) / SECTOR_HEIGHT_TILES;
+        it.value().sectors[row * TileAreaSectors::SECTORS_PER_SIDE + col] = &floor;
+        return true;
+    }));
+    return areas.values();
+}
+
+bool OtbmMapIO::serializeTileAreasParallel(NodeFileWriteHandle& writer, const QList<TileAreaSectors>& areas,
+                                           AssetManager& assetManager, const TileCodecSettings& codec) {
+    const int maxInFlight = qMax(1, QThreadPool::globalInstance()->maxThreadCount() * 2);
+    std::atomic<qint64> pendingBytes{0};
+    QList<QFuture<EncodedTileArea>> inFlight; // FIFO; the head is always the next area to write
+    int nextToSubmit = 0;
+
+    auto drainInFlight = [&inFlight]() {
+        // Workers reference 'areas' and 'pendingBytes'; they must finish before we return.
+        for (QFuture<EncodedTileArea>& future : inFlight) {
+            future.waitForFinished();
+        }
+    };
+
+    while (nextToSubmit < areas.size() || !inFlight.isEmpty()) {
+        // Keep the pool busy while both the window and the memory budget allow it
+        while (nextToSubmit < areas.size() && inFlight.size() < maxInFlight &&
+               pendingBytes.load() < MAX_PENDING_AREA_BYTES) {
+            const TileAreaSectors* area = &areas[nextToSubmit++];
+            inFlight.append(QtConcurrent::run([area, &assetManager, codec, &pendingBytes]() {
+                EncodedTileArea encoded = encodeTileArea(*area, assetManager, codec);
+                pendingBytes.fetch_add(static_cast<qint64>(encoded.bytes.size()));
+                return encoded;
+            }));
+        }
+
+        // Waiting on the head runs it on this thread if no worker has picked it up yet
+        EncodedTileArea encoded = inFlight.takeFirst().takeResult();
+        pendingBytes.fetch_sub(static_cast<qint64>(encoded.bytes.size()));
+
+        if (!encoded.ok) {
+            m_lastError = encoded.error;
+            drainInFlight();
+            return false;
+        }
+        if (!writer.addEncodedNodes(reinterpret_cast<const char*>(encoded.bytes.data()),
+                                    static_cast<qsizetype>(encoded.bytes.size()))) {
+            m_lastError = "Failed to write encoded TILE_AREA node. Error: " + QString::number(writer.getError());
+            drainInFlight();
+            return false;
+        }
+    }
+    return true;
+}
+
+OtbmMapIO::EncodedTileArea OtbmMapIO::encodeTileArea(const TileAreaSectors& area,
+                                                     AssetManager& assetManager, const TileCodecSettings& codec) {
+    // A private OtbmMapIO keeps error reporting off the shared m_lastError
+    OtbmMapIO areaIO;
+    MemoryNodeFileWriteHandle buffer(64 * 1024);
+
+    EncodedTileArea encoded;
+    encoded.ok = areaIO.serializeTileAreaNode(buffer, area, assetManager, codec) && buffer.isOk();
+    if (encoded.ok) {
+        encoded.bytes = buffer.takeBuffer();
+    } else {
+        encoded.error = areaIO.m_lastError;
+    }
+    return encoded;
+}
+
+bool OtbmMapIO::beginTileAreaNode(NodeFileWriteHandle& writer, const Position& areaBasePos) {
     // OTBM_NODE_TILE_AREA - properties usually not compressed
     if (!writer.addNode(OTBM_NODE_TILE_AREA, false)) {
         m_lastError = "Failed to start TILE_AREA node for " + areaBasePos.toString() + ".";
@@ -835,24 +1054,82 @@ bool OtbmMapIO::serializeTileAreaNode(NodeFileWriteHandle& writer, const Map& ma
         m_lastError = "Failed to write tile area coordinates for " + areaBasePos.toString() + ".";
         return false;
     }
+    return true;
+}
 
-    // Iterate tiles within this 256x256 area for the given floor (areaBasePos.z())
-    for (int y_offset = 0; y_offset < 256; ++y_offset) {
-        int current_y = areaBasePos.y() + y_offset;
-        if (current_y >= map.getHeight()) break;
+bool OtbmMapIO::serializeTileFragment(NodeFileWriteHandle& writer, const Position& areaBasePos, const QList<const Tile*>& tiles,
+                                      AssetManager& assetManager, const TileCodecSettings& codec) {
+    if (!beginTileAreaNode(writer, areaBasePos)) {
+        return false;
+    }
 
-        for (int x_offset = 0; x_offset < 256; ++x_offset) {
-            int current_x = areaBasePos.x() + x_offset;
-            if (current_x >= map.getWidth()) break;
+    for (const Tile* tile : tiles) {
+        const Position& pos = tile->getPosition();
+        if (pos.x() < areaBasePos.x() || pos.x() >= areaBasePos.x() + TILE_AREA_SIZE ||
+            pos.y() < areaBasePos.y() || pos.y() >= areaBasePos.y() + TILE_AREA_SIZE || pos.z() != areaBasePos.z()) {
+            m_lastError = "Tile at " + pos.toString() + " is outside the tile area at " + areaBasePos.toString() + ".";
+            return false;
+        }
+        if (!serializeTileNode(writer, tile, assetManager, codec)) {
+            m_lastError = "Failed to serialize tile at " + pos.toString() + ". " + m_lastError;
+            return false;
+        }
+    }
 
-            Position currentPos(current_x, current_y, areaBasePos.z());
-            const Tile* tile = map.getTile(currentPos);
+    if (!writer.endNode()) {
+        m_lastError = "Failed to end TILE_AREA node for " + areaBasePos.toString() + ".";
+        return false;
+    }
+    return true;
+}
 
-            // Only save non-empty tiles or tiles that have significant properties (flags, houseID)
-            if (tile && (!tile->isEmpty() || tile->getMapFlags() != 0 || tile->getHouseID() != 0)) {
-                if (!serializeTileNode(writer, tile, assetManager, settings)) { // Pass assetManager & settings
-                    m_lastError = "Failed to serialize tile at " + currentPos.toString() + ". " + m_lastError;
-                    return false;
+bool OtbmMapIO::parseTileFragment(const uint8_t* data, size_t length, const TileResolver& resolveTile,
+                                  AssetManager& assetManager, const TileCodecSettings& codec) {
+    MemoryNodeFileReadHandle fragmentHandle(data, length);
+    BinaryNode* rootNode = fragmentHandle.getRootNode();
+    BinaryNode* tileAreaNode = rootNode ? rootNode->getChild() : nullptr;
+    if (!tileAreaNode || tileAreaNode->getType() != OTBM_NODE_TILE_AREA) {
+        // Unlike parseTileAreaSpan, the caller has no outer handle that reports truncation
+        m_lastError = "Map fragment does not contain a TILE_AREA node.";
+        qWarning() << "OtbmMapIO::parseTileFragment:" << m_lastError;
+        return false;
+    }
+    return parseTileAreaNode(tileAreaNode, resolveTile, assetManager, codec);
+}
+
+// Pass AssetManager and the tile codec settings
+bool OtbmMapIO::serializeTileAreaNode(NodeFileWriteHandle& writer, const TileAreaSectors& area,
+                                   AssetManager& assetManager, const TileCodecSettings& codec) {
+    const Position& areaBasePos = area.basePos; // This includes Z
+    if (!beginTileAreaNode(writer, areaBasePos)) {
+        return false;
+    }
+
+    // Tiles are written in row-major order across the whole area, reading each populated
+    // sector's tile array directly; rows of sectors that do not exist are skipped outright.
+    constexpr int sectorsPerSide = TileAreaSectors::SECTORS_PER_SIDE;
+    for (int sectorRow = 0; sectorRow < sectorsPerSide; ++sectorRow) {
+        const RME::Floor* const* rowSectors = &area.sectors[sectorRow * sectorsPerSide];
+        if (std::all_of(rowSectors, rowSectors + sectorsPerSide, [](const RME::Floor* f) { return f == nullptr; })) {
+            continue;
+        }
+
+        for (int localY = 0; localY < SECTOR_HEIGHT_TILES; ++localY) {
+            for (int sectorCol = 0; sectorCol < sectorsPerSide; ++sectorCol) {
+                const RME::Floor* sector = rowSectors[sectorCol];
+                if (!sector) {
+                    continue;
+                }
+                for (int localX = 0; localX < SECTOR_WIDTH_TILES; ++localX) {
+                    const Tile* tile = sector->getTile(localX, localY);
+
+                    // Only save non-empty tiles or tiles that have significant properties (flags, houseID)
+                    if (tile && (!tile->isEmpty() || tile->getMapFlags() != 0 || tile->getHouseID() != 0)) {
+                        if (!serializeTileNode(writer, tile, assetManager, codec)) { // Pass assetManager & codec
+                            m_lastError = "Failed to serialize tile at " + tile->getPosition().toString() + ". " + m_lastError;
+                            return false;
+                        }
+                    }
                 }
             }
         }
@@ -865,8 +1142,8 @@ bool OtbmMapIO::serializeTileAreaNode(NodeFileWriteHandle& writer, const Map& ma
     return true;
 }
 
-// Pass AssetManager and AppSettings
-bool OtbmMapIO::serializeTileNode(NodeFileWriteHandle& writer, const Tile* tile, AssetManager& assetManager, AppSettings& settings) {
+// Pass AssetManager and the tile codec settings
+bool OtbmMapIO::serializeTileNode(NodeFileWriteHandle& writer, const Tile* tile, AssetManager& assetManager, const TileCodecSettings& codec) {
     uint8_t nodeType = tile->getHouseID() > 0 ? OTBM_NODE_HOUSETILE : OTBM_NODE_TILE;
     // Tile attributes usually not compressed
     if (!writer.addNode(nodeType, false)) {
@@ -919,14 +1196,14 @@ bool OtbmMapIO::serializeTileNode(NodeFileWriteHandle& writer, const Tile* tile,
 
     // Write Items (Ground item first, then top items)
     if (tile->getGround()) {
-        if (!serializeItemNode(writer, tile->getGround(), assetManager, settings)) { // Pass assetManager & settings
+        if (!serializeItemNode(writer, tile->getGround(), assetManager, codec)) { // Pass assetManager & codec
              m_lastError = "Failed to serialize ground item at " + tile->getPosition().toString() + ". " + m_lastError;
              return false;
         }
     }
     for (const auto& itemPtr : tile->getItems()) { // Assuming getItems() returns a list of unique_ptr or shared_ptr
         if (itemPtr) {
-            if (!serializeItemNode(writer, itemPtr.get(), assetManager, settings)) { // Pass assetManager & settings
+            if (!serializeItemNode(writer, itemPtr.get(), assetManager, codec)) { // Pass assetManager & codec
                 m_lastError = "Failed to serialize item ID " + QString::number(itemPtr->getID()) + " at " + tile->getPosition().toString() + ". " + m_lastError;
                 return false;
             }
@@ -935,7 +1212,7 @@ bool OtbmMapIO::serializeTileNode(NodeFileWriteHandle& writer, const Tile* tile,
 
     // Serialize Creature if present
     if (tile->getCreature()) {
-        if (!serializeCreatureNode(writer, tile->getCreature(), assetManager, settings)) {
+        if (!serializeCreatureNode(writer, tile->getCreature(), assetManager, codec)) {
             // m_lastError is set by serializeCreatureNode
             return false;
         }
@@ -948,8 +1225,8 @@ bool OtbmMapIO::serializeTileNode(NodeFileWriteHandle& writer, const Tile* tile,
     return true;
 }
 
-// Pass AssetManager and AppSettings
-bool OtbmMapIO::serializeItemNode(NodeFileWriteHandle& writer, const Item* item, AssetManager& assetManager, AppSettings& settings) {
+// Pass AssetManager and the tile codec settings
+bool OtbmMapIO::serializeItemNode(NodeFileWriteHandle& writer, const Item* item, AssetManager& assetManager, const TileCodecSettings& codec) {
     if (!item) return true; // Should not happen if called correctly
 
     // Item attributes usually not compressed, unless specific items have very large text attributes.
@@ -1054,7 +1331,7 @@ bool OtbmMapIO::serializeItemNode(NodeFileWriteHandle& writer, const Item* item,
         if (containerItem) {
             for (const auto& childItemPtr : containerItem->getItems()) {
                 if (childItemPtr) {
-                    if (!serializeItemNode(writer, childItemPtr.get(), assetManager, settings)) {
+                    if (!serializeItemNode(writer, childItemPtr.get(), assetManager, codec)) {
                         return false;
                     }
                 }
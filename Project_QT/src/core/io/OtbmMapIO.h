@@ -7,12 +7,20 @@
 #include "core/world/TownData.h" // Added for Town I/O
 #include "core/houses/HouseData.h" // Added for House I/O
 #include "core/creatures/Creature.h" // Added for Creature I/O
+#include "core/map/Floor.h" // For SECTOR_WIDTH_TILES
 #include <QVariantMap> // For passing attributes around if needed
 #include <QByteArray>  // For compress/decompress helpers
+#include <QList>
+#include <array>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
 
 // Forward declarations
 // namespace RME { namespace core { class Map; class AssetManager; class AppSettings; }} // Already in IMapIO.h
 namespace RME {
+class Floor;
 namespace core {
 namespace io {
     class BinaryNode;
@@ -86,6 +94,43 @@ public:
      */
     QString getLastError() const { return m_lastError; }
 
+    /**
+     * @brief The settings read while encoding or decoding tiles, items and creatures.
+     * AppSettings wraps a QSettings, which must not be shared between threads, so tile
+     * codecs that may run on worker threads take a copy read on the calling thread.
+     */
+    struct TileCodecSettings {
+        bool skipUnknownItems = true;
+
+        static TileCodecSettings fromSettings(AppSettings& settings);
+    };
+
+    // --- Map fragments (e.g. clipboard payloads) ---
+
+    /// Returns the tile a TILE node is decoded into, creating it if needed; nullptr rejects the position.
+    using TileResolver = std::function<Tile*(const Position& pos)>;
+
+    /**
+     * @brief Encodes tiles as a single TILE_AREA node, using the same tile and item encoding as a save.
+     * @param areaBasePos Base of the TILE_AREA_SIZE aligned area that contains every tile.
+     * @param tiles Tiles to write, in order. They do not need to belong to a map.
+     * @param codec Settings snapshot; fragments may be encoded on worker threads.
+     * @return True on success, false on failure. Sets m_lastError on failure.
+     */
+    bool serializeTileFragment(NodeFileWriteHandle& writer, const Position& areaBasePos, const QList<const Tile*>& tiles,
+                               AssetManager& assetManager, const TileCodecSettings& codec);
+
+    /**
+     * @brief Decodes one TILE_AREA node stream (NODE_START ... NODE_END) as written by
+     * serializeTileFragment(), resolving each decoded tile through 'resolveTile'.
+     * @return True on success, false on failure. Sets m_lastError on failure.
+     */
+    bool parseTileFragment(const uint8_t* data, size_t length, const TileResolver& resolveTile,
+                           AssetManager& assetManager, const TileCodecSettings& codec);
+
+    /// Side length of an OTBM TILE_AREA node, in tiles.
+    static constexpr int TILE_AREA_SIZE = 256;
+
 private:
     // --- Helper methods for loading ---
 
@@ -98,30 +143,72 @@ private:
      * @param settings Application settings.
      * @return True on success, false on failure.
      */
-    bool parseMapDataNode(BinaryNode* mapDataNode, Map& map, AssetManager& assetManager, AppSettings& settings);
+    bool parseMapDataNode(NodeFileReadHandle& readHandle, BinaryNode* mapDataNode, Map& map, AssetManager& assetManager, AppSettings& settings);
+
+    /**
+     * @brief Parses the children of MAP_DATA as a pipeline.
+     *
+     * This thread scans the node stream and cuts out each TILE_AREA subtree, worker threads decode
+     * those into detached Floor sectors, and this thread grafts the finished areas into the map in
+     * stream order. Other children are parsed in place once every earlier area has been attached,
+     * so the resulting map and the first reported error are the same as for a serial load.
+     * Falls back to serial parsing if the handle offers no direct access to its bytes.
+     */
+    bool parseMapDataChildren(NodeFileReadHandle& readHandle, BinaryNode* mapDataNode, Map& map,
+                              AssetManager& assetManager, AppSettings& settings);
+
+    /// Floor sectors decoded from one TILE_AREA node that are not attached to a map yet.
+    struct LoadedTileArea {
+        struct Sector {
+            Position origin; ///< Top-left tile of the sector
+            std::unique_ptr<RME::Floor> floor;
+        };
+        std::map<quint64, Sector> sectors; ///< Keyed by (z, sector y, sector x)
+        bool ok = false;
+        QString error;
+    };
+
+    /**
+     * @brief Decodes one encoded TILE_AREA subtree (NODE_START ... NODE_END) into detached sectors.
+     * Only reads 'map' for position validation, so it may run concurrently with grafting.
+     */
+    static LoadedTileArea decodeTileArea(const uint8_t* data, size_t length, const Map& map,
+                                         AssetManager& assetManager, const TileCodecSettings& codec);
+
+    /**
+     * @brief Attaches a decoded area to the map. Areas overlapping sectors that already exist
+     * (e.g. repeated TILE_AREA nodes) are decoded again directly into the map so tiles merge
+     * exactly as in a serial load.
+     */
+    bool graftTileArea(LoadedTileArea& area, const uint8_t* data, size_t length, Map& map,
+                       AssetManager& assetManager, const TileCodecSettings& codec);
+
+    /// Parses an encoded TILE_AREA subtree serially, resolving tiles through 'resolveTile'.
+    bool parseTileAreaSpan(const uint8_t* data, size_t length, const TileResolver& resolveTile,
+                           AssetManager& assetManager, const TileCodecSettings& codec);
 
     /**
      * @brief Parses a tile area node (OTBM_NODE_TILE_AREA).
      * Extracts the base position for the area and processes child tile nodes.
      * @param tileAreaNode The BinaryNode for the tile area.
-     * @param map The Map object to populate.
+     * @param resolveTile Supplies the tile for each decoded position (the map itself or a detached area).
      * @param assetManager For item validation.
-     * @param settings Application settings.
+     * @param codec Settings snapshot for the tile codecs.
      * @return True on success, false on failure.
      */
-    bool parseTileAreaNode(BinaryNode* tileAreaNode, Map& map, AssetManager& assetManager, AppSettings& settings);
+    bool parseTileAreaNode(BinaryNode* tileAreaNode, const TileResolver& resolveTile, AssetManager& assetManager, const TileCodecSettings& codec);
 
     /**
      * @brief Parses a single tile node (OTBM_NODE_TILE or OTBM_NODE_HOUSETILE).
      * Extracts tile position, attributes, and processes child item/creature nodes.
      * @param tileNode The BinaryNode for the tile.
-     * @param map The Map object.
+     * @param resolveTile Supplies the tile for the decoded position.
      * @param assetManager For item validation.
      * @param areaBasePos The base position of the current tile area.
-     * @param settings Application settings.
+     * @param codec Settings snapshot for the tile codecs.
      * @return True on success, false on failure.
      */
-    bool parseTileNode(BinaryNode* tileNode, Map& map, AssetManager& assetManager, const Position& areaBasePos, AppSettings& settings);
+    bool parseTileNode(BinaryNode* tileNode, const TileResolver& resolveTile, AssetManager& assetManager, const Position& areaBasePos, const TileCodecSettings& codec);
 
     /**
      * @brief Parses an item node (OTBM_NODE_ITEM).
@@ -129,10 +216,10 @@ private:
      * @param itemNode The BinaryNode for the item.
      * @param tile The Tile object to add the item to.
      * @param assetManager For item validation and creation.
-     * @param settings Application settings.
+     * @param codec Settings snapshot for the tile codecs.
      * @return True on success, false on failure.
      */
-    bool parseItemNode(BinaryNode* itemNode, Tile* tile, AssetManager& assetManager, AppSettings& settings);
+    bool parseItemNode(BinaryNode* itemNode, Tile* tile, AssetManager& assetManager, const TileCodecSettings& codec);
     // Town Data Parsing
     bool parseTownsContainerNode(BinaryNode* containerNode, Map& map, AssetManager& assetManager, AppSettings& settings);
     bool parseTownNode(BinaryNode* townNode, Map& map, AssetManager& assetManager, AppSettings& settings);
@@ -143,17 +230,55 @@ private:
     bool parseHousesContainerNode(BinaryNode* containerNode, Map& map, AssetManager& assetManager, AppSettings& settings);
     bool parseHouseNode(BinaryNode* houseNode, Map& map, AssetManager& assetManager, AppSettings& settings);
     // --- Creature Instance Parsing ---
-    bool parseCreatureNode(BinaryNode* creatureNode, Tile* tile, AssetManager& assetManager, AppSettings& settings);
+    bool parseCreatureNode(BinaryNode* creatureNode, Tile* tile, AssetManager& assetManager, const TileCodecSettings& codec);
     // Spawn Data Parsing
     bool parseSpawnNode(BinaryNode* spawnNode, Map& map, AssetManager& assetManager, AppSettings& settings);
 
     // --- Helper methods for saving (declarations) ---
+
+    /**
+     * @brief One OTBM tile area (256x256 tiles on one floor) and the populated
+     * Floor sectors that fall inside it, laid out as a row-major sector grid.
+     */
+    struct TileAreaSectors {
+        static constexpr int SECTORS_PER_SIDE = TILE_AREA_SIZE / SECTOR_WIDTH_TILES;
+        Position basePos;
+        std::array<const RME::Floor*, SECTORS_PER_SIDE * SECTORS_PER_SIDE> sectors{}; ///< nullptr where no sector exists
+    };
+
+    /**
+     * @brief Groups the map's populated Floor sectors into tile areas.
+     * Areas are returned in canonical order (Z, then Y, then X) and empty areas are never produced,
+     * so the cost scales with the stored sectors rather than the map's dimensions.
+     */
+    QList<TileAreaSectors> collectPopulatedTileAreas(const Map& map) const;
+
+    /// Upper bound for encoded TILE_AREA bytes that are finished but not yet written during a save.
+    static constexpr qint64 MAX_PENDING_AREA_BYTES = 256LL * 1024 * 1024;
+
+    /// A TILE_AREA node encoded into its own buffer by a worker thread.
+    struct EncodedTileArea {
+        std::vector<uint8_t> bytes; ///< Complete node stream (NODE_START ... NODE_END)
+        bool ok = false;
+        QString error;
+    };
+
+    /**
+     * @brief Encodes tile areas concurrently into per-area memory buffers and appends
+     * them to the writer in list order, so the output is byte-identical to a serial save.
+     * The number of areas in flight and the bytes waiting to be written are both bounded.
+     */
+    bool serializeTileAreasParallel(NodeFileWriteHandle& writer, const QList<TileAreaSectors>& areas,
+                                    AssetManager& assetManager, const TileCodecSettings& codec);
+    static EncodedTileArea encodeTileArea(const TileAreaSectors& area, AssetManager& assetManager, const TileCodecSettings& codec);
+
     bool serializeMapDataNode(NodeFileWriteHandle& writer, const Map& map, AssetManager& assetManager, AppSettings& settings);
-    bool serializeTileAreaNode(NodeFileWriteHandle& writer, const Map& map,
-                                   const Position& areaBasePos,
-                                   AssetManager& assetManager, AppSettings& settings);
-    bool serializeTileNode(NodeFileWriteHandle& writer, const Tile* tile, AssetManager& assetManager, AppSettings& settings);
-    bool serializeItemNode(NodeFileWriteHandle& writer, const Item* item, AssetManager& assetManager, AppSettings& settings);
+    /// Starts a TILE_AREA node and writes its base coordinates; the caller adds tiles and ends it.
+    bool beginTileAreaNode(NodeFileWriteHandle& writer, const Position& areaBasePos);
+    bool serializeTileAreaNode(NodeFileWriteHandle& writer, const TileAreaSectors& area,
+                                   AssetManager& assetManager, const TileCodecSettings& codec);
+    bool serializeTileNode(NodeFileWriteHandle& writer, const Tile* tile, AssetManager& assetManager, const TileCodecSettings& codec);
+    bool serializeItemNode(NodeFileWriteHandle& writer, const Item* item, AssetManager& assetManager, const TileCodecSettings& codec);
     // Town Data Serialization
     bool serializeTownsContainerNode(NodeFileWriteHandle& writer, const Map& map, AssetManager& assetManager, AppSettings& settings);
     bool serializeTownNode(NodeFileWriteHandle& writer, const RME::core::world::TownData& town, AssetManager& assetManager, AppSettings& settings);
@@ -164,7 +289,7 @@ private:
     bool serializeHousesContainerNode(NodeFileWriteHandle& writer, const Map& map, AssetManager& assetManager, AppSettings& settings);
     bool serializeHouseNode(NodeFileWriteHandle& writer, const RME::core::houses::HouseData& house, AssetManager& assetManager, AppSettings& settings);
     // --- Creature Instance Serialization ---
-    bool serializeCreatureNode(NodeFileWriteHandle& writer, const RME::core::creatures::Creature* creature, AssetManager& assetManager, AppSettings& settings);
+    bool serializeCreatureNode(NodeFileWriteHandle& writer, const RME::core::creatures::Creature* creature, AssetManager& assetManager, const TileCodecSettings& codec);
     // Spawn Data Serialization
     bool serializeSpawnNode(NodeFileWriteHandle& writer, const RME::core::spawns::SpawnData& spawn, AssetManager& assetManager, AppSettings& settings);
 
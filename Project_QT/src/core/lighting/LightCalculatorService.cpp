@@ -6,6 +6,7 @@
 #include "core/assets/AssetManager.h"
 #include "core/assets/ItemData.h"
 #include <QDebug>
+#include <QSet>
 #include <cmath>
 #include <algorithm>
 
@@ -21,12 +22,27 @@ LightCalculatorService::LightCalculatorService(QObject* parent)
 {
 }
 
-LightCalculatorService::~LightCalculatorService() = default;
+LightCalculatorService::~LightCalculatorService()
+{
+    if (m_map && m_tileChangeListenerId != 0) {
+        m_map->removeTileChangeListener(m_tileChangeListenerId);
+    }
+}
 
 void LightCalculatorService::setMap(RME::core::Map* map)
 {
     if (m_map != map) {
+        if (m_map && m_tileChangeListenerId != 0) {
+            m_map->removeTileChangeListener(m_tileChangeListenerId);
+            m_tileChangeListenerId = 0;
+        }
         m_map = map;
+        m_lightIndex.setMap(map);
+        if (m_map) {
+            m_tileChangeListenerId = m_map->addTileChangeListener([this](const Position& pos) {
+                m_lightIndex.updateTile(pos);
+            });
+        }
         emit onMapChanged();
     }
 }
@@ -106,40 +122,87 @@ TileLightInfo LightCalculatorService::calculateLightForTile(const Position& tile
         return TileLightInfo(QColor(255, 255, 255), 1.0f); // Full bright if lighting disabled
     }
 
+    TileLightInfo tileLight = calculateBaseLightForTile(tilePos);
+
+    // Add contribution from indexed map lights and dynamic lights in reach
+    std::vector<LightSource> lights;
+    collectLightsAround(tilePos, tilePos, lights);
+    for (const auto& light : lights) {
+        float intensity = calculateLightIntensity(tilePos, light);
+        if (intensity > MIN_LIGHT_INTENSITY) {
+            addLightContribution(tileLight, light.color, intensity);
+        }
+    }
+
+    return tileLight;
+}
+
+TileLightInfo LightCalculatorService::calculateBaseLightForTile(const Position& tilePos) const
+{
     // Start with ambient light
     TileLightInfo tileLight = calculateAmbientLight(tilePos);
 
     // Add contribution from items on this tile
     const Tile* tile = m_map->getTile(tilePos);
     if (tile) {
-        // Check ground item for light
-        const Item* ground = tile->getGround();
-        if (ground && ground->hasLight()) {
-            QColor itemLightColor = getLightColorFromItemId(ground->getID());
-            float intensity = ground->getLightIntensity() * LIGHT_FALLOFF_FACTOR;
-            addLightContribution(tileLight, itemLightColor, intensity);
+        std::vector<LightSource> itemLights;
+        appendTileItemLights(*tile, itemLights);
+        for (const auto& light : itemLights) {
+            addLightContribution(tileLight, light.color, light.intensity * LIGHT_FALLOFF_FACTOR);
         }
+    }
 
-        // Check other items for light
-        const auto& items = tile->getItems();
-        for (const auto& item : items) {
-            if (item && item->hasLight()) {
-                QColor itemLightColor = getLightColorFromItemId(item->getID());
-                float intensity = item->getLightIntensity() * LIGHT_FALLOFF_FACTOR;
-                addLightContribution(tileLight, itemLightColor, intensity);
-            }
+    return tileLight;
+}
+
+void LightCalculatorService::appendTileItemLights(const Tile& tile, std::vector<LightSource>& lights) const
+{
+    auto consider = [&](const Item* item) {
+        if (item && item->hasLight()) {
+            lights.emplace_back(tile.getPosition(), getLightColorFromItemId(item->getID()), item->getLightIntensity());
         }
+    };
+
+    consider(tile.getGround());
+    for (const auto& item : tile.getItems()) {
+        consider(item.get());
     }
+}
 
-    // Add contribution from dynamic lights
-    for (const auto& light : m_dynamicLights) {
-        float intensity = calculateLightIntensity(tilePos, light);
-        if (intensity > MIN_LIGHT_INTENSITY) {
-            addLightContribution(tileLight, light.color, intensity);
+void LightCalculatorService::collectTileItemLights(const Position& startPos, const Position& endPos,
+                                                   std::vector<LightSource>& lights) const
+{
+    if (!m_map) {
+        return;
+    }
+
+    // The index knows which tiles of the area carry light items; visit each of them once
+    std::vector<LightSource> indexed;
+    m_lightIndex.collectLights(QRect(QPoint(startPos.x, startPos.y), QPoint(endPos.x, endPos.y)), startPos.z, indexed);
+
+    QSet<Position> visited;
+    for (const auto& light : indexed) {
+        if (visited.contains(light.position)) {
+            continue;
+        }
+        visited.insert(light.position);
+        if (const Tile* tile = m_map->getTile(light.position)) {
+            appendTileItemLights(*tile, lights);
         }
     }
+}
 
-    return tileLight;
+void LightCalculatorService::collectLightsAround(const Position& startPos, const Position& endPos,
+                                                 std::vector<LightSource>& lights) const
+{
+    // Only lights within their radius of the area can reach it
+    const int reach = m_lightIndex.getMaxRadius();
+    const QRect area(QPoint(startPos.x - reach, startPos.y - reach), QPoint(endPos.x + reach, endPos.y + reach));
+    m_lightIndex.collectLights(area, startPos.z, lights);
+
+    for (const auto& light : m_dynamicLights) {
+        lights.push_back(light);
+    }
 }
 
 void LightCalculatorService::calculateLightForRegion(const Position& startPos, const Position& endPos, 
@@ -153,10 +216,38 @@ void LightCalculatorService::calculateLightForRegion(const Position& startPos, c
         row.resize(width);
     }
 
+    if (!m_lightingEnabled || !m_map) {
+        for (auto& row : lightMap) {
+            std::fill(row.begin(), row.end(), TileLightInfo(QColor(255, 255, 255), 1.0f)); // Full bright if lighting disabled
+        }
+        return;
+    }
+
     for (int y = 0; y < height; ++y) {
         for (int x = 0; x < width; ++x) {
             Position tilePos(startPos.x + x, startPos.y + y, startPos.z);
-            lightMap[y][x] = calculateLightForTile(tilePos);
+            lightMap[y][x] = calculateBaseLightForTile(tilePos);
+        }
+    }
+
+    // Splat each light in reach over the tiles within its radius instead of testing
+    // every light against every tile; contributions are additive, so the order is irrelevant.
+    std::vector<LightSource> lights;
+    collectLightsAround(startPos, endPos, lights);
+    for (const auto& light : lights) {
+        const int radius = light.intensity;
+        const int minX = std::max(startPos.x, light.position.x - radius);
+        const int maxX = std::min(endPos.x, light.position.x + radius);
+        const int minY = std::max(startPos.y, light.position.y - radius);
+        const int maxY = std::min(endPos.y, light.position.y + radius);
+        for (int tileY = minY; tileY <= maxY; ++tileY) {
+            for (int tileX = minX; tileX <= maxX; ++tileX) {
+                Position tilePos(tileX, tileY, startPos.z);
+                float intensity = calculateLightIntensity(tilePos, light);
+                if (intensity > MIN_LIGHT_INTENSITY) {
+                    addLightContribution(lightMap[tileY - startPos.y][tileX - startPos.x], light.color, intensity);
+                }
+            }
         }
     }
 }
@@ -190,6 +281,17 @@ void LightCalculatorService::onMapChanged()
     clearDynamicLights();
 }
 
+void LightCalculatorService::onMapDataChanged(const QList<RME::core::Position>& affectedPositions)
+{
+    if (affectedPositions.isEmpty()) {
+        m_lightIndex.invalidate(); // Unknown extent, re-index on next query
+        return;
+    }
+    for (const Position& pos : affectedPositions) {
+        m_lightIndex.updateTile(pos);
+    }
+}
+
 void LightCalculatorService::onSettingsChanged()
 {
     // Reload settings if needed
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "LightingTypes.h"
+#include "LightIndex.h"
 #include "core/services/ILightCalculatorService.h"
 #include <QObject>
 #include <QColor>
+#include <QList>
 #include <vector>
 #include <memory>
 
@@ -27,6 +29,11 @@ namespace lighting {
  * This service manages dynamic light sources and calculates lighting
  * information for tiles based on global ambient light, item lights,
  * and dynamic light sources.
+ *
+ * Light-emitting items on the map are tracked in a persistent LightIndex,
+ * kept current through Map tile-change listeners and onMapDataChanged(), so
+ * lighting a region only looks at the lights near it. addDynamicLight() is
+ * for extra lights that are not map items.
  */
 class LightCalculatorService : public QObject, public RME::core::ILightCalculatorService
 {
@@ -51,6 +58,9 @@ public:
     void clearDynamicLights();
     const std::vector<LightSource>& getDynamicLights() const { return m_dynamicLights; }
 
+    // Map item lights
+    const LightIndex& getLightIndex() const { return m_lightIndex; }
+
     // Light calculation
     TileLightInfo calculateLightForTile(const Position& tilePos) const;
     
@@ -58,6 +68,16 @@ public:
     void calculateLightForRegion(const Position& startPos, const Position& endPos, 
                                 std::vector<std::vector<TileLightInfo>>& lightMap) const;
 
+    // Inputs for renderers that accumulate light themselves (see LightRenderer::GpuAccumulate)
+    TileLightInfo getAmbientLight(int floor) const { return calculateAmbientLight(Position(0, 0, floor)); }
+    void collectLightsAround(const Position& startPos, const Position& endPos, std::vector<LightSource>& lights) const;
+    // Light items of the tiles in the area; each lights only its own tile, by intensity * LIGHT_FALLOFF_FACTOR
+    void collectTileItemLights(const Position& startPos, const Position& endPos, std::vector<LightSource>& lights) const;
+
+    // Falloff: a light adds (radius - distance) * LIGHT_FALLOFF_FACTOR, capped at 1
+    static constexpr float LIGHT_FALLOFF_FACTOR = 0.2f;
+    static constexpr float MIN_LIGHT_INTENSITY = 0.01f;
+
     // Settings
     bool isLightingEnabled() const;
     void setLightingEnabled(bool enabled);
@@ -71,9 +91,13 @@ signals:
 public slots:
     void onMapChanged();
     void onSettingsChanged();
+    // Connect UndoManager::mapDataChanged here; an empty list re-indexes the whole map
+    void onMapDataChanged(const QList<RME::core::Position>& affectedPositions);
 
 private:
     // Helper methods
+    TileLightInfo calculateBaseLightForTile(const Position& tilePos) const;
+    void appendTileItemLights(const Tile& tile, std::vector<LightSource>& lights) const;
     float calculateLightIntensity(const Position& tilePos, const LightSource& light) const;
     QColor getLightColorFromItemId(uint16_t itemId) const;
     QColor getPredefinedLightColor(uint16_t itemId) const;
@@ -97,10 +121,10 @@ private:
     float m_globalAmbientLevel;
     bool m_lightingEnabled;
     std::vector<LightSource> m_dynamicLights;
+    LightIndex m_lightIndex;
+    int m_tileChangeListenerId = 0;
 
     // Constants
-    static constexpr float LIGHT_FALLOFF_FACTOR = 0.2f;
-    static constexpr float MIN_LIGHT_INTENSITY = 0.01f;
     static constexpr uint8_t DEFAULT_AMBIENT_ALPHA = 140;
 };
 
@@ -0,0 +1,148 @@
+#include "LightIndex.h"
+#include "core/map/Map.h"
+#include "core/map/Floor.h"
+#include "core/Tile.h"
+#include "core/Item.h"
+#include <QDebug>
+#include <algorithm>
+#include <functional>
+
+namespace RME {
+namespace core {
+namespace lighting {
+
+void LightIndex::setMap(const RME::core::Map* map)
+{
+    m_map = map;
+    invalidate();
+}
+
+void LightIndex::invalidate()
+{
+    m_sectors.clear();
+    m_maxRadius = 0;
+    m_lightCount = 0;
+    m_built = false;
+}
+
+quint64 LightIndex::sectorKey(int x, int y, int z)
+{
+    const quint64 sx = static_cast<quint32>(x) / RME::SECTOR_WIDTH_TILES;
+    const quint64 sy = static_cast<quint32>(y) / RME::SECTOR_WIDTH_TILES;
+    return (static_cast<quint64>(z) << 48) | (sx << 24) | sy;
+}
+
+int LightIndex::lightsForTile(const RME::core::Tile& tile, std::vector<LightSource>& out)
+{
+    int count = 0;
+    auto consider = [&](const RME::core::Item* item) {
+        if (!item || !item->hasLight()) {
+            return;
+        }
+        out.emplace_back(tile.getPosition(),
+                         QColor::fromHsv((item->getLightColor() * 137) % 360, 128, 255),
+                         item->getLightIntensity());
+        ++count;
+    };
+
+    consider(tile.getGround());
+    for (const auto& item : tile.getItems()) {
+        consider(item.get());
+    }
+    return count;
+}
+
+void LightIndex::insertLight(const LightSource& light) const
+{
+    m_sectors[sectorKey(light.position.x, light.position.y, light.position.z)].push_back(light);
+    m_maxRadius = std::max(m_maxRadius, static_cast<int>(light.intensity));
+    ++m_lightCount;
+}
+
+void LightIndex::ensureBuilt() const
+{
+    if (m_built || !m_map) {
+        return;
+    }
+    m_built = true;
+
+    std::vector<LightSource> lights;
+    m_map->forEachTile(std::function<bool(const RME::core::Tile&)>([this, &lights](const RME::core::Tile& tile) {
+        lights.clear();
+        lightsForTile(tile, lights);
+        for (const LightSource& light : lights) {
+            insertLight(light);
+        }
+        return true;
+    }));
+    qDebug() << "LightIndex: Indexed" << m_lightCount << "light sources in" << m_sectors.size() << "sectors";
+}
+
+void LightIndex::updateTile(const Position& pos)
+{
+    if (!m_built || !m_map) {
+        return; // The next query rebuilds from scratch anyway
+    }
+
+    auto it = m_sectors.find(sectorKey(pos.x, pos.y, pos.z));
+    if (it != m_sectors.end()) {
+        std::vector<LightSource>& lights = it.value();
+        const auto removed = std::remove_if(lights.begin(), lights.end(),
+            [&pos](const LightSource& light) { return light.position == pos; });
+        m_lightCount -= static_cast<int>(lights.end() - removed);
+        lights.erase(removed, lights.end());
+        if (lights.empty()) {
+            m_sectors.erase(it);
+        }
+    }
+
+    const RME::core::Tile* tile = m_map->getTile(pos);
+    if (!tile) {
+        return;
+    }
+    std::vector<LightSource> lights;
+    lightsForTile(*tile, lights);
+    for (const LightSource& light : lights) {
+        insertLight(light);
+    }
+}
+
+void LightIndex::collectLights(const QRect& area, int z, std::vector<LightSource>& out) const
+{
+    ensureBuilt();
+    if (m_sectors.isEmpty() || area.isEmpty()) {
+        return;
+    }
+
+    const int firstX = std::max(0, area.left());
+    const int firstY = std::max(0, area.top());
+    for (int sy = firstY / RME::SECTOR_WIDTH_TILES; sy <= area.bottom() / RME::SECTOR_WIDTH_TILES; ++sy) {
+        for (int sx = firstX / RME::SECTOR_WIDTH_TILES; sx <= area.right() / RME::SECTOR_WIDTH_TILES; ++sx) {
+            auto it = m_sectors.constFind(sectorKey(sx * RME::SECTOR_WIDTH_TILES, sy * RME::SECTOR_WIDTH_TILES, z));
+            if (it == m_sectors.constEnd()) {
+                continue;
+            }
+            for (const LightSource& light : it.value()) {
+                if (area.contains(light.position.x, light.position.y)) {
+                    out.push_back(light);
+                }
+            }
+        }
+    }
+}
+
+int LightIndex::getMaxRadius() const
+{
+    ensureBuilt();
+    return m_maxRadius;
+}
+
+int LightIndex::getLightCount() const
+{
+    ensureBuilt();
+    return m_lightCount;
+}
+
+} // namespace lighting
+} // namespace core
+} // namespace RME
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "LightingTypes.h"
+#include <QHash>
+#include <QRect>
+#include <vector>
+
+namespace RME {
+namespace core {
+    class Map;
+    class Tile;
+}
+}
+
+namespace RME {
+namespace core {
+namespace lighting {
+
+/**
+ * @brief Persistent index of the light-emitting tiles of a map, bucketed by sector
+ *
+ * Each sector (SECTOR_WIDTH_TILES square, per floor) keeps the light sources of
+ * its tiles, one for every light item on a tile. The index is built
+ * with one pass over the populated sectors the first time it is queried and is
+ * then kept current through updateTile(), so light queries only touch the
+ * sectors around the queried area.
+ */
+class LightIndex
+{
+public:
+    LightIndex() = default;
+
+    /**
+     * @brief Set the map to index; the index is rebuilt on the next query
+     */
+    void setMap(const RME::core::Map* map);
+
+    /**
+     * @brief Drop all entries; the index is rebuilt on the next query
+     */
+    void invalidate();
+
+    /**
+     * @brief Re-read the light of a single tile after it changed
+     */
+    void updateTile(const Position& pos);
+
+    /**
+     * @brief Append the lights on floor z whose position lies inside area (tile coordinates)
+     */
+    void collectLights(const QRect& area, int z, std::vector<LightSource>& out) const;
+
+    /**
+     * @brief Largest light radius in the index, used to widen queries
+     * Never shrinks between rebuilds, so it is always a safe bound.
+     */
+    int getMaxRadius() const;
+
+    int getLightCount() const;
+
+    /**
+     * @brief Append one light per light-emitting item of a tile, returns how many were added
+     * The light color follows the same hue mapping MapView used for item lights.
+     */
+    static int lightsForTile(const RME::core::Tile& tile, std::vector<LightSource>& out);
+
+private:
+    static quint64 sectorKey(int x, int y, int z);
+    void ensureBuilt() const;
+    void insertLight(const LightSource& light) const;
+
+    const RME::core::Map* m_map = nullptr;
+    mutable QHash<quint64, std::vector<LightSource>> m_sectors;
+    mutable int m_maxRadius = 0;
+    mutable int m_lightCount = 0;
+    mutable bool m_built = false;
+};
+
+} // namespace lighting
+} // namespace core
+} // namespace RME
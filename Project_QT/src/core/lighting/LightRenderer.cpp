@@ -5,8 +5,10 @@
 #include <QOpenGLShaderProgram>
 #include <QOpenGLBuffer>
 #include <QOpenGLVertexArrayObject>
+#include <QVector2D>
 #include <QDebug>
 #include <algorithm>
+#include <cstddef>
 
 namespace RME {
 namespace core {
@@ -50,6 +52,12 @@ bool LightRenderer::initialize()
         return false;
     }
 
+    // Not fatal, lighting falls back to the CPU path
+    m_gpuAccumulateReady = initializeGpuAccumulation();
+    if (!m_gpuAccumulateReady) {
+        qWarning() << "LightRenderer: GPU light accumulation unavailable, using per-tile CPU lighting";
+    }
+
     m_initialized = true;
     qDebug() << "LightRenderer: Initialized successfully";
     return true;
@@ -86,7 +94,11 @@ void LightRenderer::renderLighting(const Position& startPos, const Position& end
     }
 
     // Update light texture with current lighting data
-    updateLightTexture(startPos, endPos);
+    if (getRenderMode() == RenderMode::GpuAccumulate) {
+        accumulateLightTexture(startPos, endPos);
+    } else {
+        updateLightTexture(startPos, endPos);
+    }
 
     // Render the lighting overlay
     renderLightOverlay(startPos, endPos, scrollX, scrollY);
@@ -193,20 +205,141 @@ bool LightRenderer::initializeBuffers()
     return true;
 }
 
+bool LightRenderer::initializeGpuAccumulation()
+{
+    // One instance per light: the unit quad is stretched over the light's square of
+    // influence in the light texture, where one pixel is one tile.
+    const char* vertexShaderSource = R"(
+        #version 330 core
+        layout (location = 0) in vec2 aPos;
+        layout (location = 2) in vec3 aLight;   // Tile x, tile y, radius
+        layout (location = 3) in vec4 aColor;
+        layout (location = 4) in float aTileIntensity;
+
+        uniform vec2 regionSize;                // Light texture size in tiles
+
+        flat out vec3 light;
+        flat out vec3 lightColor;
+        flat out float tileIntensity;
+
+        void main() {
+            vec2 tile = aLight.xy - vec2(aLight.z) + aPos * (2.0 * aLight.z + 1.0);
+            gl_Position = vec4(tile / regionSize * 2.0 - 1.0, 0.0, 1.0);
+            light = aLight;
+            lightColor = aColor.rgb;
+            tileIntensity = aTileIntensity;
+        }
+    )";
+
+    // Same falloff as LightCalculatorService::calculateLightIntensity(); own-tile terms
+    // match the item lights of LightCalculatorService::calculateBaseLightForTile()
+    const char* fragmentShaderSource = R"(
+        #version 330 core
+        flat in vec3 light;
+        flat in vec3 lightColor;
+        flat in float tileIntensity;
+        out vec4 FragColor;
+
+        uniform float falloffFactor;
+        uniform float minIntensity;
+
+        void main() {
+            float distance = length(floor(gl_FragCoord.xy) - light.xy);
+            float intensity = tileIntensity > 0.0 ? tileIntensity : (light.z - distance) * falloffFactor;
+            if (distance > light.z || intensity <= minIntensity) {
+                discard;
+            }
+            intensity = min(intensity, 1.0);
+            FragColor = vec4(lightColor * intensity, intensity);
+        }
+    )";
+
+    m_accumShader = new QOpenGLShaderProgram(this);
+    if (!m_accumShader->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource)) {
+        qWarning() << "LightRenderer: Failed to compile accumulation vertex shader:" << m_accumShader->log();
+        return false;
+    }
+    if (!m_accumShader->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource)) {
+        qWarning() << "LightRenderer: Failed to compile accumulation fragment shader:" << m_accumShader->log();
+        return false;
+    }
+    if (!m_accumShader->link()) {
+        qWarning() << "LightRenderer: Failed to link accumulation shader program:" << m_accumShader->log();
+        return false;
+    }
+
+    m_accumVAO = new QOpenGLVertexArrayObject(this);
+    if (!m_accumVAO->create()) {
+        qWarning() << "LightRenderer: Failed to create accumulation VAO";
+        return false;
+    }
+
+    m_lightInstanceVBO = new QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
+    if (!m_lightInstanceVBO->create()) {
+        qWarning() << "LightRenderer: Failed to create light instance VBO";
+        return false;
+    }
+    m_lightInstanceVBO->setUsagePattern(QOpenGLBuffer::StreamDraw);
+
+    m_accumVAO->bind();
+
+    // Shared unit quad
+    m_quadVBO->bind();
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // Per-light attributes
+    m_lightInstanceVBO->bind();
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(LightInstance), (void*)offsetof(LightInstance, x));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(LightInstance), (void*)offsetof(LightInstance, r));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(LightInstance), (void*)offsetof(LightInstance, tileIntensity));
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+
+    m_accumVAO->release();
+    m_lightInstanceVBO->release();
+    m_quadVBO->release();
+
+    glGenFramebuffers(1, &m_accumFBO);
+    if (m_accumFBO == 0) {
+        qWarning() << "LightRenderer: Failed to create accumulation framebuffer";
+        return false;
+    }
+
+    return true;
+}
+
 void LightRenderer::cleanupOpenGL()
 {
     delete m_lightShader;
     delete m_quadVBO;
     delete m_quadVAO;
+    delete m_accumShader;
+    delete m_lightInstanceVBO;
+    delete m_accumVAO;
     
     if (m_lightTexture != 0) {
         glDeleteTextures(1, &m_lightTexture);
         m_lightTexture = 0;
     }
 
+    if (m_accumFBO != 0) {
+        glDeleteFramebuffers(1, &m_accumFBO);
+        m_accumFBO = 0;
+    }
+
     m_lightShader = nullptr;
     m_quadVBO = nullptr;
     m_quadVAO = nullptr;
+    m_accumShader = nullptr;
+    m_lightInstanceVBO = nullptr;
+    m_accumVAO = nullptr;
+    m_gpuAccumulateReady = false;
+    m_accumTargetValid = false;
 }
 
 void LightRenderer::updateLightTexture(const Position& startPos, const Position& endPos)
@@ -251,6 +384,114 @@ void LightRenderer::updateLightTexture(const Position& startPos, const Position&
 
     m_textureWidth = width;
     m_textureHeight = height;
+    m_accumTargetValid = false;
+}
+
+void LightRenderer::accumulateLightTexture(const Position& startPos, const Position& endPos)
+{
+    int width = endPos.x - startPos.x + 1;
+    int height = endPos.y - startPos.y + 1;
+
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    // Gather the lights that can reach the region, in region-relative tile coordinates
+    m_visibleLights.clear();
+    m_lightCalculatorService->collectLightsAround(startPos, endPos, m_visibleLights);
+
+    // followed by the own-tile term of each light item inside the region
+    const size_t falloffLightCount = m_visibleLights.size();
+    m_lightCalculatorService->collectTileItemLights(startPos, endPos, m_visibleLights);
+
+    m_lightInstances.clear();
+    m_lightInstances.reserve(m_visibleLights.size());
+    for (size_t i = 0; i < m_visibleLights.size(); ++i) {
+        const LightSource& light = m_visibleLights[i];
+        const bool tileTerm = i >= falloffLightCount;
+        if (light.intensity == 0) {
+            continue;
+        }
+        LightInstance instance;
+        instance.x = static_cast<GLfloat>(light.position.x - startPos.x);
+        instance.y = static_cast<GLfloat>(light.position.y - startPos.y);
+        instance.radius = tileTerm ? 0.0f : static_cast<GLfloat>(light.intensity);
+        instance.r = static_cast<GLubyte>(light.color.red());
+        instance.g = static_cast<GLubyte>(light.color.green());
+        instance.b = static_cast<GLubyte>(light.color.blue());
+        instance.a = 255;
+        instance.tileIntensity = tileTerm ? light.intensity * LightCalculatorService::LIGHT_FALLOFF_FACTOR : 0.0f;
+        m_lightInstances.push_back(instance);
+    }
+
+    // Render into the light texture, restoring the caller's target afterwards
+    GLint previousFBO = 0;
+    GLint previousViewport[4];
+    GLfloat previousClearColor[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFBO);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, previousClearColor);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_accumFBO);
+
+    if (!m_accumTargetValid || width != m_textureWidth || height != m_textureHeight) {
+        glBindTexture(GL_TEXTURE_2D, m_lightTexture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_lightTexture, 0);
+
+        m_textureWidth = width;
+        m_textureHeight = height;
+        m_accumTargetValid = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    }
+
+    if (!m_accumTargetValid) {
+        glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
+        qWarning() << "LightRenderer: Light accumulation framebuffer incomplete, switching to CPU lighting";
+        m_gpuAccumulateReady = false;
+        updateLightTexture(startPos, endPos);
+        return;
+    }
+
+    glViewport(0, 0, width, height);
+
+    // Ambient light is uniform over a floor, so it is the clear color
+    const TileLightInfo ambient = m_lightCalculatorService->getAmbientLight(startPos.z);
+    glClearColor(ambient.lightColor.redF(), ambient.lightColor.greenF(), ambient.lightColor.blueF(),
+                 std::min(1.0f, ambient.lightLevel));
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    if (!m_lightInstances.empty()) {
+        // Additive blending into a normalized target clamps like addLightContribution()
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE);
+
+        m_accumShader->bind();
+        m_accumShader->setUniformValue("regionSize", QVector2D(width, height));
+        m_accumShader->setUniformValue("falloffFactor", LightCalculatorService::LIGHT_FALLOFF_FACTOR);
+        m_accumShader->setUniformValue("minIntensity", LightCalculatorService::MIN_LIGHT_INTENSITY);
+
+        m_lightInstanceVBO->bind();
+        m_lightInstanceVBO->allocate(m_lightInstances.data(),
+                                     static_cast<int>(m_lightInstances.size() * sizeof(LightInstance)));
+        m_lightInstanceVBO->release();
+
+        m_accumVAO->bind();
+        glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, static_cast<GLsizei>(m_lightInstances.size()));
+        m_accumVAO->release();
+
+        m_accumShader->release();
+
+        // Restore normal blending
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    glClearColor(previousClearColor[0], previousClearColor[1], previousClearColor[2], previousClearColor[3]);
 }
 
 void LightRenderer::renderLightOverlay(const Position& startPos, const Position& endPos, 
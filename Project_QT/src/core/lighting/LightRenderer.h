@@ -2,7 +2,7 @@
 
 #include "LightingTypes.h"
 #include <QObject>
-#include <QOpenGLFunctions>
+#include <QOpenGLExtraFunctions>
 #include <vector>
 #include <memory>
 
@@ -29,12 +29,24 @@ class LightCalculatorService;
  * This class handles the OpenGL rendering of lighting effects calculated
  * by the LightCalculatorService. It creates a lighting overlay that can
  * be blended with the map rendering.
+ *
+ * The overlay is a texture with one texel per tile. In GpuAccumulate mode it
+ * is rendered on the GPU: only the light sources near the view are uploaded,
+ * one instance each, and a shader adds their falloff into the texture, so the
+ * CPU cost depends on the number of lights rather than the number of visible
+ * tiles. CpuTiles computes every tile with calculateLightForRegion() and
+ * uploads the result, and is used when the GPU path cannot be set up.
  */
-class LightRenderer : public QObject, protected QOpenGLFunctions
+class LightRenderer : public QObject, protected QOpenGLExtraFunctions
 {
     Q_OBJECT
 
 public:
+    enum class RenderMode {
+        CpuTiles,       ///< Per-tile light map computed on the CPU and uploaded each frame
+        GpuAccumulate   ///< Light sources uploaded and accumulated by a shader
+    };
+
     explicit LightRenderer(QObject* parent = nullptr);
     ~LightRenderer();
 
@@ -54,14 +66,23 @@ public:
     bool isEnabled() const { return m_enabled; }
     void setEnabled(bool enabled) { m_enabled = enabled; }
 
+    /**
+     * @brief Select how the light texture is produced
+     * GpuAccumulate falls back to CpuTiles if its resources failed to initialize.
+     */
+    void setRenderMode(RenderMode mode) { m_renderMode = mode; }
+    RenderMode getRenderMode() const { return m_gpuAccumulateReady ? m_renderMode : RenderMode::CpuTiles; }
+
 private:
     // OpenGL setup
     bool initializeShaders();
     bool initializeBuffers();
+    bool initializeGpuAccumulation();
     void cleanupOpenGL();
 
     // Rendering helpers
     void updateLightTexture(const Position& startPos, const Position& endPos);
+    void accumulateLightTexture(const Position& startPos, const Position& endPos);
     void renderLightOverlay(const Position& startPos, const Position& endPos, 
                            int scrollX, int scrollY);
     void renderFogOverlay(const Position& startPos, const Position& endPos, 
@@ -77,9 +98,26 @@ private:
     QOpenGLVertexArrayObject* m_quadVAO = nullptr;
     GLuint m_lightTexture = 0;
 
+    // GpuAccumulate resources; the light texture is the color attachment of m_accumFBO
+    struct LightInstance {
+        GLfloat x, y;        // Light tile relative to the top-left tile of the region
+        GLfloat radius;
+        GLubyte r, g, b, a;  // Light color, alpha unused
+        GLfloat tileIntensity; // > 0 for a light item's own-tile term (radius 0), which has no falloff
+    };
+    QOpenGLShaderProgram* m_accumShader = nullptr;
+    QOpenGLBuffer* m_lightInstanceVBO = nullptr;
+    QOpenGLVertexArrayObject* m_accumVAO = nullptr;
+    GLuint m_accumFBO = 0;
+    std::vector<LightInstance> m_lightInstances;
+    std::vector<LightSource> m_visibleLights;
+    bool m_gpuAccumulateReady = false;
+    bool m_accumTargetValid = false;   // m_lightTexture is allocated and attached as the FBO target
+
     // Rendering state
     bool m_initialized = false;
     bool m_enabled = true;
+    RenderMode m_renderMode = RenderMode::GpuAccumulate;
     std::vector<uint8_t> m_lightBuffer;
     int m_textureWidth = 0;
     int m_textureHeight = 0;
@@ -2,6 +2,7 @@
 #include "../map_constants.h"
 #include "QTreeNode.h"
 #include "MapIterator.h" // Required for method implementations
+#include "../Tile.h"
 #include <algorithm>
 #include <cmath>
 #include <QDebug>
@@ -129,6 +130,92 @@ void BaseMap::setTile(const Position& pos, std::unique_ptr<Tile> newTile) {
     // rootNode->cleanTree(); // This might be too frequent here.
 }
 
+Floor* BaseMap::getFloor(const Position& pos) {
+    return rootNode ? rootNode->getFloor(pos) : nullptr;
+}
+
+const Floor* BaseMap::getFloor(const Position& pos) const {
+    return rootNode ? static_cast<const QTreeNode*>(rootNode.get())->getFloor(pos) : nullptr;
+}
+
+bool BaseMap::adoptFloor(const Position& sectorOrigin, std::unique_ptr<Floor>& floor) {
+    if (!rootNode || !floor) {
+        return false;
+    }
+    return rootNode->adoptFloor(sectorOrigin, floor);
+}
+
+// --- Sector traversal ---
+bool BaseMap::forEachFloor(const FloorVisitor& visitor, const SectorFilter& filter) {
+    if (!rootNode) {
+        return true;
+    }
+    return rootNode->visitFloors(filter, visitor);
+}
+
+bool BaseMap::forEachFloor(const ConstFloorVisitor& visitor, const SectorFilter& filter) const {
+    if (!rootNode) {
+        return true;
+    }
+    return static_cast<const QTreeNode*>(rootNode.get())->visitFloors(filter, visitor);
+}
+
+bool BaseMap::forEachTile(const std::function<bool(Tile&)>& visitor, const SectorFilter& filter) {
+    // Sectors fully inside the bounds skip the per-tile containment check.
+    return forEachFloor(FloorVisitor([&](Floor& floor, int sectorX, int sectorY) {
+        const bool fullyInside = filter.bounds.isNull() ||
+            filter.bounds.contains(QRect(sectorX, sectorY, SECTOR_WIDTH_TILES, SECTOR_HEIGHT_TILES));
+        if (fullyInside) {
+            return floor.forEachTile(visitor);
+        }
+        return floor.forEachTile(std::function<bool(Tile&)>([&](Tile& tile) {
+            const Position& pos = tile.getPosition();
+            return !filter.bounds.contains(pos.x, pos.y) || visitor(tile);
+        }));
+    }), filter);
+}
+
+bool BaseMap::forEachTile(const std::function<bool(const Tile&)>& visitor, const SectorFilter& filter) const {
+    return forEachFloor(ConstFloorVisitor([&](const Floor& floor, int sectorX, int sectorY) {
+        const bool fullyInside = filter.bounds.isNull() ||
+            filter.bounds.contains(QRect(sectorX, sectorY, SECTOR_WIDTH_TILES, SECTOR_HEIGHT_TILES));
+        if (fullyInside) {
+            return floor.forEachTile(visitor);
+        }
+        return floor.forEachTile(std::function<bool(const Tile&)>([&](const Tile& tile) {
+            const Position& pos = tile.getPosition();
+            return !filter.bounds.contains(pos.x, pos.y) || visitor(tile);
+        }));
+    }), filter);
+}
+
+quint64 BaseMap::countTiles(const SectorFilter& filter) const {
+    quint64 count = 0;
+    if (filter.bounds.isNull()) {
+        // Whole sectors only: the per-floor counter answers without touching tiles.
+        forEachFloor(ConstFloorVisitor([&count](const Floor& floor, int, int) {
+            count += static_cast<quint64>(floor.getTileCount());
+            return true;
+        }), filter);
+        return count;
+    }
+    forEachTile(std::function<bool(const Tile&)>([&count](const Tile&) {
+        ++count;
+        return true;
+    }), filter);
+    return count;
+}
+
+QList<Position> BaseMap::getTilePositions(const SectorFilter& filter) const {
+    QList<Position> positions;
+    positions.reserve(static_cast<qsizetype>(countTiles(filter)));
+    forEachTile(std::function<bool(const Tile&)>([&positions](const Tile& tile) {
+        positions.append(tile.getPosition());
+        return true;
+    }), filter);
+    return positions;
+}
+
 // --- Iterator Methods ---
 MapIterator BaseMap::begin() {
     if (!rootNode) {
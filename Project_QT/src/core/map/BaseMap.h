@@ -6,6 +6,8 @@
 #include "../Position.h"
 #include "../../assets/AssetManager.h"
 #include <memory>
+#include <functional>
+#include <QList>
 
 namespace RME {
 
@@ -22,6 +24,12 @@ public:
     bool removeTile(const Position& pos);
     void setTile(const Position& pos, std::unique_ptr<Tile> newTile);
 
+    // Direct access to Floor sectors, used by bulk loaders that build sectors off-tree.
+    // See QTreeNode::adoptFloor for ownership rules.
+    Floor* getFloor(const Position& pos);
+    const Floor* getFloor(const Position& pos) const;
+    bool adoptFloor(const Position& sectorOrigin, std::unique_ptr<Floor>& floor);
+
     int getWidth() const { return width; }
     int getHeight() const { return height; }
     int getNumFloors() const { return floors; }
@@ -36,6 +44,18 @@ public:
     // const_MapIterator end() const;
 
 
+    // Sector-sparse traversal: only populated Floor sectors are visited, so the cost
+    // scales with the number of stored tiles rather than width x height x floors.
+    // Visitors must not add or remove tiles while the traversal is running.
+    // Each function returns false if the visitor stopped the traversal early.
+    bool forEachFloor(const FloorVisitor& visitor, const SectorFilter& filter = SectorFilter());
+    bool forEachFloor(const ConstFloorVisitor& visitor, const SectorFilter& filter = SectorFilter()) const;
+    bool forEachTile(const std::function<bool(Tile&)>& visitor, const SectorFilter& filter = SectorFilter());
+    bool forEachTile(const std::function<bool(const Tile&)>& visitor, const SectorFilter& filter = SectorFilter()) const;
+
+    quint64 countTiles(const SectorFilter& filter = SectorFilter()) const;
+    QList<Position> getTilePositions(const SectorFilter& filter = SectorFilter()) const;
+
     QTreeNode* getRootNode() const { return rootNode.get(); }
     AssetManager* getAssetManager() const { return assetManager; }
 
@@ -60,6 +60,7 @@ Tile* Floor::getOrCreateTile(int localX, int localY, bool& created, const Positi
         } else {
             tiles[index] = std::make_unique<Tile>(globalPositionForNewTile, assetManager);
         }
+        ++tileCount;
         created = true;
     }
     return tiles[index].get();
@@ -74,6 +75,7 @@ bool Floor::removeTile(int localX, int localY) {
 
     if (tiles[index]) {
         tiles[index].reset();
+        --tileCount;
         return true;
     }
     return false;
@@ -107,17 +109,38 @@ void Floor::setTile(int localX, int localY, std::unique_ptr<Tile> newTile) {
                      newTile->getPosition().x, newTile->getPosition().y, newTile->getPosition().z);
             // Option: Correct the tile's Z? Or reject? For now, allow but warn.
         }
+        if (!tiles[index]) {
+            ++tileCount;
+        }
         tiles[index] = std::move(newTile);
-    } else {
+    } else if (tiles[index]) {
         tiles[index].reset(); // Effectively removes the tile
+        --tileCount;
     }
     // No direct notification from Floor, Map will handle it.
 }
 
-bool Floor::isEmpty() const {
-    for (const auto& tilePtr : tiles) {
-        if (tilePtr) {
-            return false;
+bool Floor::forEachTile(const std::function<bool(Tile&)>& visitor) {
+    int remaining = tileCount;
+    for (int i = 0; i < tiles.size() && remaining > 0; ++i) {
+        if (Tile* tile = tiles[i].get()) {
+            --remaining;
+            if (!visitor(*tile)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool Floor::forEachTile(const std::function<bool(const Tile&)>& visitor) const {
+    int remaining = tileCount;
+    for (int i = 0; i < tiles.size() && remaining > 0; ++i) {
+        if (const Tile* tile = tiles[i].get()) {
+            --remaining;
+            if (!visitor(*tile)) {
+                return false;
+            }
         }
     }
     return true;
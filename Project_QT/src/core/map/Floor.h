@@ -6,6 +6,7 @@
 #include "../../assets/AssetManager.h" // For IItemTypeProvider
 #include <QVector>
 #include <memory> // For std::unique_ptr
+#include <functional>
 
 namespace RME {
 
@@ -27,13 +28,20 @@ public:
 
     bool removeTile(int localX, int localY);
     void setTile(int localX, int localY, std::unique_ptr<Tile> newTile);
-    bool isEmpty() const;
+    bool isEmpty() const { return tileCount == 0; }
+    int getTileCount() const { return tileCount; }
     int getZLevel() const { return zLevel; }
 
+    // Visits populated tiles in row-major order (y outer, x inner).
+    // The visitor returns false to stop; forEachTile then returns false as well.
+    bool forEachTile(const std::function<bool(Tile&)>& visitor);
+    bool forEachTile(const std::function<bool(const Tile&)>& visitor) const;
+
 private:
     int zLevel;
     AssetManager* assetManager;
     QVector<std::unique_ptr<Tile>> tiles;
+    int tileCount = 0; // Number of non-null entries in 'tiles'
 
     bool isCoordValid(int localX, int localY) const;
 };
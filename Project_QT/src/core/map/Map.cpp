@@ -74,8 +74,10 @@ bool Map::addTown(RME::core::world::TownData&& townData) {
     // QMap::insert will overwrite if key exists.
     // If we want to distinguish add vs update, check contains first.
     // bool existing = m_townsById.contains(townData.id);
-    m_townsById.insert(townData.id, std::move(townData));
-    m_maxTownId = std::max(m_maxTownId, townData.id); // Ensure m_maxTownId is updated
+    const uint32_t townId = townData.id;
+    m_townsById.insert(townId, std::move(townData));
+    m_maxTownId = std::max(m_maxTownId, townId); // Ensure m_maxTownId is updated
+    updateTownIndex(townId);
     setChanged(true);
     return true; // existing ? indicates_update : indicates_add;
                  // For now, always true on success.
@@ -99,6 +101,7 @@ const RME::core::world::TownData* Map::getTown(uint32_t townId) const {
 
 bool Map::removeTown(uint32_t townId) {
     if (m_townsById.remove(townId) > 0) {
+        m_templeIndex.removeAll(townId);
         setChanged(true);
         // Additionally, might need to update houses that reference this townId.
         // This could be a simple loop through m_housesById or a more complex notification system.
@@ -122,6 +125,20 @@ bool Map::removeTown(uint32_t townId) {
     return false;
 }
 
+bool Map::setTownTemple(uint32_t townId, const Position& templePos) {
+    RME::core::world::TownData* town = getTown(townId);
+    if (!town) {
+        qWarning("Map::setTownTemple: Town ID %u not found.", townId);
+        return false;
+    }
+    if (town->templePosition != templePos) {
+        town->templePosition = templePos;
+        updateTownIndex(townId);
+        setChanged(true);
+    }
+    return true;
+}
+
 uint32_t Map::getUnusedTownId() const {
     uint32_t currentId = m_maxTownId + 1;
     if (currentId == 0) currentId = 1; // Handle overflow or initial state (0 is invalid)
@@ -143,10 +160,12 @@ bool Map::addHouse(RME::core::houses::HouseData&& houseData) {
         qWarning("Map::addHouse: House name cannot be empty and ID cannot be 0.");
         return false;
     }
-    m_housesById.insert(houseData.id, std::move(houseData));
-    if (houseData.id > m_maxHouseId) {
-        m_maxHouseId = houseData.id;
+    const uint32_t houseId = houseData.id;
+    m_housesById.insert(houseId, std::move(houseData));
+    if (houseId > m_maxHouseId) {
+        m_maxHouseId = houseId;
     }
+    updateHouseIndex(houseId);
     setChanged(true);
     return true;
 }
@@ -199,6 +218,7 @@ bool Map::removeHouse(uint32_t houseId) {
     }
 
     m_housesById.erase(it);
+    m_houseExitIndex.removeAll(houseId);
     setChanged(true);
 
     if (houseId == m_maxHouseId) {
@@ -231,6 +251,7 @@ uint32_t Map::getUnusedHouseId() {
 void Map::clearHouses() {
     if (!m_housesById.isEmpty()) {
         m_housesById.clear();
+        m_houseExitIndex.clear();
         m_maxHouseId = 0; // Reset max ID
         setChanged(true);
         // TODO: Iterate all tiles and set tile->setHouseID(0) for all tiles
@@ -277,6 +298,8 @@ bool Map::changeHouseId(uint32_t oldId, uint32_t newId) {
     }
 
     m_housesById.insert(newId, std::move(houseData));
+    m_houseExitIndex.removeAll(oldId);
+    updateHouseIndex(newId);
     setChanged(true);
 
     m_maxHouseId = 0;
@@ -292,6 +315,44 @@ bool Map::changeHouseId(uint32_t oldId, uint32_t newId) {
     return true;
 }
 
+bool Map::setHouseExits(uint32_t houseId, const QList<Position>& exits) {
+    RME::core::houses::HouseData* house = getHouse(houseId);
+    if (!house) {
+        qWarning("Map::setHouseExits: House ID %u not found.", houseId);
+        return false;
+    }
+    if (house->exits != exits) {
+        house->exits = exits;
+        updateHouseIndex(houseId);
+        setChanged(true);
+    }
+    return true;
+}
+
+bool Map::addHouseExit(uint32_t houseId, const Position& exitPos) {
+    RME::core::houses::HouseData* house = getHouse(houseId);
+    if (!house) {
+        qWarning("Map::addHouseExit: House ID %u not found.", houseId);
+        return false;
+    }
+    if (!house->exits.contains(exitPos)) {
+        house->addExit(exitPos);
+        m_houseExitIndex.insert(houseId, exitPos.z, QRect(exitPos.x, exitPos.y, 1, 1));
+        setChanged(true);
+    }
+    return true;
+}
+
+bool Map::removeHouseExit(uint32_t houseId, const Position& exitPos) {
+    RME::core::houses::HouseData* house = getHouse(houseId);
+    if (!house || !house->removeExit(exitPos)) {
+        return false;
+    }
+    updateHouseIndex(houseId);
+    setChanged(true);
+    return true;
+}
+
 // --- Waypoints ---
 RME::core::navigation::WaypointData* Map::getWaypoint(const QString& name) {
     auto it = m_waypoints.find(name);
@@ -331,6 +392,7 @@ bool Map::removeWaypoint(const QString& name) {
 void Map::clearTowns() {
     if (!m_townsById.isEmpty()) {
         m_townsById.clear();
+        m_templeIndex.clear();
         setChanged(true);
         // Similar to removeTown, potentially update all houses to have townId = 0
         // for (auto& housePair : m_housesById) {
@@ -348,11 +410,13 @@ void Map::clearWaypoints() {
 
 // --- Spawns ---
 void Map::addSpawn(RME::core::spawns::Spawn&& spawn) {
+    indexSpawn(spawn);
     m_spawns.append(std::move(spawn));
     setChanged(true);
 }
 
 bool Map::addSpawn(const RME::core::spawns::Spawn& spawn) {
+    indexSpawn(spawn);
     m_spawns.append(spawn);
     setChanged(true);
     return true;
@@ -370,6 +434,7 @@ bool Map::removeSpawn(const RME::core::spawns::Spawn& spawn) {
     // QList::removeOne requires the type to have operator==
     bool removed = m_spawns.removeOne(spawn);
     if (removed) {
+        unindexSpawn(spawn);
         setChanged(true);
     }
     return removed;
@@ -381,6 +446,7 @@ bool Map::removeSpawnAt(const Position& pos) {
                               return spawn.getCenter() == pos;
                           });
     if (it != m_spawns.end()) {
+        unindexSpawn(*it);
         m_spawns.erase(it);
         setChanged(true);
         return true;
@@ -407,6 +473,7 @@ const RME::core::spawns::Spawn* Map::getSpawnAt(const Position& pos) const {
 void Map::clearSpawns() {
     if (!m_spawns.isEmpty()) {
         m_spawns.clear();
+        m_spawnIndex.clear();
         setChanged(true);
     }
 }
@@ -414,60 +481,118 @@ void Map::clearSpawns() {
 // --- Advanced Queries / Tile Property Queries ---
 int Map::getSpawnOverlapCount(const Position& pos) const {
     int count = 0;
-    for (const RME::core::spawns::Spawn& spawn : m_spawns) {
-        if (spawn.containsPosition(pos)) {
+    m_spawnIndex.forEachAt(pos, [&](const Position& center, const QRect& bounds) {
+        // Same circular test as Spawn::containsPosition()
+        const int radius = (bounds.width() - 1) / 2;
+        const int dx = pos.x - center.x;
+        const int dy = pos.y - center.y;
+        if (radius > 0 && dx * dx + dy * dy <= radius * radius) {
             count++;
         }
-    }
+    });
     return count;
 }
 
-TownData* Map::getTownByTempleLocation(const Position& pos) {
-    for (auto it = m_townsById.begin(); it != m_townsById.end(); ++it) {
-        if (it.value().getTemplePosition() == pos) {
-            return &it.value();
+const TownData* Map::getTownByTempleLocation(const Position& pos) const {
+    const TownData* result = nullptr;
+    m_templeIndex.forEachAt(pos, [&](uint32_t townId, const QRect&) {
+        // Entries left behind by an in-place edit that skipped updateTownIndex() are ignored
+        const TownData* town = getTown(townId);
+        if (!result && town && town->templePosition == pos) {
+            result = town;
         }
-    }
-    return nullptr;
+    });
+    return result;
 }
 
-const TownData* Map::getTownByTempleLocation(const Position& pos) const {
-    for (auto it = m_townsById.constBegin(); it != m_townsById.constEnd(); ++it) {
-        if (it.value().getTemplePosition() == pos) {
-            return &it.value();
+QList<const HouseData*> Map::getHousesWithExitAt(const Position& pos) const {
+    QList<const HouseData*> result;
+    m_houseExitIndex.forEachAt(pos, [&](uint32_t houseId, const QRect&) {
+        const HouseData* house = getHouse(houseId);
+        if (house && house->exits.contains(pos) && !result.contains(house)) {
+            result.append(house);
         }
+    });
+    return result;
+}
+
+QList<Position> Map::getSpawnCentersInArea(int z, const QRect& area) const {
+    QList<Position> centers;
+    m_spawnIndex.forEachIntersecting(z, area, [&centers](const Position& center, const QRect&) {
+        centers.append(center);
+    });
+    return centers;
+}
+
+QRect Map::spawnIndexBounds(const RME::core::spawns::Spawn& spawn) {
+    // Zero-radius spawns are still indexed by center for getSpawnCentersInArea()
+    const Position& center = spawn.getCenter();
+    const int radius = std::max(0, spawn.getRadius());
+    return QRect(center.x - radius, center.y - radius, radius * 2 + 1, radius * 2 + 1);
+}
+
+void Map::indexSpawn(const RME::core::spawns::Spawn& spawn) {
+    const Position& center = spawn.getCenter();
+    if (!center.isValid()) {
+        return;
     }
-    return nullptr;
+    m_spawnIndex.insert(center, center.z, spawnIndexBounds(spawn));
 }
 
-QList<HouseData*> Map::getHousesWithExitAt(const Position& pos) {
-    QList<HouseData*> result;
-    for (auto it = m_housesById.begin(); it != m_housesById.end(); ++it) {
-        // HouseData::getExits() returns QList<Position>
-        if (it.value().getExits().contains(pos)) {
-            result.append(&it.value());
-        }
+void Map::unindexSpawn(const RME::core::spawns::Spawn& spawn) {
+    // Only this spawn's entry; other spawns may share its center
+    const Position& center = spawn.getCenter();
+    m_spawnIndex.removeOne(center, center.z, spawnIndexBounds(spawn));
+}
+
+void Map::updateSpawnIndex(const RME::core::spawns::Spawn& oldState, const RME::core::spawns::Spawn& spawn) {
+    unindexSpawn(oldState);
+    indexSpawn(spawn);
+}
+
+void Map::updateTownIndex(uint32_t townId) {
+    m_templeIndex.removeAll(townId);
+    const RME::core::world::TownData* town = getTown(townId);
+    if (town && town->templePosition.isValid()) {
+        const Position& temple = town->templePosition;
+        m_templeIndex.insert(townId, temple.z, QRect(temple.x, temple.y, 1, 1));
     }
-    return result;
 }
 
-QList<const HouseData*> Map::getHousesWithExitAt(const Position& pos) const {
-    QList<const HouseData*> result;
-    for (auto it = m_housesById.constBegin(); it != m_housesById.constEnd(); ++it) {
-        if (it.value().getExits().contains(pos)) {
-            result.append(&it.value());
+void Map::updateHouseIndex(uint32_t houseId) {
+    m_houseExitIndex.removeAll(houseId);
+    const RME::core::houses::HouseData* house = getHouse(houseId);
+    if (!house) {
+        return;
+    }
+    for (const Position& exit : house->exits) {
+        m_houseExitIndex.insert(houseId, exit.z, QRect(exit.x, exit.y, 1, 1));
+    }
+}
+
+int Map::addTileChangeListener(TileChangeListener listener) {
+    const int listenerId = m_nextTileChangeListenerId++;
+    m_tileChangeListeners.append(qMakePair(listenerId, std::move(listener)));
+    return listenerId;
+}
+
+void Map::removeTileChangeListener(int listenerId) {
+    for (int i = 0; i < m_tileChangeListeners.size(); ++i) {
+        if (m_tileChangeListeners[i].first == listenerId) {
+            m_tileChangeListeners.removeAt(i);
+            return;
         }
     }
-    return result;
 }
 
 void Map::notifyTileChanged(const Position& pos) {
     // TODO: Add any internal map state updates if needed (e.g., dirty flags for minimap regions)
     setChanged(true); // Mark map as changed
-    // Since Map is not a QObject, we cannot emit Qt signals directly.
-    // If direct UI updates are needed, an observer pattern or callback list
-    // would be implemented here, or EditorController could manage this.
-    // For now, just marking the map as dirty is the primary effect.
+    // Since Map is not a QObject, we cannot emit Qt signals directly; registered listeners are called instead.
+    const auto listeners = m_tileChangeListeners; // Listeners may unregister themselves
+    for (const auto& listener : listeners) {
+        listener.second(pos);
+    }
     // qInfo() << "Map tile changed at:" << pos.x << pos.y << pos.z; // Optional debug log
 }
 
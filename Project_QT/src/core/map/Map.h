@@ -2,6 +2,7 @@
 #define RME_MAP_H
 
 #include "BaseMap.h"
+#include "SpatialGrid.h"
 // #include "MapElements.h" // For TownData, HouseData - Replaced by specific includes
 #include "core/houses/HouseData.h" // Corrected include path
 #include "MapElements.h" // Assuming this is for TownData etc. and does NOT define HouseData
@@ -12,6 +13,8 @@
 #include <QString>
 #include <QList>
 #include <QMap>
+#include <QRect>
+#include <functional>
 
 namespace RME {
 namespace core { // Define ClientVersionInfo within RME::core
@@ -82,6 +85,7 @@ public:
     RME::core::world::TownData* getTown(uint32_t townId);
     const RME::core::world::TownData* getTown(uint32_t townId) const;
     bool removeTown(uint32_t townId);
+    bool setTownTemple(uint32_t townId, const Position& templePos); // Keeps the temple index current
     const QMap<uint32_t, RME::core::world::TownData>& getTownsById() const { return m_townsById; } // Kept for existing compatibility
     const QMap<uint32_t, RME::core::world::TownData>& getTowns() const { return m_townsById; } // Added as per subtask
     void clearTowns(); // Added as per subtask
@@ -103,6 +107,10 @@ public:
     void clearHouses();
     uint32_t getNextFreeHouseId() const; // Renamed from getUnusedHouseId and made const
     bool changeHouseId(uint32_t oldId, uint32_t newId); // Returns true on success
+    // Exit edits through these keep the house exit index current
+    bool setHouseExits(uint32_t houseId, const QList<Position>& exits);
+    bool addHouseExit(uint32_t houseId, const Position& exitPos);
+    bool removeHouseExit(uint32_t houseId, const Position& exitPos);
 
     // --- Waypoints ---
     const QMap<QString, RME::core::navigation::WaypointData>& getWaypoints() const { return m_waypoints; }
@@ -133,17 +141,30 @@ public:
 
     /**
      * @brief Gets the town whose temple is at the given position.
+     * Read-only; move a temple with setTownTemple().
      * @return Pointer to TownData if found, nullptr otherwise.
      */
-    TownData* getTownByTempleLocation(const Position& pos);
     const TownData* getTownByTempleLocation(const Position& pos) const;
 
     /**
      * @brief Gets a list of houses that have an exit at the given position.
+     * Read-only; change exits with setHouseExits()/addHouseExit()/removeHouseExit().
      * @return QList of pointers to HouseData. List is empty if no houses have an exit there.
      */
-    QList<HouseData*> getHousesWithExitAt(const Position& pos);
-    QList<const HouseData*> getHousesWithExitAt(const Position& pos) const; // Const version
+    QList<const HouseData*> getHousesWithExitAt(const Position& pos) const;
+
+    /**
+     * @brief Gets the centers of the spawns on floor z whose area intersects 'area'.
+     */
+    QList<Position> getSpawnCentersInArea(int z, const QRect& area) const;
+
+    // Spawn radii, temples and house exits are kept in spatial indexes, so the queries above
+    // only look at entities near the position. The add/remove/change-ID and temple/exit setters
+    // keep the indexes current themselves; call these after changing an entity in place through
+    // a non-const getter. updateSpawnIndex() takes a copy of the spawn from before the change.
+    void updateSpawnIndex(const RME::core::spawns::Spawn& oldState, const RME::core::spawns::Spawn& spawn);
+    void updateTownIndex(uint32_t townId);
+    void updateHouseIndex(uint32_t houseId);
 
     /**
      * @brief Checks if a given position is a valid location for a house exit.
@@ -155,6 +176,10 @@ public:
     bool isValidHouseExitLocation(const Position& pos) const;
 
     // Tile change notification
+    // Map is not a QObject, so interested parties (e.g. the light index) register callbacks instead.
+    using TileChangeListener = std::function<void(const Position&)>;
+    int addTileChangeListener(TileChangeListener listener); // Returns an ID for removeTileChangeListener
+    void removeTileChangeListener(int listenerId);
     void notifyTileChanged(const Position& pos);
 
     // Stubs for complex map-wide operations
@@ -165,6 +190,9 @@ public:
 
 
 private:
+    QList<QPair<int, TileChangeListener>> m_tileChangeListeners;
+    int m_nextTileChangeListenerId = 1;
+
     QString m_description;
     MapVersionInfo m_versionInfo; // Stores OTBM version and potentially a single legacy client ID
     RME::core::ClientVersionInfo m_clientVersionInfo; // Stores detailed client major/minor/build
@@ -184,6 +212,14 @@ private:
     uint32_t m_maxHouseId = 0; // Tracks the highest ID ever used
     QMap<QString, RME::core::navigation::WaypointData> m_waypoints;
     QList<RME::core::spawns::Spawn> m_spawns; // Updated to use unified Spawn class
+
+    // Spatial indexes over the collections above
+    SpatialGrid<Position> m_spawnIndex;      // Keyed by spawn center, bounds = radius square
+    SpatialGrid<uint32_t> m_templeIndex;     // Keyed by town ID
+    SpatialGrid<uint32_t> m_houseExitIndex;  // Keyed by house ID, one entry per exit
+    void indexSpawn(const RME::core::spawns::Spawn& spawn);
+    void unindexSpawn(const RME::core::spawns::Spawn& spawn);
+    static QRect spawnIndexBounds(const RME::core::spawns::Spawn& spawn);
 };
 
 } // namespace RME
@@ -0,0 +1,266 @@
+#include "MinimapCache.h"
+#include "Map.h"
+#include "Floor.h"
+#include "core/Tile.h"
+#include "core/io/MinimapExporter.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QMutexLocker>
+#include <QPainter>
+#include <QSaveFile>
+#include <QDebug>
+#include <cstring>
+
+namespace RME {
+
+namespace {
+constexpr quint32 MINIMAP_CACHE_MAGIC = 0x524D4D43; // "RMMC"
+constexpr quint32 MINIMAP_CACHE_VERSION = 1;
+constexpr qint64 DEFAULT_COST_LIMIT = 64 * 1024 * 1024;
+} // namespace
+
+MinimapCache::MinimapCache()
+    : m_colorFunction([](const Tile& tile) { return RME::core::io::MinimapExporter::getTileColor(&tile).rgba(); }) {
+    m_tiles.setMaxCost(DEFAULT_COST_LIMIT);
+}
+
+MinimapCache::~MinimapCache() {
+    setMap(nullptr);
+}
+
+void MinimapCache::setMap(Map* map) {
+    if (m_map == map) {
+        return;
+    }
+    if (m_map && m_tileChangeListenerId != 0) {
+        m_map->removeTileChangeListener(m_tileChangeListenerId);
+        m_tileChangeListenerId = 0;
+    }
+    m_map = map;
+    if (m_map) {
+        m_tileChangeListenerId = m_map->addTileChangeListener([this](const Position& pos) {
+            invalidate(pos);
+        });
+    }
+    clear();
+}
+
+void MinimapCache::setTileColorFunction(TileColorFunction colorFunction) {
+    QMutexLocker locker(&m_mutex);
+    m_colorFunction = std::move(colorFunction);
+    m_tiles.clear();
+}
+
+void MinimapCache::setCostLimit(qint64 bytes) {
+    QMutexLocker locker(&m_mutex);
+    m_tiles.setMaxCost(bytes);
+}
+
+quint64 MinimapCache::tileKey(int level, int floor, int tileX, int tileY) {
+    return (static_cast<quint64>(level) << 56) | (static_cast<quint64>(floor) << 48) |
+           (static_cast<quint64>(static_cast<quint32>(tileX) & 0xFFFFFF) << 24) |
+           (static_cast<quint32>(tileY) & 0xFFFFFF);
+}
+
+QImage MinimapCache::getTile(int level, int floor, int tileX, int tileY) {
+    if (!m_map || level < 0 || level > MAX_LEVEL || floor < 0 || floor > 15 || tileX < 0 || tileY < 0) {
+        return QImage();
+    }
+
+    const quint64 key = tileKey(level, floor, tileX, tileY);
+    quint64 generation = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (const QImage* cached = m_tiles.object(key)) {
+            return *cached;
+        }
+        generation = m_generation;
+    }
+
+    QImage image;
+    if (isAreaPopulated(level, floor, tileX, tileY)) {
+        image = level == 0 ? renderSectorTile(floor, tileX, tileY) : composeFromChildren(level, floor, tileX, tileY);
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (generation == m_generation) { // Skip if the map changed while rendering
+        const qsizetype cost = image.isNull() ? 64 : image.sizeInBytes();
+        m_tiles.insert(key, new QImage(image), cost);
+    }
+    return image;
+}
+
+bool MinimapCache::isAreaPopulated(int level, int floor, int tileX, int tileY) const {
+    const int span = tileSpan(level);
+    const QRect area(tileX * span, tileY * span, span, span);
+    // forEachFloor returns false as soon as the visitor stops it at a populated sector
+    const Map* map = m_map;
+    return !map->forEachFloor(ConstFloorVisitor([](const Floor&, int, int) { return false; }),
+                              SectorFilter::forArea(area, 1u << floor));
+}
+
+QImage MinimapCache::renderSectorTile(int floor, int tileX, int tileY) const {
+    TileColorFunction colorFunction;
+    {
+        QMutexLocker locker(&m_mutex);
+        colorFunction = m_colorFunction;
+    }
+
+    QImage image(TILE_PIXELS, TILE_PIXELS, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    const QRect area(tileX * TILE_PIXELS, tileY * TILE_PIXELS, TILE_PIXELS, TILE_PIXELS);
+    bool anyPixel = false;
+
+    const Map* map = m_map;
+    map->forEachTile(std::function<bool(const Tile&)>([&](const Tile& tile) {
+        const QRgb color = colorFunction(tile);
+        if (qAlpha(color) != 0) {
+            const Position& pos = tile.getPosition();
+            image.setPixel(pos.x - area.left(), pos.y - area.top(), qPremultiply(color));
+            anyPixel = true;
+        }
+        return true;
+    }), SectorFilter::forArea(area, 1u << floor));
+
+    return anyPixel ? image : QImage();
+}
+
+QImage MinimapCache::composeFromChildren(int level, int floor, int tileX, int tileY) {
+    QImage image(TILE_PIXELS, TILE_PIXELS, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    bool anyChild = false;
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    const int half = TILE_PIXELS / 2;
+    for (int dy = 0; dy < 2; ++dy) {
+        for (int dx = 0; dx < 2; ++dx) {
+            const QImage child = getTile(level - 1, floor, tileX * 2 + dx, tileY * 2 + dy);
+            if (!child.isNull()) {
+                painter.drawImage(QRect(dx * half, dy * half, half, half), child);
+                anyChild = true;
+            }
+        }
+    }
+    painter.end();
+
+    return anyChild ? image : QImage();
+}
+
+void MinimapCache::invalidate(const Position& pos) {
+    if (pos.x < 0 || pos.y < 0 || pos.z < 0 || pos.z > 15) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    ++m_generation;
+    const int sectorX = pos.x / TILE_PIXELS;
+    const int sectorY = pos.y / TILE_PIXELS;
+    for (int level = 0; level <= MAX_LEVEL; ++level) {
+        m_tiles.remove(tileKey(level, pos.z, sectorX >> level, sectorY >> level));
+    }
+}
+
+void MinimapCache::clear() {
+    QMutexLocker locker(&m_mutex);
+    ++m_generation;
+    m_tiles.clear();
+}
+
+bool MinimapCache::saveToFile(const QString& path, qint64 sourceStamp) const {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        QMutexLocker locker(&m_mutex);
+        m_lastError = QStringLiteral("Cannot open %1 for writing: %2").arg(path, file.errorString());
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << MINIMAP_CACHE_MAGIC << MINIMAP_CACHE_VERSION << sourceStamp;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        const QList<quint64> keys = m_tiles.keys();
+        out << static_cast<quint32>(keys.size());
+        for (quint64 key : keys) {
+            const QImage* image = m_tiles.object(key);
+            out << key;
+            if (image && !image->isNull()) {
+                out << qCompress(QByteArray(reinterpret_cast<const char*>(image->constBits()), image->sizeInBytes()));
+            } else {
+                out << QByteArray(); // Empty area
+            }
+        }
+    }
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        QMutexLocker locker(&m_mutex);
+        m_lastError = QStringLiteral("Failed to write minimap cache %1").arg(path);
+        return false;
+    }
+    return true;
+}
+
+bool MinimapCache::loadFromFile(const QString& path, qint64 sourceStamp) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        QMutexLocker locker(&m_mutex);
+        m_lastError = QStringLiteral("Cannot open %1: %2").arg(path, file.errorString());
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 savedStamp = 0;
+    quint32 count = 0;
+    in >> magic >> version >> savedStamp >> count;
+    if (in.status() != QDataStream::Ok || magic != MINIMAP_CACHE_MAGIC || version != MINIMAP_CACHE_VERSION) {
+        QMutexLocker locker(&m_mutex);
+        m_lastError = QStringLiteral("%1 is not a minimap cache file").arg(path);
+        return false;
+    }
+    if (savedStamp != sourceStamp) {
+        QMutexLocker locker(&m_mutex);
+        m_lastError = QStringLiteral("Minimap cache %1 is out of date").arg(path);
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    ++m_generation;
+    m_tiles.clear();
+    for (quint32 i = 0; i < count; ++i) {
+        quint64 key = 0;
+        QByteArray compressed;
+        in >> key >> compressed;
+        if (in.status() != QDataStream::Ok) {
+            m_lastError = QStringLiteral("Minimap cache %1 is truncated").arg(path);
+            m_tiles.clear();
+            return false;
+        }
+
+        QImage image;
+        if (!compressed.isEmpty()) {
+            const QByteArray bits = qUncompress(compressed);
+            image = QImage(TILE_PIXELS, TILE_PIXELS, QImage::Format_ARGB32_Premultiplied);
+            if (bits.size() != image.sizeInBytes()) {
+                m_lastError = QStringLiteral("Minimap cache %1 is corrupt").arg(path);
+                m_tiles.clear();
+                return false;
+            }
+            std::memcpy(image.bits(), bits.constData(), static_cast<size_t>(bits.size()));
+        }
+        const qsizetype cost = image.isNull() ? 64 : image.sizeInBytes();
+        m_tiles.insert(key, new QImage(image), cost);
+    }
+    return true;
+}
+
+QString MinimapCache::getLastError() const {
+    QMutexLocker locker(&m_mutex);
+    return m_lastError;
+}
+
+} // namespace RME
@@ -0,0 +1,90 @@
+#ifndef RME_MINIMAP_CACHE_H
+#define RME_MINIMAP_CACHE_H
+
+#include "core/Position.h"
+
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QString>
+#include <QtGlobal>
+#include <functional>
+
+namespace RME {
+
+class Map;
+class Tile;
+
+// Pyramid of minimap color tiles, shared by the minimap view and minimap exports.
+//
+// A level-0 tile is one sector (SECTOR_WIDTH_TILES square) at one pixel per map
+// tile; each further level covers twice the map span in the same TILE_PIXELS
+// square, downsampled from the four tiles below it. Tiles are rendered on first
+// request from the populated sectors only, kept in a cost-bounded cache, and
+// dropped along with their ancestors when a map tile under them changes, so
+// edits never force a full regeneration. The cache can be saved next to the map
+// file and loaded back to make the minimap of a large map available at once.
+//
+// All methods are thread-safe; tiles are rendered outside the lock.
+class MinimapCache {
+public:
+    // Color of one map tile on the minimap; a transparent color leaves the pixel empty
+    using TileColorFunction = std::function<QRgb(const Tile&)>;
+
+    static constexpr int TILE_PIXELS = 32; // Same as SECTOR_WIDTH_TILES
+    static constexpr int MAX_LEVEL = 8;    // Level 8 tiles span 8192 map tiles
+
+    MinimapCache();
+    ~MinimapCache();
+
+    MinimapCache(const MinimapCache&) = delete;
+    MinimapCache& operator=(const MinimapCache&) = delete;
+
+    // Attaches to a map's tile-change notifications and drops all tiles
+    void setMap(Map* map);
+    Map* getMap() const { return m_map; }
+
+    // Drops all tiles; the default colors are those of MinimapExporter::getTileColor()
+    void setTileColorFunction(TileColorFunction colorFunction);
+
+    void setCostLimit(qint64 bytes);
+
+    // Map tiles covered by one side of a tile at 'level'
+    static int tileSpan(int level) { return TILE_PIXELS << level; }
+
+    // Tile (tileX, tileY) of the level grid on 'floor'. Returns a null image if no
+    // populated sector intersects it. Format is ARGB32_Premultiplied.
+    QImage getTile(int level, int floor, int tileX, int tileY);
+
+    // Drops the tiles containing 'pos' at every level
+    void invalidate(const Position& pos);
+    void clear();
+
+    // Persistence; 'sourceStamp' identifies the map file version (e.g. its modification
+    // time in ms) and loading fails if it does not match the saved one.
+    bool saveToFile(const QString& path, qint64 sourceStamp) const;
+    bool loadFromFile(const QString& path, qint64 sourceStamp);
+    static QString cachePathForMap(const QString& mapFilePath) { return mapFilePath + QStringLiteral(".minimap"); }
+
+    QString getLastError() const;
+
+private:
+    static quint64 tileKey(int level, int floor, int tileX, int tileY);
+    bool isAreaPopulated(int level, int floor, int tileX, int tileY) const;
+    QImage renderSectorTile(int floor, int tileX, int tileY) const;
+    QImage composeFromChildren(int level, int floor, int tileX, int tileY);
+
+    Map* m_map = nullptr;
+    int m_tileChangeListenerId = 0;
+    TileColorFunction m_colorFunction;
+
+    // Empty areas are cached as null images so they are not re-checked
+    mutable QMutex m_mutex;
+    QCache<quint64, QImage> m_tiles;
+    quint64 m_generation = 0; // Bumped on every invalidation, see getTile()
+    mutable QString m_lastError;
+};
+
+} // namespace RME
+
+#endif // RME_MINIMAP_CACHE_H
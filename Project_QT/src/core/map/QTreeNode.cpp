@@ -135,6 +135,58 @@ Tile* QTreeNode::getOrCreateTile(const Position& pos, bool& created) {
     }
 }
 
+Floor* QTreeNode::getFloor(const Position& pos) {
+    return const_cast<Floor*>(static_cast<const QTreeNode*>(this)->getFloor(pos));
+}
+
+const Floor* QTreeNode::getFloor(const Position& pos) const {
+    if (pos.x < x_coord || pos.x >= x_coord + size ||
+        pos.y < y_coord || pos.y >= y_coord + size) {
+        return nullptr;
+    }
+    if (!isLeaf()) {
+        return children[getQuadrant(pos.x, pos.y)]->getFloor(pos);
+    }
+    if (depth < MAX_DEPTH) {
+        return nullptr;
+    }
+    auto it = z_level_floors.constFind(pos.z);
+    return it != z_level_floors.constEnd() ? it.value().get() : nullptr;
+}
+
+bool QTreeNode::adoptFloor(const Position& sectorOrigin, std::unique_ptr<Floor>& floor) {
+    if (!floor) {
+        return false;
+    }
+    if (sectorOrigin.x < x_coord || sectorOrigin.x >= x_coord + size ||
+        sectorOrigin.y < y_coord || sectorOrigin.y >= y_coord + size) {
+        qWarning() << "QTreeNode::adoptFloor - Sector" << sectorOrigin.x << "," << sectorOrigin.y
+                   << "is outside node bounds (" << x_coord << "," << y_coord << "size" << size << ")";
+        return false;
+    }
+
+    if (depth < MAX_DEPTH) {
+        if (isLeaf()) {
+            subdivide();
+            if (isLeaf()) {
+                qCritical() << "QTreeNode: Failed to subdivide node at depth" << depth << "though it's not MAX_DEPTH.";
+                return false;
+            }
+        }
+        return children[getQuadrant(sectorOrigin.x, sectorOrigin.y)]->adoptFloor(sectorOrigin, floor);
+    }
+
+    if (!isLeaf() || sectorOrigin.x != x_coord || sectorOrigin.y != y_coord) {
+        return false;
+    }
+    auto it = z_level_floors.find(sectorOrigin.z);
+    if (it != z_level_floors.end() && it.value()) {
+        return false; // Caller merges tile by tile instead
+    }
+    z_level_floors.insert(sectorOrigin.z, std::move(floor));
+    return true;
+}
+
 bool QTreeNode::removeTile(const Position& pos) {
     if (pos.x < x_coord || pos.x >= x_coord + size ||
         pos.y < y_coord || pos.y >= y_coord + size) {
@@ -227,6 +279,64 @@ bool QTreeNode::isEmpty() const {
     }
 }
 
+bool QTreeNode::visitFloors(const SectorFilter& filter, const FloorVisitor& visitor) {
+    if (!filter.intersects(x_coord, y_coord, size, size)) {
+        return true;
+    }
+
+    if (!isLeaf()) {
+        for (auto& child : children) {
+            if (child && !child->visitFloors(filter, visitor)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (depth < MAX_DEPTH) {
+        return true; // Unsubdivided leaf above sector level holds no tiles
+    }
+    for (auto it = z_level_floors.begin(); it != z_level_floors.end(); ++it) {
+        Floor* floor = it.value().get();
+        if (!floor || floor->isEmpty() || !filter.acceptsFloor(it.key())) {
+            continue;
+        }
+        if (!visitor(*floor, x_coord, y_coord)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool QTreeNode::visitFloors(const SectorFilter& filter, const ConstFloorVisitor& visitor) const {
+    if (!filter.intersects(x_coord, y_coord, size, size)) {
+        return true;
+    }
+
+    if (!isLeaf()) {
+        for (const auto& child : children) {
+            if (child && !static_cast<const QTreeNode*>(child.get())->visitFloors(filter, visitor)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (depth < MAX_DEPTH) {
+        return true;
+    }
+    for (auto it = z_level_floors.constBegin(); it != z_level_floors.constEnd(); ++it) {
+        const Floor* floor = it.value().get();
+        if (!floor || floor->isEmpty() || !filter.acceptsFloor(it.key())) {
+            continue;
+        }
+        if (!visitor(*floor, x_coord, y_coord)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void QTreeNode::setTile(const Position& pos, std::unique_ptr<Tile> newTile) {
     if (pos.x < x_coord || pos.x >= x_coord + size ||
         pos.y < y_coord || pos.y >= y_coord + size) {
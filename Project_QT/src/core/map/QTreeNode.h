@@ -7,7 +7,9 @@
 #include "../../assets/AssetManager.h" // For IItemTypeProvider
 #include <array>
 #include <memory> // For std::unique_ptr
+#include <functional>
 #include <QMap>   // For z_floors if leaf node stores multiple floors per Z
+#include <QRect>
 #include <cmath>  // For std::log2
 #include <algorithm> // For std::max
 
@@ -16,6 +18,31 @@ namespace RME {
 // Forward declaration
 class Tile;
 
+// Restricts a sector traversal to a tile-space bounding box and/or a set of floors.
+// A default-constructed filter accepts every populated sector on every floor.
+struct SectorFilter {
+    static constexpr quint32 ALL_FLOORS = 0xFFFFFFFFu;
+
+    QRect bounds;                  // Null rect means no spatial restriction
+    quint32 floorMask = ALL_FLOORS; // Bit z set => floor z is visited
+
+    static SectorFilter forArea(const QRect& area, quint32 mask = ALL_FLOORS) { return SectorFilter{area, mask}; }
+    static SectorFilter forFloor(int z) { return SectorFilter{QRect(), (z >= 0 && z < 32) ? (1u << z) : 0u}; }
+
+    bool acceptsFloor(int z) const { return z >= 0 && z < 32 && (floorMask & (1u << z)) != 0; }
+    bool intersects(int x, int y, int w, int h) const {
+        return bounds.isNull() || bounds.intersects(QRect(x, y, w, h));
+    }
+    bool contains(const Position& pos) const {
+        return acceptsFloor(pos.z) && (bounds.isNull() || bounds.contains(pos.x, pos.y));
+    }
+};
+
+// Called once per populated Floor sector; sectorX/sectorY are the sector's top-left tile.
+// Return false to stop the traversal.
+using FloorVisitor = std::function<bool(Floor& floor, int sectorX, int sectorY)>;
+using ConstFloorVisitor = std::function<bool(const Floor& floor, int sectorX, int sectorY)>;
+
 class QTreeNode {
 public:
     // Constructor for a node covering a specific area and depth in the tree
@@ -39,6 +66,20 @@ public:
     bool removeTile(const Position& pos);
     void setTile(const Position& pos, std::unique_ptr<Tile> newTile);
 
+    // Returns the Floor sector covering 'pos' at pos.z, or nullptr if none is stored.
+    Floor* getFloor(const Position& pos);
+    const Floor* getFloor(const Position& pos) const;
+    // Attaches a detached Floor sector whose top-left tile is sectorOrigin, creating the
+    // branch nodes on the way. Ownership is only taken on success; fails (leaving 'floor'
+    // untouched) if a floor already exists there or sectorOrigin is not sector-aligned.
+    bool adoptFloor(const Position& sectorOrigin, std::unique_ptr<Floor>& floor);
+
+    // Depth-first walk over populated Floor sectors (children in NW, NE, SW, SE order,
+    // floors in ascending Z within a sector). Subtrees outside filter.bounds are skipped
+    // without descending. Returns false if the visitor stopped the walk.
+    bool visitFloors(const SectorFilter& filter, const FloorVisitor& visitor);
+    bool visitFloors(const SectorFilter& filter, const ConstFloorVisitor& visitor) const;
+
     // Recursively removes empty floors and nodes to save memory
     void cleanTree();
     bool isEmpty() const; // Checks if this node (and its children/floors) are all empty
@@ -0,0 +1,166 @@
+#ifndef RME_SPATIAL_GRID_H
+#define RME_SPATIAL_GRID_H
+
+#include "core/Position.h"
+
+#include <QHash>
+#include <QList>
+#include <QMultiHash>
+#include <QRect>
+#include <QtGlobal>
+#include <algorithm>
+
+namespace RME {
+
+// Uniform grid over map space, per floor, for small map entities that cover an
+// area (spawn radii, temples, house exits). Each entry is bucketed in every
+// CELL_SIZE square cell its bounds touch, so a point query only looks at the
+// entries of one cell and a rect query at the cells it overlaps.
+//
+// A key may have several entries (e.g. a house with several exits);
+// removeAll() drops all of them, removeOne() a single entry with the given
+// bounds. Owners must call remove/insert when an entity's position or extent
+// changes.
+template <typename Key>
+class SpatialGrid {
+public:
+    static constexpr int CELL_SIZE = 64;
+
+    void insert(const Key& key, int z, const QRect& bounds) {
+        if (bounds.isEmpty()) {
+            return;
+        }
+        const Entry entry{key, z, bounds};
+        m_entries.insert(key, entry);
+        forEachCell(z, bounds, [&](quint64 cell) { m_cells[cell].append(entry); });
+    }
+
+    void removeAll(const Key& key) {
+        const QList<Entry> entries = m_entries.values(key);
+        for (const Entry& entry : entries) {
+            forEachCell(entry.z, entry.bounds, [&](quint64 cell) {
+                auto it = m_cells.find(cell);
+                if (it == m_cells.end()) {
+                    return;
+                }
+                it.value().removeIf([&key](const Entry& other) { return other.key == key; });
+                if (it.value().isEmpty()) {
+                    m_cells.erase(it);
+                }
+            });
+        }
+        m_entries.remove(key);
+    }
+
+    // Removes one entry of key with exactly these bounds, e.g. one of several
+    // entities sharing a key. Returns false if there is none.
+    bool removeOne(const Key& key, int z, const QRect& bounds) {
+        auto entryIt = m_entries.find(key);
+        while (entryIt != m_entries.end() && entryIt.key() == key) {
+            if (entryIt.value().z == z && entryIt.value().bounds == bounds) {
+                break;
+            }
+            ++entryIt;
+        }
+        if (entryIt == m_entries.end() || entryIt.key() != key) {
+            return false;
+        }
+        m_entries.erase(entryIt);
+
+        forEachCell(z, bounds, [&](quint64 cell) {
+            auto it = m_cells.find(cell);
+            if (it == m_cells.end()) {
+                return;
+            }
+            QList<Entry>& entries = it.value();
+            for (qsizetype i = 0; i < entries.size(); ++i) {
+                if (entries[i].key == key && entries[i].z == z && entries[i].bounds == bounds) {
+                    entries.removeAt(i);
+                    break;
+                }
+            }
+            if (entries.isEmpty()) {
+                m_cells.erase(it);
+            }
+        });
+        return true;
+    }
+
+    void clear() {
+        m_entries.clear();
+        m_cells.clear();
+    }
+
+    bool contains(const Key& key) const { return m_entries.contains(key); }
+    int size() const { return static_cast<int>(m_entries.size()); }
+
+    // Calls visitor(key, bounds) for each entry whose bounds contain pos
+    template <typename Visitor>
+    void forEachAt(const Position& pos, Visitor&& visitor) const {
+        auto it = m_cells.constFind(cellKey(pos.z, cellIndex(pos.x), cellIndex(pos.y)));
+        if (it == m_cells.constEnd()) {
+            return;
+        }
+        for (const Entry& entry : it.value()) {
+            if (entry.z == pos.z && entry.bounds.contains(pos.x, pos.y)) {
+                visitor(entry.key, entry.bounds);
+            }
+        }
+    }
+
+    // Calls visitor(key, bounds) once for each entry on floor z whose bounds intersect area
+    template <typename Visitor>
+    void forEachIntersecting(int z, const QRect& area, Visitor&& visitor) const {
+        forEachCell(z, area, [&](quint64 cell) {
+            auto it = m_cells.constFind(cell);
+            if (it == m_cells.constEnd()) {
+                return;
+            }
+            for (const Entry& entry : it.value()) {
+                if (entry.z != z || !entry.bounds.intersects(area)) {
+                    continue;
+                }
+                // Report each entry only from the cell holding the top-left of the overlap
+                const int left = std::max(area.left(), entry.bounds.left());
+                const int top = std::max(area.top(), entry.bounds.top());
+                if (cell == cellKey(z, cellIndex(left), cellIndex(top))) {
+                    visitor(entry.key, entry.bounds);
+                }
+            }
+        });
+    }
+
+private:
+    struct Entry {
+        Key key;
+        int z;
+        QRect bounds;
+    };
+
+    static int cellIndex(int coordinate) {
+        // Floor division so negative coordinates do not share cell 0
+        return coordinate >= 0 ? coordinate / CELL_SIZE : -((-coordinate + CELL_SIZE - 1) / CELL_SIZE);
+    }
+
+    static quint64 cellKey(int z, int cellX, int cellY) {
+        return (static_cast<quint64>(static_cast<quint8>(z)) << 48) |
+               (static_cast<quint64>(static_cast<quint16>(cellX)) << 16) |
+               static_cast<quint64>(static_cast<quint16>(cellY));
+    }
+
+    template <typename CellVisitor>
+    static void forEachCell(int z, const QRect& bounds, CellVisitor&& visitor) {
+        for (int cellY = cellIndex(bounds.top()); cellY <= cellIndex(bounds.bottom()); ++cellY) {
+            for (int cellX = cellIndex(bounds.left()); cellX <= cellIndex(bounds.right()); ++cellX) {
+                visitor(cellKey(z, cellX, cellY));
+            }
+        }
+    }
+
+    QMultiHash<Key, Entry> m_entries;
+    QHash<quint64, QList<Entry>> m_cells;
+};
+
+} // namespace RME
+
+#endif // RME_SPATIAL_GRID_H
@@ -126,29 +126,24 @@ QList<Position> SpawnManager::getSelectedSpawnPositions() const {
 // Utility methods
 QList<Position> SpawnManager::getSpawnsInRadius(const Position& center, int radius) const {
     QList<Position> spawnsInRadius;
-    
-    for (const Position& spawnPos : m_spawnPositions) {
-        // Check if spawn is within radius of center (Manhattan distance)
-        int dx = abs(spawnPos.x() - center.x());
-        int dy = abs(spawnPos.y() - center.y());
-        int dz = abs(spawnPos.z() - center.z());
-        
-        if (dz == 0 && dx <= radius && dy <= radius) {
+    if (!m_map || radius < 0) {
+        return spawnsInRadius;
+    }
+
+    // The map's spawn index returns every spawn whose area touches the square,
+    // keep those whose center lies inside it (Chebyshev distance, same floor)
+    const QRect area(center.x() - radius, center.y() - radius, radius * 2 + 1, radius * 2 + 1);
+    for (const Position& spawnPos : m_map->getSpawnCentersInArea(center.z(), area)) {
+        if (area.contains(spawnPos.x(), spawnPos.y()) && m_spawnPositions.contains(spawnPos)) {
             spawnsInRadius.append(spawnPos);
         }
     }
-    
+
     return spawnsInRadius;
 }
 
 bool SpawnManager::isPositionInAnySpawn(const Position& pos) const {
-    for (const Position& spawnPos : m_spawnPositions) {
-        const Spawn* spawn = getSpawn(spawnPos);
-        if (spawn && spawn->containsPosition(pos)) {
-            return true;
-        }
-    }
-    return false;
+    return m_map && m_map->getSpawnOverlapCount(pos) > 0;
 }
 
 // Helper methods
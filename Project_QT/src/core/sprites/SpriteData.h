@@ -45,11 +45,12 @@ struct SpriteData {
     // For animated sprite (1,1,1,1,4), this has 4 SpriteFrames.
     // For layered animated (2,1,1,1,4), this has 8 SpriteFrames (L0F0, L0F1, L0F2, L0F3, L1F0, L1F1, L1F2, L1F3)
     // This list will store all image variations sequentially.
+    // Sprites loaded from a .spr leave this empty: their frames are decoded on
+    // demand by SpriteManager::getSpriteFrame(), which falls back to this list.
     QList<SpriteFrame> frames;
 
-    // Optional: Original SPR file offset and size for on-demand loading, if not pre-loading all
-    // quint32 sprFileOffset = 0;
-    // quint32 sprDataSize = 0;
+    // Offset of this sprite's pixel data in the .spr file, 0 if it has none
+    quint32 sprAddress = 0;
 
     SpriteData() = default;
 };
@@ -2,6 +2,9 @@
 #include <QFile>
 #include <QDataStream>
 #include <QXmlStreamReader> // For OTFI (OTML format)
+#include <QCache>
+#include <QMutex>
+#include <QtEndian>
 #include <QDebug>
 
 namespace RME {
@@ -9,6 +12,7 @@ namespace RME {
 const int SPRITE_DEFAULT_WIDTH = 32;
 const int SPRITE_DEFAULT_HEIGHT = 32;
 const int SPRITE_ADDRESS_TABLE_START_OFFSET = 0; // Assuming SPR address table is at the beginning
+const qint64 DEFAULT_FRAME_CACHE_BYTES = 64 * 1024 * 1024; // ~16k decoded 32x32 frames
 
 struct SpriteManager::SpriteManagerData {
     QMap<quint32, SpriteData> sprites;
@@ -17,12 +21,25 @@ struct SpriteManager::SpriteManagerData {
     quint32 sprSignature = 0; // Store SPR signature if needed for validation
     quint32 datSignature = 0; // Store DAT signature
     quint32 maxSpriteID = 0;  // Max sprite ID read from DAT counts
+
+    // The .spr stays open and mapped; frames are decoded from it on demand
+    QFile sprFile;
+    uchar* sprMapped = nullptr;      // Mapping, or nullptr when using sprFallbackData
+    QByteArray sprFallbackData;      // File contents when the file could not be mapped
+    const uchar* sprData = nullptr;  // Start of the .spr contents
+    qint64 sprSize = 0;
+
+    // Decoded frames keyed by (sprite ID << 32) | frame, cost is the image size in bytes
+    QMutex cacheMutex;
+    QCache<quint64, QImage> frameCache{DEFAULT_FRAME_CACHE_BYTES};
 };
 
 SpriteManager::SpriteManager() : d(new SpriteManagerData()) {
     invalidSpriteData.id = 0;
 }
-SpriteManager::~SpriteManager() = default;
+SpriteManager::~SpriteManager() {
+    unmapSpr();
+}
 
 const SpriteData* SpriteManager::getSpriteData(quint32 spriteID) const {
     return d->sprites.value(spriteID, &invalidSpriteData);
@@ -37,6 +54,84 @@ const QMap<quint32, SpriteData>& SpriteManager::getAllSprites() const {
     return d->sprites;
 }
 
+QImage SpriteManager::getSpriteFrame(quint32 spriteID, int frameIndex) const {
+    auto it = d->sprites.constFind(spriteID);
+    if (it == d->sprites.constEnd() || frameIndex < 0) {
+        return QImage();
+    }
+    const SpriteData& spriteData = it.value();
+
+    // Sprites built in memory carry their own frames
+    if (!spriteData.frames.isEmpty()) {
+        return frameIndex < spriteData.frames.size() ? spriteData.frames[frameIndex].image : QImage();
+    }
+    if (spriteData.sprAddress == 0 || static_cast<quint32>(frameIndex) >= spriteData.getTotalImageCount()) {
+        return QImage();
+    }
+
+    const quint64 key = (static_cast<quint64>(spriteID) << 32) | static_cast<quint32>(frameIndex);
+    {
+        QMutexLocker locker(&d->cacheMutex);
+        if (const QImage* cached = d->frameCache.object(key)) {
+            return *cached;
+        }
+    }
+
+    // Decode outside the lock so other threads keep hitting the cache meanwhile.
+    // Corrupt frames are cached as null images so they are only reported once.
+    QImage image;
+    if (!decodeSpriteFrame(spriteData, frameIndex, image)) {
+        image = QImage();
+    }
+
+    QMutexLocker locker(&d->cacheMutex);
+    d->frameCache.insert(key, new QImage(image), qMax<qsizetype>(1, image.sizeInBytes()));
+    return image;
+}
+
+int SpriteManager::getSpriteFrameCount(quint32 spriteID) const {
+    auto it = d->sprites.constFind(spriteID);
+    if (it == d->sprites.constEnd()) {
+        return 0;
+    }
+    if (!it->frames.isEmpty()) {
+        return it->frames.size();
+    }
+    return it->sprAddress != 0 ? static_cast<int>(it->getTotalImageCount()) : 0;
+}
+
+void SpriteManager::setFrameCacheLimit(qint64 bytes) {
+    QMutexLocker locker(&d->cacheMutex);
+    d->frameCache.setMaxCost(bytes);
+}
+
+qint64 SpriteManager::getFrameCacheLimit() const {
+    QMutexLocker locker(&d->cacheMutex);
+    return d->frameCache.maxCost();
+}
+
+qint64 SpriteManager::getFrameCacheUsage() const {
+    QMutexLocker locker(&d->cacheMutex);
+    return d->frameCache.totalCost();
+}
+
+void SpriteManager::unmapSpr() {
+    {
+        QMutexLocker locker(&d->cacheMutex);
+        d->frameCache.clear();
+    }
+    if (d->sprMapped) {
+        d->sprFile.unmap(d->sprMapped);
+        d->sprMapped = nullptr;
+    }
+    if (d->sprFile.isOpen()) {
+        d->sprFile.close();
+    }
+    d->sprFallbackData.clear();
+    d->sprData = nullptr;
+    d->sprSize = 0;
+}
+
 bool SpriteManager::loadOtfi(const QString& otfiPath, OtfiData& otfiDataResult) {
     QFile file(otfiPath);
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
@@ -82,22 +177,42 @@ bool SpriteManager::loadDatSpr(const QString& datPath, const QString& sprPath, c
     }
 
     QFile datFile(actualDatPath);
-    QFile sprFile(actualSprPath);
 
     if (!datFile.open(QIODevice::ReadOnly)) {
         qWarning() << "SpriteManager: Could not open DAT file:" << datFile.fileName(); return false;
     }
-    if (!sprFile.open(QIODevice::ReadOnly)) {
-        qWarning() << "SpriteManager: Could not open SPR file:" << sprFile.fileName(); return false;
+
+    unmapSpr();
+    d->sprFile.setFileName(actualSprPath);
+    if (!d->sprFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "SpriteManager: Could not open SPR file:" << d->sprFile.fileName(); return false;
+    }
+    d->sprSize = d->sprFile.size();
+    d->sprMapped = d->sprFile.map(0, d->sprSize);
+    if (d->sprMapped) {
+        d->sprData = d->sprMapped;
+    } else {
+        // Not every device supports mapping; keep the contents in memory instead
+        d->sprFallbackData = d->sprFile.readAll();
+        if (d->sprFallbackData.size() != d->sprSize) {
+            qWarning() << "SpriteManager: Could not read SPR file:" << d->sprFile.fileName();
+            unmapSpr();
+            return false;
+        }
+        d->sprData = reinterpret_cast<const uchar*>(d->sprFallbackData.constData());
+    }
+    if (d->sprSize < 4) {
+        qWarning() << "SpriteManager: SPR file too short for signature:" << d->sprFile.fileName();
+        unmapSpr();
+        return false;
     }
 
     QDataStream datStream(&datFile); datStream.setByteOrder(QDataStream::LittleEndian);
-    QDataStream sprStream(&sprFile); sprStream.setByteOrder(QDataStream::LittleEndian);
 
     d->sprites.clear();
 
     datStream >> d->datSignature;
-    sprStream >> d->sprSignature; // SPR signature often matches DAT or is related
+    d->sprSignature = qFromLittleEndian<quint32>(d->sprData); // SPR signature often matches DAT or is related
 
     // For sample.dat: ItemCount=2, OutfitCount=0, EffectCount=0, ProjectileCount=0
     // Total sprites to read metadata for = sum of these.
@@ -170,7 +285,7 @@ bool SpriteManager::loadDatSpr(const QString& datPath, const QString& sprPath, c
 
         // The actual number of images in SPR is sd.getTotalImageCount()
         // The address table in SPR is for sprite IDs up to maxSpriteID.
-        // readSpritePixelData will be called if sd.getTotalImageCount() > 0
+        // readSpriteAddress will index its pixel data if sd.getTotalImageCount() > 0
         if (sd.width > 0 && sd.height > 0 && sd.getTotalImageCount() > 0) {
             d->sprites.insert(currentID, sd); // Insert metadata first
         } else {
@@ -181,106 +296,97 @@ bool SpriteManager::loadDatSpr(const QString& datPath, const QString& sprPath, c
         }
     }
 
-    // After all metadata is read, read pixel data
+    // After all metadata is read, index the pixel data; frames are decoded on first use
     for (auto it = d->sprites.begin(); it != d->sprites.end(); ++it) {
-        if (!readSpritePixelData(it.key(), it.value(), sprStream)) {
-             qWarning() << "SpriteManager: Failed to read pixel data for sprite ID" << it.key() << ". Removing from list.";
-             // it = d->sprites.erase(it); // Careful with iterator invalidation if erasing
-             // For now, let's allow it to exist with empty frames if pixel read fails
+        if (!readSpriteAddress(it.key(), it.value())) {
+             qWarning() << "SpriteManager: Failed to read SPR address for sprite ID" << it.key() << ". Sprite will have no frames.";
+             // For now, let's allow it to exist with no frames if the address can't be read
         }
     }
 
 
     qInfo() << "SpriteManager: Loaded metadata for" << d->sprites.size() << "sprites from" << datFile.fileName()
-            << ". Pixel data processed from" << sprFile.fileName();
+            << ". Pixel data mapped from" << d->sprFile.fileName() << (d->sprMapped ? "" : "(read into memory)");
     return true;
 }
 
-bool SpriteManager::readSpritePixelData(quint32 spriteID, SpriteData& spriteData, QDataStream& sprStream) {
+bool SpriteManager::readSpriteAddress(quint32 spriteID, SpriteData& spriteData) {
+    spriteData.sprAddress = 0;
     if (spriteData.width == 0 || spriteData.height == 0 || spriteData.getTotalImageCount() == 0) {
         return true; // No pixel data to read for empty or metadata-less sprite
     }
 
-    // SPR Address Table: Read address for this specific spriteID
-    // The table size is (d->maxSpriteID + 1) * 4 bytes if IDs start from 0, or (d->maxSpriteID - firstSpriteID + 1) * 4
-    // For sample: IDs 0, 1, 2. maxSpriteID = 2 (if firstID=0). Table size = 3*4 = 12 bytes.
-    // If firstSpriteID=1, maxSpriteID=2. IDs are 1,2. Table needs to map these.
-    // RME SPR files usually have addresses for IDs 1 through maxSpriteID.
+    // SPR Address Table: one 32-bit address per sprite ID.
     // The sample SPR was created with addresses for ID 0, 1, 2.
-
-    quint32 addressTableOffset = SPRITE_ADDRESS_TABLE_START_OFFSET + (spriteID * 4); // Assuming IDs in table are contiguous from 0
-    if (sprStream.device()->size() < static_cast<qint64>(addressTableOffset + 4)) {
+    const qint64 addressTableOffset = SPRITE_ADDRESS_TABLE_START_OFFSET + static_cast<qint64>(spriteID) * 4; // Assuming IDs in table are contiguous from 0
+    if (d->sprSize < addressTableOffset + 4) {
         qWarning() << "SpriteManager: SPR file too small for address table for sprite ID" << spriteID;
         return false;
     }
-    sprStream.device()->seek(addressTableOffset);
 
-    quint32 address;
-    sprStream >> address;
-    if (sprStream.status() != QDataStream::Ok) {
-        qWarning() << "SpriteManager: Failed to read SPR address for sprite ID" << spriteID;
+    const quint32 address = qFromLittleEndian<quint32>(d->sprData + addressTableOffset);
+    if (address >= d->sprSize) {
+        qWarning() << "SpriteManager: SPR address" << address << "out of range for sprite ID" << spriteID;
         return false;
     }
-    if (address == 0) { // Sprite is empty / does not exist in SPR
-        spriteData.frames.clear(); // Ensure no frames if address is 0
-        return true;
-    }
-
-    qint64 previousPos = sprStream.device()->pos(); // This is not needed if we read all addresses first
-                                                 // But for one-by-one, we seek to 'address'
-    sprStream.device()->seek(address);
+    spriteData.sprAddress = address; // 0 means the sprite is empty / does not exist in SPR
+    return true;
+}
 
-    quint32 numPixelsPerFrame = spriteData.width * spriteData.height;
+bool SpriteManager::decodeSpriteFrame(const SpriteData& spriteData, int frameIndex, QImage& image) const {
+    if (!d->sprData || spriteData.sprAddress == 0) {
+        return false;
+    }
 
-    for (quint32 i = 0; i < spriteData.getTotalImageCount(); ++i) {
-        if (sprStream.atEnd()) {
-            qWarning() << "SpriteManager: Unexpected end of SPR file for sprite ID" << spriteID << "frame" << i;
-            return false;
+    const quint32 width = spriteData.width;
+    const quint32 numPixelsPerFrame = spriteData.width * spriteData.height;
+    const uchar* p = d->sprData + spriteData.sprAddress;
+    const uchar* const end = d->sprData + d->sprSize;
+
+    // Frames are stored back to back; walk the run headers of earlier frames to find ours
+    for (int frame = 0; frame <= frameIndex; ++frame) {
+        const bool decode = (frame == frameIndex);
+        if (decode) {
+            image = QImage(spriteData.width, spriteData.height, QImage::Format_ARGB32);
+            image.fill(Qt::transparent);
         }
 
-        QImage image(spriteData.width, spriteData.height, QImage::Format_ARGB32);
-        image.fill(Qt::transparent);
-
         quint32 currentPixelCount = 0; // Pixels filled in current image
-        while(currentPixelCount < numPixelsPerFrame) {
-            quint16 transparentPixels, coloredPixels;
-            sprStream >> transparentPixels >> coloredPixels;
-
-            if (sprStream.status() != QDataStream::Ok) {
-                qWarning() << "SpriteManager: SPR stream error reading pixel counts for sprite" << spriteID << "frame" << i;
+        while (currentPixelCount < numPixelsPerFrame) {
+            if (end - p < 4) {
+                qWarning() << "SpriteManager: Unexpected end of SPR file for sprite ID" << spriteData.id << "frame" << frame;
                 return false;
             }
+            const quint16 transparentPixels = qFromLittleEndian<quint16>(p);
+            const quint16 coloredPixels = qFromLittleEndian<quint16>(p + 2);
+            p += 4;
 
-            // Advance for transparent pixels
+            if (transparentPixels == 0 && coloredPixels == 0) {
+                qWarning() << "SpriteManager: Empty SPR pixel run for sprite" << spriteData.id << "frame" << frame;
+                return false;
+            }
+            // Advance for transparent pixels, then the colored run must fit the frame
             currentPixelCount += transparentPixels;
-            if (currentPixelCount > numPixelsPerFrame) { // Should not happen
-                 qWarning() << "SpriteManager: SPR transparent pixel run overflow for sprite" << spriteID << "frame" << i; return false;
+            if (currentPixelCount + coloredPixels > numPixelsPerFrame) {
+                qWarning() << "SpriteManager: SPR pixel run overflow for sprite" << spriteData.id << "frame" << frame;
+                return false;
+            }
+            if (end - p < 3 * static_cast<qint64>(coloredPixels)) {
+                qWarning() << "SpriteManager: Unexpected end of SPR file reading RGB for sprite" << spriteData.id << "frame" << frame;
+                return false;
             }
 
-            // Read and set colored pixels
-            for (quint16 p = 0; p < coloredPixels; ++p) {
-                if (currentPixelCount >= numPixelsPerFrame) {
-                    qWarning() << "SpriteManager: SPR colored pixel run overflow for sprite" << spriteID << "frame" << i; return false;
-                }
-                quint8 r, g, b;
-                sprStream >> r >> g >> b;
-                if (sprStream.status() != QDataStream::Ok) {
-                     qWarning() << "SpriteManager: SPR stream error reading RGB for sprite" << spriteID << "frame" << i; return false;
-                }
-
-                quint32 y = currentPixelCount / spriteData.width;
-                quint32 x = currentPixelCount % spriteData.width;
-                image.setPixel(x, y, qRgba(r, g, b, 255));
-                currentPixelCount++;
+            if (!decode) {
+                p += 3 * coloredPixels;
+                currentPixelCount += coloredPixels;
+                continue;
+            }
+            for (quint16 i = 0; i < coloredPixels; ++i, ++currentPixelCount, p += 3) {
+                QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(currentPixelCount / width));
+                line[currentPixelCount % width] = qRgba(p[0], p[1], p[2], 255);
             }
         }
-        spriteData.frames.append({image});
     }
-    // Restore stream position? Not strictly needed if addresses are absolute and always re-sought.
-    // However, the original code saved and restored previousPos around a single sprite's full data read,
-    // which is only correct if the outer loop is also seeking for each sprite ID's address.
-    // The current refined logic reads metadata for ALL sprites first, then iterates through the sprite map
-    // to call readSpritePixelData. This is better. So, no need to restore previousPos here.
     return true;
 }
 
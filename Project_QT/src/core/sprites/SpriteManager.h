@@ -5,6 +5,7 @@
 #include "../assets/ClientProfile.h" // For DatFormat
 #include <QMap>
 #include <QString>
+#include <QImage>
 #include <QScopedPointer>
 
 // Forward declare QDataStream if it's only used in .cpp for parameters
@@ -23,6 +24,15 @@ struct OtfiData {
 };
 
 
+/**
+ * @brief Owns the client's sprite metadata and pixel data.
+ *
+ * loadDatSpr() only reads the DAT metadata and the .spr address table; the .spr
+ * itself stays memory-mapped. Frames are decoded the first time they are asked
+ * for through getSpriteFrame() and kept in an LRU cache bounded by decoded bytes,
+ * so memory follows what is actually drawn rather than the size of the client.
+ * getSpriteFrame() may be called from any thread.
+ */
 class SpriteManager {
 public:
     SpriteManager();
@@ -37,9 +47,19 @@ public:
     // Optional: Load OTFI to override paths or sprite properties
     bool loadOtfi(const QString& otfiPath, OtfiData& otfiDataResult); // Parses OTFI into struct
 
+    // Metadata only; use getSpriteFrame() for pixels
     const SpriteData* getSpriteData(quint32 spriteID) const;
     const SpriteData& getDefaultSpriteData() const; // For invalid IDs
 
+    // Decoded image for one frame of a sprite, a null QImage if it has none
+    QImage getSpriteFrame(quint32 spriteID, int frameIndex = 0) const;
+    int getSpriteFrameCount(quint32 spriteID) const;
+
+    // Upper bound for decoded frames kept in memory, in bytes
+    void setFrameCacheLimit(qint64 bytes);
+    qint64 getFrameCacheLimit() const;
+    qint64 getFrameCacheUsage() const;
+
     int getSpriteCount() const;
     const QMap<quint32, SpriteData>& getAllSprites() const; // For iteration, if needed
 
@@ -47,10 +67,12 @@ private:
     // DAT parsing helpers based on DatFormat
     // bool parseDat(QDataStream& stream, const ClientProfile& clientProfile); // This seems to be integrated into loadDatSpr
 
-    // SPR reading helper
-    // It's called multiple times by loadDatSpr for each sprite ID entry.
-    // sprStream should be an open QDataStream for the .spr file.
-    bool readSpritePixelData(quint32 spriteID, SpriteData& spriteData, QDataStream& sprStream);
+    // SPR helpers, working on the mapped .spr
+    // Looks up the sprite's entry in the address table and stores it in spriteData.sprAddress.
+    bool readSpriteAddress(quint32 spriteID, SpriteData& spriteData);
+    // Decodes one RLE-compressed frame; earlier frames of the sprite are skipped without decoding.
+    bool decodeSpriteFrame(const SpriteData& spriteData, int frameIndex, QImage& image) const;
+    void unmapSpr();
 
     struct SpriteManagerData; // PIMPL
     QScopedPointer<SpriteManagerData> d;
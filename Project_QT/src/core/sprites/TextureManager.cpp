@@ -32,8 +32,14 @@ bool TextureManager::initialize()
     }
 
     // Initialize OpenGL functions
-    if (!initializeOpenGLFunctions()) {
-        qWarning() << "TextureManager: Failed to initialize OpenGL functions";
+    initializeOpenGLFunctions();
+
+    // One 32x32 frame per layer; stay within what the driver supports
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    m_layersPerPage = qMin<int>(maxLayers, MAX_LAYERS_PER_PAGE);
+    if (m_layersPerPage <= 0) {
+        qWarning() << "TextureManager: Array textures are not supported by this context";
         return false;
     }
 
@@ -51,46 +57,148 @@ void TextureManager::setSpriteManager(SpriteManager* spriteManager)
     }
 }
 
-GLuint TextureManager::getTextureForSprite(quint32 spriteId)
+bool TextureManager::getAtlasSlot(quint32 spriteId, int frameIndex, AtlasSlot& slot)
 {
     if (!m_initialized || !m_spriteManager) {
-        return 0;
+        return false;
     }
 
-    // Check if texture is already cached
-    auto it = m_spriteTextures.find(spriteId);
-    if (it != m_spriteTextures.end()) {
-        return it.value();
+    const quint64 key = slotKey(spriteId, frameIndex);
+    auto it = m_slotLookup.constFind(key);
+    if (it != m_slotLookup.constEnd()) {
+        SlotEntry& entry = m_slots[it.value()];
+        entry.lastUsed = m_frameStamp;
+        entry.referenced = true;
+        slot.page = static_cast<quint16>(it.value() / m_layersPerPage);
+        slot.layer = static_cast<quint16>(it.value() % m_layersPerPage);
+        return true;
     }
 
-    // Get sprite data from SpriteManager
-    const SpriteData* spriteData = m_spriteManager->getSpriteData(spriteId);
-    if (!spriteData) {
-        qWarning() << "TextureManager: Sprite" << spriteId << "not found in SpriteManager";
-        return 0;
+    // Decoded on demand by SpriteManager
+    if (frameIndex < 0 || frameIndex >= m_spriteManager->getSpriteFrameCount(spriteId)) {
+        qWarning() << "TextureManager: Invalid frame index" << frameIndex << "for sprite" << spriteId
+                   << "(has" << m_spriteManager->getSpriteFrameCount(spriteId) << "frames)";
+        return false;
     }
 
-    // Get the first frame image (for now, animation support can be added later)
-    if (spriteData->frames.isEmpty()) {
-        qWarning() << "TextureManager: Sprite" << spriteId << "has no frames";
-        return 0;
+    const QImage frameImage = m_spriteManager->getSpriteFrame(spriteId, frameIndex);
+    if (frameImage.isNull()) {
+        qWarning() << "TextureManager: Sprite" << spriteId << "frame" << frameIndex << "has null image";
+        return false;
     }
 
-    const QImage& spriteImage = spriteData->frames.first().image;
-    if (spriteImage.isNull()) {
-        qWarning() << "TextureManager: Sprite" << spriteId << "has null image";
-        return 0;
+    const int slotIndex = allocateSlot();
+    if (slotIndex < 0) {
+        if (!m_atlasFullWarned) {
+            qWarning() << "TextureManager: Sprite atlas is full with frames used by the current frame";
+            m_atlasFullWarned = true;
+        }
+        return false;
     }
 
-    // Create OpenGL texture
-    GLuint textureId = createTextureFromQImage(spriteImage);
-    if (textureId != 0) {
-        // Cache the texture
-        m_spriteTextures[spriteId] = textureId;
-        qDebug() << "TextureManager: Created texture" << textureId << "for sprite" << spriteId;
+    if (!uploadFrame(slotIndex, frameImage)) {
+        return false;
     }
 
-    return textureId;
+    SlotEntry& entry = m_slots[slotIndex];
+    entry.key = key;
+    entry.lastUsed = m_frameStamp;
+    entry.referenced = true;
+    entry.occupied = true;
+    m_slotLookup.insert(key, slotIndex);
+
+    slot.page = static_cast<quint16>(slotIndex / m_layersPerPage);
+    slot.layer = static_cast<quint16>(slotIndex % m_layersPerPage);
+    return true;
+}
+
+int TextureManager::allocateSlot()
+{
+    // Fill every slot of the allocated pages first, then grow by a page
+    if (m_nextFreeSlot < m_slots.size() || (m_pages.size() < MAX_ATLAS_PAGES && allocatePage())) {
+        return m_nextFreeSlot++;
+    }
+
+    // Clock sweep: frames drawn since the hand last passed get a second chance,
+    // frames drawn in the current frame are never taken. Two passes are enough
+    // to clear every referenced bit.
+    const int slotCount = m_slots.size();
+    for (int step = 0; step < 2 * slotCount; ++step) {
+        const int index = m_clockHand;
+        m_clockHand = (m_clockHand + 1) % slotCount;
+
+        SlotEntry& entry = m_slots[index];
+        if (entry.lastUsed == m_frameStamp) {
+            continue;
+        }
+        if (entry.referenced) {
+            entry.referenced = false;
+            continue;
+        }
+
+        if (entry.occupied) {
+            m_slotLookup.remove(entry.key);
+            entry.occupied = false;
+        }
+        return index;
+    }
+
+    return -1;
+}
+
+bool TextureManager::allocatePage()
+{
+    GLuint textureId = 0;
+    glGenTextures(1, &textureId);
+    if (textureId == 0) {
+        qWarning() << "TextureManager: Failed to generate atlas page texture";
+        return false;
+    }
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureId);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, SLOT_SIZE, SLOT_SIZE, m_layersPerPage,
+                 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    // Set texture parameters for pixel-perfect 2D rendering
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+        qWarning() << "TextureManager: OpenGL error allocating atlas page:" << error;
+        glDeleteTextures(1, &textureId);
+        return false;
+    }
+
+    m_pages.append(textureId);
+    m_slots.resize(m_pages.size() * m_layersPerPage);
+    qDebug() << "TextureManager: Allocated atlas page" << m_pages.size() - 1 << "with" << m_layersPerPage << "layers";
+    return true;
+}
+
+bool TextureManager::uploadFrame(int slotIndex, const QImage& image)
+{
+    // Frames are drawn as one tile, so anything that is not 32x32 is resampled to fit a layer
+    QImage glImage = image.convertToFormat(QImage::Format_RGBA8888);
+    if (glImage.width() != SLOT_SIZE || glImage.height() != SLOT_SIZE) {
+        glImage = glImage.scaled(SLOT_SIZE, SLOT_SIZE, Qt::IgnoreAspectRatio, Qt::FastTransformation);
+    }
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_pages[slotIndex / m_layersPerPage]);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, slotIndex % m_layersPerPage,
+                    SLOT_SIZE, SLOT_SIZE, 1, GL_RGBA, GL_UNSIGNED_BYTE, glImage.constBits());
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+        qWarning() << "TextureManager: OpenGL error uploading atlas layer:" << error;
+        return false;
+    }
+    return true;
 }
 
 GLuint TextureManager::createTextureFromQImage(const QImage& image)
@@ -138,62 +246,13 @@ GLuint TextureManager::createTextureFromQImage(const QImage& image)
     return textureId;
 }
 
-GLuint TextureManager::getTextureForSpriteFrame(quint32 spriteId, int frameIndex)
-{
-    if (!m_initialized || !m_spriteManager) {
-        return 0;
-    }
-
-    // Check if frame texture is already cached
-    QPair<quint32, int> frameKey(spriteId, frameIndex);
-    auto it = m_frameTextures.find(frameKey);
-    if (it != m_frameTextures.end()) {
-        return it.value();
-    }
-
-    // Get sprite data from SpriteManager
-    const SpriteData* spriteData = m_spriteManager->getSpriteData(spriteId);
-    if (!spriteData) {
-        qWarning() << "TextureManager: Sprite" << spriteId << "not found in SpriteManager";
-        return 0;
-    }
-
-    // Check if frame index is valid
-    if (frameIndex < 0 || frameIndex >= spriteData->frames.size()) {
-        qWarning() << "TextureManager: Invalid frame index" << frameIndex << "for sprite" << spriteId 
-                   << "(has" << spriteData->frames.size() << "frames)";
-        return 0;
-    }
-
-    const QImage& frameImage = spriteData->frames[frameIndex].image;
-    if (frameImage.isNull()) {
-        qWarning() << "TextureManager: Sprite" << spriteId << "frame" << frameIndex << "has null image";
-        return 0;
-    }
-
-    // Create OpenGL texture for this frame
-    GLuint textureId = createTextureFromQImage(frameImage);
-    if (textureId != 0) {
-        // Cache the frame texture
-        m_frameTextures[frameKey] = textureId;
-        qDebug() << "TextureManager: Created texture" << textureId << "for sprite" << spriteId << "frame" << frameIndex;
-    }
-
-    return textureId;
-}
-
 int TextureManager::getSpriteFrameCount(quint32 spriteId) const
 {
     if (!m_spriteManager) {
         return 0;
     }
 
-    const SpriteData* spriteData = m_spriteManager->getSpriteData(spriteId);
-    if (!spriteData) {
-        return 0;
-    }
-
-    return spriteData->frames.size();
+    return m_spriteManager->getSpriteFrameCount(spriteId);
 }
 
 void TextureManager::clearCache()
@@ -202,26 +261,18 @@ void TextureManager::clearCache()
         return;
     }
 
-    // Delete all cached textures
-    for (auto it = m_spriteTextures.begin(); it != m_spriteTextures.end(); ++it) {
-        deleteTexture(it.value());
-    }
-    
-    // Delete all cached frame textures
-    for (auto it = m_frameTextures.begin(); it != m_frameTextures.end(); ++it) {
-        deleteTexture(it.value());
+    // Delete all atlas pages
+    if (!m_pages.isEmpty()) {
+        glDeleteTextures(m_pages.size(), m_pages.constData());
     }
-    
-    m_spriteTextures.clear();
-    m_frameTextures.clear();
-    qDebug() << "TextureManager: Cleared texture cache";
-}
 
-void TextureManager::deleteTexture(GLuint textureId)
-{
-    if (textureId != 0 && m_initialized) {
-        glDeleteTextures(1, &textureId);
-    }
+    m_pages.clear();
+    m_slots.clear();
+    m_slotLookup.clear();
+    m_nextFreeSlot = 0;
+    m_clockHand = 0;
+    m_atlasFullWarned = false;
+    qDebug() << "TextureManager: Cleared texture cache";
 }
 
 } // namespace sprites
@@ -2,7 +2,8 @@
 
 #include <QObject>
 #include <QHash>
-#include <QOpenGLFunctions>
+#include <QVector>
+#include <QOpenGLExtraFunctions>
 #include <QImage>
 
 namespace RME {
@@ -12,16 +13,35 @@ namespace sprites {
 class SpriteManager;
 
 /**
- * @brief Simple texture manager for 2D sprite rendering
- * 
- * Converts SpriteManager QImages to OpenGL textures for immediate mode rendering.
- * Uses simple texture caching for performance.
+ * @brief Texture manager for 2D sprite rendering
+ *
+ * Sprite frames are packed into a small number of GL_TEXTURE_2D_ARRAY "pages",
+ * one 32x32 frame per array layer, so a renderer can draw any mix of sprites
+ * from one vertex stream with the pages bound once instead of binding a texture
+ * per sprite.
+ *
+ * Frames are uploaded on first use. When every layer is taken, the least
+ * recently drawn frames are evicted with a clock sweep; frames used in the
+ * current frame (see beginFrame()) are never evicted, so slots handed out while
+ * building a batch stay valid until it is drawn.
  */
-class TextureManager : public QObject, protected QOpenGLFunctions
+class TextureManager : public QObject, protected QOpenGLExtraFunctions
 {
     Q_OBJECT
 
 public:
+    static constexpr int SLOT_SIZE = 32;          ///< Width and height of one atlas layer in pixels
+    static constexpr int MAX_ATLAS_PAGES = 4;     ///< Upper bound on array textures
+    static constexpr int MAX_LAYERS_PER_PAGE = 2048;
+
+    /**
+     * @brief Location of a sprite frame in the atlas
+     */
+    struct AtlasSlot {
+        quint16 page = 0;  ///< Index into the atlas pages, see getAtlasPageTexture()
+        quint16 layer = 0; ///< Layer within the page's array texture
+    };
+
     explicit TextureManager(QObject* parent = nullptr);
     ~TextureManager();
 
@@ -37,16 +57,27 @@ public:
     void setSpriteManager(SpriteManager* spriteManager);
 
     /**
-     * @brief Get OpenGL texture ID for a sprite
-     * Creates texture if not cached, returns 0 if sprite not found
+     * @brief Start a new rendered frame
+     * Slots returned before the next call are protected from eviction.
+     */
+    void beginFrame() { ++m_frameStamp; }
+
+    /**
+     * @brief Get the atlas slot for a sprite frame, uploading it if needed
+     * Returns false if the sprite or frame does not exist, or the atlas is full
+     * with frames already used in the current frame.
+     */
+    bool getAtlasSlot(quint32 spriteId, int frameIndex, AtlasSlot& slot);
+
+    /**
+     * @brief Get the GL_TEXTURE_2D_ARRAY name of an atlas page, 0 if not allocated
      */
-    GLuint getTextureForSprite(quint32 spriteId);
+    GLuint getAtlasPageTexture(int page) const { return page < m_pages.size() ? m_pages[page] : 0; }
 
     /**
-     * @brief Get OpenGL texture ID for a specific sprite frame
-     * Supports animation by allowing frame selection
+     * @brief Get number of allocated atlas pages
      */
-    GLuint getTextureForSpriteFrame(quint32 spriteId, int frameIndex = 0);
+    int getAtlasPageCount() const { return m_pages.size(); }
 
     /**
      * @brief Create OpenGL texture from QImage
@@ -55,14 +86,14 @@ public:
     GLuint createTextureFromQImage(const QImage& image);
 
     /**
-     * @brief Clear all cached textures
+     * @brief Drop all atlas contents and delete the atlas pages
      */
     void clearCache();
 
     /**
-     * @brief Get number of cached textures
+     * @brief Get number of sprite frames resident in the atlas
      */
-    int getCachedTextureCount() const { return m_spriteTextures.size(); }
+    int getCachedTextureCount() const { return m_slotLookup.size(); }
 
     /**
      * @brief Get number of frames for a sprite (for animation)
@@ -70,17 +101,37 @@ public:
     int getSpriteFrameCount(quint32 spriteId) const;
 
 private:
+    struct SlotEntry {
+        quint64 key = 0;      ///< (sprite ID << 32) | frame, valid when occupied
+        quint32 lastUsed = 0; ///< Frame stamp of the last getAtlasSlot() hit
+        bool referenced = false; ///< Second-chance bit, cleared by the eviction sweep
+        bool occupied = false;
+    };
+
+    static quint64 slotKey(quint32 spriteId, int frameIndex) {
+        return (static_cast<quint64>(spriteId) << 32) | static_cast<quint32>(frameIndex);
+    }
+
     /**
-     * @brief Delete OpenGL texture and remove from cache
+     * @brief Find a free or evictable slot, allocating a new page if needed
+     * Returns -1 if every slot is in use by the current frame.
      */
-    void deleteTexture(GLuint textureId);
+    int allocateSlot();
+    bool allocatePage();
+    bool uploadFrame(int slotIndex, const QImage& image);
 
     SpriteManager* m_spriteManager = nullptr;
-    QHash<quint32, GLuint> m_spriteTextures; // Sprite ID -> OpenGL texture ID (first frame)
-    QHash<QPair<quint32, int>, GLuint> m_frameTextures; // (Sprite ID, Frame) -> OpenGL texture ID
+    QVector<GLuint> m_pages;                 // GL_TEXTURE_2D_ARRAY per page
+    QVector<SlotEntry> m_slots;              // pages * m_layersPerPage entries
+    QHash<quint64, int> m_slotLookup;        // slotKey -> index into m_slots
+    int m_layersPerPage = 0;
+    int m_nextFreeSlot = 0;                  // Slots below this have been handed out at least once
+    int m_clockHand = 0;                     // Eviction sweep position
+    quint32 m_frameStamp = 1;
+    bool m_atlasFullWarned = false;
     bool m_initialized = false;
 };
 
 } // namespace sprites
 } // namespace core
-} // namespace RME
\ No newline at end of file
+} // namespace RME
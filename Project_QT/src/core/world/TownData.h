@@ -12,7 +12,7 @@ class TownData {
 public:
     uint32_t id = 0;
     QString name;
-    Position templePosition;
+    Position templePosition; // For a town owned by a Map, change it with Map::setTownTemple()
 
     TownData() = default; // Explicit default constructor
     TownData(uint32_t id_, const QString& name_, const Position& templePos_)
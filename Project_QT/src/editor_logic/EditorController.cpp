@@ -40,6 +40,7 @@
 #include "editor_logic/commands/RemoveSpawnCommand.h" // Added for LOGIC-07
 #include "editor_logic/commands/MapWideOperationCommand.h" // Added for LOGIC-09
 #include "core/io/OtbmMapIO.h" // Added for FINAL-01
+#include "core/io/MinimapExporter.h"
 #include "core/actions/TileChangeCommand.h" // Added for TASK_001
 #include "editor_logic/commands/RecordSetGroundCommand.h" // Added for TASK_001
 #include "editor_logic/commands/RecordAddRemoveItemCommand.h" // Added for TASK_001
@@ -94,6 +95,7 @@ void EditorController::initializeDependencies()
     // Get from map when map is loaded
     m_housesManager = nullptr; // Will be set when map is loaded via setMap()
     m_clipboardManager = new RME::core::clipboard::ClipboardManager(this);
+    m_clipboardManager->setAppSettings(m_appSettings);
     m_waypointManager = new RME::core::waypoints::WaypointManager(this);
     
     qDebug() << "EditorController: Dependencies initialized from services";
@@ -1527,64 +1529,26 @@ bool EditorController::exportMiniMap(const QString& filename, int floor, bool sh
         exportFloor = 7; // Default to ground floor
     }
     
-    // Create a QImage for the minimap
+    // Ensure reasonable dimensions
     int mapWidth = m_map->getWidth();
     int mapHeight = m_map->getHeight();
-    
-    // Ensure reasonable dimensions
-    if (mapWidth <= 0 || mapHeight <= 0 || mapWidth > 65535 || mapHeight > 65535) {
+    if (mapWidth <= 0 || mapHeight <= 0) {
         qWarning("EditorController::exportMiniMap: Invalid map dimensions: %d x %d",
                  mapWidth, mapHeight);
         return false;
     }
     
-    // Create image with map dimensions
-    QImage minimap(mapWidth, mapHeight, QImage::Format_ARGB32);
-    minimap.fill(Qt::transparent);
-    
-    // Render the map to the image
-    QPainter painter(&minimap);
-    
-    // Iterate through all tiles on the specified floor
-    for (int x = 0; x < mapWidth; ++x) {
-        for (int y = 0; y < mapHeight; ++y) {
-            RME::core::Position pos(x, y, exportFloor);
-            const RME::core::Tile* tile = m_map->getTile(pos);
-            
-            if (tile) {
-                // Determine tile color based on its properties
-                QColor tileColor;
-                
-                if (tile->hasGround()) {
-                    // Ground tiles are typically brown/green
-                    tileColor = QColor(150, 100, 50); // Brown
-                } else if (tile->isBlocking()) {
-                    // Blocking tiles are typically gray
-                    tileColor = QColor(100, 100, 100); // Gray
-                } else if (tile->hasItems()) {
-                    // Tiles with items are typically blue
-                    tileColor = QColor(50, 100, 150); // Blue
-                } else {
-                    // Empty tiles are transparent
-                    continue;
-                }
-                
-                // Draw the tile as a single pixel
-                painter.setPen(tileColor);
-                painter.drawPoint(x, y);
-            }
-        }
-    }
-    
-    // Save the image
-    bool success = minimap.save(filename);
+    // Stream the image band by band; a map-sized QImage does not fit in memory for large maps
+    RME::core::io::MinimapExporter exporter(m_map);
+    exporter.setMinimapCache(m_minimapCache);
+    bool success = exporter.exportFloorStreaming(filename, exportFloor);
     
     if (success) {
         qInfo("EditorController::exportMiniMap: Successfully exported minimap to %s",
               qUtf8Printable(filename));
     } else {
-        qWarning("EditorController::exportMiniMap: Failed to save minimap to %s",
-                qUtf8Printable(filename));
+        qWarning("EditorController::exportMiniMap: Failed to save minimap to %s: %s",
+                qUtf8Printable(filename), qUtf8Printable(exporter.getLastError()));
     }
     
     return success;
@@ -1713,6 +1677,10 @@ bool EditorController::newMap(int width, int height, const QString& name) {
     m_currentMapFilename.clear();
     setMapModified(false);
     
+    if (m_housesManager) {
+        m_housesManager->rebuildTileIndex();
+    }
+    
     qInfo() << "EditorController::newMap: Created new map" << width << "x" << height << "named" << name;
     emit mapLoaded(QString()); // Empty filename for new map
     
@@ -1753,6 +1721,11 @@ bool EditorController::loadMap(const QString& filename) {
         m_currentMapFilename = filename;
         setMapModified(false);
         
+        // Tiles were replaced without per-tile notifications
+        if (m_housesManager) {
+            m_housesManager->rebuildTileIndex();
+        }
+        
         qInfo() << "EditorController::loadMap: Successfully loaded map from" << filename;
         emit mapLoaded(filename);
         
@@ -19,6 +19,7 @@ class QUndoStack;
 class QUndoCommand;
 
 namespace RME {
+class MinimapCache;
 namespace core {
     class Map;
     class BrushSettings;
@@ -136,6 +137,9 @@ public:
     bool importMap(const QString& filename, const RME::core::Position& offset = RME::core::Position(0, 0, 0));
     bool exportMiniMap(const QString& filename, int floor = -1, bool showDialog = true);
     bool exportSelectionAsMiniMap(const QString& filename);
+    // Minimap cache kept by a minimap view of this map; exports render from it when set
+    void setMinimapCache(RME::MinimapCache* cache) { m_minimapCache = cache; }
+    RME::MinimapCache* getMinimapCache() const { return m_minimapCache; }
     
     // Ground validation operations (LOGIC-09)
     quint32 validateGroundStacks();
@@ -213,6 +217,7 @@ private:
     RME::core::houses::Houses* m_housesManager;
     RME::core::clipboard::ClipboardManager* m_clipboardManager;
     RME::core::waypoints::WaypointManager* m_waypointManager;
+    RME::MinimapCache* m_minimapCache = nullptr; // Not owned
     
     // Tool mode state (LOGIC-06)
     ToolMode m_currentToolMode = ToolMode::Brush;
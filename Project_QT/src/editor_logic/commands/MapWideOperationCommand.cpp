@@ -1,5 +1,6 @@
 #include "editor_logic/commands/MapWideOperationCommand.h"
 #include "core/map/Map.h"
+#include "core/map/Floor.h"
 #include "core/Tile.h"
 #include "core/editor/EditorControllerInterface.h"
 #include "core/selection/SelectionManager.h"
@@ -11,6 +12,10 @@
 #include <QDataStream>
 #include <QBuffer>
 #include <QRandomGenerator> // For randomization
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <QVector>
+#include <atomic>
 
 namespace RME {
 namespace core {
@@ -25,7 +30,8 @@ MapWideOperationCommand::MapWideOperationCommand(
 ) : BaseCommand(controller, QObject::tr("Map Operation"), parent),
     m_operationType(operationType),
     m_map(map),
-    m_parameters(parameters)
+    m_parameters(parameters),
+    m_randomSeed(QRandomGenerator::global()->generate())
 {
     Q_ASSERT(m_map);
     
@@ -42,8 +48,12 @@ void MapWideOperationCommand::redo() {
     m_modifiedTileCount = 0;
     m_wasCancelled = false;
     
-    // Backup tiles only on first execution
-    if (!m_hasBeenExecuted) {
+    // Backup tiles only on first execution. Sector-parallel operations capture their
+    // backups inside each work unit, and only for tiles they actually modify.
+    m_captureBackups = !m_hasBeenExecuted;
+    if (!m_hasBeenExecuted && isSectorParallelOperation()) {
+        m_hasBeenExecuted = true;
+    } else if (!m_hasBeenExecuted) {
         QList<RME::core::Position> positions = getOperationPositions();
         
         updateProgress(0, QObject::tr("Preparing operation..."));
@@ -169,22 +179,147 @@ void MapWideOperationCommand::backupTile(const RME::core::Position& pos) {
         return;
     }
     
+    m_tileBackups.append(captureTileBackup(*tile));
+}
+
+MapWideOperationCommand::TileBackup MapWideOperationCommand::captureTileBackup(const RME::core::Tile& tile) {
     // Serialize tile state
     QBuffer buffer;
     buffer.open(QIODevice::WriteOnly);
     QDataStream stream(&buffer);
     
     // Store tile data (simplified - would need proper tile serialization)
-    stream << tile->getHouseId();
-    stream << tile->isProtectionZone();
-    stream << tile->hasGround();
+    stream << tile.getHouseId();
+    stream << tile.isProtectionZone();
+    stream << tile.hasGround();
     // TODO: Add complete tile serialization
     
     TileBackup backup;
-    backup.position = pos;
+    backup.position = tile.getPosition();
     backup.tileData = buffer.data();
+    return backup;
+}
+
+bool MapWideOperationCommand::isSectorParallelOperation() const {
+    switch (m_operationType) {
+        case OperationType::BorderizeMap:
+        case OperationType::RandomizeMap:
+        case OperationType::ValidateGrounds:
+        case OperationType::RemoveDuplicateGrounds:
+            return true;
+        default:
+            return false;
+    }
+}
+
+quint32 MapWideOperationCommand::sectorSeed(int sectorX, int sectorY, int z) const {
+    return m_randomSeed
+        ^ (static_cast<quint32>(sectorX) * 73856093u)
+        ^ (static_cast<quint32>(sectorY) * 19349663u)
+        ^ (static_cast<quint32>(z) * 83492791u);
+}
+
+QVector<MapWideOperationCommand::SectorWorkUnit> MapWideOperationCommand::collectSectorUnits() const {
+    // Every populated Floor sector is an independent work unit
+    QVector<SectorWorkUnit> units;
+    m_map->forEachFloor(RME::FloorVisitor([&units](RME::Floor& floor, int sectorX, int sectorY) {
+        units.append(SectorWorkUnit{&floor, sectorX, sectorY});
+        return true;
+    }));
+    return units;
+}
+
+bool MapWideOperationCommand::dispatchUnits(int unitCount, const std::function<void(int)>& processUnit,
+                                            const std::function<void()>& afterCallerUnit) {
+    std::atomic<int> nextUnit{0};
+    std::atomic<bool> cancelled{false};
+    
+    // Workers claim the next unprocessed sector from a shared counter, so idle
+    // workers keep taking work until none is left instead of owning fixed ranges.
+    auto drain = [&]() {
+        for (int i = nextUnit.fetch_add(1); i < unitCount && !cancelled.load(); i = nextUnit.fetch_add(1)) {
+            processUnit(i);
+        }
+    };
     
-    m_tileBackups.append(backup);
+    const int helperCount = qBound(0, QThreadPool::globalInstance()->maxThreadCount() - 1, unitCount - 1);
+    QList<QFuture<void>> helpers;
+    for (int i = 0; i < helperCount; ++i) {
+        helpers.append(QtConcurrent::run(drain));
+    }
+    
+    // The calling thread works as well, and between its units it owns progress
+    // reporting and cancellation, since both callbacks may touch the UI.
+    for (int i = nextUnit.fetch_add(1); i < unitCount; i = nextUnit.fetch_add(1)) {
+        if (!shouldContinue()) {
+            cancelled = true;
+            break;
+        }
+        processUnit(i);
+        if (afterCallerUnit) {
+            afterCallerUnit();
+        }
+    }
+    for (QFuture<void>& helper : helpers) {
+        helper.waitForFinished();
+    }
+    return !cancelled;
+}
+
+bool MapWideOperationCommand::runSectorParallel(const SectorTileOperation& operation, const QString& progressText) {
+    const QVector<SectorWorkUnit> units = collectSectorUnits();
+    const int unitCount = units.size();
+    const quint64 totalTiles = m_map->countTiles();
+    const bool captureBackups = m_captureBackups;
+    QVector<SectorResult> results(unitCount);
+    std::atomic<quint64> processedTiles{0};
+    
+    auto processUnit = [&](int index) {
+        const SectorWorkUnit& unit = units[index];
+        SectorResult& result = results[index];
+        QRandomGenerator rng(sectorSeed(unit.sectorX, unit.sectorY, unit.floor->getZLevel()));
+        
+        unit.floor->forEachTile(std::function<bool(RME::core::Tile&)>([&](RME::core::Tile& tile) {
+            TileBackup backup;
+            if (captureBackups) {
+                backup = captureTileBackup(tile);
+            }
+            if (operation(tile, rng)) {
+                if (captureBackups) {
+                    result.backups.append(backup);
+                }
+                result.changedPositions.append(tile.getPosition());
+                ++result.modifiedTiles;
+            }
+            ++result.processedTiles;
+            return true;
+        }));
+        processedTiles.fetch_add(result.processedTiles, std::memory_order_relaxed);
+    };
+    
+    const bool completed = dispatchUnits(unitCount, processUnit, [&]() {
+        const quint64 done = processedTiles.load(std::memory_order_relaxed);
+        int progress = 20 + static_cast<int>(totalTiles > 0 ? (done * 70) / totalTiles : 70); // 20-90%
+        updateProgress(progress, progressText.arg(done).arg(totalTiles));
+    });
+    
+    // Merge in sector traversal order rather than completion order, so backups and
+    // change notifications come out identical to a serial run. Units finished before
+    // a cancellation are merged too, keeping their changes undoable.
+    for (const SectorResult& result : results) {
+        m_tileBackups.append(result.backups);
+        m_processedTileCount += result.processedTiles;
+        m_modifiedTileCount += result.modifiedTiles;
+        for (const RME::core::Position& pos : result.changedPositions) {
+            m_map->notifyTileChanged(pos);
+        }
+    }
+    
+    if (!completed) {
+        m_wasCancelled = true;
+        return false;
+    }
+    return true;
 }
 
 void MapWideOperationCommand::restoreTile(const TileBackup& backup) {
@@ -254,14 +389,9 @@ QList<RME::core::Position> MapWideOperationCommand::getOperationPositions() cons
             break;
         }
         default: {
-            // Get all map positions
-            for (int z = 0; z < m_map->getDepth(); ++z) {
-                for (int y = 0; y < m_map->getHeight(); ++y) {
-                    for (int x = 0; x < m_map->getWidth(); ++x) {
-                        positions.append(RME::core::Position(x, y, z));
-                    }
-                }
-            }
+            // Only existing tiles can be backed up, so collect them from populated sectors
+            // instead of enumerating every coordinate of the map.
+            positions = m_map->getTilePositions();
             break;
         }
     }
@@ -288,51 +418,42 @@ void MapWideOperationCommand::executeBorderizeMap() {
         return;
     }
     
-    // Calculate total tiles for progress tracking
-    int totalTiles = 0;
-    for (int z = 0; z < m_map->getDepth(); ++z) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int x = 0; x < m_map->getWidth(); ++x) {
-                RME::core::Position pos(x, y, z);
-                if (m_map->getTile(pos)) {
-                    totalTiles++;
+    updateProgress(20, QObject::tr("Analyzing tiles for borderization..."));
+    
+    // Borderizing a tile reads its neighbours, which may sit in a sector another worker
+    // is changing. Every tile is therefore analysed first while nothing is written, and
+    // the results are applied in a second pass that touches only the tile itself.
+    const QVector<SectorWorkUnit> units = collectSectorUnits();
+    QVector<QVector<QPair<const RME::core::Tile*, quint8>>> unitPlans(units.size());
+    if (!dispatchUnits(units.size(), [&](int index) {
+            units[index].floor->forEachTile(std::function<bool(RME::core::Tile&)>([&](RME::core::Tile& tile) {
+                quint8 config = 0;
+                if (planBorderization(tile, materialManager, config)) {
+                    unitPlans[index].append(qMakePair(static_cast<const RME::core::Tile*>(&tile), config));
                 }
-            }
-        }
+                return true;
+            }));
+        }, {})) {
+        m_wasCancelled = true;
+        return;
     }
     
-    updateProgress(20, QObject::tr("Analyzing tiles for borderization..."));
+    QHash<const RME::core::Tile*, quint8> plans;
+    for (const auto& unitPlan : std::as_const(unitPlans)) {
+        for (const auto& plan : unitPlan) {
+            plans.insert(plan.first, plan.second);
+        }
+    }
     
-    // Process all tiles
-    int processedCount = 0;
-    for (int z = 0; z < m_map->getDepth(); ++z) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int x = 0; x < m_map->getWidth(); ++x) {
-                if (!shouldContinue()) {
-                    m_wasCancelled = true;
-                    return;
-                }
-                
-                RME::core::Position pos(x, y, z);
-                RME::core::Tile* tile = m_map->getTile(pos);
-                
-                if (tile && tile->getGround()) {
-                    // Apply borderization to this tile
-                    if (applyBorderizationToTile(tile, pos, materialManager)) {
-                        m_modifiedTileCount++;
-                    }
-                }
-                
-                processedCount++;
-                m_processedTileCount++;
-                
-                // Update progress every 100 tiles
-                if (processedCount % 100 == 0) {
-                    int progress = 20 + (processedCount * 70) / totalTiles; // 20-90%
-                    updateProgress(progress, QObject::tr("Borderizing tiles... %1/%2").arg(processedCount).arg(totalTiles));
-                }
+    if (!runSectorParallel([&plans](RME::core::Tile& tile, QRandomGenerator&) {
+            const auto plan = plans.constFind(&tile);
+            if (plan == plans.constEnd()) {
+                return false;
             }
-        }
+            tile.applyBorders(plan.value());
+            return true; // Assume modification occurred
+        }, QObject::tr("Borderizing tiles... %1/%2"))) {
+        return;
     }
     
     updateProgress(100, QObject::tr("Borderization completed. Modified %1 tiles.").arg(m_modifiedTileCount));
@@ -358,51 +479,14 @@ void MapWideOperationCommand::executeRandomizeMap() {
         return;
     }
     
-    // Calculate total tiles for progress tracking
-    int totalTiles = 0;
-    for (int z = 0; z < m_map->getDepth(); ++z) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int x = 0; x < m_map->getWidth(); ++x) {
-                RME::core::Position pos(x, y, z);
-                if (m_map->getTile(pos)) {
-                    totalTiles++;
-                }
-            }
-        }
-    }
-    
     updateProgress(20, QObject::tr("Analyzing tiles for randomization..."));
     
-    // Process all tiles
-    int processedCount = 0;
-    for (int z = 0; z < m_map->getDepth(); ++z) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int x = 0; x < m_map->getWidth(); ++x) {
-                if (!shouldContinue()) {
-                    m_wasCancelled = true;
-                    return;
-                }
-                
-                RME::core::Position pos(x, y, z);
-                RME::core::Tile* tile = m_map->getTile(pos);
-                
-                if (tile && tile->getGround()) {
-                    // Apply randomization to this tile
-                    if (applyRandomizationToTile(tile, pos, materialManager)) {
-                        m_modifiedTileCount++;
-                    }
-                }
-                
-                processedCount++;
-                m_processedTileCount++;
-                
-                // Update progress every 100 tiles
-                if (processedCount % 100 == 0) {
-                    int progress = 20 + (processedCount * 70) / totalTiles; // 20-90%
-                    updateProgress(progress, QObject::tr("Randomizing tiles... %1/%2").arg(processedCount).arg(totalTiles));
-                }
-            }
-        }
+    // Each sector draws from its own seeded generator, so the result is the same
+    // regardless of how sectors are distributed across workers.
+    if (!runSectorParallel([this, materialManager](RME::core::Tile& tile, QRandomGenerator& rng) {
+            return tile.getGround() && applyRandomizationToTile(&tile, tile.getPosition(), materialManager, rng);
+        }, QObject::tr("Randomizing tiles... %1/%2"))) {
+        return;
     }
     
     updateProgress(100, QObject::tr("Randomization completed. Modified %1 tiles.").arg(m_modifiedTileCount));
@@ -428,54 +512,44 @@ void MapWideOperationCommand::executeClearInvalidHouseTiles() {
         return;
     }
     
-    // Calculate total tiles for progress tracking
-    int totalTiles = 0;
-    for (int z = 0; z < m_map->getDepth(); ++z) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int x = 0; x < m_map->getWidth(); ++x) {
-                RME::core::Position pos(x, y, z);
-                if (m_map->getTile(pos)) {
-                    totalTiles++;
-                }
-            }
-        }
-    }
+    // Populated-sector tile counters answer this without probing empty coordinates
+    const quint64 totalTiles = m_map->countTiles();
     
     updateProgress(20, QObject::tr("Checking house tile validity..."));
     
     // Process all tiles
-    int processedCount = 0;
-    for (int z = 0; z < m_map->getDepth(); ++z) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int x = 0; x < m_map->getWidth(); ++x) {
-                if (!shouldContinue()) {
-                    m_wasCancelled = true;
-                    return;
-                }
-                
-                RME::core::Position pos(x, y, z);
-                RME::core::Tile* tile = m_map->getTile(pos);
-                
-                if (tile && tile->getHouseId() != 0) {
-                    // Check if house still exists
-                    if (!houses->getHouse(tile->getHouseId())) {
-                        // House doesn't exist, clear the house ID
-                        tile->setHouseId(0);
-                        m_modifiedTileCount++;
-                        m_map->notifyTileChanged(pos);
-                    }
-                }
-                
-                processedCount++;
-                m_processedTileCount++;
-                
-                // Update progress every 100 tiles
-                if (processedCount % 100 == 0) {
-                    int progress = 20 + (processedCount * 70) / totalTiles; // 20-90%
-                    updateProgress(progress, QObject::tr("Checking house tiles... %1/%2").arg(processedCount).arg(totalTiles));
-                }
+    quint64 processedCount = 0;
+    const bool completed = m_map->forEachTile([&](RME::core::Tile& tileRef) {
+        if (!shouldContinue()) {
+            return false;
+        }
+        
+        RME::core::Tile* tile = &tileRef;
+        const RME::core::Position& pos = tile->getPosition();
+        
+        if (tile && tile->getHouseId() != 0) {
+            // Check if house still exists
+            if (!houses->getHouse(tile->getHouseId())) {
+                // House doesn't exist, clear the house ID
+                tile->setHouseId(0);
+                m_modifiedTileCount++;
+                m_map->notifyTileChanged(pos);
             }
         }
+        
+        processedCount++;
+        m_processedTileCount++;
+        
+        // Update progress every 100 tiles
+        if (processedCount % 100 == 0) {
+            int progress = 20 + static_cast<int>((processedCount * 70) / totalTiles); // 20-90%
+            updateProgress(progress, QObject::tr("Checking house tiles... %1/%2").arg(processedCount).arg(totalTiles));
+        }
+        return true;
+    });
+    if (!completed) {
+        m_wasCancelled = true;
+        return;
     }
     
     updateProgress(100, QObject::tr("House tile cleanup completed. Cleaned %1 tiles.").arg(m_modifiedTileCount));
@@ -494,53 +568,43 @@ void MapWideOperationCommand::executeClearModifiedTileState() {
     m_processedTileCount = 0;
     m_modifiedTileCount = 0;
     
-    // Calculate total tiles for progress tracking
-    int totalTiles = 0;
-    for (int z = 0; z < m_map->getDepth(); ++z) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int x = 0; x < m_map->getWidth(); ++x) {
-                RME::core::Position pos(x, y, z);
-                if (m_map->getTile(pos)) {
-                    totalTiles++;
-                }
-            }
-        }
-    }
+    // Populated-sector tile counters answer this without probing empty coordinates
+    const quint64 totalTiles = m_map->countTiles();
     
     updateProgress(20, QObject::tr("Clearing tile modification flags..."));
     
     // Process all tiles
-    int processedCount = 0;
-    for (int z = 0; z < m_map->getDepth(); ++z) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int x = 0; x < m_map->getWidth(); ++x) {
-                if (!shouldContinue()) {
-                    m_wasCancelled = true;
-                    return;
-                }
-                
-                RME::core::Position pos(x, y, z);
-                RME::core::Tile* tile = m_map->getTile(pos);
-                
-                if (tile) {
-                    // Clear modification flags (assuming there's a method for this)
-                    // This would clear any "dirty" or "modified" flags on the tile
-                    if (tile->isModified()) {
-                        tile->setModified(false);
-                        m_modifiedTileCount++;
-                    }
-                }
-                
-                processedCount++;
-                m_processedTileCount++;
-                
-                // Update progress every 100 tiles
-                if (processedCount % 100 == 0) {
-                    int progress = 20 + (processedCount * 70) / totalTiles; // 20-90%
-                    updateProgress(progress, QObject::tr("Clearing modification flags... %1/%2").arg(processedCount).arg(totalTiles));
-                }
+    quint64 processedCount = 0;
+    const bool completed = m_map->forEachTile([&](RME::core::Tile& tileRef) {
+        if (!shouldContinue()) {
+            return false;
+        }
+        
+        RME::core::Tile* tile = &tileRef;
+        const RME::core::Position& pos = tile->getPosition();
+        
+        if (tile) {
+            // Clear modification flags (assuming there's a method for this)
+            // This would clear any "dirty" or "modified" flags on the tile
+            if (tile->isModified()) {
+                tile->setModified(false);
+                m_modifiedTileCount++;
             }
         }
+        
+        processedCount++;
+        m_processedTileCount++;
+        
+        // Update progress every 100 tiles
+        if (processedCount % 100 == 0) {
+            int progress = 20 + static_cast<int>((processedCount * 70) / totalTiles); // 20-90%
+            updateProgress(progress, QObject::tr("Clearing modification flags... %1/%2").arg(processedCount).arg(totalTiles));
+        }
+        return true;
+    });
+    if (!completed) {
+        m_wasCancelled = true;
+        return;
     }
     
     updateProgress(100, QObject::tr("Modified state clearing completed. Cleared %1 tiles.").arg(m_modifiedTileCount));
@@ -562,69 +626,24 @@ void MapWideOperationCommand::executeValidateGrounds() {
     // Get default ground item ID from parameters or use a default
     uint16_t defaultGroundId = m_parameters.value("defaultGroundId", 100).toUInt(); // Default grass
     
-    // Calculate total tiles for progress tracking
-    int totalTiles = 0;
-    for (int z = 0; z < m_map->getDepth(); ++z) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int x = 0; x < m_map->getWidth(); ++x) {
-                RME::core::Position pos(x, y, z);
-                if (m_map->getTile(pos)) {
-                    totalTiles++;
-                }
-            }
-        }
-    }
-    
     updateProgress(20, QObject::tr("Validating ground items..."));
     
-    // Process all tiles
-    int processedCount = 0;
-    for (int z = 0; z < m_map->getDepth(); ++z) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int x = 0; x < m_map->getWidth(); ++x) {
-                if (!shouldContinue()) {
-                    m_wasCancelled = true;
-                    return;
-                }
-                
-                RME::core::Position pos(x, y, z);
-                RME::core::Tile* tile = m_map->getTile(pos);
-                
-                if (tile) {
-                    bool needsGround = false;
-                    
-                    // Check if tile needs ground
-                    if (!tile->getGround()) {
-                        needsGround = true;
-                    } else {
-                        RME::core::Item* ground = tile->getGround();
-                        // Check if ground item is valid (simplified check)
-                        if (ground->getID() == 0) {
-                            needsGround = true;
-                        }
-                    }
-                    
-                    if (needsGround) {
-                        // Add default ground
-                        auto defaultGround = RME::core::Item::create(defaultGroundId, tile->getItemTypeProvider());
-                        if (defaultGround) {
-                            tile->setGround(std::move(defaultGround));
-                            m_modifiedTileCount++;
-                            m_map->notifyTileChanged(pos);
-                        }
-                    }
-                }
-                
-                processedCount++;
-                m_processedTileCount++;
-                
-                // Update progress every 100 tiles
-                if (processedCount % 100 == 0) {
-                    int progress = 20 + (processedCount * 70) / totalTiles; // 20-90%
-                    updateProgress(progress, QObject::tr("Validating grounds... %1/%2").arg(processedCount).arg(totalTiles));
-                }
+    if (!runSectorParallel([defaultGroundId](RME::core::Tile& tile, QRandomGenerator&) {
+            // Check if tile needs ground (missing, or an invalid ground item - simplified check)
+            RME::core::Item* ground = tile.getGround();
+            if (ground && ground->getID() != 0) {
+                return false;
             }
-        }
+            
+            // Add default ground
+            auto defaultGround = RME::core::Item::create(defaultGroundId, tile.getItemTypeProvider());
+            if (!defaultGround) {
+                return false;
+            }
+            tile.setGround(std::move(defaultGround));
+            return true;
+        }, QObject::tr("Validating grounds... %1/%2"))) {
+        return;
     }
     
     updateProgress(100, QObject::tr("Ground validation completed. Fixed %1 tiles.").arg(m_modifiedTileCount));
@@ -728,6 +747,7 @@ void MapWideOperationCommand::executeRandomizeSelection() {
     updateProgress(20, QObject::tr("Randomizing %1 selected tiles...").arg(selectedPositions.size()));
     
     // Process selected tiles
+    QRandomGenerator rng(m_randomSeed);
     int processedCount = 0;
     for (const RME::core::Position& pos : selectedPositions) {
         if (!shouldContinue()) {
@@ -738,7 +758,7 @@ void MapWideOperationCommand::executeRandomizeSelection() {
         RME::core::Tile* tile = m_map->getTile(pos);
         if (tile && tile->getGround()) {
             // Apply randomization to this tile
-            if (applyRandomizationToTile(tile, pos, materialManager)) {
+            if (applyRandomizationToTile(tile, pos, materialManager, rng)) {
                 m_modifiedTileCount++;
             }
         }
@@ -838,73 +858,28 @@ void MapWideOperationCommand::executeRemoveDuplicateGrounds() {
     m_processedTileCount = 0;
     m_modifiedTileCount = 0;
     
-    // Calculate total tiles for progress tracking
-    int totalTiles = 0;
-    for (int z = 0; z < m_map->getDepth(); ++z) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int x = 0; x < m_map->getWidth(); ++x) {
-                RME::core::Position pos(x, y, z);
-                if (m_map->getTile(pos)) {
-                    totalTiles++;
-                }
-            }
-        }
-    }
-    
     updateProgress(20, QObject::tr("Checking for duplicate grounds..."));
     
-    // Process all tiles
-    int processedCount = 0;
-    for (int z = 0; z < m_map->getDepth(); ++z) {
-        for (int y = 0; y < m_map->getHeight(); ++y) {
-            for (int x = 0; x < m_map->getWidth(); ++x) {
-                if (!shouldContinue()) {
-                    m_wasCancelled = true;
-                    return;
-                }
-                
-                RME::core::Position pos(x, y, z);
-                RME::core::Tile* tile = m_map->getTile(pos);
-                
-                if (tile) {
-                    // Check for duplicate ground items in the tile's item list
-                    // This would remove any ground-type items that are not the actual ground
-                    const auto& items = tile->getItems();
-                    bool removedDuplicates = false;
-                    
-                    if (tile->getGround()) {
-                        uint16_t groundId = tile->getGround()->getID();
-                        
-                        // Remove any items that have the same ID as the ground
-                        // (simplified implementation - in reality would need more sophisticated duplicate detection)
-                        auto it = items.begin();
-                        while (it != items.end()) {
-                            if ((*it) && (*it)->getID() == groundId) {
-                                // Found duplicate ground item
-                                it = items.erase(it);
-                                removedDuplicates = true;
-                            } else {
-                                ++it;
-                            }
-                        }
-                    }
-                    
-                    if (removedDuplicates) {
-                        m_modifiedTileCount++;
-                        m_map->notifyTileChanged(pos);
-                    }
-                }
-                
-                processedCount++;
-                m_processedTileCount++;
-                
-                // Update progress every 100 tiles
-                if (processedCount % 100 == 0) {
-                    int progress = 20 + (processedCount * 70) / totalTiles; // 20-90%
-                    updateProgress(progress, QObject::tr("Checking duplicates... %1/%2").arg(processedCount).arg(totalTiles));
+    if (!runSectorParallel([](RME::core::Tile& tile, QRandomGenerator&) {
+            if (!tile.getGround()) {
+                return false;
+            }
+            
+            // Remove any items that have the same ID as the ground
+            // (simplified implementation - in reality would need more sophisticated duplicate detection)
+            const uint16_t groundId = tile.getGround()->getID();
+            QList<RME::core::Item*> duplicates;
+            for (const auto& item : tile.getItems()) {
+                if (item && item->getID() == groundId) {
+                    duplicates.append(item.get());
                 }
             }
-        }
+            for (RME::core::Item* duplicate : duplicates) {
+                tile.removeItem(duplicate);
+            }
+            return !duplicates.isEmpty();
+        }, QObject::tr("Checking duplicates... %1/%2"))) {
+        return;
     }
     
     updateProgress(100, QObject::tr("Duplicate ground removal completed. Cleaned %1 tiles.").arg(m_modifiedTileCount));
@@ -913,35 +888,39 @@ void MapWideOperationCommand::executeRemoveDuplicateGrounds() {
 }
 
 // Helper method implementations
-bool MapWideOperationCommand::applyBorderizationToTile(RME::core::Tile* tile, const RME::core::Position& pos, MaterialManager* materialManager) {
-    if (!tile || !materialManager || !tile->getGround()) {
-        return false;
-    }
-    
-    RME::core::Item* groundItem = tile->getGround();
-    if (!groundItem) {
+bool MapWideOperationCommand::planBorderization(const RME::core::Tile& tile, MaterialManager* materialManager, quint8& config) const {
+    if (!materialManager || !tile.getGround()) {
         return false;
     }
     
     // Get material data for the ground item
-    const MaterialData* material = materialManager->getMaterialByItemId(groundItem->getID());
+    const MaterialData* material = materialManager->getMaterialByItemId(tile.getGround()->getID());
     if (!material || !material->hasBorders()) {
         return false; // No border data available
     }
     
     // Get neighboring tiles
-    RME::core::Tile* neighbors[8];
+    const RME::core::Tile* neighbors[8];
     for (int i = 0; i < 8; ++i) {
-        neighbors[i] = getNeighborTile(pos, i);
+        neighbors[i] = getNeighborTile(tile.getPosition(), i);
     }
     
-    // Apply borderization using tile's built-in method
-    tile->borderize(neighbors);
+    config = tile.borderNeighborConfig(neighbors);
+    return true;
+}
+
+bool MapWideOperationCommand::applyBorderizationToTile(RME::core::Tile* tile, const RME::core::Position& pos, MaterialManager* materialManager) {
+    Q_UNUSED(pos);
+    quint8 config = 0;
+    if (!tile || !planBorderization(*tile, materialManager, config)) {
+        return false;
+    }
     
+    tile->applyBorders(config);
     return true; // Assume modification occurred
 }
 
-bool MapWideOperationCommand::applyRandomizationToTile(RME::core::Tile* tile, const RME::core::Position& pos, MaterialManager* materialManager) {
+bool MapWideOperationCommand::applyRandomizationToTile(RME::core::Tile* tile, const RME::core::Position& pos, MaterialManager* materialManager, QRandomGenerator& rng) {
     if (!tile || !materialManager || !tile->getGround()) {
         return false;
     }
@@ -959,8 +938,7 @@ bool MapWideOperationCommand::applyRandomizationToTile(RME::core::Tile* tile, co
     
     // Apply randomization (simplified implementation)
     // In a full implementation, this would select random alternatives from the material
-    QRandomGenerator* rng = QRandomGenerator::global();
-    if (rng->bounded(100) < 30) { // 30% chance to randomize
+    if (rng.bounded(100) < 30) { // 30% chance to randomize
         // TODO: Get alternative ground items from material and apply one randomly
         return true;
     }
@@ -5,13 +5,18 @@
 #include <QString>
 #include <QHash>
 #include <QList>
+#include <QVector>
+#include <QByteArray>
 #include <functional>
 #include "core/Position.h"
 #include "core/actions/CommandIds.h"
 #include <QtGlobal> // For quint32
 
+class QRandomGenerator;
+
 // Forward declarations
 namespace RME {
+class Floor;
 namespace core {
     class Map;
     class Tile;
@@ -81,6 +86,25 @@ private:
         QByteArray tileData; // Serialized tile state
     };
     QList<TileBackup> m_tileBackups;
+    bool m_captureBackups = true; // False on re-execution after undo; backups already exist
+    
+    // Sector-parallel execution: each populated Floor sector is one work unit whose
+    // results are merged in traversal order once all workers are done.
+    struct SectorWorkUnit {
+        RME::Floor* floor = nullptr;
+        int sectorX = 0;
+        int sectorY = 0;
+    };
+    struct SectorResult {
+        QList<TileBackup> backups; // Pre-modification state of tiles this unit changed
+        QList<RME::core::Position> changedPositions;
+        quint32 processedTiles = 0;
+        quint32 modifiedTiles = 0;
+    };
+    // Applies the operation to one tile and returns true if the tile was modified.
+    // Must only write to the tile it is given.
+    using SectorTileOperation = std::function<bool(RME::core::Tile& tile, QRandomGenerator& rng)>;
+    quint32 m_randomSeed; // Per-command seed so redo and parallel runs randomize identically
     
     // Progress tracking
     std::function<void(int, const QString&)> m_progressCallback;
@@ -103,6 +127,14 @@ private:
     
     // Helper methods
     void backupTile(const RME::core::Position& pos);
+    static TileBackup captureTileBackup(const RME::core::Tile& tile);
+    bool isSectorParallelOperation() const;
+    QVector<SectorWorkUnit> collectSectorUnits() const;
+    // Runs processUnit(0..unitCount-1) on the pool and the calling thread; false if cancelled
+    bool dispatchUnits(int unitCount, const std::function<void(int)>& processUnit,
+                       const std::function<void()>& afterCallerUnit);
+    bool runSectorParallel(const SectorTileOperation& operation, const QString& progressText);
+    quint32 sectorSeed(int sectorX, int sectorY, int z) const;
     void restoreTile(const TileBackup& backup);
     bool shouldContinue();
     void updateProgress(int percentage, const QString& message);
@@ -110,8 +142,9 @@ private:
     QList<RME::core::Position> getOperationPositions() const;
     
     // Operation helper methods
+    bool planBorderization(const RME::core::Tile& tile, class MaterialManager* materialManager, quint8& config) const;
     bool applyBorderizationToTile(RME::core::Tile* tile, const RME::core::Position& pos, class MaterialManager* materialManager);
-    bool applyRandomizationToTile(RME::core::Tile* tile, const RME::core::Position& pos, class MaterialManager* materialManager);
+    bool applyRandomizationToTile(RME::core::Tile* tile, const RME::core::Position& pos, class MaterialManager* materialManager, QRandomGenerator& rng);
     RME::core::Tile* getNeighborTile(const RME::core::Position& pos, int direction) const;
 };
 
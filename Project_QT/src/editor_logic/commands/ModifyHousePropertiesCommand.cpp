@@ -131,11 +131,10 @@ void ModifyHousePropertiesCommand::applyProperties(const QHash<QString, QVariant
             house->name = value.toString();
         } else if (property == "entryPoint") {
             RME::core::Position newEntryPoint = value.value<RME::core::Position>();
-            RME::core::Position oldEntryPoint = house->entryPoint;
-            house->entryPoint = newEntryPoint;
             
-            // Update house exit if entry point changed
-            if (newEntryPoint != oldEntryPoint) {
+            // setHouseExit() moves the entry point along with the exit tile flags
+            // and the map's exit index, so the old entry point must still be set here
+            if (newEntryPoint != house->entryPoint) {
                 m_housesManager->setHouseExit(m_houseId, newEntryPoint);
             }
         } else if (property == "townId") {
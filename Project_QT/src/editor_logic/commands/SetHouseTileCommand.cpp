@@ -53,10 +53,8 @@ void SetHouseTileCommand::redo() {
         if (m_originalTileHouseId != 0 && m_originalTileHouseId != m_houseId) {
             qWarning("SetHouseTileCommand: Tile at (%s) belonged to house %u, reassigning to house %u.")
                 .arg(m_tilePos.toString()).arg(m_originalTileHouseId).arg(m_houseId);
-            // NOTE: This command does not manage unlinking from the *old* house's m_tilePositions list.
-            // That would require access to the Houses manager or the old House object.
-            // The HouseBrush should ideally handle such complex reassignments by generating multiple commands
-            // or a more sophisticated command if a tile is "stolen" from another house.
+            // linkTileToHouse() below moves the tile out of the old house's tile index;
+            // undo() links it back.
         }
 
         // Set tile's house ID and protection zone
@@ -2,6 +2,7 @@
 #include "widgets/MapView.h"
 #include "core/map/Map.h"
 #include "editor_logic/EditorController.h"
+#include "core/lighting/LightCalculatorService.h"
 #include <QFileInfo>
 
 namespace RME {
@@ -26,6 +27,10 @@ EditorInstanceWidget::EditorInstanceWidget(RME::core::Map* map,
         m_editorController->setMap(m_map);
     }
     m_editorController->setUndoStack(m_undoStack);
+
+    // Light index follows tile edits through the map's tile-change listeners
+    m_lightCalculatorService = new RME::core::lighting::LightCalculatorService(this);
+    m_lightCalculatorService->setMap(m_map);
     
     setupUI();
     connectSignals();
@@ -78,6 +83,7 @@ bool EditorInstanceWidget::isUntitled() const
 void EditorInstanceWidget::setAppSettings(RME::core::settings::AppSettings* settings)
 {
     m_appSettings = settings;
+    m_lightCalculatorService->setAppSettings(settings);
     if (m_mapView) {
         m_mapView->setAppSettings(settings);
     }
@@ -86,6 +92,7 @@ void EditorInstanceWidget::setAppSettings(RME::core::settings::AppSettings* sett
 void EditorInstanceWidget::setAssetManager(RME::core::assets::AssetManager* assetManager)
 {
     m_assetManager = assetManager;
+    m_lightCalculatorService->setAssetManager(assetManager);
     if (m_mapView) {
         m_mapView->setAssetManager(assetManager);
     }
@@ -109,6 +116,7 @@ void EditorInstanceWidget::setupUI()
     m_mapView = new RME::ui::widgets::MapView(this);
     m_mapView->setMap(m_map);
     m_mapView->setEditorController(m_editorController);
+    m_mapView->setLightCalculatorService(m_lightCalculatorService);
     
     // Set dependencies if available
     if (m_appSettings) {
@@ -148,6 +156,11 @@ void EditorInstanceWidget::connectSignals()
                     this, &EditorInstanceWidget::onMapChanged);
             connect(m_editorController, &EditorController::selectionChanged, 
                     this, &EditorInstanceWidget::onSelectionChanged);
+            // A (re)loaded map replaces every tile at once; re-index its lights
+            connect(m_editorController, &EditorController::mapLoaded,
+                    m_lightCalculatorService, [this]() {
+                        m_lightCalculatorService->onMapDataChanged(QList<RME::core::Position>());
+                    });
         }
     }
 }
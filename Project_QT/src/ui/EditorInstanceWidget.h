@@ -14,6 +14,7 @@ namespace core {
     namespace settings { class AppSettings; }
     namespace assets { class AssetManager; }
     namespace sprites { class TextureManager; }
+    namespace lighting { class LightCalculatorService; }
 }
 namespace editor_logic {
     class EditorController;
@@ -57,6 +58,7 @@ public:
     RME::editor_logic::EditorController* getEditorController() const { return m_editorController; }
     RME::core::Map* getMap() const { return m_map; }
     QUndoStack* getUndoStack() const { return m_undoStack; }
+    RME::core::lighting::LightCalculatorService* getLightCalculatorService() const { return m_lightCalculatorService; }
     
     // File management
     QString getFilePath() const { return m_filePath; }
@@ -92,6 +94,7 @@ private:
     RME::core::Map* m_map = nullptr;
     RME::editor_logic::EditorController* m_editorController = nullptr;
     QUndoStack* m_undoStack = nullptr;
+    RME::core::lighting::LightCalculatorService* m_lightCalculatorService = nullptr;
 
     // File information
     QString m_filePath;
@@ -1,5 +1,6 @@
 #include "ui/dialogs/SpawnPropertiesDialog.h"
 #include "core/spawns/Spawn.h"
+#include "core/map/Map.h"
 
 #include <QMessageBox>
 #include <QDebug>
@@ -8,9 +9,10 @@ namespace RME {
 namespace ui {
 namespace dialogs {
 
-SpawnPropertiesDialog::SpawnPropertiesDialog(QWidget* parent, RME::core::spawns::Spawn* spawn)
+SpawnPropertiesDialog::SpawnPropertiesDialog(QWidget* parent, RME::core::spawns::Spawn* spawn, RME::Map* map)
     : QDialog(parent)
     , m_spawn(spawn)
+    , m_map(map)
 {
     Q_ASSERT(m_spawn);
     
@@ -69,8 +71,14 @@ void SpawnPropertiesDialog::saveSpawnData() {
         return;
     }
     
+    const RME::core::spawns::Spawn oldState = *m_spawn;
+
     // Save spawn radius
     m_spawn->setRadius(m_spawnRadiusSpin->value());
+
+    if (m_map) {
+        m_map->updateSpawnIndex(oldState, *m_spawn);
+    }
 }
 
 bool SpawnPropertiesDialog::validateInput() {
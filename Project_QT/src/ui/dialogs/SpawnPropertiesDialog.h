@@ -10,6 +10,7 @@
 
 // Forward declarations
 namespace RME {
+class Map;
 namespace core {
 namespace spawns {
     class Spawn;
@@ -31,7 +32,8 @@ class SpawnPropertiesDialog : public QDialog {
     Q_OBJECT
 
 public:
-    explicit SpawnPropertiesDialog(QWidget* parent, RME::core::spawns::Spawn* spawn);
+    // Pass the map owning the spawn so its spawn index follows the edit
+    explicit SpawnPropertiesDialog(QWidget* parent, RME::core::spawns::Spawn* spawn, RME::Map* map = nullptr);
     ~SpawnPropertiesDialog() override = default;
 
     // Result access
@@ -52,6 +54,7 @@ private:
     // Core data
     RME::core::spawns::Spawn* m_spawn = nullptr;
     RME::core::spawns::Spawn* m_originalSpawn = nullptr; // Backup for cancel
+    RME::Map* m_map = nullptr;
     bool m_wasModified = false;
 
     // UI components
@@ -74,6 +74,18 @@ void BrushCategoryTab::setBrushManagerService(RME::core::brush::BrushManagerServ
     }
 }
 
+void BrushCategoryTab::setPreviewGenerator(BrushPreviewGenerator* generator)
+{
+    if (m_previewGenerator != generator) {
+        m_previewGenerator = generator;
+        
+        // The list view is created lazily and picks the generator up then
+        if (m_listWidget) {
+            m_listWidget->setPreviewGenerator(generator);
+        }
+    }
+}
+
 void BrushCategoryTab::refreshBrushes()
 {
     if (!m_brushManagerService) {
@@ -250,6 +262,7 @@ void BrushCategoryTab::updateViewWidget()
         case SmallIconView: // Use list widget for small icons too
             if (!m_listWidget) {
                 m_listWidget = new BrushListWidget(this);
+                m_listWidget->setPreviewGenerator(m_previewGenerator);
                 connect(m_listWidget, &BrushListWidget::brushSelected, 
                         this, &BrushCategoryTab::onBrushSelected);
                 connect(m_listWidget, &BrushListWidget::brushActivated, 
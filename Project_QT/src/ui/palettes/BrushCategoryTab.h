@@ -21,6 +21,7 @@ namespace ui {
 namespace palettes {
 
 class BrushListWidget;
+class BrushPreviewGenerator;
 class BrushGridWidget;
 
 /**
@@ -69,6 +70,7 @@ public:
 
     // Brush management
     void setBrushManagerService(RME::core::brush::BrushManagerService* service);
+    void setPreviewGenerator(BrushPreviewGenerator* generator);
     void refreshBrushes();
     QList<RME::core::Brush*> getBrushes() const;
     QList<RME::core::Brush*> getFilteredBrushes() const;
@@ -116,6 +118,7 @@ private:
 
     // Services
     RME::core::brush::BrushManagerService* m_brushManagerService = nullptr;
+    BrushPreviewGenerator* m_previewGenerator = nullptr; // Not owned
 
     // UI Components
     QVBoxLayout* m_mainLayout = nullptr;
@@ -63,6 +63,43 @@ void BrushListWidget::setSelectedBrush(RME::core::Brush* brush)
     }
 }
 
+void BrushListWidget::setPreviewGenerator(BrushPreviewGenerator* generator)
+{
+    if (m_previewGenerator == generator) {
+        return;
+    }
+
+    if (m_previewGenerator) {
+        disconnect(m_previewGenerator, nullptr, this, nullptr);
+    }
+
+    m_previewGenerator = generator;
+
+    if (m_previewGenerator) {
+        connect(m_previewGenerator, &BrushPreviewGenerator::previewReady,
+                this, &BrushListWidget::onPreviewReady);
+    }
+
+    // Rebuild icons so they come from the new source
+    populateList();
+}
+
+void BrushListWidget::onPreviewReady(RME::core::Brush* brush, const QSize& size,
+                                     BrushPreviewGenerator::PreviewStyle style, const QPixmap& preview)
+{
+    if (style != BrushPreviewGenerator::IconStyle || size != iconSize()) {
+        return;
+    }
+
+    for (int i = 0; i < count(); ++i) {
+        QListWidgetItem* item = this->item(i);
+        if (item && item->data(Qt::UserRole).value<RME::core::Brush*>() == brush) {
+            item->setIcon(QIcon(preview));
+            break;
+        }
+    }
+}
+
 void BrushListWidget::onItemSelectionChanged()
 {
     QListWidgetItem* currentItem = this->currentItem();
@@ -131,6 +168,14 @@ void BrushListWidget::setupConnections()
 
 void BrushListWidget::populateList()
 {
+    // Previews queued for the old items are no longer needed
+    if (m_previewGenerator) {
+        for (int i = 0; i < count(); ++i) {
+            RME::core::Brush* brush = item(i)->data(Qt::UserRole).value<RME::core::Brush*>();
+            m_previewGenerator->cancelPreview(brush, iconSize(), BrushPreviewGenerator::IconStyle);
+        }
+    }
+
     // Clear existing items
     clear();
     
@@ -177,9 +222,14 @@ QListWidgetItem* BrushListWidget::createBrushItem(RME::core::Brush* brush)
     QString tooltip = createBrushTooltip(brush);
     item->setToolTip(tooltip);
     
-    // Set icon based on brush type
-    QIcon icon = createBrushIcon(brush);
-    item->setIcon(icon);
+    // Use the rendered preview when a generator is available; it returns a
+    // placeholder at once and delivers the real image through previewReady()
+    if (m_previewGenerator) {
+        item->setIcon(QIcon(m_previewGenerator->generatePreviewAsync(brush, iconSize(), BrushPreviewGenerator::IconStyle)));
+    } else {
+        QIcon icon = createBrushIcon(brush);
+        item->setIcon(icon);
+    }
     
     // Set item height for consistent appearance
     item->setSizeHint(QSize(-1, 32));
@@ -2,6 +2,7 @@
 
 #include <QListWidget>
 #include <QList>
+#include "BrushPreviewGenerator.h"
 
 namespace RME {
 namespace core {
@@ -35,9 +36,15 @@ public:
     RME::core::Brush* getSelectedBrush() const;
     void setSelectedBrush(RME::core::Brush* brush);
 
+    // Item previews are rendered asynchronously by the generator when one is set
+    void setPreviewGenerator(BrushPreviewGenerator* generator);
+    BrushPreviewGenerator* getPreviewGenerator() const { return m_previewGenerator; }
+
 public slots:
     void onItemSelectionChanged();
     void onItemActivated(QListWidgetItem* item);
+    void onPreviewReady(RME::core::Brush* brush, const QSize& size,
+                        RME::ui::palettes::BrushPreviewGenerator::PreviewStyle style, const QPixmap& preview);
 
 signals:
     void brushSelected(RME::core::Brush* brush);
@@ -59,6 +66,7 @@ protected:
 private:
     QList<RME::core::Brush*> m_brushes;
     RME::core::Brush* m_selectedBrush = nullptr;
+    BrushPreviewGenerator* m_previewGenerator = nullptr; // Not owned
 };
 
 } // namespace palettes
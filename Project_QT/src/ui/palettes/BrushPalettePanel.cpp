@@ -4,13 +4,16 @@
 #include "BrushOrganizer.h"
 #include "AdvancedSearchWidget.h"
 #include "BrushContextMenu.h"
+#include "BrushPreviewGenerator.h"
 #include "core/services/ServiceContainer.h"
+#include "core/services/IClientDataService.h"
 #include "core/brush/BrushManagerService.h"
 #include "core/brush/BrushStateService.h"
 #include "core/brush/Brush.h"
 #include <QDebug>
 #include <QApplication>
 #include <QStyle>
+#include <QStandardPaths>
 
 namespace RME {
 namespace ui {
@@ -48,10 +51,13 @@ BrushPalettePanel::BrushPalettePanel(QWidget* parent)
     m_filterManager = new BrushFilterManager(this);
     m_brushOrganizer = new BrushOrganizer(this);
     m_contextMenu = new BrushContextMenu(this);
+    m_previewGenerator = new BrushPreviewGenerator(this);
     
     // Configure advanced features
     m_contextMenu->setFilterManager(m_filterManager);
     m_contextMenu->setBrushOrganizer(m_brushOrganizer);
+    m_previewGenerator->setDiskCacheDirectory(
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/brush_previews");
     
     setupUI();
     setupConnections();
@@ -72,6 +78,10 @@ void BrushPalettePanel::setServiceContainer(RME::core::services::ServiceContaine
         m_brushManagerService = serviceContainer->getBrushManagerService();
         m_brushStateService = serviceContainer->getBrushStateService();
         
+        if (auto* clientDataService = serviceContainer->getClientDataService()) {
+            m_previewGenerator->setAssetManager(clientDataService->getAssetManager());
+        }
+        
         if (m_brushManagerService) {
             qDebug() << "BrushPalettePanel: BrushManagerService connected";
         }
@@ -443,6 +453,11 @@ void BrushPalettePanel::setupCategoryTabs()
     m_allBrushesTab = new BrushCategoryTab(BrushCategoryTab::AllBrushes, this);
     m_recentTab = new BrushCategoryTab(BrushCategoryTab::RecentBrushes, this);
     
+    // All tabs share one preview generator so its cache and render pool are shared
+    for (BrushCategoryTab* tab : {m_terrainTab, m_objectTab, m_entityTab, m_specialTab, m_allBrushesTab, m_recentTab}) {
+        tab->setPreviewGenerator(m_previewGenerator);
+    }
+    
     // Add tabs
     m_categoryTabs->addTab(m_terrainTab, "Terrain");
     m_categoryTabs->addTab(m_objectTab, "Objects");
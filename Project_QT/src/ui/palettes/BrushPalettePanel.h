@@ -33,6 +33,7 @@ class BrushFilterManager;
 class BrushOrganizer;
 class AdvancedSearchWidget;
 class BrushContextMenu;
+class BrushPreviewGenerator;
 
 /**
  * @brief Main brush palette panel for selecting and managing brushes
@@ -161,6 +162,7 @@ private:
     BrushFilterManager* m_filterManager = nullptr;
     BrushOrganizer* m_brushOrganizer = nullptr;
     BrushContextMenu* m_contextMenu = nullptr;
+    BrushPreviewGenerator* m_previewGenerator = nullptr;
 
     // State
     ViewMode m_viewMode = GridView;
@@ -6,20 +6,34 @@
 #include <QDebug>
 #include <QtConcurrent>
 #include <QRegExp>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFutureWatcher>
+#include <QThread>
 
 namespace RME {
 namespace ui {
 namespace palettes {
 
+namespace {
+// Bump when preview rendering changes so stale disk previews are not reused
+constexpr int DISK_CACHE_FORMAT_VERSION = 1;
+}
+
 BrushPreviewGenerator::BrushPreviewGenerator(QObject* parent)
     : QObject(parent)
     , m_previewCache(m_maxCacheSize)
 {
+    // Leave a core for the UI thread so scrolling stays smooth while a palette fills in
+    m_renderPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
     qDebug() << "BrushPreviewGenerator: Created";
 }
 
 BrushPreviewGenerator::~BrushPreviewGenerator()
 {
+    cancelAllPreviews();
+    m_renderPool.waitForDone();
     clearCache();
     qDebug() << "BrushPreviewGenerator: Destroyed";
 }
@@ -40,93 +54,229 @@ QPixmap BrushPreviewGenerator::generatePreview(RME::core::Brush* brush, const QS
     }
 
     // Check cache first
-    QString cacheKey = generateCacheKey(brush, size, style);
-    
-    QMutexLocker locker(&m_cacheMutex);
-    QPixmap* cachedPreview = m_previewCache.object(cacheKey);
-    if (cachedPreview) {
-        return *cachedPreview;
+    const QPixmap cached = cachedPreview(brush, size, style);
+    if (!cached.isNull()) {
+        return cached;
     }
-    locker.unlock();
 
-    // Generate new preview
-    QPixmap preview;
+    const QPixmap preview = QPixmap::fromImage(renderPreviewImage(brush, size, style, renderSettings()));
+    QMutexLocker locker(&m_cacheMutex);
+    m_previewCache.insert(PreviewKey{brush, size, style}, new QPixmap(preview));
+    return preview;
+}
+
+QImage BrushPreviewGenerator::renderPreviewImage(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render)
+{
     QString brushType = brush->getType();
 
     try {
         if (brushType.contains("Ground")) {
-            preview = generateGroundBrushPreview(brush, size, style);
+            return generateGroundBrushPreview(brush, size, style, render);
         } else if (brushType.contains("Wall")) {
-            preview = generateWallBrushPreview(brush, size, style);
+            return generateWallBrushPreview(brush, size, style, render);
         } else if (brushType.contains("Carpet")) {
-            preview = generateCarpetBrushPreview(brush, size, style);
+            return generateCarpetBrushPreview(brush, size, style, render);
         } else if (brushType.contains("Table")) {
-            preview = generateTableBrushPreview(brush, size, style);
+            return generateTableBrushPreview(brush, size, style, render);
         } else if (brushType.contains("Doodad")) {
-            preview = generateDoodadBrushPreview(brush, size, style);
+            return generateDoodadBrushPreview(brush, size, style, render);
         } else if (brushType.contains("Raw")) {
-            preview = generateRawBrushPreview(brush, size, style);
+            return generateRawBrushPreview(brush, size, style, render);
         } else if (brushType.contains("Creature")) {
-            preview = generateCreatureBrushPreview(brush, size, style);
+            return generateCreatureBrushPreview(brush, size, style, render);
         } else if (brushType.contains("Spawn")) {
-            preview = generateSpawnBrushPreview(brush, size, style);
+            return generateSpawnBrushPreview(brush, size, style, render);
         } else if (brushType.contains("Waypoint")) {
-            preview = generateWaypointBrushPreview(brush, size, style);
+            return generateWaypointBrushPreview(brush, size, style, render);
         } else if (brushType.contains("House")) {
-            preview = generateHouseBrushPreview(brush, size, style);
+            return generateHouseBrushPreview(brush, size, style, render);
         } else if (brushType.contains("Eraser")) {
-            preview = generateEraserBrushPreview(brush, size, style);
-        } else {
-            preview = generateDefaultBrushPreview(brush, size, style);
+            return generateEraserBrushPreview(brush, size, style, render);
         }
-
-        // Cache the result
-        locker.relock();
-        m_previewCache.insert(cacheKey, new QPixmap(preview));
-        
     } catch (const std::exception& e) {
         qWarning() << "BrushPreviewGenerator: Failed to generate preview for" << brush->getName() << ":" << e.what();
-        emit previewGenerationFailed(brush, QString::fromStdString(e.what()));
-        return generateDefaultBrushPreview(brush, size, style);
     }
-
-    return preview;
+    return generateDefaultBrushPreview(brush, size, style, render);
 }
 
 QPixmap BrushPreviewGenerator::generatePreviewAsync(RME::core::Brush* brush, const QSize& size, PreviewStyle style)
 {
+    if (!brush) {
+        return QPixmap();
+    }
+
     // Check cache first for immediate return
-    QString cacheKey = generateCacheKey(brush, size, style);
-    
+    const QPixmap cached = cachedPreview(brush, size, style);
+    if (!cached.isNull()) {
+        return cached;
+    }
+
+    // previewReady() delivers the real preview; the placeholder is cheap to draw here
+    requestPreview(brush, size, style, VisiblePriority);
+    return QPixmap::fromImage(generateDefaultBrushPreview(brush, size, style, renderSettings()));
+}
+
+QPixmap BrushPreviewGenerator::cachedPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style) const
+{
     QMutexLocker locker(&m_cacheMutex);
-    QPixmap* cachedPreview = m_previewCache.object(cacheKey);
-    if (cachedPreview) {
-        return *cachedPreview;
+    const QPixmap* cached = m_previewCache.object(PreviewKey{brush, size, style});
+    return cached ? *cached : QPixmap();
+}
+
+bool BrushPreviewGenerator::requestPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, int priority)
+{
+    if (!brush || size.isEmpty()) {
+        return false;
+    }
+    const PreviewKey key{brush, size, style};
+    {
+        QMutexLocker locker(&m_cacheMutex);
+        if (m_previewCache.contains(key)) {
+            return true;
+        }
+    }
+    if (m_runningJobs.contains(key)) {
+        return false; // Coalesced with the render in flight
     }
-    locker.unlock();
 
-    // Generate asynchronously
-    QFuture<QPixmap> future = QtConcurrent::run([this, brush, size, style]() {
-        return generatePreview(brush, size, style);
-    });
+    auto pending = m_pendingJobs.find(key);
+    if (pending != m_pendingJobs.end()) {
+        // Coalesce; only move the job forward if the new request is more urgent
+        if (priority < pending->priority) {
+            m_jobQueue.remove(QueueSlot(pending->priority, pending->sequence));
+            pending->priority = priority;
+            m_jobQueue.insert(QueueSlot(pending->priority, pending->sequence), key);
+        }
+        return false;
+    }
 
-    // For now, return a placeholder and emit signal when ready
-    QPixmap placeholder = generateDefaultBrushPreview(brush, size, style);
-    
-    // Connect future to signal emission using QFutureWatcher
-    QFutureWatcher<QPixmap>* watcher = new QFutureWatcher<QPixmap>(this);
-    connect(watcher, &QFutureWatcher<QPixmap>::finished, this, [this, watcher]() {
-        emit previewReady(watcher->result());
-        watcher->deleteLater();
-    });
-    watcher->setFuture(future);
-    // This would require more complex async handling
-    
-    return placeholder;
+    const PendingJob job{priority, m_nextSequence++};
+    m_pendingJobs.insert(key, job);
+    m_jobQueue.insert(QueueSlot(job.priority, job.sequence), key);
+    dispatchJobs();
+    return false;
+}
+
+void BrushPreviewGenerator::cancelPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style)
+{
+    // Renders already started are left to finish; their result is still cached
+    const auto pending = m_pendingJobs.constFind(PreviewKey{brush, size, style});
+    if (pending != m_pendingJobs.constEnd()) {
+        m_jobQueue.remove(QueueSlot(pending->priority, pending->sequence));
+        m_pendingJobs.erase(pending);
+    }
+}
+
+void BrushPreviewGenerator::cancelAllPreviews()
+{
+    m_pendingJobs.clear();
+    m_jobQueue.clear();
+}
+
+void BrushPreviewGenerator::dispatchJobs()
+{
+    while (!m_jobQueue.isEmpty() && m_runningJobs.size() < m_renderPool.maxThreadCount()) {
+        const PreviewKey key = m_jobQueue.first();
+        m_jobQueue.erase(m_jobQueue.begin());
+        m_pendingJobs.remove(key);
+
+        const quint64 generation = m_generation;
+        m_runningJobs.insert(key, generation);
+        // Workers render with the settings of the dispatch, which also key the disk cache file
+        const RenderSettings render = renderSettings();
+        const QString diskPath = diskCachePath(key, render);
+
+        QFuture<QImage> future = QtConcurrent::run(&m_renderPool, [this, key, render, diskPath, generation]() {
+            QImage image;
+            if (!diskPath.isEmpty() && QFile::exists(diskPath) && image.load(diskPath, "PNG") && image.size() == key.size) {
+                return image;
+            }
+            image = renderPreviewImage(key.brush, key.size, key.style, render);
+            // A stale render is dropped by onJobFinished(), so do not keep it on disk either
+            if (!diskPath.isEmpty() && !image.isNull() && generation == m_generation.load() && !image.save(diskPath, "PNG")) {
+                qWarning() << "BrushPreviewGenerator: Could not write preview cache file" << diskPath;
+            }
+            return image;
+        });
+
+        auto* watcher = new QFutureWatcher<QImage>(this);
+        connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, key, generation]() {
+            onJobFinished(key, generation, watcher->result());
+            watcher->deleteLater();
+        });
+        watcher->setFuture(future);
+    }
+}
+
+void BrushPreviewGenerator::onJobFinished(const PreviewKey& key, quint64 generation, const QImage& image)
+{
+    m_runningJobs.remove(key);
+
+    if (generation == m_generation && !image.isNull()) {
+        // QPixmap must be created on the UI thread
+        const QPixmap preview = QPixmap::fromImage(image);
+        {
+            QMutexLocker locker(&m_cacheMutex);
+            m_previewCache.insert(key, new QPixmap(preview));
+        }
+        emit previewReady(key.brush, key.size, key.style, preview);
+    } else if (image.isNull()) {
+        emit previewGenerationFailed(key.brush, tr("Preview rendering failed"));
+    } else {
+        // Settings changed mid-render; render again if someone still wants it
+        requestPreview(key.brush, key.size, key.style, VisiblePriority);
+    }
+
+    dispatchJobs();
+}
+
+BrushPreviewGenerator::RenderSettings BrushPreviewGenerator::renderSettings() const
+{
+    return RenderSettings{m_backgroundColor, m_gridEnabled};
+}
+
+QString BrushPreviewGenerator::diskCachePath(const PreviewKey& key, const RenderSettings& render) const
+{
+    if (m_diskCacheDirectory.isEmpty()) {
+        return QString();
+    }
+    // Brush pointers change between runs, so previews on disk are keyed by what identifies the brush
+    const QString identity = QString("%1|%2|%3|%4x%5|%6|%7|%8")
+        .arg(DISK_CACHE_FORMAT_VERSION)
+        .arg(key.brush->getType(), key.brush->getName())
+        .arg(key.size.width())
+        .arg(key.size.height())
+        .arg(static_cast<int>(key.style))
+        .arg(render.backgroundColor.name(QColor::HexArgb))
+        .arg(render.gridEnabled ? 1 : 0);
+    const QByteArray hash = QCryptographicHash::hash(identity.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return m_diskCacheDirectory + QLatin1Char('/') + QString::fromLatin1(hash) + QStringLiteral(".png");
+}
+
+void BrushPreviewGenerator::setDiskCacheDirectory(const QString& directory)
+{
+    if (!directory.isEmpty() && !QDir().mkpath(directory)) {
+        qWarning() << "BrushPreviewGenerator: Cannot create preview cache directory" << directory;
+        m_diskCacheDirectory.clear();
+        return;
+    }
+    m_diskCacheDirectory = directory;
+}
+
+void BrushPreviewGenerator::clearDiskCache()
+{
+    if (m_diskCacheDirectory.isEmpty()) {
+        return;
+    }
+    QDir dir(m_diskCacheDirectory);
+    for (const QString& fileName : dir.entryList(QStringList() << "*.png", QDir::Files)) {
+        dir.remove(fileName);
+    }
 }
 
 void BrushPreviewGenerator::clearCache()
 {
+    ++m_generation;
     QMutexLocker locker(&m_cacheMutex);
     m_previewCache.clear();
     qDebug() << "BrushPreviewGenerator: Cache cleared";
@@ -172,24 +322,24 @@ bool BrushPreviewGenerator::isGridEnabled() const
 
 void BrushPreviewGenerator::onPreviewGenerated(RME::core::Brush* brush, const QPixmap& preview)
 {
-    emit previewReady(brush, preview);
+    emit previewReady(brush, preview.size(), IconStyle, preview);
 }
 
 // Brush-specific preview generation methods
 
-QPixmap BrushPreviewGenerator::generateGroundBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style)
+QImage BrushPreviewGenerator::generateGroundBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render)
 {
     if (!brush || !m_assetManager) {
-        return generateDefaultBrushPreview(brush, size, style);
+        return generateDefaultBrushPreview(brush, size, style, render);
     }
     
-    QPixmap preview(size);
+    QImage preview(size, QImage::Format_ARGB32_Premultiplied);
     preview.fill(Qt::transparent);
     
     QPainter painter(&preview);
     painter.setRenderHint(QPainter::SmoothPixmapTransformation);
     
-    drawBackground(painter, preview.rect(), style);
+    drawBackground(painter, preview.rect(), style, render);
     
     // Try to get material data from the ground brush
     auto* materialManager = m_assetManager->getMaterialManager();
@@ -224,19 +374,15 @@ QPixmap BrushPreviewGenerator::generateGroundBrushPreview(RME::core::Brush* brus
                             int itemIndex = (x + y * 3) % material.groundItems.size();
                             uint16_t itemId = material.groundItems[itemIndex].itemId;
                             
-                            const SpriteData* spriteData = spriteManager->getSpriteData(itemId);
-                            if (spriteData && !spriteData->frames.isEmpty()) {
-                                const QImage& spriteImage = spriteData->frames.first().image;
-                                if (!spriteImage.isNull()) {
-                                    QPixmap sprite = QPixmap::fromImage(spriteImage);
-                                    QRect tileRect(offsetX + x * tileSize, offsetY + y * tileSize, tileSize, tileSize);
-                                    QPixmap scaledSprite = sprite.scaled(tileSize, tileSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-                                    
-                                    // Center sprite in tile
-                                    int spriteX = tileRect.x() + (tileSize - scaledSprite.width()) / 2;
-                                    int spriteY = tileRect.y() + (tileSize - scaledSprite.height()) / 2;
-                                    painter.drawPixmap(spriteX, spriteY, scaledSprite);
-                                }
+                            const QImage spriteImage = spriteManager->getSpriteFrame(itemId, 0);
+                            if (!spriteImage.isNull()) {
+                                QRect tileRect(offsetX + x * tileSize, offsetY + y * tileSize, tileSize, tileSize);
+                                QImage scaledSprite = spriteImage.scaled(tileSize, tileSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+                                
+                                // Center sprite in tile
+                                int spriteX = tileRect.x() + (tileSize - scaledSprite.width()) / 2;
+                                int spriteY = tileRect.y() + (tileSize - scaledSprite.height()) / 2;
+                                painter.drawImage(spriteX, spriteY, scaledSprite);
                             }
                         }
                     }
@@ -249,7 +395,7 @@ QPixmap BrushPreviewGenerator::generateGroundBrushPreview(RME::core::Brush* brus
                                       tileSize, spriteManager);
                 }
                 
-                if (m_gridEnabled) {
+                if (render.gridEnabled) {
                     drawGrid(painter, preview.rect());
                 }
                 
@@ -277,7 +423,7 @@ QPixmap BrushPreviewGenerator::generateGroundBrushPreview(RME::core::Brush* brus
         }
     }
     
-    if (m_gridEnabled) {
+    if (render.gridEnabled) {
         drawGrid(painter, preview.rect());
     }
     
@@ -286,19 +432,19 @@ QPixmap BrushPreviewGenerator::generateGroundBrushPreview(RME::core::Brush* brus
     return preview;
 }
 
-QPixmap BrushPreviewGenerator::generateWallBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style)
+QImage BrushPreviewGenerator::generateWallBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render)
 {
     if (!brush || !m_assetManager) {
-        return generateDefaultBrushPreview(brush, size, style);
+        return generateDefaultBrushPreview(brush, size, style, render);
     }
     
-    QPixmap preview(size);
+    QImage preview(size, QImage::Format_ARGB32_Premultiplied);
     preview.fill(Qt::transparent);
     
     QPainter painter(&preview);
     painter.setRenderHint(QPainter::SmoothPixmapTransformation);
     
-    drawBackground(painter, preview.rect(), style);
+    drawBackground(painter, preview.rect(), style, render);
     
     // Try to get material data from the wall brush
     auto* materialManager = m_assetManager->getMaterialManager();
@@ -353,25 +499,21 @@ QPixmap BrushPreviewGenerator::generateWallBrushPreview(RME::core::Brush* brush,
                             }
                             
                             if (wallItemId > 0) {
-                                const SpriteData* spriteData = spriteManager->getSpriteData(wallItemId);
-                                if (spriteData && !spriteData->frames.isEmpty()) {
-                                    const QImage& spriteImage = spriteData->frames.first().image;
-                                    if (!spriteImage.isNull()) {
-                                        QPixmap sprite = QPixmap::fromImage(spriteImage);
-                                        QRect tileRect(offsetX + x * tileSize, offsetY + y * tileSize, tileSize, tileSize);
-                                        QPixmap scaledSprite = sprite.scaled(tileSize, tileSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-                                        
-                                        // Center sprite in tile
-                                        int spriteX = tileRect.x() + (tileSize - scaledSprite.width()) / 2;
-                                        int spriteY = tileRect.y() + (tileSize - scaledSprite.height()) / 2;
-                                        painter.drawPixmap(spriteX, spriteY, scaledSprite);
-                                    }
+                                const QImage spriteImage = spriteManager->getSpriteFrame(wallItemId, 0);
+                                if (!spriteImage.isNull()) {
+                                    QRect tileRect(offsetX + x * tileSize, offsetY + y * tileSize, tileSize, tileSize);
+                                    QImage scaledSprite = spriteImage.scaled(tileSize, tileSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+                                    
+                                    // Center sprite in tile
+                                    int spriteX = tileRect.x() + (tileSize - scaledSprite.width()) / 2;
+                                    int spriteY = tileRect.y() + (tileSize - scaledSprite.height()) / 2;
+                                    painter.drawImage(spriteX, spriteY, scaledSprite);
                                 }
                             }
                         }
                     }
                     
-                    if (m_gridEnabled) {
+                    if (render.gridEnabled) {
                         drawGrid(painter, preview.rect());
                     }
                     
@@ -403,7 +545,7 @@ QPixmap BrushPreviewGenerator::generateWallBrushPreview(RME::core::Brush* brush,
         }
     }
     
-    if (m_gridEnabled) {
+    if (render.gridEnabled) {
         drawGrid(painter, preview.rect());
     }
     
@@ -412,15 +554,15 @@ QPixmap BrushPreviewGenerator::generateWallBrushPreview(RME::core::Brush* brush,
     return preview;
 }
 
-QPixmap BrushPreviewGenerator::generateCreatureBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style)
+QImage BrushPreviewGenerator::generateCreatureBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render)
 {
-    QPixmap preview(size);
+    QImage preview(size, QImage::Format_ARGB32_Premultiplied);
     preview.fill(Qt::transparent);
     
     QPainter painter(&preview);
     painter.setRenderHint(QPainter::Antialiasing);
     
-    drawBackground(painter, preview.rect(), style);
+    drawBackground(painter, preview.rect(), style, render);
     
     // Draw creature representation
     QColor creatureColor(33, 150, 243); // Blue
@@ -441,7 +583,7 @@ QPixmap BrushPreviewGenerator::generateCreatureBrushPreview(RME::core::Brush* br
     painter.drawEllipse(leftEye, eyeSize / 2, eyeSize / 2);
     painter.drawEllipse(rightEye, eyeSize / 2, eyeSize / 2);
     
-    if (m_gridEnabled) {
+    if (render.gridEnabled) {
         drawGrid(painter, preview.rect());
     }
     
@@ -450,15 +592,15 @@ QPixmap BrushPreviewGenerator::generateCreatureBrushPreview(RME::core::Brush* br
     return preview;
 }
 
-QPixmap BrushPreviewGenerator::generateDefaultBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style)
+QImage BrushPreviewGenerator::generateDefaultBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render)
 {
-    QPixmap preview(size);
+    QImage preview(size, QImage::Format_ARGB32_Premultiplied);
     preview.fill(Qt::transparent);
     
     QPainter painter(&preview);
     painter.setRenderHint(QPainter::Antialiasing);
     
-    drawBackground(painter, preview.rect(), style);
+    drawBackground(painter, preview.rect(), style, render);
     
     // Draw generic brush icon
     QColor brushColor(158, 158, 158);
@@ -479,7 +621,7 @@ QPixmap BrushPreviewGenerator::generateDefaultBrushPreview(RME::core::Brush* bru
     painter.setFont(QFont("Arial", qMax(8, size.width() / 4), QFont::Bold));
     painter.drawText(preview.rect(), Qt::AlignCenter, "?");
     
-    if (m_gridEnabled) {
+    if (render.gridEnabled) {
         drawGrid(painter, preview.rect());
     }
     
@@ -489,15 +631,15 @@ QPixmap BrushPreviewGenerator::generateDefaultBrushPreview(RME::core::Brush* bru
 }
 
 // Placeholder implementations for other brush types
-QPixmap BrushPreviewGenerator::generateCarpetBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style)
+QImage BrushPreviewGenerator::generateCarpetBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render)
 {
-    QPixmap preview(size);
+    QImage preview(size, QImage::Format_ARGB32_Premultiplied);
     preview.fill(Qt::transparent);
     
     QPainter painter(&preview);
     painter.setRenderHint(QPainter::Antialiasing);
     
-    drawBackground(painter, preview.rect(), style);
+    drawBackground(painter, preview.rect(), style, render);
     
     // Draw carpet pattern
     QColor carpetColor(156, 39, 176); // Purple
@@ -524,7 +666,7 @@ QPixmap BrushPreviewGenerator::generateCarpetBrushPreview(RME::core::Brush* brus
         }
     }
     
-    if (m_gridEnabled) {
+    if (render.gridEnabled) {
         drawGrid(painter, preview.rect());
     }
     
@@ -533,15 +675,15 @@ QPixmap BrushPreviewGenerator::generateCarpetBrushPreview(RME::core::Brush* brus
     return preview;
 }
 
-QPixmap BrushPreviewGenerator::generateTableBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style)
+QImage BrushPreviewGenerator::generateTableBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render)
 {
-    QPixmap preview(size);
+    QImage preview(size, QImage::Format_ARGB32_Premultiplied);
     preview.fill(Qt::transparent);
     
     QPainter painter(&preview);
     painter.setRenderHint(QPainter::Antialiasing);
     
-    drawBackground(painter, preview.rect(), style);
+    drawBackground(painter, preview.rect(), style, render);
     
     // Draw table pattern
     QColor tableColor(121, 85, 72); // Brown
@@ -572,7 +714,7 @@ QPixmap BrushPreviewGenerator::generateTableBrushPreview(RME::core::Brush* brush
     painter.drawRect(bottomLeftLeg);
     painter.drawRect(bottomRightLeg);
     
-    if (m_gridEnabled) {
+    if (render.gridEnabled) {
         drawGrid(painter, preview.rect());
     }
     
@@ -581,15 +723,15 @@ QPixmap BrushPreviewGenerator::generateTableBrushPreview(RME::core::Brush* brush
     return preview;
 }
 
-QPixmap BrushPreviewGenerator::generateDoodadBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style)
+QImage BrushPreviewGenerator::generateDoodadBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render)
 {
-    QPixmap preview(size);
+    QImage preview(size, QImage::Format_ARGB32_Premultiplied);
     preview.fill(Qt::transparent);
     
     QPainter painter(&preview);
     painter.setRenderHint(QPainter::Antialiasing);
     
-    drawBackground(painter, preview.rect(), style);
+    drawBackground(painter, preview.rect(), style, render);
     
     // Draw doodad items (decorative objects)
     QColor doodadColor(139, 195, 74); // Light green
@@ -622,7 +764,7 @@ QPixmap BrushPreviewGenerator::generateDoodadBrushPreview(RME::core::Brush* brus
     painter.setFont(QFont("Arial", qMax(6, size.width() / 8), QFont::Bold));
     painter.drawText(preview.rect(), Qt::AlignCenter, "D");
     
-    if (m_gridEnabled) {
+    if (render.gridEnabled) {
         drawGrid(painter, preview.rect());
     }
     
@@ -631,19 +773,19 @@ QPixmap BrushPreviewGenerator::generateDoodadBrushPreview(RME::core::Brush* brus
     return preview;
 }
 
-QPixmap BrushPreviewGenerator::generateRawBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style)
+QImage BrushPreviewGenerator::generateRawBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render)
 {
     if (!brush || !m_assetManager) {
-        return generateDefaultBrushPreview(brush, size, style);
+        return generateDefaultBrushPreview(brush, size, style, render);
     }
     
-    QPixmap preview(size);
+    QImage preview(size, QImage::Format_ARGB32_Premultiplied);
     preview.fill(Qt::transparent);
     
     QPainter painter(&preview);
     painter.setRenderHint(QPainter::SmoothPixmapTransformation);
     
-    drawBackground(painter, preview.rect(), style);
+    drawBackground(painter, preview.rect(), style, render);
     
     // Try to get the raw brush's item ID
     // This would need to be implemented in the RawBrush class
@@ -663,26 +805,22 @@ QPixmap BrushPreviewGenerator::generateRawBrushPreview(RME::core::Brush* brush,
         // Get sprite from AssetManager
         auto* spriteManager = m_assetManager->getSpriteManager();
         if (spriteManager) {
-            const SpriteData* spriteData = spriteManager->getSpriteData(itemId);
-            if (spriteData && !spriteData->frames.isEmpty()) {
-                const QImage& spriteImage = spriteData->frames.first().image;
-                if (!spriteImage.isNull()) {
-                    // Scale sprite to fit preview
-                    QPixmap sprite = QPixmap::fromImage(spriteImage);
-                    QPixmap scaledSprite = sprite.scaled(size * 0.8, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-                    
-                    // Center the sprite in the preview
-                    int x = (size.width() - scaledSprite.width()) / 2;
-                    int y = (size.height() - scaledSprite.height()) / 2;
-                    painter.drawPixmap(x, y, scaledSprite);
-                    
-                    if (m_gridEnabled) {
-                        drawGrid(painter, preview.rect());
-                    }
-                    
-                    drawBorder(painter, preview.rect(), style);
-                    return preview;
+            const QImage spriteImage = spriteManager->getSpriteFrame(itemId, 0);
+            if (!spriteImage.isNull()) {
+                // Scale sprite to fit preview
+                QImage scaledSprite = spriteImage.scaled(size * 0.8, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+                
+                // Center the sprite in the preview
+                int x = (size.width() - scaledSprite.width()) / 2;
+                int y = (size.height() - scaledSprite.height()) / 2;
+                painter.drawImage(x, y, scaledSprite);
+                
+                if (render.gridEnabled) {
+                    drawGrid(painter, preview.rect());
                 }
+                
+                drawBorder(painter, preview.rect(), style);
+                return preview;
             }
         }
     }
@@ -702,7 +840,7 @@ QPixmap BrushPreviewGenerator::generateRawBrushPreview(RME::core::Brush* brush,
     painter.setFont(QFont("Arial", qMax(8, size.width() / 3), QFont::Bold));
     painter.drawText(preview.rect(), Qt::AlignCenter, "R");
     
-    if (m_gridEnabled) {
+    if (render.gridEnabled) {
         drawGrid(painter, preview.rect());
     }
     
@@ -711,15 +849,15 @@ QPixmap BrushPreviewGenerator::generateRawBrushPreview(RME::core::Brush* brush,
     return preview;
 }
 
-QPixmap BrushPreviewGenerator::generateSpawnBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style)
+QImage BrushPreviewGenerator::generateSpawnBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render)
 {
-    QPixmap preview(size);
+    QImage preview(size, QImage::Format_ARGB32_Premultiplied);
     preview.fill(Qt::transparent);
     
     QPainter painter(&preview);
     painter.setRenderHint(QPainter::Antialiasing);
     
-    drawBackground(painter, preview.rect(), style);
+    drawBackground(painter, preview.rect(), style, render);
     
     // Draw spawn area circle
     QRect circleRect = preview.rect().adjusted(4, 4, -4, -4);
@@ -748,7 +886,7 @@ QPixmap BrushPreviewGenerator::generateSpawnBrushPreview(RME::core::Brush* brush
         painter.drawEllipse(radiusRect);
     }
     
-    if (m_gridEnabled) {
+    if (render.gridEnabled) {
         drawGrid(painter, preview.rect());
     }
     
@@ -757,15 +895,15 @@ QPixmap BrushPreviewGenerator::generateSpawnBrushPreview(RME::core::Brush* brush
     return preview;
 }
 
-QPixmap BrushPreviewGenerator::generateWaypointBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style)
+QImage BrushPreviewGenerator::generateWaypointBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render)
 {
-    QPixmap preview(size);
+    QImage preview(size, QImage::Format_ARGB32_Premultiplied);
     preview.fill(Qt::transparent);
     
     QPainter painter(&preview);
     painter.setRenderHint(QPainter::Antialiasing);
     
-    drawBackground(painter, preview.rect(), style);
+    drawBackground(painter, preview.rect(), style, render);
     
     // Draw waypoint flag
     QRect flagRect = preview.rect().adjusted(8, 4, -8, -4);
@@ -792,7 +930,7 @@ QPixmap BrushPreviewGenerator::generateWaypointBrushPreview(RME::core::Brush* br
     QRect textRect = flag.boundingRect();
     painter.drawText(textRect, Qt::AlignCenter, "W");
     
-    if (m_gridEnabled) {
+    if (render.gridEnabled) {
         drawGrid(painter, preview.rect());
     }
     
@@ -801,15 +939,15 @@ QPixmap BrushPreviewGenerator::generateWaypointBrushPreview(RME::core::Brush* br
     return preview;
 }
 
-QPixmap BrushPreviewGenerator::generateHouseBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style)
+QImage BrushPreviewGenerator::generateHouseBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render)
 {
-    QPixmap preview(size);
+    QImage preview(size, QImage::Format_ARGB32_Premultiplied);
     preview.fill(Qt::transparent);
     
     QPainter painter(&preview);
     painter.setRenderHint(QPainter::Antialiasing);
     
-    drawBackground(painter, preview.rect(), style);
+    drawBackground(painter, preview.rect(), style, render);
     
     // Draw house outline
     QRect houseRect = preview.rect().adjusted(4, 4, -4, -4);
@@ -839,7 +977,7 @@ QPixmap BrushPreviewGenerator::generateHouseBrushPreview(RME::core::Brush* brush
     painter.setFont(QFont("Arial", qMax(6, size.width() / 8), QFont::Bold));
     painter.drawText(houseRect, Qt::AlignCenter, "H");
     
-    if (m_gridEnabled) {
+    if (render.gridEnabled) {
         drawGrid(painter, preview.rect());
     }
     
@@ -848,15 +986,15 @@ QPixmap BrushPreviewGenerator::generateHouseBrushPreview(RME::core::Brush* brush
     return preview;
 }
 
-QPixmap BrushPreviewGenerator::generateEraserBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style)
+QImage BrushPreviewGenerator::generateEraserBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render)
 {
-    QPixmap preview(size);
+    QImage preview(size, QImage::Format_ARGB32_Premultiplied);
     preview.fill(Qt::transparent);
     
     QPainter painter(&preview);
     painter.setRenderHint(QPainter::Antialiasing);
     
-    drawBackground(painter, preview.rect(), style);
+    drawBackground(painter, preview.rect(), style, render);
     
     // Draw eraser circle
     QRect eraserRect = preview.rect().adjusted(4, 4, -4, -4);
@@ -879,7 +1017,7 @@ QPixmap BrushPreviewGenerator::generateEraserBrushPreview(RME::core::Brush* brus
         painter.drawLine(eraserRect.left() + 2, y, eraserRect.right() - 2, y);
     }
     
-    if (m_gridEnabled) {
+    if (render.gridEnabled) {
         drawGrid(painter, preview.rect());
     }
     
@@ -890,20 +1028,10 @@ QPixmap BrushPreviewGenerator::generateEraserBrushPreview(RME::core::Brush* brus
 
 // Helper methods
 
-QString BrushPreviewGenerator::generateCacheKey(RME::core::Brush* brush, const QSize& size, PreviewStyle style) const
+void BrushPreviewGenerator::drawBackground(QPainter& painter, const QRect& rect, PreviewStyle style,
+                                           const RenderSettings& render)
 {
-    return QString("%1_%2x%3_%4_%5_%6")
-        .arg(reinterpret_cast<quintptr>(brush))
-        .arg(size.width())
-        .arg(size.height())
-        .arg(static_cast<int>(style))
-        .arg(m_backgroundColor.name())
-        .arg(m_gridEnabled ? 1 : 0);
-}
-
-void BrushPreviewGenerator::drawBackground(QPainter& painter, const QRect& rect, PreviewStyle style)
-{
-    painter.fillRect(rect, m_backgroundColor);
+    painter.fillRect(rect, render.backgroundColor);
 }
 
 void BrushPreviewGenerator::drawGrid(QPainter& painter, const QRect& rect, int gridSize)
@@ -952,18 +1080,12 @@ void BrushPreviewGenerator::drawMaterialBorders(QPainter& painter, const BorderS
     
     // Draw corner and edge borders around the area
     for (const auto& border : borderSet.borders) {
-        const SpriteData* spriteData = spriteManager->getSpriteData(border.itemId);
-        if (!spriteData || spriteData->frames.isEmpty()) {
-            continue;
-        }
-        
-        const QImage& spriteImage = spriteData->frames.first().image;
+        const QImage spriteImage = spriteManager->getSpriteFrame(border.itemId, 0);
         if (spriteImage.isNull()) {
             continue;
         }
         
-        QPixmap borderSprite = QPixmap::fromImage(spriteImage);
-        QPixmap scaledBorder = borderSprite.scaled(tileSize, tileSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        QImage scaledBorder = spriteImage.scaled(tileSize, tileSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
         
         QRect borderRect;
         switch (border.position) {
@@ -999,7 +1121,7 @@ void BrushPreviewGenerator::drawMaterialBorders(QPainter& painter, const BorderS
             // Center border sprite in rect
             int x = borderRect.x() + (tileSize - scaledBorder.width()) / 2;
             int y = borderRect.y() + (tileSize - scaledBorder.height()) / 2;
-            painter.drawPixmap(x, y, scaledBorder);
+            painter.drawImage(x, y, scaledBorder);
         }
     }
 }
@@ -4,8 +4,15 @@
 #include <QPixmap>
 #include <QSize>
 #include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QMap>
 #include <QMutex>
 #include <QFuture>
+#include <QThreadPool>
+#include <QString>
+#include <QColor>
+#include <atomic>
 
 namespace RME {
 namespace core {
@@ -26,6 +33,15 @@ namespace palettes {
  * This class creates visual previews for different brush types,
  * caching the results for performance. Supports different preview
  * sizes and styles.
+ *
+ * requestPreview() queues a render on a private thread pool and returns at
+ * once; previewReady() is emitted on the UI thread with the brush, size and
+ * style of the request. Requests for a preview that is already queued or
+ * rendering are merged, lower priority values are rendered first, and
+ * cancelPreview() drops queued requests that are no longer needed (e.g.
+ * scrolled out of view). Previews are rendered to QImage off the UI thread and
+ * kept in a memory cache and, if a directory is set, a PNG cache on disk that
+ * survives restarts.
  */
 class BrushPreviewGenerator : public QObject
 {
@@ -41,6 +57,14 @@ public:
         DetailStyle     ///< Large detailed preview
     };
 
+    /**
+     * @brief Request priorities; lower values are rendered first
+     */
+    enum PreviewPriority {
+        VisiblePriority = 0,  ///< Shown on screen right now
+        PrefetchPriority = 10 ///< Likely to be shown soon (e.g. just outside the viewport)
+    };
+
     explicit BrushPreviewGenerator(QObject* parent = nullptr);
     ~BrushPreviewGenerator();
 
@@ -48,14 +72,31 @@ public:
     void setAssetManager(RME::core::assets::AssetManager* assetManager);
 
     // Preview generation
+    // Renders synchronously on the calling (UI) thread; prefer requestPreview() for lists
     QPixmap generatePreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style = IconStyle);
+    // Returns the cached preview, or a placeholder after queuing a request with VisiblePriority
     QPixmap generatePreviewAsync(RME::core::Brush* brush, const QSize& size, PreviewStyle style = IconStyle);
 
+    // Asynchronous pipeline
+    // Returns true and emits nothing if the preview is already in memory (see cachedPreview())
+    bool requestPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style = IconStyle,
+                        int priority = VisiblePriority);
+    void cancelPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style = IconStyle);
+    void cancelAllPreviews();
+    QPixmap cachedPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style = IconStyle) const;
+    int getPendingPreviewCount() const { return m_pendingJobs.size(); }
+
     // Cache management
     void clearCache();
     void setCacheSize(int maxCost);
     int getCacheSize() const;
 
+    // PNG previews are stored in 'directory' (created if needed); an empty path disables the disk cache.
+    // Use a directory per client version, since previews are keyed by brush name and not by sprites.
+    void setDiskCacheDirectory(const QString& directory);
+    QString getDiskCacheDirectory() const { return m_diskCacheDirectory; }
+    void clearDiskCache();
+
     // Preview configuration
     void setBackgroundColor(const QColor& color);
     QColor getBackgroundColor() const;
@@ -67,38 +108,80 @@ public slots:
     void onPreviewGenerated(RME::core::Brush* brush, const QPixmap& preview);
 
 signals:
-    void previewReady(RME::core::Brush* brush, const QPixmap& preview);
+    void previewReady(RME::core::Brush* brush, const QSize& size,
+                      RME::ui::palettes::BrushPreviewGenerator::PreviewStyle style, const QPixmap& preview);
     void previewGenerationFailed(RME::core::Brush* brush, const QString& error);
 
 protected:
+    // Rendering options, copied for each render so worker threads never read the members
+    struct RenderSettings {
+        QColor backgroundColor;
+        bool gridEnabled = false;
+    };
+    RenderSettings renderSettings() const;
+
     // Preview generation methods
-    QPixmap generateGroundBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style);
-    QPixmap generateWallBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style);
-    QPixmap generateCarpetBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style);
-    QPixmap generateTableBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style);
-    QPixmap generateDoodadBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style);
-    QPixmap generateRawBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style);
-    QPixmap generateCreatureBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style);
-    QPixmap generateSpawnBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style);
-    QPixmap generateWaypointBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style);
-    QPixmap generateHouseBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style);
-    QPixmap generateEraserBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style);
-    QPixmap generateDefaultBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style);
+    QImage generateGroundBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render);
+    QImage generateWallBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render);
+    QImage generateCarpetBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render);
+    QImage generateTableBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render);
+    QImage generateDoodadBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render);
+    QImage generateRawBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render);
+    QImage generateCreatureBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render);
+    QImage generateSpawnBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render);
+    QImage generateWaypointBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render);
+    QImage generateHouseBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render);
+    QImage generateEraserBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render);
+    QImage generateDefaultBrushPreview(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render);
 
     // Helper methods
-    QString generateCacheKey(RME::core::Brush* brush, const QSize& size, PreviewStyle style) const;
-    void drawBackground(QPainter& painter, const QRect& rect, PreviewStyle style);
+    // Dispatches on the brush type; safe to call from worker threads
+    QImage renderPreviewImage(RME::core::Brush* brush, const QSize& size, PreviewStyle style, const RenderSettings& render);
+    void drawBackground(QPainter& painter, const QRect& rect, PreviewStyle style, const RenderSettings& render);
     void drawGrid(QPainter& painter, const QRect& rect, int gridSize = 8);
     void drawBorder(QPainter& painter, const QRect& rect, PreviewStyle style);
     void drawMaterialBorders(QPainter& painter, const BorderSetData& borderSet, const QRect& area, int tileSize, class SpriteManager* spriteManager);
 
 private:
+    struct PreviewKey {
+        RME::core::Brush* brush = nullptr;
+        QSize size;
+        PreviewStyle style = IconStyle;
+
+        bool operator==(const PreviewKey& other) const {
+            return brush == other.brush && size == other.size && style == other.style;
+        }
+    };
+    friend size_t qHash(const PreviewKey& key, size_t seed) {
+        return qHashMulti(seed, key.brush, key.size.width(), key.size.height(), static_cast<int>(key.style));
+    }
+
+    struct PendingJob {
+        int priority = VisiblePriority;
+        quint64 sequence = 0;
+    };
+    // Queue order: priority first, then request order
+    using QueueSlot = QPair<int, quint64>;
+
+    void dispatchJobs();
+    void onJobFinished(const PreviewKey& key, quint64 generation, const QImage& image);
+    QString diskCachePath(const PreviewKey& key, const RenderSettings& render) const;
+
     // Dependencies
     RME::core::assets::AssetManager* m_assetManager = nullptr;
 
     // Cache
-    QCache<QString, QPixmap> m_previewCache;
+    QCache<PreviewKey, QPixmap> m_previewCache;
     mutable QMutex m_cacheMutex;
+    QString m_diskCacheDirectory;
+
+    // Job queue, only touched on the UI thread
+    QHash<PreviewKey, PendingJob> m_pendingJobs;
+    QMap<QueueSlot, PreviewKey> m_jobQueue;
+    QHash<PreviewKey, quint64> m_runningJobs; // Value is the generation the job started in
+    quint64 m_nextSequence = 0;
+    std::atomic<quint64> m_generation{0}; // Bumped when rendering settings change, stale results are dropped
+    QThreadPool m_renderPool;
 
     // Configuration
     QColor m_backgroundColor = QColor(240, 240, 240);
@@ -329,27 +329,24 @@ void ItemPalettePanel::updateItemPreview(quint16 itemId) {
         // Get sprite preview
         auto* spriteManager = m_clientDataService->getSpriteManager();
         if (spriteManager) {
-            const SpriteData* spriteData = spriteManager->getSpriteData(itemId);
-            if (spriteData && !spriteData->frames.isEmpty()) {
-                const QImage& spriteImage = spriteData->frames.first().image;
-                if (!spriteImage.isNull()) {
-                    // Scale sprite for preview (larger than icon)
-                    QPixmap sprite = QPixmap::fromImage(spriteImage);
-                    QPixmap scaledSprite = sprite.scaled(64, 64, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-                    
-                    // Create a 64x64 canvas and center the sprite
-                    QPixmap previewPixmap(64, 64);
-                    previewPixmap.fill(Qt::transparent);
-                    
-                    QPainter painter(&previewPixmap);
-                    int x = (64 - scaledSprite.width()) / 2;
-                    int y = (64 - scaledSprite.height()) / 2;
-                    painter.drawPixmap(x, y, scaledSprite);
-                    
-                    m_previewLabel->setPixmap(previewPixmap);
-                    m_itemInfoLabel->setText(itemInfo);
-                    return;
-                }
+            const QImage spriteImage = spriteManager->getSpriteFrame(itemId, 0);
+            if (!spriteImage.isNull()) {
+                // Scale sprite for preview (larger than icon)
+                QPixmap sprite = QPixmap::fromImage(spriteImage);
+                QPixmap scaledSprite = sprite.scaled(64, 64, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+                
+                // Create a 64x64 canvas and center the sprite
+                QPixmap previewPixmap(64, 64);
+                previewPixmap.fill(Qt::transparent);
+                
+                QPainter painter(&previewPixmap);
+                int x = (64 - scaledSprite.width()) / 2;
+                int y = (64 - scaledSprite.height()) / 2;
+                painter.drawPixmap(x, y, scaledSprite);
+                
+                m_previewLabel->setPixmap(previewPixmap);
+                m_itemInfoLabel->setText(itemInfo);
+                return;
             }
         }
     }
@@ -545,26 +542,23 @@ QIcon ItemPalettePanel::getItemIcon(quint16 itemId) const {
     if (m_clientDataService) {
         auto* spriteManager = m_clientDataService->getSpriteManager();
         if (spriteManager) {
-            const SpriteData* spriteData = spriteManager->getSpriteData(itemId);
-            if (spriteData && !spriteData->frames.isEmpty()) {
-                // Get the first frame of the sprite
-                const QImage& spriteImage = spriteData->frames.first().image;
-                if (!spriteImage.isNull()) {
-                    // Scale to icon size while maintaining aspect ratio
-                    QPixmap sprite = QPixmap::fromImage(spriteImage);
-                    QPixmap scaledSprite = sprite.scaled(32, 32, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-                    
-                    // Create a 32x32 canvas and center the sprite
-                    QPixmap iconPixmap(32, 32);
-                    iconPixmap.fill(Qt::transparent);
-                    
-                    QPainter painter(&iconPixmap);
-                    int x = (32 - scaledSprite.width()) / 2;
-                    int y = (32 - scaledSprite.height()) / 2;
-                    painter.drawPixmap(x, y, scaledSprite);
-                    
-                    return QIcon(iconPixmap);
-                }
+            // Get the first frame of the sprite
+            const QImage spriteImage = spriteManager->getSpriteFrame(itemId, 0);
+            if (!spriteImage.isNull()) {
+                // Scale to icon size while maintaining aspect ratio
+                QPixmap sprite = QPixmap::fromImage(spriteImage);
+                QPixmap scaledSprite = sprite.scaled(32, 32, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+                
+                // Create a 32x32 canvas and center the sprite
+                QPixmap iconPixmap(32, 32);
+                iconPixmap.fill(Qt::transparent);
+                
+                QPainter painter(&iconPixmap);
+                int x = (32 - scaledSprite.width()) / 2;
+                int y = (32 - scaledSprite.height()) / 2;
+                painter.drawPixmap(x, y, scaledSprite);
+                
+                return QIcon(iconPixmap);
             }
         }
     }
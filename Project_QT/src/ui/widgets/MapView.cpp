@@ -14,6 +14,8 @@
 #include <QOpenGLBuffer>        // For RENDER-02 VBO
 #include <QOpenGLVertexArrayObject> // For RENDER-02 VAO
 #include <QElapsedTimer>        // For RENDER-03 animation timing
+#include <cstddef>              // For offsetof
+#include <functional>
 
 namespace RME {
 namespace ui {
@@ -513,6 +515,160 @@ bool MapView::initializeShaders() {
     m_quadVAO->release();
     m_quadVBO->release();
     
+    return initializeTileInstancing();
+}
+
+// Instanced tile rendering: the unit quad is shared, position and color come per instance
+bool MapView::initializeTileInstancing() {
+    m_tileInstanceShader = new QOpenGLShaderProgram(this);
+    
+    const char* vertexShaderSource = R"(
+        #version 330 core
+        layout (location = 0) in vec2 aPos;
+        layout (location = 1) in vec2 aTile;
+        layout (location = 2) in vec4 aColor;
+        uniform mat4 projectionMatrix;
+        uniform float tileSize;
+        out vec4 vColor;
+        void main() {
+            vColor = aColor;
+            gl_Position = projectionMatrix * vec4((aTile + aPos) * tileSize, 0.0, 1.0);
+        }
+    )";
+    
+    const char* fragmentShaderSource = R"(
+        #version 330 core
+        in vec4 vColor;
+        out vec4 FragColor;
+        void main() {
+            FragColor = vColor;
+        }
+    )";
+    
+    if (!m_tileInstanceShader->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource) ||
+        !m_tileInstanceShader->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource) ||
+        !m_tileInstanceShader->link()) {
+        qWarning() << "Failed to build instanced tile shader:" << m_tileInstanceShader->log();
+        return false;
+    }
+    
+    m_tileInstanceVBO = new QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
+    m_tileInstanceVAO = new QOpenGLVertexArrayObject(this);
+    if (!m_tileInstanceVBO->create() || !m_tileInstanceVAO->create()) {
+        qWarning() << "Failed to create instance VBO or VAO";
+        return false;
+    }
+    m_tileInstanceVBO->setUsagePattern(QOpenGLBuffer::StreamDraw);
+    
+    m_tileInstanceVAO->bind();
+    
+    // Attribute 0: shared unit quad
+    m_quadVBO->bind();
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+    
+    // Attributes 1 and 2: per-instance tile position and color
+    m_tileInstanceVBO->bind();
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(TileInstance),
+                          reinterpret_cast<const void*>(offsetof(TileInstance, x)));
+    glVertexAttribDivisor(1, 1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(TileInstance),
+                          reinterpret_cast<const void*>(offsetof(TileInstance, r)));
+    glVertexAttribDivisor(2, 1);
+    
+    m_tileInstanceVAO->release();
+    m_tileInstanceVBO->release();
+    m_quadVBO->release();
+    
+    return initializeSpriteBatching();
+}
+
+// Batched sprite rendering: the unit quad is shared, position and atlas slot come per instance
+bool MapView::initializeSpriteBatching() {
+    m_spriteShader = new QOpenGLShaderProgram(this);
+    
+    const char* vertexShaderSource = R"(
+        #version 330 core
+        layout (location = 0) in vec2 aPos;
+        layout (location = 1) in vec2 aScreenPos;
+        layout (location = 2) in uvec2 aSlot;
+        layout (location = 3) in float aAlpha;
+        uniform mat4 screenMatrix;
+        uniform float spriteSize;
+        out vec2 vTexCoord;
+        flat out uvec2 vSlot;
+        out float vAlpha;
+        void main() {
+            vTexCoord = aPos;
+            vSlot = aSlot;
+            vAlpha = aAlpha;
+            gl_Position = screenMatrix * vec4(aScreenPos + aPos * spriteSize, 0.0, 1.0);
+        }
+    )";
+    
+    // Sampler arrays may only be indexed with constants, hence the branches on the page.
+    // Keep the page count in sync with TextureManager::MAX_ATLAS_PAGES.
+    const char* fragmentShaderSource = R"(
+        #version 330 core
+        in vec2 vTexCoord;
+        flat in uvec2 vSlot;
+        in float vAlpha;
+        uniform sampler2DArray atlasPages[4];
+        out vec4 FragColor;
+        void main() {
+            vec3 coord = vec3(vTexCoord, float(vSlot.y));
+            vec4 texel;
+            if (vSlot.x == 0u) texel = texture(atlasPages[0], coord);
+            else if (vSlot.x == 1u) texel = texture(atlasPages[1], coord);
+            else if (vSlot.x == 2u) texel = texture(atlasPages[2], coord);
+            else texel = texture(atlasPages[3], coord);
+            FragColor = vec4(texel.rgb, texel.a * vAlpha);
+        }
+    )";
+    
+    if (!m_spriteShader->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource) ||
+        !m_spriteShader->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource) ||
+        !m_spriteShader->link()) {
+        qWarning() << "Failed to build sprite batch shader:" << m_spriteShader->log();
+        return false;
+    }
+    
+    m_spriteInstanceVBO = new QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
+    m_spriteInstanceVAO = new QOpenGLVertexArrayObject(this);
+    if (!m_spriteInstanceVBO->create() || !m_spriteInstanceVAO->create()) {
+        qWarning() << "Failed to create sprite instance VBO or VAO";
+        return false;
+    }
+    m_spriteInstanceVBO->setUsagePattern(QOpenGLBuffer::StreamDraw);
+    
+    m_spriteInstanceVAO->bind();
+    
+    // Attribute 0: shared unit quad, doubles as texture coordinates
+    m_quadVBO->bind();
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+    
+    // Attributes 1-3: per-instance screen position, atlas slot and alpha
+    m_spriteInstanceVBO->bind();
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance),
+                          reinterpret_cast<const void*>(offsetof(SpriteInstance, x)));
+    glVertexAttribDivisor(1, 1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribIPointer(2, 2, GL_UNSIGNED_SHORT, sizeof(SpriteInstance),
+                           reinterpret_cast<const void*>(offsetof(SpriteInstance, page)));
+    glVertexAttribDivisor(2, 1);
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteInstance),
+                          reinterpret_cast<const void*>(offsetof(SpriteInstance, alpha)));
+    glVertexAttribDivisor(3, 1);
+    
+    m_spriteInstanceVAO->release();
+    m_spriteInstanceVBO->release();
+    m_quadVBO->release();
+    
     return true;
 }
 
@@ -520,9 +676,21 @@ void MapView::cleanupShaders() {
     delete m_colorQuadShader;
     delete m_quadVBO;
     delete m_quadVAO;
+    delete m_tileInstanceShader;
+    delete m_tileInstanceVBO;
+    delete m_tileInstanceVAO;
+    delete m_spriteShader;
+    delete m_spriteInstanceVBO;
+    delete m_spriteInstanceVAO;
     m_colorQuadShader = nullptr;
     m_quadVBO = nullptr;
     m_quadVAO = nullptr;
+    m_tileInstanceShader = nullptr;
+    m_tileInstanceVBO = nullptr;
+    m_tileInstanceVAO = nullptr;
+    m_spriteShader = nullptr;
+    m_spriteInstanceVBO = nullptr;
+    m_spriteInstanceVAO = nullptr;
 }
 
 // RENDER-02: Calculate visible tile range
@@ -683,9 +851,9 @@ float MapView::calculateFloorAlpha(int tileZ) const {
     }
 }
 
-// RENDER-02: Main tile rendering method with optimizations
+// RENDER-02: Main tile rendering method, one instanced draw for all visible tiles
 void MapView::renderTiles() {
-    if (!m_colorQuadShader || !m_quadVAO) {
+    if (!m_tileInstanceShader || !m_tileInstanceVAO) {
         return;
     }
     
@@ -698,74 +866,64 @@ void MapView::renderTiles() {
         return;
     }
     
-    // Bind shader and VAO once
-    m_colorQuadShader->bind();
-    m_quadVAO->bind();
-    
     // Cache settings for performance
     bool showOnlyModified = m_appSettings->getBoolean(RME::Config::SHOW_ONLY_MODIFIED_TILES);
+    const QRect visibleTiles(QPoint(minMapX, minMapY), QPoint(maxMapX, maxMapY));
+    const RME::core::Map* map = m_map;
     
-    // Pre-calculate base model matrix for tile positioning
-    QMatrix4x4 baseModelMatrix;
-    baseModelMatrix.scale(TILE_PIXEL_SIZE, TILE_PIXEL_SIZE);
-    
-    int tilesRendered = 0;
-    const int maxTilesPerFrame = 10000; // Performance limit for very large views
+    m_tileInstances.clear(); // Keeps capacity from the previous frame
     
-    // Render tiles from top floor to bottom (painter's algorithm)
-    for (int z = renderMaxZ; z >= renderMinZ && tilesRendered < maxTilesPerFrame; --z) {
+    // Collect floors from top to bottom; instances are drawn in order, which keeps
+    // the painter's algorithm blending of the old per-tile loop.
+    for (int z = renderMaxZ; z >= renderMinZ; --z) {
         // Pre-calculate floor alpha for this entire floor
         float floorAlpha = calculateFloorAlpha(z);
         if (floorAlpha <= 0.0f) {
             continue; // Skip entire floor if invisible
         }
         
-        for (int y = minMapY; y <= maxMapY && tilesRendered < maxTilesPerFrame; ++y) {
-            for (int x = minMapX; x <= maxMapX && tilesRendered < maxTilesPerFrame; ++x) {
-                const RME::core::Tile* tile = m_map->getTile(RME::core::Position(x, y, z));
-                
-                // Skip empty tiles unless they're house tiles or special
-                if (!tile || (tile->isEmpty() && tile->getHouseId() == 0 && !tile->hasMapFlag(RME::TileMapFlag::PROTECTION_ZONE))) {
-                    continue;
-                }
-                
-                // Skip unmodified tiles if only showing modified
-                if (showOnlyModified && !tile->hasStateFlag(RME::TileStateFlag::MODIFIED)) {
-                    continue;
-                }
-                
-                // Determine tile color
-                QColor baseColor = determineTileColor(tile);
-                
-                // Apply floor alpha to the color
-                QColor finalColor(baseColor.red(), baseColor.green(), baseColor.blue(), 
-                                static_cast<int>(floorAlpha * baseColor.alpha()));
-                
-                // Optimize matrix calculation - reuse base matrix
-                QMatrix4x4 modelMatrix = baseModelMatrix;
-                modelMatrix.translate(x * TILE_PIXEL_SIZE, y * TILE_PIXEL_SIZE, 0.0f);
-                
-                QMatrix4x4 mvp = m_projectionMatrix * modelMatrix;
-                
-                // Set shader uniforms
-                m_colorQuadShader->setUniformValue("mvpMatrix", mvp);
-                m_colorQuadShader->setUniformValue("uColor", 
-                    QVector4D(finalColor.redF(), finalColor.greenF(), finalColor.blueF(), finalColor.alphaF()));
-                
-                // Draw the quad
-                glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-                tilesRendered++;
+        // Only populated sectors intersecting the view are visited
+        const RME::SectorFilter filter{visibleTiles, 1u << z};
+        map->forEachTile(std::function<bool(const RME::core::Tile&)>([&](const RME::core::Tile& tile) {
+            // Skip empty tiles unless they're house tiles or special
+            if (tile.isEmpty() && tile.getHouseId() == 0 && !tile.hasMapFlag(RME::TileMapFlag::PROTECTION_ZONE)) {
+                return true;
             }
-        }
+            
+            // Skip unmodified tiles if only showing modified
+            if (showOnlyModified && !tile.hasStateFlag(RME::TileStateFlag::MODIFIED)) {
+                return true;
+            }
+            
+            const QColor baseColor = determineTileColor(&tile);
+            const RME::core::Position& pos = tile.getPosition();
+            m_tileInstances.append(TileInstance{
+                static_cast<GLfloat>(pos.x), static_cast<GLfloat>(pos.y),
+                static_cast<GLubyte>(baseColor.red()), static_cast<GLubyte>(baseColor.green()),
+                static_cast<GLubyte>(baseColor.blue()),
+                static_cast<GLubyte>(floorAlpha * baseColor.alpha())});
+            return true;
+        }), filter);
     }
     
-    // Debug info for performance monitoring
-    if (tilesRendered >= maxTilesPerFrame) {
-        qDebug() << "MapView: Rendered maximum tiles per frame (" << maxTilesPerFrame << "), some tiles may be skipped";
+    if (m_tileInstances.isEmpty()) {
+        return;
     }
     
-    m_quadVAO->release();
-    m_colorQuadShader->release();
+    m_tileInstanceShader->bind();
+    m_tileInstanceShader->setUniformValue("projectionMatrix", m_projectionMatrix);
+    m_tileInstanceShader->setUniformValue("tileSize", static_cast<GLfloat>(TILE_PIXEL_SIZE));
+    
+    m_tileInstanceVAO->bind();
+    m_tileInstanceVBO->bind();
+    m_tileInstanceVBO->allocate(m_tileInstances.constData(),
+                                static_cast<int>(m_tileInstances.size() * sizeof(TileInstance)));
+    
+    glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, static_cast<GLsizei>(m_tileInstances.size()));
+    
+    m_tileInstanceVBO->release();
+    m_tileInstanceVAO->release();
+    m_tileInstanceShader->release();
 }
 
 // RENDER-02: Grid rendering for visual aid
@@ -855,35 +1013,25 @@ void MapView::renderTileHighlights() {
     }
 }
 
-// RENDER-03: Simple sprite rendering with immediate mode OpenGL
+// RENDER-03: Sprite rendering, all visible item frames in one instanced draw
 void MapView::renderSprites() {
-    if (!m_textureManager || !m_map) {
+    if (!m_textureManager || !m_map || !m_spriteShader || !m_spriteInstanceVAO) {
         return;
     }
     
     // Calculate visible range (reuse from RENDER-02)
     int minMapX, maxMapX, minMapY, maxMapY, renderMinZ, renderMaxZ;
     calculateVisibleRange(minMapX, maxMapX, minMapY, maxMapY, renderMinZ, renderMaxZ);
-    
-    // Enable texture rendering
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    // Disable the shader program for immediate mode rendering
-    if (m_colorQuadShader) {
-        m_colorQuadShader->release();
+    if (minMapX > maxMapX || minMapY > maxMapY || renderMinZ > renderMaxZ) {
+        return;
     }
     
-    // Set up 2D projection for immediate mode
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, width(), height(), 0, -1, 1); // Screen coordinates
+    const QRect visibleTiles(QPoint(minMapX, minMapY), QPoint(maxMapX, maxMapY));
+    const RME::core::Map* map = m_map;
     
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
+    // Atlas slots handed out from here on stay resident until the batch is drawn
+    m_textureManager->beginFrame();
+    m_spriteInstances.clear(); // Keeps capacity from the previous frame
     
     // Render sprites from top floor to bottom (same as tiles)
     for (int z = renderMaxZ; z >= renderMinZ; --z) {
@@ -891,59 +1039,70 @@ void MapView::renderSprites() {
         if (floorAlpha <= 0.0f) {
             continue; // Skip invisible floors
         }
+        const GLubyte alpha = static_cast<GLubyte>(floorAlpha * 255.0f);
         
-        // Set alpha for floor ghosting
-        glColor4f(1.0f, 1.0f, 1.0f, floorAlpha);
-        
-        for (int y = minMapY; y <= maxMapY; ++y) {
-            for (int x = minMapX; x <= maxMapX; ++x) {
-                const RME::core::Tile* tile = m_map->getTile(RME::core::Position(x, y, z));
-                if (!tile || tile->isEmpty()) {
-                    continue;
-                }
-                
-                // Convert map coordinates to screen coordinates
-                QPoint screenPos = mapCoordsToScreen(RME::core::Position(x, y, z));
-                
-                // Render all items on this tile with improved stacking
-                drawStackedItems(screenPos, tile, floorAlpha);
+        const RME::SectorFilter filter{visibleTiles, 1u << z};
+        map->forEachTile(std::function<bool(const RME::core::Tile&)>([&](const RME::core::Tile& tile) {
+            if (!tile.isEmpty()) {
+                appendStackedItems(mapCoordsToScreen(tile.getPosition()), &tile, alpha);
             }
-        }
+            return true;
+        }), filter);
     }
     
-    // Restore matrices
-    glPopMatrix(); // MODELVIEW
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
+    if (m_spriteInstances.isEmpty()) {
+        return;
+    }
+    
+    QMatrix4x4 screenMatrix;
+    screenMatrix.ortho(0.0f, width(), height(), 0.0f, -1.0f, 1.0f); // Screen coordinates
+    
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    
+    m_spriteShader->bind();
+    m_spriteShader->setUniformValue("screenMatrix", screenMatrix);
+    m_spriteShader->setUniformValue("spriteSize", static_cast<GLfloat>(TILE_PIXEL_SIZE));
+    
+    // Every page is bound once; unallocated pages are never referenced by an instance
+    GLint pageUnits[RME::core::sprites::TextureManager::MAX_ATLAS_PAGES];
+    for (int page = 0; page < RME::core::sprites::TextureManager::MAX_ATLAS_PAGES; ++page) {
+        glActiveTexture(GL_TEXTURE0 + page);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureManager->getAtlasPageTexture(page));
+        pageUnits[page] = page;
+    }
+    m_spriteShader->setUniformValueArray("atlasPages", pageUnits, RME::core::sprites::TextureManager::MAX_ATLAS_PAGES);
+    
+    m_spriteInstanceVAO->bind();
+    m_spriteInstanceVBO->bind();
+    m_spriteInstanceVBO->allocate(m_spriteInstances.constData(),
+                                  static_cast<int>(m_spriteInstances.size() * sizeof(SpriteInstance)));
+    
+    glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, static_cast<GLsizei>(m_spriteInstances.size()));
+    
+    m_spriteInstanceVBO->release();
+    m_spriteInstanceVAO->release();
+    m_spriteShader->release();
     
     // Restore OpenGL state
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f); // Reset color
-    glDisable(GL_TEXTURE_2D);
+    for (int page = RME::core::sprites::TextureManager::MAX_ATLAS_PAGES - 1; page >= 0; --page) {
+        glActiveTexture(GL_TEXTURE0 + page);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    }
     glDisable(GL_BLEND);
 }
 
-// RENDER-03: Draw textured quad using immediate mode OpenGL
-void MapView::drawTexturedQuad(float x, float y, float width, float height, GLuint textureId) {
-    if (textureId == 0) {
+// RENDER-03: Queue one item frame for the sprite batch
+void MapView::appendSprite(float x, float y, quint32 spriteId, int frame, GLubyte alpha) {
+    RME::core::sprites::TextureManager::AtlasSlot slot;
+    if (!m_textureManager->getAtlasSlot(spriteId, frame, slot)) {
         return;
     }
-    
-    glBindTexture(GL_TEXTURE_2D, textureId);
-    
-    // Draw quad with texture coordinates (immediate mode)
-    glBegin(GL_QUADS);
-        glTexCoord2f(0.0f, 0.0f); glVertex2f(x, y);                    // Top-left
-        glTexCoord2f(1.0f, 0.0f); glVertex2f(x + width, y);            // Top-right
-        glTexCoord2f(1.0f, 1.0f); glVertex2f(x + width, y + height);   // Bottom-right
-        glTexCoord2f(0.0f, 1.0f); glVertex2f(x, y + height);           // Bottom-left
-    glEnd();
-    
-    glBindTexture(GL_TEXTURE_2D, 0);
+    m_spriteInstances.append(SpriteInstance{x, y, slot.page, slot.layer, alpha, {0, 0, 0}});
 }
 
 // RENDER-03: Enhanced item rendering with stacking and animation
-void MapView::drawStackedItems(const QPoint& screenPos, const RME::core::Tile* tile, float alpha) {
+void MapView::appendStackedItems(const QPoint& screenPos, const RME::core::Tile* tile, GLubyte alpha) {
     if (!tile || !m_textureManager) {
         return;
     }
@@ -954,11 +1113,7 @@ void MapView::drawStackedItems(const QPoint& screenPos, const RME::core::Tile* t
     // Render ground item first
     const RME::core::Item* ground = tile->getGround();
     if (ground) {
-        int animFrame = getCurrentAnimationFrame(ground->getID());
-        GLuint textureId = m_textureManager->getTextureForSpriteFrame(ground->getID(), animFrame);
-        if (textureId != 0) {
-            drawTexturedQuad(screenPos.x(), screenPos.y(), TILE_PIXEL_SIZE, TILE_PIXEL_SIZE, textureId);
-        }
+        appendSprite(screenPos.x(), screenPos.y(), ground->getID(), getCurrentAnimationFrame(ground->getID()), alpha);
     }
     
     // Render item stack with slight offset for visibility
@@ -966,16 +1121,10 @@ void MapView::drawStackedItems(const QPoint& screenPos, const RME::core::Tile* t
     for (int i = 0; i < items.size(); ++i) {
         const auto& item = items[i];
         if (item) {
-            int animFrame = getCurrentAnimationFrame(item->getID());
-            GLuint textureId = m_textureManager->getTextureForSpriteFrame(item->getID(), animFrame);
-            if (textureId != 0) {
-                // Apply stack offset for better visibility
-                float offsetX = stackOffset;
-                float offsetY = stackOffset;
-                
-                drawTexturedQuad(screenPos.x() + offsetX, screenPos.y() + offsetY, 
-                               TILE_PIXEL_SIZE, TILE_PIXEL_SIZE, textureId);
-                
+            const qsizetype sizeBefore = m_spriteInstances.size();
+            appendSprite(screenPos.x() + stackOffset, screenPos.y() + stackOffset,
+                         item->getID(), getCurrentAnimationFrame(item->getID()), alpha);
+            if (m_spriteInstances.size() != sizeBefore) {
                 // Increase offset for next item (but cap it to avoid too much spread)
                 stackOffset += STACK_OFFSET_PIXELS;
                 if (stackOffset > STACK_OFFSET_PIXELS * 3) {
@@ -1032,62 +1181,11 @@ void MapView::renderLightingEffects() {
     int scrollX = static_cast<int>((m_viewCenterMapCoords.x() - width() / (2.0 * TILE_PIXEL_SIZE * m_zoomFactor)) * TILE_PIXEL_SIZE);
     int scrollY = static_cast<int>((m_viewCenterMapCoords.y() - height() / (2.0 * TILE_PIXEL_SIZE * m_zoomFactor)) * TILE_PIXEL_SIZE);
     
-    // Update dynamic lights from items on the map
-    updateDynamicLights();
-    
+    // Map lights come from the service's light index, which tracks tile changes itself
     // Render lighting overlay
     m_lightRenderer->renderLighting(startPos, endPos, scrollX, scrollY, false);
 }
 
-void MapView::updateDynamicLights() {
-    if (!m_lightCalculatorService || !m_map) {
-        return;
-    }
-    
-    // Clear existing dynamic lights
-    m_lightCalculatorService->clearDynamicLights();
-    
-    // Calculate visible range
-    int minMapX, maxMapX, minMapY, maxMapY, renderMinZ, renderMaxZ;
-    calculateVisibleRange(minMapX, maxMapX, minMapY, maxMapY, renderMinZ, renderMaxZ);
-    
-    // Add lights from items in visible area
-    for (int z = renderMinZ; z <= renderMaxZ; ++z) {
-        for (int y = minMapY; y <= maxMapY; ++y) {
-            for (int x = minMapX; x <= maxMapX; ++x) {
-                const RME::core::Tile* tile = m_map->getTile(RME::core::Position(x, y, z));
-                if (!tile) {
-                    continue;
-                }
-                
-                // Check ground item for light
-                const RME::core::Item* ground = tile->getGround();
-                if (ground && ground->hasLight()) {
-                    RME::core::Position lightPos(x, y, z);
-                    QColor lightColor = QColor::fromHsv((ground->getLightColor() * 137) % 360, 128, 255);
-                    uint8_t intensity = ground->getLightIntensity();
-                    
-                    RME::core::lighting::LightSource lightSource(lightPos, lightColor, intensity);
-                    m_lightCalculatorService->addDynamicLight(lightSource);
-                }
-                
-                // Check other items for light
-                const auto& items = tile->getItems();
-                for (const auto& item : items) {
-                    if (item && item->hasLight()) {
-                        RME::core::Position lightPos(x, y, z);
-                        QColor lightColor = QColor::fromHsv((item->getLightColor() * 137) % 360, 128, 255);
-                        uint8_t intensity = item->getLightIntensity();
-                        
-                        RME::core::lighting::LightSource lightSource(lightPos, lightColor, intensity);
-                        m_lightCalculatorService->addDynamicLight(lightSource);
-                    }
-                }
-            }
-        }
-    }
-}
-
 } // namespace widgets
 } // namespace ui
 } // namespace RME
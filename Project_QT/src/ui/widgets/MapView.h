@@ -4,6 +4,7 @@
 #include <QOpenGLFunctions_4_3_Core> // Or your chosen version from RENDER-00, default 4.3
 #include <QPointF>
 #include <QMatrix4x4>
+#include <QVector>
 #include "core/Position.h" // Adjusted path for mapcore::Position
 #include "../../editor_logic/EditorController.h" // Added
 #include "../../core/settings/BrushSettings.h"   // Added
@@ -86,6 +87,8 @@ private:
     
     // RENDER-02: Private methods
     bool initializeShaders();
+    bool initializeTileInstancing();
+    bool initializeSpriteBatching();
     void cleanupShaders();
     void calculateVisibleRange(int& minMapX, int& maxMapX, int& minMapY, int& maxMapY, 
                               int& renderMinZ, int& renderMaxZ) const;
@@ -98,13 +101,12 @@ private:
     
     // RENDER-03: Sprite rendering methods
     void renderSprites();
-    void drawTexturedQuad(float x, float y, float width, float height, GLuint textureId);
-    void drawStackedItems(const QPoint& screenPos, const RME::core::Tile* tile, float alpha);
+    void appendSprite(float x, float y, quint32 spriteId, int frame, GLubyte alpha);
+    void appendStackedItems(const QPoint& screenPos, const RME::core::Tile* tile, GLubyte alpha);
     int getCurrentAnimationFrame(quint32 spriteId) const;
     
     // RENDER-04: Lighting rendering methods
     void renderLightingEffects();
-    void updateDynamicLights();
 
     int m_currentFloor;
     qreal m_zoomFactor;
@@ -143,6 +145,30 @@ private:
     QOpenGLBuffer* m_quadVBO = nullptr;
     QOpenGLVertexArrayObject* m_quadVAO = nullptr;
 
+    // Tile quads are drawn instanced: one instance per visible tile, rebuilt every frame
+    // from the populated sectors in view and submitted with a single draw call.
+    struct TileInstance {
+        GLfloat x, y;       // Tile coordinates
+        GLubyte r, g, b, a; // Final color, floor alpha applied
+    };
+    QOpenGLShaderProgram* m_tileInstanceShader = nullptr;
+    QOpenGLBuffer* m_tileInstanceVBO = nullptr;
+    QOpenGLVertexArrayObject* m_tileInstanceVAO = nullptr;
+    QVector<TileInstance> m_tileInstances; // Reused across frames to avoid reallocations
+
+    // Sprites are drawn the same way: one instance per item frame, sampling the
+    // TextureManager atlas pages, so a full screen of stacks is a single draw call.
+    struct SpriteInstance {
+        GLfloat x, y;         // Top-left corner in screen pixels
+        GLushort page, layer; // TextureManager::AtlasSlot
+        GLubyte alpha;        // Floor ghosting
+        GLubyte padding[3];
+    };
+    QOpenGLShaderProgram* m_spriteShader = nullptr;
+    QOpenGLBuffer* m_spriteInstanceVBO = nullptr;
+    QOpenGLVertexArrayObject* m_spriteInstanceVAO = nullptr;
+    QVector<SpriteInstance> m_spriteInstances;
+
     // Constants from boilerplate
     // These should ideally be configurable or obtained from a settings manager eventually
     const int TILE_PIXEL_SIZE = 32;
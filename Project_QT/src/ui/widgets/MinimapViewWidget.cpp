@@ -1,7 +1,12 @@
 #include "MinimapViewWidget.h"
+#include "editor_logic/EditorController.h"
 #include <QPainter>
 #include <QMouseEvent>
 #include <QResizeEvent>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDebug>
+#include <cmath>
 
 namespace RME {
 namespace ui {
@@ -53,6 +58,90 @@ MinimapViewWidget::MinimapViewWidget(RME::core::editor::EditorStateService* edit
         // Initialize view rectangle
         m_mainMapViewRect = m_editorStateService->getViewRect();
     }
+
+    m_minimapCache.setTileColorFunction([this](const RME::Tile& tile) {
+        return getTileMinimapColor(&tile).rgba();
+    });
+    onMapChanged(m_currentMap);
+}
+
+MinimapViewWidget::~MinimapViewWidget()
+{
+    setEditorController(nullptr);
+    savePersistentCache();
+    if (m_currentMap && m_tileChangeListenerId != 0) {
+        m_currentMap->removeTileChangeListener(m_tileChangeListenerId);
+    }
+}
+
+void MinimapViewWidget::setPersistentCacheFile(const QString& mapFilePath)
+{
+    if (mapFilePath == m_mapFilePath) {
+        return;
+    }
+    m_mapFilePath = mapFilePath;
+    if (m_mapFilePath.isEmpty() || !m_currentMap) {
+        return;
+    }
+
+    const qint64 stamp = QFileInfo(m_mapFilePath).lastModified().toMSecsSinceEpoch();
+    const QString cachePath = RME::MinimapCache::cachePathForMap(m_mapFilePath);
+    if (QFileInfo::exists(cachePath)) {
+        if (m_minimapCache.loadFromFile(cachePath, stamp)) {
+            m_needsFullRedraw = true;
+            update();
+        } else {
+            qDebug() << "MinimapViewWidget: Ignoring minimap cache:" << m_minimapCache.getLastError();
+        }
+    }
+}
+
+void MinimapViewWidget::setEditorController(RME::editor_logic::EditorController* controller)
+{
+    if (m_editorController == controller) {
+        return;
+    }
+    if (m_editorController) {
+        disconnect(m_editorController, nullptr, this, nullptr);
+        if (m_editorController->getMinimapCache() == &m_minimapCache) {
+            m_editorController->setMinimapCache(nullptr);
+        }
+    }
+    m_editorController = controller;
+    if (!m_editorController) {
+        return;
+    }
+
+    m_editorController->setMinimapCache(&m_minimapCache);
+    connect(m_editorController, &RME::editor_logic::EditorController::mapLoaded,
+            this, [this](const QString& filename) {
+                onMapChanged(m_editorController->getMap());
+                setPersistentCacheFile(filename);
+            });
+    connect(m_editorController, &RME::editor_logic::EditorController::mapSaved,
+            this, [this](const QString& filename) {
+                // Save As moves the cache next to the new file; either way it matches the file now
+                setPersistentCacheFile(filename);
+                savePersistentCache();
+            });
+    connect(m_editorController, &RME::editor_logic::EditorController::mapClosed,
+            this, [this]() {
+                savePersistentCache();
+                setPersistentCacheFile(QString());
+            });
+    setPersistentCacheFile(m_editorController->getCurrentMapFilename());
+}
+
+void MinimapViewWidget::savePersistentCache()
+{
+    // Unsaved edits would not match the map file the cache is stamped with
+    if (m_mapFilePath.isEmpty() || !m_currentMap || m_currentMap->hasChanged()) {
+        return;
+    }
+    const qint64 stamp = QFileInfo(m_mapFilePath).lastModified().toMSecsSinceEpoch();
+    if (!m_minimapCache.saveToFile(RME::MinimapCache::cachePathForMap(m_mapFilePath), stamp)) {
+        qWarning() << "MinimapViewWidget: Failed to save minimap cache:" << m_minimapCache.getLastError();
+    }
 }
 
 void MinimapViewWidget::setMainMapViewRect(const QRectF& viewRect)
@@ -63,7 +152,25 @@ void MinimapViewWidget::setMainMapViewRect(const QRectF& viewRect)
 
 void MinimapViewWidget::onMapChanged(RME::core::Map* currentMap)
 {
+    if (currentMap != m_currentMap) {
+        savePersistentCache();
+        m_mapFilePath.clear();
+        if (m_currentMap && m_tileChangeListenerId != 0) {
+            m_currentMap->removeTileChangeListener(m_tileChangeListenerId);
+            m_tileChangeListenerId = 0;
+        }
+    }
     m_currentMap = currentMap;
+    m_minimapCache.setMap(currentMap);
+    if (m_currentMap && m_tileChangeListenerId == 0) {
+        // The cache drops the affected tiles itself; recomposing from it is cheap
+        m_tileChangeListenerId = m_currentMap->addTileChangeListener([this](const RME::core::Position& pos) {
+            if (pos.z == m_currentFloor) {
+                m_needsFullRedraw = true;
+                update();
+            }
+        });
+    }
     m_needsFullRedraw = true;
     update();
 }
@@ -218,31 +325,26 @@ void MinimapViewWidget::renderMinimap()
     m_mapOffsetX = startX;
     m_mapOffsetY = startY;
     
-    // Iterate through the visible tiles and draw them
-    for (int y = 0; y < visibleMapHeight && (startY + y) < mapHeight; ++y) {
-        for (int x = 0; x < visibleMapWidth && (startX + x) < mapWidth; ++x) {
-            int mapX = startX + x;
-            int mapY = startY + y;
-            
-            // Get the tile at this position
-            RME::core::Position tilePos(mapX, mapY, m_currentFloor);
-            RME::core::Tile* tile = m_currentMap->getTile(tilePos);
-            
-            // Calculate the pixel position in the widget
-            int pixelX = static_cast<int>(x * scale);
-            int pixelY = static_cast<int>(y * scale);
-            int pixelSize = std::max(1, static_cast<int>(scale));
-            
-            // Get the color for this tile
-            QColor color;
-            if (tile) {
-                color = getTileMinimapColor(tile);
-            } else {
-                color = m_backgroundColor;
+    // Use the coarsest pyramid level that still has at least one pixel per map tile it covers
+    const double tilesPerPixel = 1.0 / scale;
+    int level = 0;
+    while (level < RME::MinimapCache::MAX_LEVEL && (1 << (level + 1)) <= tilesPerPixel) {
+        ++level;
+    }
+    const int span = RME::MinimapCache::tileSpan(level);
+    const int endX = std::min(mapWidth, startX + visibleMapWidth);
+    const int endY = std::min(mapHeight, startY + visibleMapHeight);
+    
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, scale < 1.0);
+    for (int tileY = startY / span; tileY * span < endY; ++tileY) {
+        for (int tileX = startX / span; tileX * span < endX; ++tileX) {
+            const QImage tileImage = m_minimapCache.getTile(level, m_currentFloor, tileX, tileY);
+            if (tileImage.isNull()) {
+                continue; // Nothing on this part of the floor
             }
-            
-            // Draw the tile as a rectangle
-            painter.fillRect(pixelX, pixelY, pixelSize, pixelSize, color);
+            const QRectF target((tileX * span - startX) * scale, (tileY * span - startY) * scale,
+                                span * scale, span * scale);
+            painter.drawImage(target, tileImage);
         }
     }
     
@@ -6,6 +6,8 @@
 #include <QPoint>
 #include <QRectF>
 #include <QColor>
+#include <QString>
+#include "core/map/MinimapCache.h"
 
 // Forward declarations
 class QMouseEvent;
@@ -22,6 +24,9 @@ namespace core {
         class ItemDatabase;
     }
 }
+namespace editor_logic {
+    class EditorController;
+}
 namespace ui {
 namespace widgets {
 
@@ -33,6 +38,9 @@ class EditorStateService;
  * 
  * This widget displays a small, zoomed-out overview of the current map floor
  * and allows navigation by clicking or dragging on the minimap.
+ *
+ * The picture is composed from a MinimapCache pyramid at the level matching the
+ * widget scale; tile edits only invalidate the cache tiles above them.
  */
 class MinimapViewWidget : public QWidget {
     Q_OBJECT
@@ -48,6 +56,7 @@ public:
     MinimapViewWidget(EditorStateService* editorState, 
                      RME::core::assets::ItemDatabase* itemDatabase, 
                      QWidget* parent = nullptr);
+    ~MinimapViewWidget() override;
     
     /**
      * @brief Set the main map view's visible rectangle
@@ -56,6 +65,28 @@ public:
      */
     void setMainMapViewRect(const QRectF& viewRect);
 
+    /**
+     * @brief Persist the minimap cache next to the given map file
+     *
+     * Loads an up-to-date cache for the file right away and writes the cache
+     * back when the map is closed without unsaved changes. An empty path
+     * turns persistence off.
+     */
+    void setPersistentCacheFile(const QString& mapFilePath);
+
+    /**
+     * @brief Cache of the current map, e.g. for MinimapExporter::setMinimapCache()
+     */
+    RME::MinimapCache* getMinimapCache() { return &m_minimapCache; }
+
+    /**
+     * @brief Follow the map files opened and saved through the controller
+     *
+     * Persists the cache next to each opened or saved map file and lends the
+     * cache to the controller, so minimap exports render from it.
+     */
+    void setEditorController(RME::editor_logic::EditorController* controller);
+
 public slots:
     /**
      * @brief Handle map change
@@ -99,6 +130,11 @@ private:
      * @brief Render the minimap to the pixmap buffer
      */
     void renderMinimap();
+
+    /**
+     * @brief Write the cache for the current map file if it matches the file on disk
+     */
+    void savePersistentCache();
     
     /**
      * @brief Convert widget coordinates to map coordinates
@@ -126,6 +162,7 @@ private:
 
     // Services
     EditorStateService* m_editorStateService;
+    RME::editor_logic::EditorController* m_editorController = nullptr;
     RME::core::assets::ItemDatabase* m_itemDatabase;
     
     // Map data
@@ -136,6 +173,9 @@ private:
     // Rendering
     QPixmap m_minimapPixmap; // Offscreen buffer for the minimap rendering
     bool m_needsFullRedraw = true;
+    RME::MinimapCache m_minimapCache;
+    QString m_mapFilePath; // Map file the cache is persisted next to, empty if not persisted
+    int m_tileChangeListenerId = 0;
     
     // Interaction state
     QPoint m_dragStartPos;
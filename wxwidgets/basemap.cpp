@@ -132,6 +132,19 @@ Tile* BaseMap::swapTile(int x, int y, int z, Tile* newtile) {
 	return leaf->setTile(x, y, z, newtile);
 }
 
+ItemIndex& BaseMap::getItemIndex() {
+	if (!item_index.isBuilt()) {
+		item_index.build(*this);
+	}
+	return item_index;
+}
+
+const ItemIndex& BaseMap::getItemIndex() const {
+	// Don't create static const maps!
+	BaseMap* self = const_cast<BaseMap*>(this);
+	return self->getItemIndex();
+}
+
 // Iterators
 
 MapIterator::MapIterator(BaseMap* _map) :
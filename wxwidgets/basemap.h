@@ -23,6 +23,8 @@
 #include "filehandle.h"
 #include "map_allocator.h"
 #include "tile.h"
+#include "zone_index.h"
+#include "item_index.h"
 
 // Class declarations
 class QTreeNode;
@@ -139,11 +141,28 @@ public:
 		return tilecount;
 	}
 
+	// Zone regions of the tiles currently in the map
+	ZoneIndex& getZoneIndex() {
+		return zone_index;
+	}
+	// Item, action ID and unique ID lookup, built on first use
+	ItemIndex& getItemIndex();
+	const ItemIndex& getItemIndex() const;
+	ItemIndex* getItemIndexIfBuilt() {
+		return item_index.isBuilt() ? &item_index : nullptr;
+	}
+	// For operations that edit tiles in place instead of swapping them, the index is rebuilt on the next query
+	void resetItemIndex() {
+		item_index.reset();
+	}
+
 public:
 	MapAllocator allocator;
 
 protected:
 	uint64_t tilecount;
+	ZoneIndex zone_index;
+	ItemIndex item_index;
 
 	QTreeNode root; // The Quad Tree root
 
@@ -836,6 +836,7 @@ void Editor::borderizeSelection() {
 void Editor::borderizeMap(bool showdialog) {
 	if (!showdialog) {
 		// Old immediate processing for automated calls
+		map.resetItemIndex();
 		uint64_t tiles_done = 0;
 		for (TileLocation* tileLocation : map) {
 			Tile* tile = tileLocation->get();
@@ -878,6 +879,7 @@ void Editor::randomizeSelection() {
 }
 
 void Editor::randomizeMap(bool showdialog) {
+	map.resetItemIndex();
 	if (showdialog) {
 		g_gui.CreateLoadBar("Randomizing map...");
 	}
@@ -2067,6 +2069,7 @@ uint32_t Editor::validateGrounds(bool validateStack, bool generateEmpty, bool re
     selection.clear();
 
     g_gui.CreateLoadBar("Validating ground tiles...");
+    map.resetItemIndex();
 
     if (validateStack) {
         changes += validateGroundStacks();
@@ -126,6 +126,37 @@ protected:
 	}
 };
 
+// Read-only memory mapping of a whole file.
+// The mapped bytes stay valid until close(), and may be read from any thread.
+class MappedFile : boost::noncopyable {
+public:
+	MappedFile() = default;
+	~MappedFile() {
+		close();
+	}
+
+	bool open(const std::string& name);
+	void close();
+
+	bool isOpen() const {
+		return data != nullptr;
+	}
+	const uint8_t* getData() const {
+		return data;
+	}
+	size_t size() const {
+		return file_size;
+	}
+
+protected:
+	const uint8_t* data = nullptr;
+	size_t file_size = 0;
+#ifdef _WIN32
+	void* file_handle = nullptr;
+	void* mapping_handle = nullptr;
+#endif
+};
+
 class NodeFileReadHandle;
 class DiskNodeFileReadHandle;
 class MemoryNodeFileReadHandle;
@@ -42,6 +42,61 @@
 #include "../brushes/door_archway.xpm"
 #include "../brushes/door_archway_small.xpm"
 
+// Upper bound for sprites queued or decoded ahead of the viewport (4 KB of RGBA each)
+static const size_t PREFETCH_MAX_SPRITES = 4096;
+// Size of one 32x32 RGBA sprite, the unit of the texture and software sprite budgets
+static const size_t SPRITE_TEXTURE_BYTES = SPRITE_PIXELS * SPRITE_PIXELS * 4;
+// Compressed pixel dumps kept in memory when sprites are not memcached
+static const size_t SPRITE_DUMP_BUDGET = 16 * 1024 * 1024;
+// Upper bound for textures or dumps freed by a single garbageCollection call
+static const int RESIDENCY_EVICTIONS_PER_FRAME = 64;
+
+// Expands a sprite pixel dump into a newd SPRITE_PIXELS x SPRITE_PIXELS RGBA buffer
+static uint8_t* decodeSpriteRGBA(const uint8_t* dump, uint16_t size, bool use_alpha) {
+	const int pixels_data_size = SPRITE_PIXELS_SIZE * 4;
+	uint8_t* data = newd uint8_t[pixels_data_size];
+	uint8_t bpp = use_alpha ? 4 : 3;
+	int write = 0;
+	int read = 0;
+
+	// decompress pixels
+	while (read < size && write < pixels_data_size) {
+		int transparent = dump[read] | dump[read + 1] << 8;
+		if (use_alpha && transparent >= SPRITE_PIXELS_SIZE) { // Corrupted sprite?
+			break;
+		}
+		read += 2;
+		for (int i = 0; i < transparent && write < pixels_data_size; i++) {
+			data[write + 0] = 0x00; // red
+			data[write + 1] = 0x00; // green
+			data[write + 2] = 0x00; // blue
+			data[write + 3] = 0x00; // alpha
+			write += 4;
+		}
+
+		int colored = dump[read] | dump[read + 1] << 8;
+		read += 2;
+		for (int i = 0; i < colored && write < pixels_data_size; i++) {
+			data[write + 0] = dump[read + 0]; // red
+			data[write + 1] = dump[read + 1]; // green
+			data[write + 2] = dump[read + 2]; // blue
+			data[write + 3] = use_alpha ? dump[read + 3] : 0xFF; // alpha
+			write += 4;
+			read += bpp;
+		}
+	}
+
+	// fill remaining pixels
+	while (write < pixels_data_size) {
+		data[write + 0] = 0x00; // red
+		data[write + 1] = 0x00; // green
+		data[write + 2] = 0x00; // blue
+		data[write + 3] = 0x00; // alpha
+		write += 4;
+	}
+	return data;
+}
+
 // All 133 template colors
 static uint32_t TemplateOutfitLookupTable[] = {
 	0xFFFFFF,
@@ -182,19 +237,21 @@ static uint32_t TemplateOutfitLookupTable[] = {
 GraphicManager::GraphicManager() :
 	client_version(nullptr),
 	unloaded(true),
+	prefetch_stop(false),
 	dat_format(DAT_FORMAT_UNKNOWN),
 	otfi_found(false),
 	is_extended(false),
 	has_transparency(false),
 	has_frame_durations(false),
 	has_frame_groups(false),
-	loaded_textures(0),
-	lastclean(0) {
+	residency_clock(0) {
 	animation_timer = newd wxStopWatch();
 	animation_timer->Start();
 }
 
 GraphicManager::~GraphicManager() {
+	stopPrefetchThread();
+
 	for (SpriteMap::iterator iter = sprite_space.begin(); iter != sprite_space.end(); ++iter) {
 		delete iter->second;
 	}
@@ -235,13 +292,11 @@ void GraphicManager::clear() {
 
 	sprite_space.swap(new_sprite_space);
 	image_space.clear();
-	cleanup_list.clear();
 
 	item_count = 0;
 	creature_count = 0;
-	loaded_textures = 0;
-	lastclean = time(nullptr);
-	spritefile = "";
+	stopPrefetchThread();
+	sprite_file.close();
 
 	unloaded = true;
 }
@@ -839,7 +894,12 @@ bool GraphicManager::loadSpriteData(const FileName& datafile, wxString& error, w
 	}
 
 	if (!g_settings.getInteger(Config::USE_MEMCACHED_SPRITES)) {
-		spritefile = nstr(datafile.GetFullPath());
+		// Sprites are read on demand straight from the mapping, and decoded ahead of the viewport
+		if (!sprite_file.open(nstr(datafile.GetFullPath()))) {
+			error = "Failed to map the sprite file into memory";
+			return false;
+		}
+		startPrefetchThread();
 		unloaded = false;
 		return true;
 	}
@@ -899,63 +959,245 @@ bool GraphicManager::loadSpriteDump(uint8_t*& target, uint16_t& size, int sprite
 		return true;
 	}
 
-	FileReadHandle fh(spritefile);
-	if (!fh.isOk()) {
+	const uint8_t* mapped_dump = nullptr;
+	uint16_t sprite_size = 0;
+	if (!getMappedSpriteDump(sprite_id, mapped_dump, sprite_size)) {
 		return false;
 	}
 	unloaded = false;
 
-	if (!fh.seek((is_extended ? 4 : 2) + sprite_id * sizeof(uint32_t))) {
+	target = nullptr;
+	if (sprite_size > 0) {
+		target = newd uint8_t[sprite_size];
+		memcpy(target, mapped_dump, sprite_size);
+	}
+	size = sprite_size;
+	return true;
+}
+
+bool GraphicManager::getMappedSpriteDump(uint32_t sprite_id, const uint8_t*& dump, uint16_t& size) const {
+	if (!sprite_file.isOpen()) {
+		return false;
+	}
+
+	const uint8_t* data = sprite_file.getData();
+	const size_t file_size = sprite_file.size();
+
+	const size_t table_offset = (is_extended ? 4 : 2) + static_cast<size_t>(sprite_id) * sizeof(uint32_t);
+	if (table_offset + sizeof(uint32_t) > file_size) {
 		return false;
 	}
+	uint32_t address;
+	memcpy(&address, data + table_offset, sizeof(address));
+	if (address == 0) {
+		// Empty GameSprite
+		dump = nullptr;
+		size = 0;
+		return true;
+	}
+
+	const size_t size_offset = static_cast<size_t>(address) + 3; // Skip the color key
+	if (size_offset + sizeof(uint16_t) > file_size) {
+		return false;
+	}
+	uint16_t sprite_size;
+	memcpy(&sprite_size, data + size_offset, sizeof(sprite_size));
+	if (size_offset + sizeof(uint16_t) + sprite_size > file_size) {
+		return false;
+	}
+
+	dump = data + size_offset + sizeof(uint16_t);
+	size = sprite_size;
+	return true;
+}
+
+void GraphicManager::startPrefetchThread() {
+	stopPrefetchThread();
+	prefetch_stop = false;
+	prefetch_thread = std::thread(&GraphicManager::prefetchThreadLoop, this);
+}
+
+void GraphicManager::stopPrefetchThread() {
+	{
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+		prefetch_stop = true;
+	}
+	prefetch_signal.notify_all();
+	if (prefetch_thread.joinable()) {
+		prefetch_thread.join();
+	}
+
+	std::lock_guard<std::mutex> lock(prefetch_mutex);
+	for (auto& decoded : prefetched_rgba) {
+		delete[] decoded.second;
+	}
+	prefetched_rgba.clear();
+	prefetched_order.clear();
+	prefetch_pending.clear();
+	prefetch_queue.clear();
+}
+
+void GraphicManager::prefetchThreadLoop() {
+	const bool use_alpha = has_transparency;
+
+	std::unique_lock<std::mutex> lock(prefetch_mutex);
+	while (true) {
+		prefetch_signal.wait(lock, [this] { return prefetch_stop || !prefetch_queue.empty(); });
+		if (prefetch_stop) {
+			return;
+		}
+		const uint32_t sprite_id = prefetch_queue.front();
+		prefetch_queue.pop_front();
+		lock.unlock();
+
+		// Any page faults on the mapped sprite file are taken here instead of on the render thread
+		uint8_t* rgba = nullptr;
+		const uint8_t* dump = nullptr;
+		uint16_t size = 0;
+		if (getMappedSpriteDump(sprite_id, dump, size)) {
+			rgba = decodeSpriteRGBA(dump, size, use_alpha);
+		}
+
+		lock.lock();
+		if (rgba) {
+			prefetched_rgba[sprite_id] = rgba;
+			prefetched_order.push_back(sprite_id);
+			// Taken sprites are left in the order list; drop them once they outnumber the live ones
+			if (prefetched_order.size() > 2 * PREFETCH_MAX_SPRITES) {
+				prefetched_order.erase(std::remove_if(prefetched_order.begin(), prefetched_order.end(), [this](uint32_t id) {
+					return prefetched_rgba.find(id) == prefetched_rgba.end();
+				}), prefetched_order.end());
+			}
+		} else {
+			prefetch_pending.erase(sprite_id);
+		}
+	}
+}
+
+void GraphicManager::prefetchSprites(const std::vector<GameSprite*>& sprites) {
+	if (!prefetch_thread.joinable()) {
+		return;
+	}
 
-	uint32_t to_seek = 0;
-	if (fh.getU32(to_seek)) {
-		fh.seek(to_seek + 3);
-		uint16_t sprite_size;
-		if (fh.getU16(sprite_size)) {
-			target = newd uint8_t[sprite_size];
-			if (fh.getRAW(target, sprite_size)) {
-				size = sprite_size;
-				return true;
+	bool queued = false;
+	{
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+		for (GameSprite* spr : sprites) {
+			for (GameSprite::NormalImage* image : spr->spriteList) {
+				if (!image || image->id == 0 || image->isGLLoaded || image->dump) {
+					continue;
+				}
+				if (prefetch_pending.size() >= PREFETCH_MAX_SPRITES) {
+					if (prefetched_rgba.empty()) {
+						break; // Everything pending is still queued
+					}
+					// Make room by dropping the oldest decoded image that was never drawn
+					auto stale = prefetched_rgba.end();
+					while (stale == prefetched_rgba.end() && !prefetched_order.empty()) {
+						stale = prefetched_rgba.find(prefetched_order.front());
+						prefetched_order.pop_front();
+					}
+					if (stale == prefetched_rgba.end()) {
+						break;
+					}
+					delete[] stale->second;
+					prefetch_pending.erase(stale->first);
+					prefetched_rgba.erase(stale);
+				}
+				if (prefetch_pending.insert(image->id).second) {
+					prefetch_queue.push_back(image->id);
+					queued = true;
+				}
 			}
-			delete[] target;
-			target = nullptr;
 		}
 	}
-	return false;
+	if (queued) {
+		prefetch_signal.notify_one();
+	}
 }
 
-void GraphicManager::addSpriteToCleanup(GameSprite* spr) {
-	cleanup_list.push_back(spr);
-	// Clean if needed
-	if (cleanup_list.size() > std::max<uint32_t>(100, g_settings.getInteger(Config::SOFTWARE_CLEAN_THRESHOLD))) {
-		for (int i = 0; i < g_settings.getInteger(Config::SOFTWARE_CLEAN_SIZE) && static_cast<uint32_t>(i) < cleanup_list.size(); ++i) {
-			cleanup_list.front()->unloadDC();
-			cleanup_list.pop_front();
+uint8_t* GraphicManager::takePrefetchedRGBA(uint32_t sprite_id) {
+	if (!prefetch_thread.joinable()) {
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(prefetch_mutex);
+	auto it = prefetched_rgba.find(sprite_id);
+	if (it == prefetched_rgba.end()) {
+		return nullptr;
+	}
+	uint8_t* rgba = it->second;
+	prefetched_rgba.erase(it);
+	prefetch_pending.erase(sprite_id);
+	return rgba;
+}
+
+void GraphicManager::touchTexture(GameSprite::Image* image) {
+	resident_textures.touch(image, SPRITE_TEXTURE_BYTES, residency_clock);
+}
+
+void GraphicManager::releaseTexture(GameSprite::Image* image) {
+	resident_textures.remove(image);
+}
+
+void GraphicManager::touchSpriteDump(GameSprite::NormalImage* image) {
+	resident_dumps.touch(image, image->size, residency_clock);
+}
+
+void GraphicManager::releaseSpriteDump(GameSprite::NormalImage* image) {
+	resident_dumps.remove(image);
+}
+
+void GraphicManager::touchSoftwareSprite(GameSprite* sprite) {
+	size_t bytes = 0;
+	if (sprite->dc[SPRITE_SIZE_16x16]) {
+		bytes += 16 * 16 * 4;
+	}
+	if (sprite->dc[SPRITE_SIZE_32x32]) {
+		bytes += SPRITE_TEXTURE_BYTES;
+	}
+	resident_software_sprites.touch(sprite, bytes, residency_clock);
+
+	// Trim the least recently drawn sprites, never the one that is being drawn
+	const size_t budget = std::max<size_t>(100, g_settings.getInteger(Config::SOFTWARE_CLEAN_THRESHOLD)) * SPRITE_TEXTURE_BYTES;
+	const int max_evictions = g_settings.getInteger(Config::SOFTWARE_CLEAN_SIZE);
+	for (int i = 0; i < max_evictions && resident_software_sprites.bytes() > budget; ++i) {
+		GameSprite* oldest = resident_software_sprites.leastRecentlyUsed();
+		if (oldest == sprite) {
+			break;
 		}
+		oldest->unloadDC();
 	}
 }
 
+void GraphicManager::releaseSoftwareSprite(GameSprite* sprite) {
+	resident_software_sprites.remove(sprite);
+}
+
 void GraphicManager::garbageCollection() {
-	if (g_settings.getInteger(Config::TEXTURE_MANAGEMENT)) {
-		int t = time(nullptr);
-		if (loaded_textures > g_settings.getInteger(Config::TEXTURE_CLEAN_THRESHOLD) && t - lastclean > g_settings.getInteger(Config::TEXTURE_CLEAN_PULSE)) {
-			ImageMap::iterator iit = image_space.begin();
-			while (iit != image_space.end()) {
-				iit->second->clean(t);
-				++iit;
-			}
-			SpriteMap::iterator sit = sprite_space.begin();
-			while (sit != sprite_space.end()) {
-				GameSprite* gs = dynamic_cast<GameSprite*>(sit->second);
-				if (gs) {
-					gs->clean(t);
-				}
-				++sit;
-			}
-			lastclean = t;
+	residency_clock = time(nullptr);
+	if (!g_settings.getInteger(Config::TEXTURE_MANAGEMENT)) {
+		return;
+	}
+
+	// Only the tails of the lists are looked at, so a frame never costs more than a few evictions
+	const size_t texture_budget = static_cast<size_t>(std::max(0, g_settings.getInteger(Config::TEXTURE_CLEAN_THRESHOLD))) * SPRITE_TEXTURE_BYTES;
+	const int texture_longevity = g_settings.getInteger(Config::TEXTURE_LONGEVITY);
+	for (int i = 0; i < RESIDENCY_EVICTIONS_PER_FRAME && resident_textures.bytes() > texture_budget; ++i) {
+		GameSprite::Image* image = resident_textures.leastRecentlyUsed();
+		if (residency_clock - image->texture_link.last_used <= texture_longevity) {
+			break; // Everything else was used even more recently
 		}
+		image->evictTexture();
+	}
+
+	// Dumps are only needed to (re)create textures, we keep them around for 5 seconds
+	for (int i = 0; i < RESIDENCY_EVICTIONS_PER_FRAME && resident_dumps.size() > 0; ++i) {
+		GameSprite::NormalImage* image = resident_dumps.leastRecentlyUsed();
+		if (resident_dumps.bytes() <= SPRITE_DUMP_BUDGET && residency_clock - image->dump_link.last_used <= 5) {
+			break;
+		}
+		image->evictDump();
 	}
 }
 
@@ -1019,19 +1261,12 @@ GameSprite::~GameSprite() {
 	delete animator;
 }
 
-void GameSprite::clean(int time) {
-	for (std::list<TemplateImage*>::iterator iter = instanced_templates.begin();
-		 iter != instanced_templates.end();
-		 ++iter) {
-		(*iter)->clean(time);
-	}
-}
-
 void GameSprite::unloadDC() {
 	delete dc[SPRITE_SIZE_16x16];
 	delete dc[SPRITE_SIZE_32x32];
 	dc[SPRITE_SIZE_16x16] = nullptr;
 	dc[SPRITE_SIZE_32x32] = nullptr;
+	g_gui.gfx.releaseSoftwareSprite(this);
 }
 
 int GameSprite::getDrawHeight() const {
@@ -1139,9 +1374,9 @@ wxMemoryDC* GameSprite::getDC(SpriteSize size) {
 
 		wxBitmap bmp(image);
 		dc[size] = newd wxMemoryDC(bmp);
-		g_gui.gfx.addSpriteToCleanup(this);
 		image.Destroy();
 	}
+	g_gui.gfx.touchSoftwareSprite(this);
 	return dc[size];
 }
 
@@ -1248,8 +1483,7 @@ void GameSprite::DrawOutfit(wxDC* dc, SpriteSize sz, int start_x, int start_y, c
 }
 
 GameSprite::Image::Image() :
-	isGLLoaded(false),
-	lastaccess(0) {
+	isGLLoaded(false) {
 	////
 }
 
@@ -1266,7 +1500,7 @@ void GameSprite::Image::createGLTexture(GLuint whatid) {
 	}
 
 	isGLLoaded = true;
-	g_gui.gfx.loaded_textures += 1;
+	g_gui.gfx.touchTexture(this);
 
 	glBindTexture(GL_TEXTURE_2D, whatid);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); // Linear Filtering
@@ -1280,17 +1514,21 @@ void GameSprite::Image::createGLTexture(GLuint whatid) {
 }
 
 void GameSprite::Image::unloadGLTexture(GLuint whatid) {
+	if (isGLLoaded) {
+		g_gui.gfx.releaseTexture(this);
+	}
 	isGLLoaded = false;
-	g_gui.gfx.loaded_textures -= 1;
 	glDeleteTextures(1, &whatid);
 }
 
 void GameSprite::Image::visit() {
-	lastaccess = time(nullptr);
+	if (isGLLoaded) {
+		g_gui.gfx.touchTexture(this);
+	}
 }
 
-void GameSprite::Image::clean(int time) {
-	if (isGLLoaded && time - lastaccess > g_settings.getInteger(Config::TEXTURE_LONGEVITY)) {
+void GameSprite::Image::evictTexture() {
+	if (isGLLoaded) {
 		unloadGLTexture(0);
 	}
 }
@@ -1304,14 +1542,13 @@ GameSprite::NormalImage::NormalImage() :
 
 GameSprite::NormalImage::~NormalImage() {
 	delete[] dump;
+	g_gui.gfx.releaseSpriteDump(this);
 }
 
-void GameSprite::NormalImage::clean(int time) {
-	Image::clean(time);
-	if (time - lastaccess > 5 && !g_settings.getInteger(Config::USE_MEMCACHED_SPRITES)) { // We keep dumps around for 5 seconds.
-		delete[] dump;
-		dump = nullptr;
-	}
+void GameSprite::NormalImage::evictDump() {
+	delete[] dump;
+	dump = nullptr;
+	g_gui.gfx.releaseSpriteDump(this);
 }
 
 uint8_t* GameSprite::NormalImage::getRGBData() {
@@ -1323,6 +1560,7 @@ uint8_t* GameSprite::NormalImage::getRGBData() {
 		if (!g_gui.gfx.loadSpriteDump(dump, size, id)) {
 			return nullptr;
 		}
+		g_gui.gfx.touchSpriteDump(this);
 	}
 
 	const int pixels_data_size = SPRITE_PIXELS * SPRITE_PIXELS * 3;
@@ -1364,6 +1602,10 @@ uint8_t* GameSprite::NormalImage::getRGBData() {
 }
 
 uint8_t* GameSprite::NormalImage::getRGBAData() {
+	if (uint8_t* prefetched = g_gui.gfx.takePrefetchedRGBA(id)) {
+		return prefetched;
+	}
+
 	if (!dump) {
 		if (g_settings.getInteger(Config::USE_MEMCACHED_SPRITES)) {
 			return nullptr;
@@ -1372,51 +1614,10 @@ uint8_t* GameSprite::NormalImage::getRGBAData() {
 		if (!g_gui.gfx.loadSpriteDump(dump, size, id)) {
 			return nullptr;
 		}
+		g_gui.gfx.touchSpriteDump(this);
 	}
 
-	const int pixels_data_size = SPRITE_PIXELS_SIZE * 4;
-	uint8_t* data = newd uint8_t[pixels_data_size];
-	bool use_alpha = g_gui.gfx.hasTransparency();
-	uint8_t bpp = use_alpha ? 4 : 3;
-	int write = 0;
-	int read = 0;
-
-	// decompress pixels
-	while (read < size && write < pixels_data_size) {
-		int transparent = dump[read] | dump[read + 1] << 8;
-		if (use_alpha && transparent >= SPRITE_PIXELS_SIZE) { // Corrupted sprite?
-			break;
-		}
-		read += 2;
-		for (int i = 0; i < transparent && write < pixels_data_size; i++) {
-			data[write + 0] = 0x00; // red
-			data[write + 1] = 0x00; // green
-			data[write + 2] = 0x00; // blue
-			data[write + 3] = 0x00; // alpha
-			write += 4;
-		}
-
-		int colored = dump[read] | dump[read + 1] << 8;
-		read += 2;
-		for (int i = 0; i < colored && write < pixels_data_size; i++) {
-			data[write + 0] = dump[read + 0]; // red
-			data[write + 1] = dump[read + 1]; // green
-			data[write + 2] = dump[read + 2]; // blue
-			data[write + 3] = use_alpha ? dump[read + 3] : 0xFF; // alpha
-			write += 4;
-			read += bpp;
-		}
-	}
-
-	// fill remaining pixels
-	while (write < pixels_data_size) {
-		data[write + 0] = 0x00; // red
-		data[write + 1] = 0x00; // green
-		data[write + 2] = 0x00; // blue
-		data[write + 3] = 0x00; // alpha
-		write += 4;
-	}
-	return data;
+	return decodeSpriteRGBA(dump, size, g_gui.gfx.hasTransparency());
 }
 
 GLuint GameSprite::NormalImage::getHardwareID() {
@@ -20,7 +20,13 @@
 
 #include "outfit.h"
 #include "common.h"
+#include "filehandle.h"
 #include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "client_version.h"
 
@@ -46,6 +52,91 @@ class GraphicManager;
 class FileReadHandle;
 class Animator;
 
+// Intrusive least recently used list of resident sprite resources (GL textures, pixel dumps, software DCs).
+// Each entry embeds a ResidencyLink, so touching, removing and finding the eviction candidate are O(1).
+template <typename T>
+struct ResidencyLink {
+	T* prev = nullptr;
+	T* next = nullptr;
+	size_t bytes = 0;
+	int last_used = 0;
+	bool linked = false;
+};
+
+template <typename T, ResidencyLink<T> T::*Link>
+class ResidencyList {
+public:
+	// Links 'entry' if needed and moves it to the most recently used end
+	void touch(T* entry, size_t bytes, int now) {
+		ResidencyLink<T>& link = entry->*Link;
+		if (link.linked) {
+			total_bytes = total_bytes - link.bytes + bytes;
+			link.bytes = bytes;
+			link.last_used = now;
+			if (head == entry) {
+				return;
+			}
+			unlinkEntry(entry);
+		} else {
+			link.linked = true;
+			link.bytes = bytes;
+			total_bytes += bytes;
+			++count;
+		}
+		link.last_used = now;
+		link.prev = nullptr;
+		link.next = head;
+		if (head) {
+			(head->*Link).prev = entry;
+		}
+		head = entry;
+		if (!tail) {
+			tail = entry;
+		}
+	}
+
+	void remove(T* entry) {
+		ResidencyLink<T>& link = entry->*Link;
+		if (!link.linked) {
+			return;
+		}
+		unlinkEntry(entry);
+		total_bytes -= link.bytes;
+		--count;
+		link = ResidencyLink<T>();
+	}
+
+	T* leastRecentlyUsed() const {
+		return tail;
+	}
+	size_t bytes() const {
+		return total_bytes;
+	}
+	size_t size() const {
+		return count;
+	}
+
+private:
+	void unlinkEntry(T* entry) {
+		ResidencyLink<T>& link = entry->*Link;
+		if (link.prev) {
+			(link.prev->*Link).next = link.next;
+		} else {
+			head = link.next;
+		}
+		if (link.next) {
+			(link.next->*Link).prev = link.prev;
+		} else {
+			tail = link.prev;
+		}
+	}
+
+	T* head = nullptr;
+	T* tail = nullptr;
+	size_t total_bytes = 0;
+	size_t count = 0;
+};
+
 struct SpriteLight {
 	uint8_t intensity = 0;
 	uint8_t color = 0;
@@ -91,8 +182,6 @@ public:
 
 	virtual void unloadDC();
 
-	void clean(int time);
-
 	int getDrawHeight() const;
 	std::pair<int, int> getDrawOffset() const;
 	uint8_t getMiniMapColor() const;
@@ -118,10 +207,12 @@ protected:
 		virtual ~Image();
 
 		bool isGLLoaded;
-		int lastaccess;
+		ResidencyLink<Image> texture_link;
 
+		// Marks the texture as used this frame
 		void visit();
-		virtual void clean(int time);
+		// Drops the GL texture, it is recreated on the next getHardwareID
+		void evictTexture();
 
 		virtual GLuint getHardwareID() = 0;
 		virtual uint8_t* getRGBData() = 0;
@@ -143,8 +234,10 @@ protected:
 		// This contains the pixel data
 		uint16_t size;
 		uint8_t* dump;
+		ResidencyLink<NormalImage> dump_link;
 
-		virtual void clean(int time);
+		// Frees the pixel dump, it is read from the sprite file again when needed
+		void evictDump();
 
 		virtual GLuint getHardwareID();
 		virtual uint8_t* getRGBData();
@@ -181,6 +274,7 @@ protected:
 
 	uint32_t id;
 	wxMemoryDC* dc[SPRITE_SIZE_COUNT];
+	ResidencyLink<GameSprite> dc_link;
 
 public:
 	// GameSprite info
@@ -297,9 +391,13 @@ public:
 	bool loadSpriteMetadataFlags(FileReadHandle& file, GameSprite* sType, wxString& error, wxArrayString& warnings);
 	bool loadSpriteData(const FileName& datafile, wxString& error, wxArrayString& warnings);
 
-	// Cleans old & unused textures according to config settings
+	// Evicts a few of the least recently used textures and pixel dumps that are over budget, called every frame
 	void garbageCollection();
-	void addSpriteToCleanup(GameSprite* spr);
+
+	// Queues the images of these sprites that have no texture yet for decoding on the prefetch thread
+	void prefetchSprites(const std::vector<GameSprite*>& sprites);
+	// Takes a decoded RGBA image from the prefetch thread, or nullptr. The caller owns the buffer.
+	uint8_t* takePrefetchedRGBA(uint32_t sprite_id);
 
 	wxFileName getMetadataFileName() const {
 		return metadata_file;
@@ -315,15 +413,43 @@ public:
 
 private:
 	bool unloaded;
-	// This is used if memcaching is NOT on
-	std::string spritefile;
+	// This is used if memcaching is NOT on; mapped once when the sprite data is loaded
+	MappedFile sprite_file;
 	bool loadSpriteDump(uint8_t*& target, uint16_t& size, int sprite_id);
+	// Locates a sprite's pixel dump inside the mapped sprite file, safe on any thread
+	bool getMappedSpriteDump(uint32_t sprite_id, const uint8_t*& dump, uint16_t& size) const;
+
+	// Background decoding of sprites near the viewport, only used with a mapped sprite file
+	void startPrefetchThread();
+	void stopPrefetchThread();
+	void prefetchThreadLoop();
+
+	std::thread prefetch_thread;
+	std::mutex prefetch_mutex;
+	std::condition_variable prefetch_signal;
+	bool prefetch_stop;
+	std::deque<uint32_t> prefetch_queue;
+	std::unordered_set<uint32_t> prefetch_pending; // Queued or decoded, not yet taken
+	std::unordered_map<uint32_t, uint8_t*> prefetched_rgba;
+	std::deque<uint32_t> prefetched_order; // Decode order, oldest first; may hold ids already taken
 
 	typedef std::map<int, Sprite*> SpriteMap;
 	SpriteMap sprite_space;
 	typedef std::map<int, GameSprite::Image*> ImageMap;
 	ImageMap image_space;
-	std::deque<GameSprite*> cleanup_list;
+
+	// Resident sprite resources, most recently used first
+	void touchTexture(GameSprite::Image* image);
+	void releaseTexture(GameSprite::Image* image);
+	void touchSpriteDump(GameSprite::NormalImage* image);
+	void releaseSpriteDump(GameSprite::NormalImage* image);
+	void touchSoftwareSprite(GameSprite* sprite);
+	void releaseSoftwareSprite(GameSprite* sprite);
+
+	ResidencyList<GameSprite::Image, &GameSprite::Image::texture_link> resident_textures;
+	ResidencyList<GameSprite::NormalImage, &GameSprite::NormalImage::dump_link> resident_dumps;
+	ResidencyList<GameSprite, &GameSprite::dc_link> resident_software_sprites;
+	int residency_clock; // Time of the current frame, stamped on every use
 
 	DatFormat dat_format;
 	uint16_t item_count;
@@ -336,11 +462,9 @@ private:
 	wxFileName metadata_file;
 	wxFileName sprites_file;
 
-	int loaded_textures;
-	int lastclean;
-
 	wxStopWatch* animation_timer;
 
+	friend class GameSprite;
 	friend class GameSprite::Image;
 	friend class GameSprite::NormalImage;
 	friend class GameSprite::TemplateImage;
@@ -0,0 +1,157 @@
+//////////////////////////////////////////////////////////////////////
+// This file is part of Remere's Map Editor
+//////////////////////////////////////////////////////////////////////
+// Remere's Map Editor is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Remere's Map Editor is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//////////////////////////////////////////////////////////////////////
+
+#include "main.h"
+
+#include "item_index.h"
+#include "basemap.h"
+#include "complexitem.h"
+
+void ItemIndex::build(BaseMap& map) {
+	reset();
+	built = true;
+	for (MapIterator it = map.begin(); it != map.end(); ++it) {
+		if (const Tile* tile = (*it)->get()) {
+			updateTile(tile, true);
+		}
+	}
+}
+
+void ItemIndex::reset() {
+	for (auto& key_entries : entries) {
+		key_entries.clear();
+	}
+	built = false;
+}
+
+void ItemIndex::addTile(const Tile* tile) {
+	if (built && tile) {
+		updateTile(tile, true);
+	}
+}
+
+void ItemIndex::removeTile(const Tile* tile) {
+	if (built && tile) {
+		updateTile(tile, false);
+	}
+}
+
+void ItemIndex::removeItem(const Tile* tile, const Item* item) {
+	if (built && tile && item) {
+		updateItem(item, blockKey(tile->getPosition()), false);
+	}
+}
+
+uint32_t ItemIndex::count(Key key, uint16_t value) const {
+	auto it = entries[key].find(value);
+	return it != entries[key].end() ? it->second.total : 0;
+}
+
+void ItemIndex::getBlocks(Key key, uint16_t first, uint16_t last, PositionVector& blocks) const {
+	const auto& key_entries = entries[key];
+	if (first == last) {
+		auto it = key_entries.find(first);
+		if (it != key_entries.end()) {
+			appendBlocks(it->second, blocks);
+		}
+		return;
+	}
+
+	// Wide ranges are cheaper to match against the values present on the map
+	if (static_cast<size_t>(last - first) >= key_entries.size()) {
+		for (const auto& it : key_entries) {
+			if (it.first >= first && it.first <= last) {
+				appendBlocks(it.second, blocks);
+			}
+		}
+		return;
+	}
+
+	for (uint32_t value = first; value <= last; ++value) {
+		auto it = key_entries.find(static_cast<uint16_t>(value));
+		if (it != key_entries.end()) {
+			appendBlocks(it->second, blocks);
+		}
+	}
+}
+
+uint64_t ItemIndex::blockKey(const Position& position) {
+	return (static_cast<uint64_t>(position.z) << 32) | (static_cast<uint64_t>(position.x / BLOCK_SIZE) << 16) | static_cast<uint64_t>(position.y / BLOCK_SIZE);
+}
+
+Position ItemIndex::blockOrigin(uint64_t key) {
+	return Position(static_cast<int>((key >> 16) & 0xFFFF) * BLOCK_SIZE, static_cast<int>(key & 0xFFFF) * BLOCK_SIZE, static_cast<int>(key >> 32));
+}
+
+void ItemIndex::appendBlocks(const Entry& entry, PositionVector& blocks) {
+	for (const auto& block : entry.blocks) {
+		blocks.push_back(blockOrigin(block.first));
+	}
+}
+
+void ItemIndex::updateTile(const Tile* tile, bool add) {
+	const uint64_t block = blockKey(tile->getPosition());
+	if (tile->ground) {
+		updateItem(tile->ground, block, add);
+	}
+	for (const Item* item : tile->items) {
+		updateItem(item, block, add);
+	}
+}
+
+void ItemIndex::updateItem(const Item* item, uint64_t block, bool add) {
+	update(ITEM_ID, item->getID(), block, add);
+	if (item->getActionID() != 0) {
+		update(ACTION_ID, item->getActionID(), block, add);
+	}
+	if (item->getUniqueID() != 0) {
+		update(UNIQUE_ID, item->getUniqueID(), block, add);
+	}
+
+	if (const Container* container = dynamic_cast<const Container*>(item)) {
+		for (const Item* contained : const_cast<Container*>(container)->getVector()) {
+			updateItem(contained, block, add);
+		}
+	}
+}
+
+void ItemIndex::update(Key key, uint16_t value, uint64_t block, bool add) {
+	auto& key_entries = entries[key];
+	if (add) {
+		Entry& entry = key_entries[value];
+		++entry.total;
+		++entry.blocks[block];
+		return;
+	}
+
+	auto it = key_entries.find(value);
+	if (it == key_entries.end()) {
+		return;
+	}
+	Entry& entry = it->second;
+	auto block_it = entry.blocks.find(block);
+	if (block_it == entry.blocks.end()) {
+		return;
+	}
+	--entry.total;
+	if (--block_it->second == 0) {
+		entry.blocks.erase(block_it);
+	}
+	if (entry.total == 0) {
+		key_entries.erase(it);
+	}
+}
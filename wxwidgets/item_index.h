@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////
+// This file is part of Remere's Map Editor
+//////////////////////////////////////////////////////////////////////
+// Remere's Map Editor is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Remere's Map Editor is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//////////////////////////////////////////////////////////////////////
+
+#ifndef RME_ITEM_INDEX_H
+#define RME_ITEM_INDEX_H
+
+#include "position.h"
+
+#include <unordered_map>
+
+class BaseMap;
+class Tile;
+class Item;
+
+// Inverted index from item ID, action ID and unique ID to the map blocks holding such items.
+// Items are counted per block of BLOCK_SIZE x BLOCK_SIZE tiles on a floor rather than per tile,
+// which keeps ground IDs covering the whole map cheap, and reordering items on a tile needs no update.
+// Items inside containers are included. The index is built on first use and then kept
+// up to date as tiles enter and leave the map, which covers actions, undo and redo.
+class ItemIndex {
+public:
+	enum Key {
+		ITEM_ID,
+		ACTION_ID,
+		UNIQUE_ID,
+		KEY_COUNT
+	};
+
+	static const int BLOCK_SIZE = 16;
+
+	ItemIndex() = default;
+
+	ItemIndex(const ItemIndex&) = delete;
+	ItemIndex& operator=(const ItemIndex&) = delete;
+
+	bool isBuilt() const {
+		return built;
+	}
+	void build(BaseMap& map);
+	// Drops the index, it is rebuilt on the next query
+	void reset();
+
+	// Both do nothing until the index is built
+	void addTile(const Tile* tile);
+	void removeTile(const Tile* tile);
+	// For items removed from a tile that stays in the map
+	void removeItem(const Tile* tile, const Item* item);
+
+	// Number of items with this key value on the map
+	uint32_t count(Key key, uint16_t value) const;
+	// Appends the origins of the blocks holding items with a key value in [first, last].
+	// Blocks may repeat when several values share them.
+	void getBlocks(Key key, uint16_t first, uint16_t last, PositionVector& blocks) const;
+
+private:
+	struct Entry {
+		uint32_t total = 0;
+		std::unordered_map<uint64_t, uint32_t> blocks; // Block key -> item count
+	};
+
+	static uint64_t blockKey(const Position& position);
+	static Position blockOrigin(uint64_t key);
+	static void appendBlocks(const Entry& entry, PositionVector& blocks);
+
+	void updateTile(const Tile* tile, bool add);
+	void updateItem(const Item* item, uint64_t block, bool add);
+	void update(Key key, uint16_t value, uint64_t block, bool add);
+
+	std::unordered_map<uint16_t, Entry> entries[KEY_COUNT];
+	bool built = false;
+};
+
+#endif
@@ -24,9 +24,15 @@
 
 #include "editor.h"
 
+// A peer holding more unsent data than this cannot keep up with the session
+static const size_t SEND_QUEUE_LIMIT = 32 * 1024 * 1024;
+// Packets gathered into a single socket write
+static const size_t SEND_BATCH_SIZE = 64;
+
 LivePeer::LivePeer(LiveServer* server, boost::asio::ip::tcp::socket socket) :
 	LiveSocket(),
-	readMessage(), server(server), socket(std::move(socket)), color(), id(0), clientId(0), connected(false) {
+	readMessage(), server(server), socket(std::move(socket)), color(), id(0), clientId(0), connected(false),
+	queuedBytes(0), writing(false), sendClosed(false) {
 	ASSERT(server != nullptr);
 }
 
@@ -48,12 +54,21 @@ bool LivePeer::handleError(const boost::system::error_code& error) {
 	} else if (error == boost::asio::error::connection_aborted) {
 		logMessage(name + " have left the server.");
 		return true;
+	} else if (error == boost::asio::error::operation_aborted) {
+		// The socket was closed on our side (e.g. the peer fell behind), which already removes it
+		return true;
 	}
 	return false;
 }
 
 std::string LivePeer::getHostName() const {
-	return socket.remote_endpoint().address().to_string();
+	// A closed socket has no remote endpoint; the throwing overload would take down the network thread
+	boost::system::error_code error;
+	const boost::asio::ip::tcp::endpoint endpoint = socket.remote_endpoint(error);
+	if (error) {
+		return LiveSocket::getHostName();
+	}
+	return endpoint.address().to_string();
 }
 
 void LivePeer::receiveHeader() {
@@ -178,38 +193,97 @@ void LivePeer::send(NetworkMessage& message) {
 		logMessage("[Server]: Attempted to send empty message, ignoring");
 		return;
 	}
-	
-	// Write size to the first 4 bytes (header)
-	memcpy(&message.buffer[0], &message.size, 4);
-	
-	// Only log non-cursor packets to reduce excessive logging
-	bool isCursorPacket = message.buffer.size() > 0 && message.buffer[4] == PACKET_CURSOR_UPDATE;
-	if (!isCursorPacket) {
-		logMessage(wxString::Format("[Server]: Sending packet to %s (size: %zu bytes, type: 0x%02X)", 
-			getHostName(), message.size + 4, message.buffer[4]));
+	queuePacket(sealPacket(message));
+}
+
+void LivePeer::queuePacket(const SharedPacket& packet, uint64_t coalesceKey) {
+	std::lock_guard<std::mutex> lock(queueLock);
+	if (sendClosed) {
+		return;
 	}
-	
-	try {
-		boost::asio::async_write(socket, 
-			boost::asio::buffer(message.buffer, message.size + 4), 
-			[this, msgSize = message.size, isCursorPacket](const boost::system::error_code& error, size_t bytesTransferred) -> void {
-				if (error) {
-					logMessage(wxString::Format("[Server]: Error sending packet to %s: %s", 
-						getHostName(), error.message()));
-				} else if (bytesTransferred != msgSize + 4) {
-					logMessage(wxString::Format("[Server]: Incomplete packet sent to %s [sent: %zu, expected: %zu]", 
-						getHostName(), bytesTransferred, msgSize + 4));
-				} else if (!isCursorPacket) {
-					// Only log successful sends for non-cursor packets
-					logMessage(wxString::Format("[Server]: Successfully sent packet to %s (%zu bytes)", 
-						getHostName(), bytesTransferred));
+
+	// Only the newest packet for a key is worth sending; it takes the back of the
+	// queue so it cannot be overtaken by anything queued before it
+	if (coalesceKey != 0) {
+		auto queued = queuedKeys.find(coalesceKey);
+		if (queued != queuedKeys.end()) {
+			queuedBytes -= queued->second->packet->size();
+			sendQueue.erase(queued->second);
+			queuedKeys.erase(queued);
+		}
+	}
+
+	sendQueue.push_back({ packet, coalesceKey });
+	if (coalesceKey != 0) {
+		queuedKeys[coalesceKey] = std::prev(sendQueue.end());
+	}
+	queuedBytes += packet->size();
+
+	if (queuedBytes > SEND_QUEUE_LIMIT) {
+		sendClosed = true;
+		dropQueue();
+		logMessage(wxString::Format("[Server]: %s is not keeping up with the session, disconnecting.", name));
+
+		// Sockets belong to the network thread, and the client list to the main thread
+		boost::asio::post(socket.get_executor(), [this]() {
+			boost::system::error_code error;
+			socket.close(error);
+		});
+		wxTheApp->CallAfter([this]() {
+			close();
+		});
+		return;
+	}
+
+	if (!writing) {
+		flushQueue();
+	}
+}
+
+void LivePeer::flushQueue() {
+	writingPackets.clear();
+	if (sendQueue.empty()) {
+		writing = false;
+		return;
+	}
+
+	std::vector<boost::asio::const_buffer> buffers;
+	while (!sendQueue.empty() && writingPackets.size() < SEND_BATCH_SIZE) {
+		QueuedPacket& queued = sendQueue.front();
+		if (queued.key != 0) {
+			queuedKeys.erase(queued.key);
+		}
+		queuedBytes -= queued.packet->size();
+
+		buffers.push_back(boost::asio::buffer(*queued.packet));
+		writingPackets.push_back(std::move(queued.packet));
+		sendQueue.pop_front();
+	}
+
+	// The written packets stay referenced in writingPackets until the write completes
+	writing = true;
+	boost::asio::async_write(socket, buffers,
+		[this](const boost::system::error_code& error, size_t) -> void {
+			std::lock_guard<std::mutex> lock(queueLock);
+			if (error) {
+				sendClosed = true;
+				writing = false;
+				writingPackets.clear();
+				dropQueue();
+				if (error != boost::asio::error::operation_aborted) {
+					logMessage(wxString::Format("[Server]: Error sending to %s: %s", name, error.message()));
 				}
+				return;
 			}
-		);
-	} catch (std::exception& e) {
-		logMessage(wxString::Format("[Server]: Exception sending packet to %s: %s", 
-			getHostName(), e.what()));
-	}
+			flushQueue();
+		}
+	);
+}
+
+void LivePeer::dropQueue() {
+	sendQueue.clear();
+	queuedKeys.clear();
+	queuedBytes = 0;
 }
 
 void LivePeer::parseLoginPacket(NetworkMessage message) {
@@ -21,6 +21,9 @@
 #include "live_socket.h"
 #include "net_connection.h"
 
+#include <list>
+#include <mutex>
+
 class LiveServer;
 class LivePeer : public LiveSocket {
 public:
@@ -53,6 +56,17 @@ public:
 	void send(NetworkMessage& message) override;
 	void sendChat(const wxString& chatMessage) override;
 
+	// Queues a sealed packet for this peer. A packet with a non-zero key replaces
+	// any packet with the same key that has not been written yet.
+	void queuePacket(const SharedPacket& packet, uint64_t coalesceKey = 0);
+
+	static uint64_t nodePacketKey(uint32_t nodeIndex, uint16_t floorMask) {
+		return (static_cast<uint64_t>(PACKET_NODE) << 56) | (static_cast<uint64_t>(floorMask) << 32) | nodeIndex;
+	}
+	static uint64_t cursorPacketKey(uint32_t cursorId) {
+		return (static_cast<uint64_t>(PACKET_CURSOR_UPDATE) << 56) | cursorId;
+	}
+
 	//
 	void updateCursor(const Position& position) override;
 
@@ -74,6 +88,10 @@ protected:
 	void parseChatMessage(NetworkMessage& message);
 	void parseClientColorUpdate(NetworkMessage& message);
 
+	// Send queue helpers, the caller holds queueLock
+	void flushQueue(); // Starts one gathered write of the packets at the front of the queue
+	void dropQueue();
+
 	//
 	NetworkMessage readMessage;
 
@@ -87,6 +105,19 @@ protected:
 
 	bool connected;
 
+	// Send queue, written by any thread and drained on the network thread
+	struct QueuedPacket {
+		SharedPacket packet;
+		uint64_t key;
+	};
+	std::mutex queueLock;
+	std::list<QueuedPacket> sendQueue;
+	std::unordered_map<uint64_t, std::list<QueuedPacket>::iterator> queuedKeys;
+	std::vector<SharedPacket> writingPackets;
+	size_t queuedBytes;
+	bool writing;
+	bool sendClosed;
+
 	friend class LiveLogTab;
 	friend class LiveServer;
 };
@@ -294,16 +294,16 @@ std::string LiveServer::getHostName() const {
 	return "localhost";
 }
 
+void LiveServer::broadcast(NetworkMessage& message, uint64_t coalesceKey) {
+	const SharedPacket packet = sealPacket(message);
+	for (auto& clientEntry : clients) {
+		clientEntry.second->queuePacket(packet, coalesceKey);
+	}
+}
+
 void LiveServer::broadcastNodes(DirtyList& dirtyList) {
 	// Skip if we're not ready for drawing operations
 	if (!drawingReady || stopped) {
-		// Log to file instead of UI
-		std::ofstream logFile((GetAppDir() + wxFileName::GetPathSeparator() + "server_status.log").ToStdString(), std::ios::app);
-		if (logFile.is_open()) {
-			wxDateTime now = wxDateTime::Now();
-			logFile << now.FormatISOCombined() << ": Skipped broadcast, drawing not ready\n";
-			logFile.close();
-		}
 		return;
 	}
 
@@ -312,163 +312,43 @@ void LiveServer::broadcastNodes(DirtyList& dirtyList) {
 		return;
 	}
 
-	// Log to file rather than UI
-	std::ofstream logFile((GetAppDir() + wxFileName::GetPathSeparator() + "server_ops.log").ToStdString(), std::ios::app);
-	if (logFile.is_open()) {
-		wxDateTime now = wxDateTime::Now();
-		logFile << now.FormatISOCombined() << ": Broadcasting changes to " << clients.size() << " clients\n";
-	}
+	std::vector<LivePeer*> receivers;
+	receivers.reserve(clients.size());
+	for (const auto& ind : dirtyList.GetPosList()) {
+		int32_t ndx = ind.pos >> 18;
+		int32_t ndy = (ind.pos >> 4) & 0x3FFF;
 
-	// Extract the change information to a struct we can capture in our lambda
-	struct BroadcastData {
-		uint32_t owner;
-		std::vector<Change*> changes;  // Changed from ChangeList to std::vector<Change*>
-		std::vector<DirtyList::ValueType> positions;  // Use the existing type from DirtyList
-	};
+		QTreeNode* node = editor->map.getLeaf(ndx * 4, ndy * 4);
+		if (!node) {
+			continue;
+		}
 
-	std::shared_ptr<BroadcastData> broadcastData = std::make_shared<BroadcastData>();
-	broadcastData->owner = 0; // Server is always owner 0
-	
-	try {
-		// Get the changes from the dirty list, converting them to a format we can save and broadcast
-		// Note: We need to create deep copies of the changes as the dirty list will be cleared
-		ChangeList& changeList = dirtyList.GetChanges();
-		broadcastData->changes.reserve(changeList.size());
-		
-		for (Change* change : changeList) {
-			if (!change) continue;
-			
-			// Store a pointer - no unique_ptr here
-			if (change->getType() == CHANGE_TILE) {
-				// Create a deep copy of the change
-				Tile* oldTile = static_cast<Tile*>(change->getData());
-				if (oldTile) {
-					Tile* newTile = oldTile->deepCopy(editor->map);
-					Change* newChange = new Change(newTile);
-					broadcastData->changes.push_back(newChange);
-				}
+		receivers.clear();
+		for (auto& clientEntry : clients) {
+			LivePeer* peer = clientEntry.second;
+			const uint32_t clientId = peer->getClientId();
+			if (node->isVisible(clientId, true) || node->isVisible(clientId, false)) {
+				receivers.push_back(peer);
 			}
 		}
-		
-		// Get position list - need to copy the positions manually
-		DirtyList::SetType& positionList = dirtyList.GetPosList();
-		for (const auto& pos : positionList) {
-			broadcastData->positions.push_back(pos);
+		if (receivers.empty()) {
+			continue;
 		}
-		
-		// Safe logging of the node count
-		if (logFile.is_open()) {
-			logFile << "Changes: " << broadcastData->changes.size() << ", Positions: " << broadcastData->positions.size() << "\n";
-		}
-		
-		// Use a safer approach with CallAfter
-		wxTheApp->CallAfter([this, broadcastData]() {
-			try {
-				if (!editor || !drawingReady) return;
-
-				// Handle host changes first
-				if (broadcastData->owner == 0 && !broadcastData->changes.empty()) {
-					NetworkedAction* action = static_cast<NetworkedAction*>(editor->actionQueue->createAction(ACTION_REMOTE));
-					if (action) {
-						action->owner = broadcastData->owner;
-						
-						// Add the changes to the action - action takes ownership
-						for (Change* change : broadcastData->changes) {
-							if (change) {
-								action->addChange(change);
-							}
-						}
-						
-						// Add the action to the queue
-						editor->actionQueue->addAction(action, 0);
-					}
-				}
 
-				// Now handle the network broadcasting
-				// Create a vector of all the work we need to do
-				struct BroadcastWork {
-					LivePeer* peer;
-					QTreeNode* node;
-					int32_t ndx;
-					int32_t ndy;
-					uint32_t floors;
-					uint32_t clientId;
-				};
-				
-				std::vector<BroadcastWork> workItems;
-
-				// First gather all the work without doing any actual sending
-				for (const auto& ind : broadcastData->positions) {
-					int32_t ndx = ind.pos >> 18;
-					int32_t ndy = (ind.pos >> 4) & 0x3FFF;
-					uint32_t floors = ind.floors;
-
-					QTreeNode* node = editor->map.getLeaf(ndx * 4, ndy * 4);
-					if (!node) continue;
-
-					for (auto& clientEntry : clients) {
-						LivePeer* peer = clientEntry.second;
-						if (!peer) continue;
-
-						const uint32_t clientId = peer->getClientId();
-						
-						if (node->isVisible(clientId, true) || node->isVisible(clientId, false)) {
-							workItems.push_back({peer, node, ndx, ndy, floors, clientId});
-						}
-					}
-				}
-
-				// If we have work to do, process it all in a single batch
-				if (!workItems.empty()) {
-					// Process work items in batches to avoid overwhelming the network
-					const size_t batchSize = 100; // Process 100 work items at a time
-					
-					for (size_t startIdx = 0; startIdx < workItems.size(); startIdx += batchSize) {
-						size_t endIdx = std::min(startIdx + batchSize, workItems.size());
-						
-						for (size_t i = startIdx; i < endIdx; ++i) {
-							const auto& work = workItems[i];
-							if (work.peer && work.node) {
-								sendNode(work.clientId, work.node, work.ndx, work.ndy, work.floors);
-							}
-						}
-					}
-					
-					// Log completion to file
-					std::ofstream logFile((GetAppDir() + wxFileName::GetPathSeparator() + "server_ops.log").ToStdString(), std::ios::app);
-					if (logFile.is_open()) {
-						wxDateTime now = wxDateTime::Now();
-						logFile << now.FormatISOCombined() << ": Broadcast completed, sent " << workItems.size() << " node updates\n";
-						logFile.close();
-					}
-				}
-			} catch (std::exception& e) {
-				// Log error to file
-				std::ofstream logFile((GetAppDir() + wxFileName::GetPathSeparator() + "server_error.log").ToStdString(), std::ios::app);
-				if (logFile.is_open()) {
-					wxDateTime now = wxDateTime::Now();
-					logFile << now.FormatISOCombined() << ": Error broadcasting nodes: " << e.what() << "\n";
-					logFile.close();
-				}
-			}
-		});
-		
-		if (logFile.is_open()) {
-			logFile << "Broadcast queued to main thread\n";
-			logFile.close();
-		}
-	} catch (std::exception& e) {
-		// Log error to file
-		if (logFile.is_open()) {
-			logFile << "Error preparing broadcast: " << e.what() << "\n";
-			logFile.close();
-		} else {
-			std::ofstream errorLog((GetAppDir() + wxFileName::GetPathSeparator() + "server_error.log").ToStdString(), std::ios::app);
-			if (errorLog.is_open()) {
-				wxDateTime now = wxDateTime::Now();
-				errorLog << now.FormatISOCombined() << ": Error preparing broadcast: " << e.what() << "\n";
-				errorLog.close();
+		// The node is encoded once, every receiver queues the same packet
+		try {
+			NetworkMessage message;
+			const uint16_t sendMask = writeNode(message, node, ndx, ndy, ind.floors);
+			const SharedPacket packet = sealPacket(message);
+			const uint64_t key = LivePeer::nodePacketKey(ind.pos | ((ind.floors & 0xFF00) ? 1 : 0), sendMask);
+
+			const bool underground = isUnderground(ind.floors);
+			for (LivePeer* peer : receivers) {
+				node->setVisible(peer->getClientId(), underground, true);
+				peer->queuePacket(packet, key);
 			}
+		} catch (std::exception& e) {
+			logMessage(wxString::Format("Error broadcasting node [%d,%d]: %s", ndx, ndy, e.what()));
 		}
 	}
 }
@@ -493,10 +373,7 @@ void LiveServer::broadcastCursor(const LiveCursor& cursor) {
 	message.write<uint8_t>(PACKET_CURSOR_UPDATE);
 	writeCursor(message, cursor);
 
-	for (auto& clientEntry : clients) {
-		LivePeer* peer = clientEntry.second;
-		peer->send(message);
-	}
+	broadcast(message, LivePeer::cursorPacketKey(cursor.id));
 	
 	g_gui.RefreshView();
 }
@@ -521,9 +398,7 @@ void LiveServer::broadcastChat(const wxString& speaker, const wxString& chatMess
 	message.write<std::string>(nstr(displayName));
 	message.write<std::string>(nstr(chatMessage));
 
-	for (auto& clientEntry : clients) {
-		clientEntry.second->send(message);
-	}
+	broadcast(message);
 
 	if (log) {
 		log->Chat(displayName, chatMessage);
@@ -544,9 +419,7 @@ void LiveServer::startOperation(const wxString& operationMessage) {
 	message.write<uint8_t>(PACKET_START_OPERATION);
 	message.write<std::string>(nstr(operationMessage));
 
-	for (auto& clientEntry : clients) {
-		clientEntry.second->send(message);
-	}
+	broadcast(message);
 }
 
 void LiveServer::updateOperation(int32_t percent) {
@@ -558,9 +431,7 @@ void LiveServer::updateOperation(int32_t percent) {
 	message.write<uint8_t>(PACKET_UPDATE_OPERATION);
 	message.write<uint32_t>(percent);
 
-	for (auto& clientEntry : clients) {
-		clientEntry.second->send(message);
-	}
+	broadcast(message);
 }
 
 LiveLogTab* LiveServer::createLogWindow(wxWindow* parent) {
@@ -593,10 +464,7 @@ void LiveServer::broadcastColorChange(uint32_t clientId, const wxColor& color) {
 	logMessage(wxString::Format("[Server]: Broadcasting color change for client %u: RGB(%d,%d,%d)", 
 		clientId, color.Red(), color.Green(), color.Blue()));
 
-	// Send to all clients
-	for (auto& clientEntry : clients) {
-		clientEntry.second->send(message);
-	}
+	broadcast(message);
 
 	// Update client list in all open log tabs
 	updateClientList();
@@ -85,6 +85,9 @@ public:
 	}
 
 protected:
+	// Seals the message once and queues it to every client
+	void broadcast(NetworkMessage& message, uint64_t coalesceKey = 0);
+
 	std::unordered_map<uint32_t, LivePeer*> clients;
 
 	std::shared_ptr<boost::asio::ip::tcp::acceptor> acceptor;
@@ -112,6 +112,10 @@ void LiveSocket::receiveNode(NetworkMessage& message, Editor& editor, Action* ac
 	}
 }
 
+bool LiveSocket::isUnderground(uint32_t floorMask) {
+	return (floorMask & 0xFF00) && !(floorMask & 0x00FF);
+}
+
 void LiveSocket::sendNode(uint32_t clientId, QTreeNode* node, int32_t ndx, int32_t ndy, uint32_t floorMask) {
 	// Safety check
 	if (!node) {
@@ -119,60 +123,46 @@ void LiveSocket::sendNode(uint32_t clientId, QTreeNode* node, int32_t ndx, int32
 		return;
 	}
 
-	bool underground;
-	if (floorMask & 0xFF00) {
-		if (floorMask & 0x00FF) {
-			underground = false;
-		} else {
-			underground = true;
-		}
-	} else {
-		underground = false;
-	}
-
 	// Mark the node as visible to this client
-	node->setVisible(clientId, underground, true);
+	node->setVisible(clientId, isUnderground(floorMask), true);
 
 	try {
-		// Prepare the message
 		NetworkMessage message;
-		message.write<uint8_t>(PACKET_NODE);
-		message.write<uint32_t>((ndx << 18) | (ndy << 4) | ((floorMask & 0xFF00) ? 1 : 0));
-
-		// Check floors
-		Floor** floors = node->getFloors();
-		bool hasFloors = false;
-
-		uint16_t sendMask = 0;
-		for (uint32_t z = 0; z < MAP_LAYERS; ++z) {
-			uint32_t bit = 1 << z;
-			if (floors[z] && testFlags(floorMask, bit)) {
-				sendMask |= bit;
-				hasFloors = true;
-			}
-		}
-
-		// Add the floor mask to the message
-		message.write<uint16_t>(sendMask);
-
-		// If we have floors to send, add them to the message
-		if (hasFloors) {
-			for (uint32_t z = 0; z < MAP_LAYERS; ++z) {
-				if (testFlags(sendMask, static_cast<uint64_t>(1) << z)) {
-					sendFloor(message, floors[z]);
-				}
-			}
-		}
+		const uint16_t sendMask = writeNode(message, node, ndx, ndy, floorMask);
 
 		// Send the message
 		logMessage(wxString::Format("Sending node [%d,%d,%s] with floor mask 0x%04X", 
-			ndx, ndy, underground ? "underground" : "surface", sendMask));
+			ndx, ndy, isUnderground(floorMask) ? "underground" : "surface", sendMask));
 		send(message);
 	} catch (std::exception& e) {
 		logMessage(wxString::Format("Error sending node [%d,%d]: %s", ndx, ndy, e.what()));
 	}
 }
 
+uint16_t LiveSocket::writeNode(NetworkMessage& message, QTreeNode* node, int32_t ndx, int32_t ndy, uint32_t floorMask) {
+	message.write<uint8_t>(PACKET_NODE);
+	message.write<uint32_t>((ndx << 18) | (ndy << 4) | ((floorMask & 0xFF00) ? 1 : 0));
+
+	// Check floors
+	Floor** floors = node->getFloors();
+	uint16_t sendMask = 0;
+	for (uint32_t z = 0; z < MAP_LAYERS; ++z) {
+		uint32_t bit = 1 << z;
+		if (floors[z] && testFlags(floorMask, bit)) {
+			sendMask |= bit;
+		}
+	}
+
+	// Add the floor mask to the message, followed by the floors it names
+	message.write<uint16_t>(sendMask);
+	for (uint32_t z = 0; z < MAP_LAYERS; ++z) {
+		if (testFlags(sendMask, static_cast<uint64_t>(1) << z)) {
+			sendFloor(message, floors[z]);
+		}
+	}
+	return sendMask;
+}
+
 void LiveSocket::receiveFloor(NetworkMessage& message, Editor& editor, Action* action, int32_t ndx, int32_t ndy, int32_t z, QTreeNode* node, Floor* floor) {
 	Map& map = editor.map;
 
@@ -432,3 +422,9 @@ void LiveSocket::writeCursor(NetworkMessage& message, const LiveCursor& cursor)
 	message.write<uint8_t>(cursor.color.Alpha());
 	message.write<Position>(cursor.pos);
 }
+
+SharedPacket LiveSocket::sealPacket(NetworkMessage& message) {
+	const uint32_t size = static_cast<uint32_t>(message.size);
+	memcpy(&message.buffer[0], &size, 4);
+	return std::make_shared<const std::vector<uint8_t>>(message.buffer.begin(), message.buffer.begin() + message.size + 4);
+}
@@ -30,6 +30,10 @@
 class LiveLogTab;
 class Action;
 
+// A sealed packet, size header included. It is immutable so one encoding can be
+// queued to any number of peers.
+typedef std::shared_ptr<const std::vector<uint8_t>> SharedPacket;
+
 struct LiveCursor {
 	uint32_t id;
 	wxColor color;
@@ -89,6 +93,9 @@ protected:
 	// receive / send methods
 	void receiveNode(NetworkMessage& message, Editor& editor, Action* action, int32_t ndx, int32_t ndy, bool underground);
 	void sendNode(uint32_t clientId, QTreeNode* node, int32_t ndx, int32_t ndy, uint32_t floorMask);
+	// Writes a PACKET_NODE with the floors of floorMask the node has, returns the floors written
+	uint16_t writeNode(NetworkMessage& message, QTreeNode* node, int32_t ndx, int32_t ndy, uint32_t floorMask);
+	static bool isUnderground(uint32_t floorMask);
 
 	void receiveFloor(NetworkMessage& message, Editor& editor, Action* action, int32_t ndx, int32_t ndy, int32_t z, QTreeNode* node, Floor* floor);
 	void sendFloor(NetworkMessage& message, Floor* floor);
@@ -102,6 +109,9 @@ protected:
 	LiveCursor readCursor(NetworkMessage& message);
 	void writeCursor(NetworkMessage& message, const LiveCursor& cursor);
 
+	// Writes the size header and copies the message into a shareable packet
+	static SharedPacket sealPacket(NetworkMessage& message);
+
 	//
 	std::unordered_map<uint32_t, LiveCursor> cursors;
 
@@ -1011,7 +1011,7 @@ void MainMenuBar::OnSearchForItem(wxCommandEvent& WXUNUSED(event)) {
                 OnSearchForItem::RangeFinder finder(ranges, ignored_ids, ignored_ranges);
                 g_gui.CreateLoadBar("Searching map...");
                 
-                foreach_ItemOnMap(g_gui.GetCurrentMap(), finder, false);
+                foreach_ItemOnMap(g_gui.GetCurrentMap(), ItemIndex::ITEM_ID, ranges, finder, false);
                 std::vector<std::pair<Tile*, Item*>>& result = finder.result;
                 
                 g_gui.DestroyLoadBar();
@@ -1034,7 +1034,7 @@ void MainMenuBar::OnSearchForItem(wxCommandEvent& WXUNUSED(event)) {
             OnSearchForItem::Finder finder(dialog.getResultID(), (uint32_t)g_settings.getInteger(Config::REPLACE_SIZE));
             g_gui.CreateLoadBar("Searching map...");
 
-            foreach_ItemOnMap(g_gui.GetCurrentMap(), finder, false);
+            foreach_ItemOnMap(g_gui.GetCurrentMap(), ItemIndex::ITEM_ID, finder.itemId, finder, false);
             std::vector<std::pair<Tile*, Item*>>& result = finder.result;
 
             g_gui.DestroyLoadBar();
@@ -1361,7 +1361,7 @@ void MainMenuBar::OnSearchForItemOnSelection(wxCommandEvent& WXUNUSED(event)) {
 				OnSearchForItem::RangeFinder finder(ranges);
 				g_gui.CreateLoadBar("Searching on selected area...");
 				
-				foreach_ItemOnMap(g_gui.GetCurrentMap(), finder, true);
+				foreach_ItemOnMap(g_gui.GetCurrentMap(), ItemIndex::ITEM_ID, ranges, finder, true);
 				std::vector<std::pair<Tile*, Item*>>& result = finder.result;
 				
 				g_gui.DestroyLoadBar();
@@ -1392,7 +1392,7 @@ void MainMenuBar::OnSearchForItemOnSelection(wxCommandEvent& WXUNUSED(event)) {
 			OnSearchForItem::Finder finder(dialog.getResultID(), (uint32_t)g_settings.getInteger(Config::REPLACE_SIZE));
 			g_gui.CreateLoadBar("Searching on selected area...");
 
-			foreach_ItemOnMap(g_gui.GetCurrentMap(), finder, true);
+			foreach_ItemOnMap(g_gui.GetCurrentMap(), ItemIndex::ITEM_ID, finder.itemId, finder, true);
 			std::vector<std::pair<Tile*, Item*>>& result = finder.result;
 
 			g_gui.DestroyLoadBar();
@@ -1641,7 +1641,7 @@ void MainMenuBar::OnMapRemoveItems(wxCommandEvent& WXUNUSED(event)) {
 		OnMapRemoveItems::RemoveItemCondition condition(itemid);
 		g_gui.CreateLoadBar("Searching map for items to remove...");
 
-		int64_t count = RemoveItemOnMap(g_gui.GetCurrentMap(), condition, false);
+		int64_t count = RemoveItemOnMap(g_gui.GetCurrentMap(), itemid, condition, false);
 
 		g_gui.DestroyLoadBar();
 
@@ -2993,7 +2993,28 @@ void MainMenuBar::SearchItems(bool unique, bool action, bool container, bool wri
         searcher.uniqueRanges = uniqueRanges;
         searcher.actionRanges = actionRanges;
 
-        foreach_ItemOnMap(g_gui.GetCurrentMap(), searcher, onSelection);
+        if (zones || container || writable) {
+            foreach_ItemOnMap(g_gui.GetCurrentMap(), searcher, onSelection);
+        } else {
+            // Only action and unique IDs are wanted, the item index knows where they are
+            Map& map = g_gui.GetCurrentMap();
+            const std::vector<std::pair<uint16_t, uint16_t>> anyId { std::make_pair(uint16_t(1), uint16_t(0xFFFF)) };
+            TileVector tiles;
+            if (unique) {
+                map.getIndexedTiles(ItemIndex::UNIQUE_ID, uniqueRanges.empty() ? anyId : uniqueRanges, onSelection, tiles);
+            }
+            if (action) {
+                map.getIndexedTiles(ItemIndex::ACTION_ID, actionRanges.empty() ? anyId : actionRanges, onSelection, tiles);
+            }
+            // A tile may hold both kinds of IDs
+            std::sort(tiles.begin(), tiles.end());
+            tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+
+            long long done = 0;
+            for (Tile* tile : tiles) {
+                foreach_ItemOnTile(map, tile, searcher, ++done);
+            }
+        }
         searcher.sort();
         std::vector<std::pair<Tile*, Item*>>& found = searcher.found;
 
@@ -3490,7 +3511,7 @@ void MainMenuBar::OnRefreshItems(wxCommandEvent& WXUNUSED(event)) {
         
         // First find all matching items
         OnSearchForItem::Finder finder(dialog.getResultID(), (uint32_t)g_settings.getInteger(Config::REPLACE_SIZE));
-        foreach_ItemOnMap(g_gui.GetCurrentMap(), finder, false);
+        foreach_ItemOnMap(g_gui.GetCurrentMap(), ItemIndex::ITEM_ID, finder.itemId, finder, false);
         std::vector<std::pair<Tile*, Item*>>& items = finder.result;
 
         // Store properties of found items
@@ -143,6 +143,7 @@ bool Map::convert(MapVersion to, bool showdialog) {
 }
 
 bool Map::convert(const ConversionMap& rm, bool showdialog) {
+	resetItemIndex();
 	if (showdialog) {
 		g_gui.CreateLoadBar("Converting map ...");
 	}
@@ -276,6 +277,7 @@ bool Map::convert(const ConversionMap& rm, bool showdialog) {
 }
 
 void Map::cleanInvalidTiles(bool showdialog) {
+	resetItemIndex();
 	uint64_t tiles_done = 0;
 	uint64_t removed_count = 0;
 	bool has_invalid_tiles = false;
@@ -340,6 +342,33 @@ void Map::cleanInvalidTiles(bool showdialog) {
 	}
 }
 
+void Map::getIndexedTiles(ItemIndex::Key key, const std::vector<std::pair<uint16_t, uint16_t>>& ranges, bool selectedOnly, TileVector& tiles) {
+	PositionVector blocks;
+	const ItemIndex& index = getItemIndex();
+	for (const auto& range : ranges) {
+		index.getBlocks(key, range.first, range.second, blocks);
+	}
+
+	std::sort(blocks.begin(), blocks.end(), [](const Position& a, const Position& b) {
+		if (a.z != b.z) {
+			return a.z < b.z;
+		}
+		return a.y != b.y ? a.y < b.y : a.x < b.x;
+	});
+	blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+
+	for (const Position& block : blocks) {
+		for (int y = block.y; y < block.y + ItemIndex::BLOCK_SIZE; ++y) {
+			for (int x = block.x; x < block.x + ItemIndex::BLOCK_SIZE; ++x) {
+				Tile* tile = getTile(x, y, block.z);
+				if (tile && (!selectedOnly || tile->isSelected())) {
+					tiles.push_back(tile);
+				}
+			}
+		}
+	}
+}
+
 void Map::convertHouseTiles(uint32_t fromId, uint32_t toId) {
 	g_gui.CreateLoadBar("Converting house tiles...");
 	uint64_t tiles_done = 0;
@@ -663,6 +692,7 @@ bool Map::exportMinimap(FileName filename, int floor, bool displaydialog) {
 }
 
 uint32_t Map::cleanDuplicateItems(const std::vector<std::pair<uint16_t, uint16_t>>& ranges, const PropertyFlags& flags) {
+	resetItemIndex();
 	uint32_t duplicates_removed = 0;
 	uint32_t tiles_affected = 0;
 
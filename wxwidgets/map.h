@@ -91,6 +91,10 @@ public:
 	bool convert(MapVersion to, bool showdialog = false);
 	bool convert(const ConversionMap& cm, bool showdialog = false);
 
+	// Tiles of the item index blocks holding items with a 'key' value in one of the ranges,
+	// ordered by floor, row and column. Callers still have to check the items on each tile.
+	void getIndexedTiles(ItemIndex::Key key, const std::vector<std::pair<uint16_t, uint16_t>>& ranges, bool selectedOnly, TileVector& tiles);
+
 	// Query information about the map
 
 	MapVersion getVersion() const;
@@ -219,6 +223,40 @@ public:
 	Waypoints waypoints;
 };
 
+template <typename ForeachType>
+inline void foreach_ItemOnTile(Map& map, Tile* tile, ForeachType& foreach, long long done) {
+	if (tile->ground) {
+		foreach (map, tile, tile->ground, done)
+			;
+	}
+
+	std::queue<Container*> containers;
+	for (ItemVector::iterator itemiter = tile->items.begin(); itemiter != tile->items.end(); ++itemiter) {
+		Item* item = *itemiter;
+		Container* container = dynamic_cast<Container*>(item);
+		foreach (map, tile, item, done)
+			;
+		if (container) {
+			containers.push(container);
+
+			do {
+				container = containers.front();
+				ItemVector& v = container->getVector();
+				for (ItemVector::iterator containeriter = v.begin(); containeriter != v.end(); ++containeriter) {
+					Item* i = *containeriter;
+					Container* c = dynamic_cast<Container*>(i);
+					foreach (map, tile, i, done)
+						;
+					if (c) {
+						containers.push(c);
+					}
+				}
+				containers.pop();
+			} while (containers.size());
+		}
+	}
+}
+
 template <typename ForeachType>
 inline void foreach_ItemOnMap(Map& map, ForeachType& foreach, bool selectedTiles) {
 	MapIterator tileiter = map.begin();
@@ -233,40 +271,28 @@ inline void foreach_ItemOnMap(Map& map, ForeachType& foreach, bool selectedTiles
 			continue;
 		}
 
-		if (tile->ground) {
-			foreach (map, tile, tile->ground, done)
-				;
-		}
-
-		std::queue<Container*> containers;
-		for (ItemVector::iterator itemiter = tile->items.begin(); itemiter != tile->items.end(); ++itemiter) {
-			Item* item = *itemiter;
-			Container* container = dynamic_cast<Container*>(item);
-			foreach (map, tile, item, done)
-				;
-			if (container) {
-				containers.push(container);
-
-				do {
-					container = containers.front();
-					ItemVector& v = container->getVector();
-					for (ItemVector::iterator containeriter = v.begin(); containeriter != v.end(); ++containeriter) {
-						Item* i = *containeriter;
-						Container* c = dynamic_cast<Container*>(i);
-						foreach (map, tile, i, done)
-							;
-						if (c) {
-							containers.push(c);
-						}
-					}
-					containers.pop();
-				} while (containers.size());
-			}
-		}
+		foreach_ItemOnTile(map, tile, foreach, done);
 		++tileiter;
 	}
 }
 
+// Same as foreach_ItemOnMap, but only visits the tiles the item index lists for these values
+template <typename ForeachType>
+inline void foreach_ItemOnMap(Map& map, ItemIndex::Key key, const std::vector<std::pair<uint16_t, uint16_t>>& ranges, ForeachType& foreach, bool selectedTiles) {
+	TileVector tiles;
+	map.getIndexedTiles(key, ranges, selectedTiles, tiles);
+
+	long long done = 0;
+	for (Tile* tile : tiles) {
+		foreach_ItemOnTile(map, tile, foreach, ++done);
+	}
+}
+
+template <typename ForeachType>
+inline void foreach_ItemOnMap(Map& map, ItemIndex::Key key, uint16_t value, ForeachType& foreach, bool selectedTiles) {
+	foreach_ItemOnMap(map, key, std::vector<std::pair<uint16_t, uint16_t>> { std::make_pair(value, value) }, foreach, selectedTiles);
+}
+
 template <typename ForeachType>
 inline void foreach_TileOnMap(Map& map, ForeachType& foreach) {
 	MapIterator tileiter = map.begin();
@@ -300,6 +326,37 @@ inline long long remove_if_TileOnMap(Map& map, RemoveIfType& remove_if) {
 	return removed;
 }
 
+template <typename RemoveIfType>
+inline void RemoveItemOnTile(Map& map, Tile* tile, RemoveIfType& condition, int64_t& removed, int64_t done) {
+	// Items are removed in place, so the item index has to follow
+	ItemIndex* index = map.getItemIndexIfBuilt();
+
+	if (tile->ground) {
+		if (condition(map, tile->ground, removed, done)) {
+			if (index) {
+				index->removeItem(tile, tile->ground);
+			}
+			delete tile->ground;
+			tile->ground = nullptr;
+			++removed;
+		}
+	}
+
+	for (auto iit = tile->items.begin(); iit != tile->items.end();) {
+		Item* item = *iit;
+		if (condition(map, item, removed, done)) {
+			if (index) {
+				index->removeItem(tile, item);
+			}
+			iit = tile->items.erase(iit);
+			delete item;
+			++removed;
+		} else {
+			++iit;
+		}
+	}
+}
+
 template <typename RemoveIfType>
 inline int64_t RemoveItemOnMap(Map& map, RemoveIfType& condition, bool selectedOnly) {
 	int64_t done = 0;
@@ -316,27 +373,24 @@ inline int64_t RemoveItemOnMap(Map& map, RemoveIfType& condition, bool selectedO
 			continue;
 		}
 
-		if (tile->ground) {
-			if (condition(map, tile->ground, removed, done)) {
-				delete tile->ground;
-				tile->ground = nullptr;
-				++removed;
-			}
-		}
-
-		for (auto iit = tile->items.begin(); iit != tile->items.end();) {
-			Item* item = *iit;
-			if (condition(map, item, removed, done)) {
-				iit = tile->items.erase(iit);
-				delete item;
-				++removed;
-			} else {
-				++iit;
-			}
-		}
+		RemoveItemOnTile(map, tile, condition, removed, done);
 		++it;
 	}
 	return removed;
 }
 
+// Same as RemoveItemOnMap, but only visits the tiles holding items with this ID
+template <typename RemoveIfType>
+inline int64_t RemoveItemOnMap(Map& map, uint16_t itemId, RemoveIfType& condition, bool selectedOnly) {
+	TileVector tiles;
+	map.getIndexedTiles(ItemIndex::ITEM_ID, { std::make_pair(itemId, itemId) }, selectedOnly, tiles);
+
+	int64_t done = 0;
+	int64_t removed = 0;
+	for (Tile* tile : tiles) {
+		RemoveItemOnTile(map, tile, condition, removed, ++done);
+	}
+	return removed;
+}
+
 #endif
@@ -155,7 +155,8 @@ bool DrawingOptions::isDrawLight() const noexcept {
 }
 
 MapDrawer::MapDrawer(MapCanvas* canvas) :
-	canvas(canvas), editor(canvas->editor) {
+	canvas(canvas), editor(canvas->editor),
+	prefetch_start_x(-1), prefetch_start_y(-1), prefetch_end_x(-1), prefetch_end_y(-1), prefetch_floor(-1) {
 	light_drawer = std::make_shared<LightDrawer>();
 }
 
@@ -236,6 +237,7 @@ void MapDrawer::Release() {
 }
 
 void MapDrawer::Draw() {
+	PrefetchSprites();
 	DrawBackground();
 	DrawMap();
 	if (options.isDrawLight()) {
@@ -259,6 +261,60 @@ void MapDrawer::Draw() {
 	}
 }
 
+void MapDrawer::PrefetchSprites() {
+	// Tiles this far outside the viewport get their sprites decoded before they scroll into view
+	const int margin = 4;
+
+	if (options.show_as_minimap || options.show_only_colors) {
+		return;
+	}
+	if (start_x == prefetch_start_x && start_y == prefetch_start_y && end_x == prefetch_end_x && end_y == prefetch_end_y && floor == prefetch_floor) {
+		return;
+	}
+	prefetch_start_x = start_x;
+	prefetch_start_y = start_y;
+	prefetch_end_x = end_x;
+	prefetch_end_y = end_y;
+	prefetch_floor = floor;
+
+	std::vector<GameSprite*> sprites;
+	std::unordered_set<GameSprite*> seen;
+	auto addItem = [&](const Item* item) {
+		GameSprite* spr = g_items[item->getID()].sprite;
+		if (spr && seen.insert(spr).second) {
+			sprites.push_back(spr);
+		}
+	};
+
+	for (int map_z = start_z; map_z >= end_z; map_z--) {
+		for (int map_y = start_y - margin; map_y <= end_y + margin; ++map_y) {
+			for (int map_x = start_x - margin; map_x <= end_x + margin; ++map_x) {
+				if (map_x >= start_x && map_x <= end_x && map_y >= start_y && map_y <= end_y) {
+					map_x = end_x; // Skip the visible part of the row, it is drawn right away
+					continue;
+				}
+				if (map_x < 0 || map_y < 0) {
+					continue;
+				}
+				const Tile* tile = editor.map.getTile(map_x, map_y, map_z);
+				if (!tile) {
+					continue;
+				}
+				if (tile->ground) {
+					addItem(tile->ground);
+				}
+				for (const Item* item : tile->items) {
+					addItem(item);
+				}
+			}
+		}
+	}
+
+	if (!sprites.empty()) {
+		g_gui.gfx.prefetchSprites(sprites);
+	}
+}
+
 void MapDrawer::DrawBackground() {
 	// Black Background
 	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
@@ -337,7 +393,6 @@ void MapDrawer::DrawMap() {
 			int nd_end_x = (end_x & ~3) + 4;
 			int nd_end_y = (end_y & ~3) + 4;
 
-			zoneTiles.clear();
 			for (int nd_map_x = nd_start_x; nd_map_x <= nd_end_x; nd_map_x += 4) {
 				for (int nd_map_y = nd_start_y; nd_map_y <= nd_end_y; nd_map_y += 4) {
 					QTreeNode* nd = editor.map.getLeaf(nd_map_x, nd_map_y);
@@ -380,17 +435,16 @@ void MapDrawer::DrawMap() {
 					}
 				}
 			}
-			for (auto& itZonePos : zoneTiles) {
-				ZoneFinder finder(itZonePos.second);
-				auto zones = finder.findZones();
-
-				for (const auto& itZone : zones) {
-					const FinderPosition center = finder.findClosestToCenter(itZone);
-
-					QTreeNode* nd = editor.getMap().getLeaf(center.x, center.y);
-					TileLocation* location = nd->getTile(center.x, center.y, center.z);
-
-					const Tile* tile = location->get();
+			if (options.show_tooltips && map_z == floor && zoom <= g_settings.getInteger(Config::TOOLTIP_MAX_ZOOM)) {
+				// One label per connected zone region, the regions are cached by the map
+				zoneAnchors.clear();
+				editor.map.getZoneIndex().getLabelAnchors(nd_start_x, nd_start_y, nd_end_x + 3, nd_end_y + 3, map_z, zoneAnchors);
+
+				for (const Position& center : zoneAnchors) {
+					const Tile* tile = editor.map.getTile(center);
+					if (!tile) {
+						continue;
+					}
 
 					std::ostringstream tooltip;
 					tooltip << "zone id: ";
@@ -1582,16 +1636,8 @@ void MapDrawer::WriteTooltip(Tile* tile, Item* item, std::ostringstream& stream,
 		stream << "\n";
 	}
 
-	if (!zoneIds.empty()) {
-		for (auto& zoneId : zoneIds) {
-			auto itZone = zoneTiles.find(zoneId);
-			if (itZone == zoneTiles.end()) {
-				zoneTiles.emplace(zoneId, std::vector<FinderPosition>({ FinderPosition(tile->getX(), tile->getY(), tile->getZ()) }));
-			} else {
-				itZone->second.push_back(FinderPosition(tile->getX(), tile->getY(), tile->getZ()));
-			}
-		}
-	} else {
+	// Zone tiles are labelled once per zone region by DrawMap
+	if (zoneIds.empty()) {
 		stream << "id: " << id << "\n";
 	}
 
@@ -235,6 +235,10 @@ Tile* QTreeNode::setTile(int x, int y, int z, Tile* newtile) {
 	TileLocation* tmp = &f->locs[offset_x * 4 + offset_y];
 	Tile* oldtile = tmp->tile;
 	tmp->tile = newtile;
+	map.zone_index.removeTile(oldtile);
+	map.zone_index.addTile(newtile);
+	map.item_index.removeTile(oldtile);
+	map.item_index.addTile(newtile);
 
 	if (newtile && !oldtile) {
 		++map.tilecount;
@@ -253,6 +257,8 @@ void QTreeNode::clearTile(int x, int y, int z) {
 	int offset_y = y & 3;
 
 	TileLocation* tmp = &f->locs[offset_x * 4 + offset_y];
+	map.zone_index.removeTile(tmp->tile);
+	map.item_index.removeTile(tmp->tile);
 	delete tmp->tile;
 	tmp->tile = map.allocator(tmp);
 }
@@ -645,6 +645,14 @@ void OldPropertiesWindow::OnChar(wxKeyEvent& evt) {
 	evt.Skip();
 }
 
+bool OldPropertiesWindow::isUniqueIDTaken(int uid) const {
+	// Keeping the current UID is always fine
+	if (uid == 0 || !edit_map || !edit_item || uid == edit_item->getUniqueID()) {
+		return false;
+	}
+	return edit_map->getItemIndex().count(ItemIndex::UNIQUE_ID, static_cast<uint16_t>(uid)) > 0;
+}
+
 void OldPropertiesWindow::OnClickOK(wxCommandEvent& WXUNUSED(event)) {
 	if (edit_item) {
 		if (dynamic_cast<Container*>(edit_item)) {
@@ -656,7 +664,7 @@ void OldPropertiesWindow::OnClickOK(wxCommandEvent& WXUNUSED(event)) {
 				g_gui.PopupDialog(this, "Error", "Unique ID must be between 1000 and 65535.", wxOK);
 				return;
 			}
-			if (/* there is no item with the same UID */ false) {
+			if (isUniqueIDTaken(new_uid)) {
 				g_gui.PopupDialog(this, "Error", "Unique ID must be unique, this UID is already taken.", wxOK);
 				return;
 			}
@@ -677,7 +685,7 @@ void OldPropertiesWindow::OnClickOK(wxCommandEvent& WXUNUSED(event)) {
 				g_gui.PopupDialog(this, "Error", "Unique ID must be between 1000 and 65535.", wxOK);
 				return;
 			}
-			if (/* there is no item with the same UID */ false) {
+			if (isUniqueIDTaken(new_uid)) {
 				g_gui.PopupDialog(this, "Error", "Unique ID must be unique, this UID is already taken.", wxOK);
 				return;
 			}
@@ -709,7 +717,7 @@ void OldPropertiesWindow::OnClickOK(wxCommandEvent& WXUNUSED(event)) {
 				g_gui.PopupDialog(this, "Error", "Unique ID must be between 1000 and 65535.", wxOK);
 				return;
 			}
-			if (/* there is no item with the same UID */ false) {
+			if (isUniqueIDTaken(new_uid)) {
 				g_gui.PopupDialog(this, "Error", "Unique ID must be unique, this UID is already taken.", wxOK);
 				return;
 			}
@@ -757,7 +765,7 @@ void OldPropertiesWindow::OnClickOK(wxCommandEvent& WXUNUSED(event)) {
 				g_gui.PopupDialog(this, "Error", "Unique ID must be between 1000 and 65535.", wxOK);
 				return;
 			}
-			if (/* there is no item with the same UID */ false) {
+			if (isUniqueIDTaken(new_uid)) {
 				g_gui.PopupDialog(this, "Error", "Unique ID must be unique, this UID is already taken.", wxOK);
 				return;
 			}
@@ -60,6 +60,9 @@ protected:
 	// Singleton instance for non-modal use
 	static OldPropertiesWindow* instance;
 
+	// True if another item on the map already has this unique ID
+	bool isUniqueIDTaken(int uid) const;
+
 	// item
 	wxSpinCtrl* count_field;
 	wxSpinCtrl* action_id_field;
@@ -86,7 +86,6 @@ protected:
 	wxColourPickerCtrl* dark_mode_color_pick;
 	/*
 	wxCheckBox* texture_managment_chkbox;
-	wxSpinCtrl* clean_interval_spin;
 	wxSpinCtrl* texture_longevity_spin;
 	wxSpinCtrl* texture_threshold_spin;
 	wxSpinCtrl* software_threshold_spin;
@@ -235,7 +235,7 @@ void SearchResultWindow::ContinueSearch() {
 	ContinuedFinder finder(last_search_itemid, existingPositions, 
 		(uint32_t)g_settings.getInteger(Config::REPLACE_SIZE));
 	
-	foreach_ItemOnMap(g_gui.GetCurrentMap(), finder, last_search_on_selection);
+	foreach_ItemOnMap(g_gui.GetCurrentMap(), ItemIndex::ITEM_ID, last_search_itemid, finder, last_search_on_selection);
 	std::vector<std::pair<Tile*, Item*>>& result = finder.result;
 	
 	g_gui.DestroyLoadBar();
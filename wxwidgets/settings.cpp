@@ -290,7 +290,6 @@ void Settings::IO(IOMode mode) {
 
 	section("Graphics");
 	Int(TEXTURE_MANAGEMENT, 1);
-	Int(TEXTURE_CLEAN_PULSE, 15);
 	Int(TEXTURE_LONGEVITY, 20);
 	Int(TEXTURE_CLEAN_THRESHOLD, 2500);
 	Int(SOFTWARE_CLEAN_THRESHOLD, 1800);
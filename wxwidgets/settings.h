@@ -31,7 +31,6 @@ namespace Config {
 
 		MERGE_MOVE,
 		TEXTURE_MANAGEMENT,
-		TEXTURE_CLEAN_PULSE,
 		TEXTURE_CLEAN_THRESHOLD,
 		TEXTURE_LONGEVITY,
 		HARD_REFRESH_RATE,
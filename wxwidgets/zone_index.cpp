@@ -0,0 +1,170 @@
+//////////////////////////////////////////////////////////////////////
+// This file is part of Remere's Map Editor
+//////////////////////////////////////////////////////////////////////
+// Remere's Map Editor is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Remere's Map Editor is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//////////////////////////////////////////////////////////////////////
+
+#include "main.h"
+
+#include "zone_index.h"
+#include "tile.h"
+
+#include <algorithm>
+#include <limits>
+
+void ZoneIndex::addTile(const Tile* tile) {
+	if (!tile || tile->getZoneIds().empty()) {
+		return;
+	}
+
+	FloorZones& floor = floors[tile->getZ()];
+	const uint32_t key = packPosition(tile->getX(), tile->getY());
+	for (uint16_t zoneId : tile->getZoneIds()) {
+		ZoneFloor& zone = floor.zones[zoneId];
+		if (zone.tiles.insert(key).second) {
+			zone.dirty = true;
+			floor.dirty = true;
+		}
+	}
+}
+
+void ZoneIndex::removeTile(const Tile* tile) {
+	if (!tile || tile->getZoneIds().empty()) {
+		return;
+	}
+
+	FloorZones& floor = floors[tile->getZ()];
+	const uint32_t key = packPosition(tile->getX(), tile->getY());
+	for (uint16_t zoneId : tile->getZoneIds()) {
+		auto it = floor.zones.find(zoneId);
+		if (it == floor.zones.end() || it->second.tiles.erase(key) == 0) {
+			continue;
+		}
+		if (it->second.tiles.empty()) {
+			floor.zones.erase(it);
+		} else {
+			it->second.dirty = true;
+		}
+		floor.dirty = true;
+	}
+}
+
+void ZoneIndex::clear() {
+	for (FloorZones& floor : floors) {
+		floor.zones.clear();
+		floor.anchors.clear();
+		floor.dirty = false;
+	}
+}
+
+void ZoneIndex::getLabelAnchors(int start_x, int start_y, int end_x, int end_y, int z, PositionVector& anchors) {
+	if (z < 0 || z >= MAP_LAYERS) {
+		return;
+	}
+
+	FloorZones& floor = floors[z];
+	if (floor.dirty) {
+		update(floor);
+	}
+
+	auto it = std::lower_bound(floor.anchors.begin(), floor.anchors.end(), start_x, [](const Position& anchor, int x) {
+		return anchor.x < x;
+	});
+	for (; it != floor.anchors.end() && it->x <= end_x; ++it) {
+		if (it->y >= start_y && it->y <= end_y) {
+			anchors.push_back(*it);
+		}
+	}
+}
+
+void ZoneIndex::update(FloorZones& floor) {
+	const int z = static_cast<int>(&floor - floors);
+
+	floor.anchors.clear();
+	for (auto& it : floor.zones) {
+		ZoneFloor& zone = it.second;
+		if (zone.dirty) {
+			findAnchors(zone, z);
+		}
+		floor.anchors.insert(floor.anchors.end(), zone.anchors.begin(), zone.anchors.end());
+	}
+	std::sort(floor.anchors.begin(), floor.anchors.end(), [](const Position& a, const Position& b) {
+		return a.x < b.x || (a.x == b.x && a.y < b.y);
+	});
+	// A tile in several zones is an anchor for each of them, but gets a single label
+	floor.anchors.erase(std::unique(floor.anchors.begin(), floor.anchors.end()), floor.anchors.end());
+	floor.dirty = false;
+}
+
+void ZoneIndex::findAnchors(ZoneFloor& zone, int z) {
+	zone.anchors.clear();
+
+	std::unordered_set<uint32_t> visited;
+	visited.reserve(zone.tiles.size());
+	std::vector<uint32_t> region;
+	std::vector<uint32_t> stack;
+
+	for (uint32_t start : zone.tiles) {
+		if (!visited.insert(start).second) {
+			continue;
+		}
+
+		// Flood fill the 4-connected region around this tile
+		region.clear();
+		stack.push_back(start);
+		while (!stack.empty()) {
+			const uint32_t key = stack.back();
+			stack.pop_back();
+			region.push_back(key);
+
+			const int x = key >> 16;
+			const int y = key & 0xFFFF;
+			const uint32_t neighbors[] = {
+				packPosition(x + 1, y),
+				packPosition(x - 1, y),
+				packPosition(x, y + 1),
+				packPosition(x, y - 1)
+			};
+			for (uint32_t next : neighbors) {
+				if (zone.tiles.count(next) != 0 && visited.insert(next).second) {
+					stack.push_back(next);
+				}
+			}
+		}
+
+		// The label goes on the region tile closest to the centroid
+		int64_t sum_x = 0;
+		int64_t sum_y = 0;
+		for (uint32_t key : region) {
+			sum_x += key >> 16;
+			sum_y += key & 0xFFFF;
+		}
+		const double center_x = static_cast<double>(sum_x / static_cast<int64_t>(region.size()));
+		const double center_y = static_cast<double>(sum_y / static_cast<int64_t>(region.size()));
+
+		double min_distance = std::numeric_limits<double>::max();
+		uint32_t closest = region.front();
+		for (uint32_t key : region) {
+			const double dx = static_cast<int>(key >> 16) - center_x;
+			const double dy = static_cast<int>(key & 0xFFFF) - center_y;
+			const double distance = dx * dx + dy * dy;
+			if (distance < min_distance) {
+				min_distance = distance;
+				closest = key;
+			}
+		}
+		zone.anchors.push_back(Position(closest >> 16, closest & 0xFFFF, z));
+	}
+	zone.dirty = false;
+}
@@ -0,0 +1,69 @@
+//////////////////////////////////////////////////////////////////////
+// This file is part of Remere's Map Editor
+//////////////////////////////////////////////////////////////////////
+// Remere's Map Editor is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Remere's Map Editor is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//////////////////////////////////////////////////////////////////////
+
+#ifndef RME_ZONE_INDEX_H
+#define RME_ZONE_INDEX_H
+
+#include "position.h"
+
+#include <map>
+#include <unordered_set>
+
+class Tile;
+
+// Connected regions of every zone ID, per floor.
+// Kept up to date as tiles enter and leave the map; the regions and their label
+// anchors of a zone are only recomputed when one of its tiles changed since the last query.
+class ZoneIndex {
+public:
+	ZoneIndex() = default;
+
+	ZoneIndex(const ZoneIndex&) = delete;
+	ZoneIndex& operator=(const ZoneIndex&) = delete;
+
+	void addTile(const Tile* tile);
+	void removeTile(const Tile* tile);
+	void clear();
+
+	// Appends the label anchors of floor 'z' inside the given rectangle,
+	// one per connected region of a zone, at the region tile closest to its centroid
+	void getLabelAnchors(int start_x, int start_y, int end_x, int end_y, int z, PositionVector& anchors);
+
+private:
+	struct ZoneFloor {
+		std::unordered_set<uint32_t> tiles; // Packed x/y
+		PositionVector anchors;
+		bool dirty = false;
+	};
+
+	struct FloorZones {
+		std::map<uint16_t, ZoneFloor> zones;
+		PositionVector anchors; // Of all zones, sorted by x
+		bool dirty = false;
+	};
+
+	static uint32_t packPosition(int x, int y) {
+		return (static_cast<uint32_t>(x) << 16) | static_cast<uint32_t>(y & 0xFFFF);
+	}
+
+	void update(FloorZones& floor);
+	static void findAnchors(ZoneFloor& zone, int z);
+
+	FloorZones floors[MAP_LAYERS];
+};
+
+#endif